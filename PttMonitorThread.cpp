@@ -1,18 +1,34 @@
 // PttMonitorThread.cpp
 #include "PttMonitorThread.h"
-#include <QDebug>
 #include <QMutexLocker>
-#include <QDateTime>
+#include <algorithm>
+#include <sched.h>
+#include "asynclogger.h"
 #include "fpga_driver.h"
 #include "channel_utils.h"
 #include "channelcachemanager.h"
+#include "channelparamqueue.h"
+#include "wakeupnotifier.h"
 PttMonitorThread::PttMonitorThread(ConfigManager* configManager, QObject* parent)
     : QThread(parent)
     , m_stopFlag(0)
     , m_currentPtt(0)
     , m_configManager(configManager)
     , m_manager(new RadioChannelManager(configManager, this))
+    , m_lastPtt(0)
+    , m_paramsPending(false)
+    , m_committedPtt(0)
+    , m_hasCommitted(false)
 {
+    for (int i = 0; i < RadioChannelManager::DAC_COUNT; i++) {
+        m_committedChannels[i] = 0;
+        m_committedSelections[i] = 0;
+    }
+    // 一轮最多取空整个参数队列
+    m_batchReceivedNs.reserve(ChannelParamQueue::CAPACITY);
+
+    m_commitNotifier = new WakeupNotifier(this);
+    connect(m_commitNotifier, &WakeupNotifier::activated, this, &PttMonitorThread::hardwareCommitted);
 }
 
 PttMonitorThread::~PttMonitorThread()
@@ -35,41 +51,191 @@ void PttMonitorThread::wakeUp()
     m_semaphore.release(); // 唤醒等待中的线程
 }
 
+void PttMonitorThread::setRtProfile(const RtProfile& profile)
+{
+    m_rtProfile = profile;
+}
+
+RtProfile PttMonitorThread::rtProfile() const
+{
+    return m_rtProfile;
+}
+
+JitterStats PttMonitorThread::jitterStats() const
+{
+    return m_jitter.stats();
+}
+
+void PttMonitorThread::restoreState(UINT8 ptt, const QVector<INT8>& dacChannels, const QVector<INT8>& dacSelections)
+{
+    m_manager->restoreState(ptt, dacChannels, dacSelections);
+    m_currentPtt.storeRelaxed(ptt);
+    m_lastPtt = ptt;
+
+    QMutexLocker locker(&m_mutex);
+    m_committedPtt = ptt;
+    m_hasCommitted = true;
+    m_manager->getDacState(m_committedChannels, m_committedSelections);
+}
+
+void PttMonitorThread::committedState(UINT8* ptt, QVector<INT8>* dacChannels, QVector<INT8>* dacSelections)
+{
+    QMutexLocker locker(&m_mutex);
+    if (ptt) *ptt = m_committedPtt;
+    // 在调用线程中构造QVector，PTT线程只写定长数组
+    int count = m_hasCommitted ? RadioChannelManager::DAC_COUNT : 0;
+    if (dacChannels) {
+        dacChannels->resize(count);
+        std::copy(m_committedChannels, m_committedChannels + count, dacChannels->begin());
+    }
+    if (dacSelections) {
+        dacSelections->resize(count);
+        std::copy(m_committedSelections, m_committedSelections + count, dacSelections->begin());
+    }
+}
+
+bool PttMonitorThread::processPtt(UINT8 currentPtt, bool paramsChanged)
+{
+    bool pttChanged = (currentPtt != m_lastPtt);
+
+    if (pttChanged) {
+        LOG_DEBUG("ptt", "执行配置信道操作原因：[PTT变化]");
+        LOG_INFO("ptt", "[PTT值改变]: 从0x{:X}({})到0x{:X}({})", m_lastPtt, m_lastPtt, currentPtt, currentPtt);
+        // 通过管理器处理PTT变化
+        m_manager->processPttChange(currentPtt);
+        // 更新lastPtt
+        m_lastPtt = currentPtt;
+    }
+
+    // 当信号量被释放（paramsChanged为true）或者PTT改变时，执行配置下发操作
+    if (!paramsChanged && !pttChanged) {
+        return false;
+    }
+    if (paramsChanged) {
+        LOG_DEBUG("ptt", "执行配置信道操作原因：[信道参数改变]");
+    }
+
+    // 从管理器获取当前所有DAC通道承载的信道编号，复制到栈上数组
+    INT8 dacChannels[RadioChannelManager::DAC_COUNT];
+    INT8 dacSelections[RadioChannelManager::DAC_COUNT];
+    m_manager->getDacState(dacChannels, dacSelections);
+
+    // 只按需查找单个信道，不复制整个缓存
+    ChannelSetting setting;
+    for (int dacChannelIndex = 0; dacChannelIndex < RadioChannelManager::DAC_COUNT; dacChannelIndex++) {
+        int intChannel = static_cast<int>(dacChannels[dacChannelIndex]);
+        // 非0信道在各DAC间不重复，下标即该信道对应的DAC通道索引
+        if (intChannel == 0 || !ChannelCacheManager::instance()->getChannelSetting(intChannel, &setting)) {
+            continue;
+        }
+
+        if (setting.isChange || pttChanged) {
+            // 发送参数到FPGA
+            m_manager->sendToHardware(dacChannelIndex, setting);
+
+            if (pttChanged) {
+                //设置dac输出
+                m_manager->resetFpgaChl(dacChannelIndex, intChannel);
+            }
+        }
+    }
+
+    // 记录本轮下发后的DAC分配，唤醒主线程写入硬件状态日志
+    {
+        QMutexLocker locker(&m_mutex);
+        m_committedPtt = currentPtt;
+        m_hasCommitted = true;
+        for (int i = 0; i < RadioChannelManager::DAC_COUNT; i++) {
+            m_committedChannels[i] = dacChannels[i];
+            m_committedSelections[i] = dacSelections[i];
+        }
+    }
+    m_commitNotifier->notify();
+    return true;
+}
+
 void PttMonitorThread::run()
 {
-    UINT8 lastPtt = 0;
-    
-    qDebug("PTT监控线程启动"); 
+    // 热重启时从恢复的PTT值开始比较，PTT未变则不重新分配
+    m_lastPtt = static_cast<UINT8>(m_currentPtt.loadRelaxed());
+
+    // 实时调度在进入循环前一次性设置，之后的循环不再有缺页和分配
+    if (m_rtProfile.enabled) {
+        QStringList errors;
+        m_rtProfile.applyToCurrentThread(&errors);
+        for (const QString& error : errors) {
+            LOG_WARN("ptt", "实时调度设置失败: {}", error);
+        }
+
+        // 记录实际生效的调度策略和优先级，设置失败时为普通调度
+        int policy = sched_getscheduler(0);
+        struct sched_param param;
+        if (sched_getparam(0, &param) != 0) {
+            param.sched_priority = 0;
+        }
+        const char* policyName = policy == SCHED_FIFO ? "SCHED_FIFO"
+                               : policy == SCHED_RR ? "SCHED_RR" : "SCHED_OTHER";
+        LOG_INFO("ptt", "实时调度: 策略={} 优先级={} CPU={} 栈预取={}KB",
+                 policyName, param.sched_priority, m_rtProfile.cpu, m_rtProfile.stackPrefaultKb);
+    }
+
+    struct timespec nextPeriod;
+    clock_gettime(CLOCK_MONOTONIC, &nextPeriod);
+    qint64 lastReportNs = ChannelParamQueue::nowNs();
+    m_jitter.reset();
+    if (m_rtProfile.jitterMode()) {
+        LOG_INFO("ptt", "抖动测量模式: 周期{}us，每{}s输出统计", m_rtProfile.jitterPeriodUs, m_rtProfile.jitterReportSec);
+    }
+
+    LOG_INFO("ptt", "PTT监控线程启动");
     while (!m_stopFlag.loadRelaxed()) {
+        bool semaphoreAcquired;
+        if (m_rtProfile.jitterMode()) {
+            // 按固定周期轮询PTT，统计每次唤醒相对预定时刻的延迟
+            semaphoreAcquired = waitNextPeriod(&nextPeriod);
+            qint64 now = ChannelParamQueue::nowNs();
+            if (now - lastReportNs >= m_rtProfile.jitterReportSec * 1000000000LL) {
+                reportJitter();
+                lastReportNs = now;
+            }
+        } else {
 #if USE_FPGA_TEST
-        bool semaphoreAcquired = m_semaphore.tryAcquire(1, 10000);
+            semaphoreAcquired = m_semaphore.tryAcquire(1, 10000);
 #else
-        // 等待信号量，超时时间为1ms,线程会定期唤醒检查PTT值，也会在信号量被释放时立即唤醒
-        bool semaphoreAcquired = m_semaphore.tryAcquire(1, 10000);
+            // 等待信号量，超时时间为1ms,线程会定期唤醒检查PTT值，也会在信号量被释放时立即唤醒
+            semaphoreAcquired = m_semaphore.tryAcquire(1, 10000);
 #endif
+        }
         // 如果停止标志已设置，退出循环
         if (m_stopFlag.loadRelaxed()) {
             break;
         }
+
+        // 先取空参数队列再读PTT，PTT读取失败时参数已写入缓存，留到下一轮下发
+        if (semaphoreAcquired) {
+            m_paramsPending = true;
+        }
+        drainParamQueue();
+
         // 获取当前PTT值
         UINT8 currentPtt;
 
         // 正常模式：获取当前PTT值从硬件
         struct radios radio_data;
-        qDebug() << "-----------------------------获取PTT状态start--------------------------------------";
+        LOG_TRACE("ptt", "-----------------------------获取PTT状态start--------------------------------------");
         int ret = get_ptt_sta_power(&radio_data); //待填
         if (ret != FPGA_OK) {
             // 获取失败，保持上次的值
-            currentPtt = lastPtt;
-            qDebug() << "获取PTT状态失败,错误玛： " << ret;
+            currentPtt = m_lastPtt;
+            LOG_WARN("ptt", "获取PTT状态失败,错误玛： {}", ret);
             continue; // 获取失败，跳过后续处理，直接进入下一次循环
         }
         
         // 检查PTT值是否在有效范围内 (0x0到0xf)
         if (!IS_VALID_PTT(radio_data.radio_sta)) {
             // 值不在有效范围内，保持上次的值
-            currentPtt = lastPtt;
-            qDebug() << "获取到无效的PTT状态值: " << radio_data.radio_sta << "，保持上次值: " << lastPtt;
+            currentPtt = m_lastPtt;
+            LOG_WARN("ptt", "获取到无效的PTT状态值: {}，保持上次值: {}", radio_data.radio_sta, m_lastPtt);
             continue; // PTT值无效，跳过后续处理，直接进入下一次循环
         }
         
@@ -77,52 +243,75 @@ void PttMonitorThread::run()
         currentPtt = radio_data.radio_sta;
         // 设置当前PTT值
         m_currentPtt.storeRelaxed(currentPtt);
-        qDebug() << "-----------------------------获取PTT状态end--------------------------------------";
-
-        bool pttChanged = (currentPtt != lastPtt);
-
-        if (pttChanged) {
-            qDebug()<<"执行配置信道操作原因：[PTT变化]";
-            qDebug() << QDateTime::currentDateTime().toString("hh:mm:ss.zzz")
-                     << "[PTT值改变]: 从0x" << QString::number(lastPtt, 16).toUpper() <<lastPtt
-                     << "到0x" << QString::number(currentPtt, 16).toUpper()<<currentPtt;
-            // 通过管理器处理PTT变化
-            m_manager->processPttChange(currentPtt);
-            // 更新lastPtt
-            lastPtt = currentPtt;
-        }
+        LOG_TRACE("ptt", "-----------------------------获取PTT状态end--------------------------------------");
 
-        // 当信号量被释放（semaphoreAcquired为true）或者PTT改变时，执行配置下发操作
-        if (semaphoreAcquired || pttChanged) {
-            if(semaphoreAcquired){
-                qDebug()<<"执行配置信道操作原因：[信道参数改变]";
-            }
+        commitRound(currentPtt);
+    }
 
-            // 从管理器获取当前所有DAC通道承载的信道编号列表
-            QVector<INT8> dacChannels = m_manager->getDacChannels();
-            for (INT8 channel : dacChannels) {
-                int intChannel=static_cast<int>(channel);
-                int absChannel=qAbs(intChannel);
-                auto channelCfgList=ChannelCacheManager::instance()->getAllChannelSettings();
-
-                if(!channelCfgList.keys().contains(absChannel))continue;
-
-                if(channelCfgList[absChannel].isChange||pttChanged){
-                    // 找到该信道对应的DAC通道索引
-                    int dacChannelIndex = dacChannels.indexOf(intChannel);
-                    if (dacChannelIndex != -1) {
-                        // 发送参数到FPGA
-                        m_manager->sendToHardware(dacChannelIndex,channelCfgList[absChannel]);
-
-                        if(pttChanged){
-                            //设置dac输出
-                            m_manager->resetFpgaChl(dacChannelIndex,intChannel);
-                        }
-                    }
-                }
-            }
+    if (m_rtProfile.jitterMode()) {
+        reportJitter();
+    }
+    LOG_INFO("ptt", "PTT监控线程停止");
+}
+
+void PttMonitorThread::drainParamQueue()
+{
+    // 取出MQTT线程入队的参数批次，写入缓存后在本轮一起下发
+    ChannelParamBatch batch;
+    while (ChannelParamQueue::instance()->pop(&batch)) {
+        ChannelCacheManager::instance()->updateChannelParametersBatch(batch.settings);
+        // 超出预留容量(连续多轮未下发)时不再记录时延，不扩容
+        if (static_cast<quint32>(m_batchReceivedNs.size()) < ChannelParamQueue::CAPACITY) {
+            m_batchReceivedNs.append(batch.receivedNs);
         }
+        m_paramsPending = true;
+    }
+}
+
+bool PttMonitorThread::commitRound(UINT8 currentPtt)
+{
+    bool committed = processPtt(currentPtt, m_paramsPending);
+    if (committed) {
+        // 统计参数消息从接收到下发完成的时延
+        for (qint64 receivedNs : m_batchReceivedNs) {
+            ChannelParamQueue::instance()->recordApplyLatency(receivedNs);
+        }
+    }
+    // clear()保留预留的容量
+    m_batchReceivedNs.clear();
+    m_paramsPending = false;
+    return committed;
+}
+
+bool PttMonitorThread::waitNextPeriod(struct timespec* next)
+{
+    long periodNs = m_rtProfile.jitterPeriodUs * 1000L;
+    next->tv_nsec += periodNs;
+    while (next->tv_nsec >= 1000000000L) {
+        next->tv_nsec -= 1000000000L;
+        next->tv_sec++;
     }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, nullptr);
 
-    qDebug("PTT监控线程停止");
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    qint64 latencyNs = (now.tv_sec - next->tv_sec) * 1000000000LL + (now.tv_nsec - next->tv_nsec);
+    m_jitter.record(latencyNs / 1000);
+
+    // 延迟超过一个周期时从当前时刻重新计时，不连续补跑错过的周期
+    if (latencyNs >= periodNs) {
+        m_jitter.recordOverrun();
+        *next = now;
+    }
+
+    // 参数下发和停止请求不等周期，本轮一并处理
+    return m_semaphore.tryAcquire();
+}
+
+void PttMonitorThread::reportJitter()
+{
+    JitterStats stats = m_jitter.stats();
+    LOG_INFO("ptt", "唤醒延迟(us): 次数={} min={} avg={} p50={} p99={} p99.9={} max={} 超周期={}",
+             stats.count, stats.minUs, stats.avgUs, stats.p50Us, stats.p99Us, stats.p999Us,
+             stats.maxUs, stats.overruns);
 }
@@ -7,7 +7,12 @@
 #include <QSemaphore>
 #include "RadioChannelManager.h"
 #include "configmanager.h"
+#include "rtprofile.h"
 #include <QMutex>
+#include <time.h>
+
+class WakeupNotifier;
+
 class PttMonitorThread : public QThread
 {
     Q_OBJECT
@@ -22,16 +27,63 @@ public:
     // 唤醒线程的方法
     void wakeUp();
 
+    // 实时调度配置，在start()之前设置，线程启动时应用到自身
+    void setRtProfile(const RtProfile& profile);
+    RtProfile rtProfile() const;
+
+    // 抖动测量模式下的唤醒延迟分布，任意线程可调用
+    JitterStats jitterStats() const;
+
+    // 热重启时恢复PTT值和DAC信道分配，须在start()之前调用
+    void restoreState(UINT8 ptt, const QVector<INT8>& dacChannels, const QVector<INT8>& dacSelections);
+
+    // 获取最近一次下发到硬件的PTT值和DAC信道分配，尚未下发过时信道分配为空
+    void committedState(UINT8* ptt, QVector<INT8>* dacChannels, QVector<INT8>* dacSelections);
+
+    // 处理一次PTT采样：PTT变化时重新分配DAC并下发，paramsChanged时下发参数有变化的信道
+    // 返回本轮是否下发；稳态下不分配堆内存。run()每轮调用，测试可在未启动的线程对象上直接调用
+    bool processPtt(UINT8 currentPtt, bool paramsChanged);
+
+    // run()每轮的参数步骤，只能在同一线程中调用：先取空参数队列写入缓存，
+    // 读到PTT后commitRound下发并统计参数时延。稳态下不分配堆内存，测试可在其他线程上直接调用
+    void drainParamQueue();
+    bool commitRound(UINT8 currentPtt);
+
+signals:
+    // 配置下发完成，在主线程发出；连续多轮下发在处理前合并为一次
+    void hardwareCommitted();
+
 protected:
     void run() override;
 
 private:
+    // 抖动测量模式：休眠到下一个周期的绝对时刻并记录唤醒延迟，返回期间是否被wakeUp()唤醒
+    bool waitNextPeriod(struct timespec* next);
+    void reportJitter();
+
     RadioChannelManager* m_manager;
     ConfigManager* m_configManager;
     QAtomicInt m_stopFlag;
     QAtomicInt m_currentPtt;
     QMutex m_mutex;
     QSemaphore m_semaphore;  // 用于唤醒线程的信号量
+
+    RtProfile m_rtProfile;
+    JitterHistogram m_jitter;
+
+    // 以下只由PTT线程访问
+    UINT8 m_lastPtt;
+    QVector<qint64> m_batchReceivedNs;      // 本轮取出的参数批次接收时刻，预留容量后复用
+    bool m_paramsPending;                   // 已写入缓存、尚未下发的参数
+
+    // 最近一次下发完成后的DAC信道分配，由m_mutex保护；用定长数组，写入时不分配内存
+    UINT8 m_committedPtt;
+    bool m_hasCommitted;
+    INT8 m_committedChannels[RadioChannelManager::DAC_COUNT];
+    INT8 m_committedSelections[RadioChannelManager::DAC_COUNT];
+
+    // 下发完成后唤醒主线程发出hardwareCommitted，代替跨线程排队信号
+    WakeupNotifier* m_commitNotifier;
 };
 
 #endif // PTTMONITORTHREAD_H
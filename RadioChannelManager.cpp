@@ -1,6 +1,7 @@
 // RadioChannelManager.cpp
 #include "RadioChannelManager.h"
 #include <QDebug>
+#include "asynclogger.h"
 #include "fpga_driver.h"
 #include "channel_utils.h"
 #include "channelparaconifg.h"
@@ -103,6 +104,20 @@ void RadioChannelManager::initialize()
     ptt_val_current = 0;
 }
 
+void RadioChannelManager::restoreState(UINT8 ptt, const QVector<INT8>& channels, const QVector<INT8>& selections)
+{
+    if (channels.size() != 4 || selections.size() != 4) {
+        return;
+    }
+    for (int i = 0; i < 4; i++) {
+        dac_chl[i] = channels[i];
+        dac_sel[i] = selections[i];
+    }
+    ptt_val_old = ptt;
+    ptt_val_current = ptt;
+    LOG_DEBUG("radio", "[热重启] 恢复DAC分配: {}", getStatusString());
+}
+
 QVector<INT8> RadioChannelManager::getDacChannels() const
 {
     QVector<INT8> channels;
@@ -121,12 +136,27 @@ QVector<INT8> RadioChannelManager::getDacSelections() const
     return selections;
 }
 
+void RadioChannelManager::getDacState(INT8* channels, INT8* selections) const
+{
+    for (int i = 0; i < DAC_COUNT; i++) {
+        channels[i] = dac_chl[i];
+        if (selections) {
+            selections[i] = dac_sel[i];
+        }
+    }
+}
+
 QString RadioChannelManager::getChannelDescription(INT8 channel) const
+{
+    return QString(channelName(channel));
+}
+
+const char* RadioChannelManager::channelName(INT8 channel)
 {
     if (channel >= 0 && channel < 7) {
-        return QString(chl_dsp_p[channel]);
+        return chl_dsp_p[channel];
     } else if (channel < 0 && channel > -7) {
-        return QString(chl_dsp_n[channel * -1]);
+        return chl_dsp_n[channel * -1];
     }
     return "INVALID";
 }
@@ -134,7 +164,7 @@ QString RadioChannelManager::getChannelDescription(INT8 channel) const
 void RadioChannelManager::processPttChange(UINT8 newPtt)
 {
     if(!IS_VALID_PTT(newPtt)){
-        qDebug() << "PTT值错误 - PTT:" << newPtt;
+        LOG_WARN("radio", "PTT值错误 - PTT: {}", newPtt);
         return;
     }
 
@@ -143,16 +173,10 @@ void RadioChannelManager::processPttChange(UINT8 newPtt)
     ptt_val_current = newPtt;
 
     // 输出释放前的状态
-    QString beforeStatus = QString("before free: dac1=%1, dac2=%2, dac3=%3, dac4=%4, sel1=%5, sel2=%6, sel3=%7, sel4=%8")
-                               .arg(getChannelDescription(dac_chl[0]))
-                               .arg(getChannelDescription(dac_chl[1]))
-                               .arg(getChannelDescription(dac_chl[2]))
-                               .arg(getChannelDescription(dac_chl[3]))
-                               .arg(static_cast<int>(dac_sel[0]))
-                               .arg(static_cast<int>(dac_sel[1]))
-                               .arg(static_cast<int>(dac_sel[2]))
-                               .arg(static_cast<int>(dac_sel[3]));
-    qDebug() << beforeStatus;
+    LOG_DEBUG("radio", "before free: dac1={}, dac2={}, dac3={}, dac4={}, sel1={}, sel2={}, sel3={}, sel4={}",
+              channelName(dac_chl[0]), channelName(dac_chl[1]),
+              channelName(dac_chl[2]), channelName(dac_chl[3]),
+              dac_sel[0], dac_sel[1], dac_sel[2], dac_sel[3]);
 
     // 获取从接收变为发送的电台列表
     UINT8 rs_bits = (ptt_val_current ^ oldPtt) & ptt_val_current;
@@ -163,46 +187,32 @@ void RadioChannelManager::processPttChange(UINT8 newPtt)
     sendFreeDacChl(rs_bits);
 
     // 输出释放后的状态
-    QString afterFreeStatus = QString("after free: dac1=%1, dac2=%2, dac3=%3, dac4=%4")
-                                  .arg(getChannelDescription(dac_chl[0]))
-                                  .arg(getChannelDescription(dac_chl[1]))
-                                  .arg(getChannelDescription(dac_chl[2]))
-                                  .arg(getChannelDescription(dac_chl[3]));
-    qDebug() << afterFreeStatus;
+    LOG_DEBUG("radio", "after free: dac1={}, dac2={}, dac3={}, dac4={}",
+              channelName(dac_chl[0]), channelName(dac_chl[1]),
+              channelName(dac_chl[2]), channelName(dac_chl[3]));
 
     // 分配新信道
     allocateDacChl(ptt_val_current);
 
     // 输出分配后的状态
-    QString afterAllocStatus = QString("after alloc: dac1=%1, dac2=%2, dac3=%3, dac4=%4, sel1=%5, sel2=%6, sel3=%7, sel4=%8")
-                                   .arg(getChannelDescription(dac_chl[0]))
-                                   .arg(getChannelDescription(dac_chl[1]))
-                                   .arg(getChannelDescription(dac_chl[2]))
-                                   .arg(getChannelDescription(dac_chl[3]))
-                                   .arg(static_cast<int>(dac_sel[0]))
-                                   .arg(static_cast<int>(dac_sel[1]))
-                                   .arg(static_cast<int>(dac_sel[2]))
-                                   .arg(static_cast<int>(dac_sel[3]));
-    qDebug() << afterAllocStatus;
+    LOG_DEBUG("radio", "after alloc: dac1={}, dac2={}, dac3={}, dac4={}, sel1={}, sel2={}, sel3={}, sel4={}",
+              channelName(dac_chl[0]), channelName(dac_chl[1]),
+              channelName(dac_chl[2]), channelName(dac_chl[3]),
+              dac_sel[0], dac_sel[1], dac_sel[2], dac_sel[3]);
 
     // 更新旧PTT值
     ptt_val_old = ptt_val_current;
 
-    // 同步更新电台状态到globalStatusMap
+    // 同步更新电台状态，原子写入，不与界面和数据库竞争
     for (int radioIdx = 1; radioIdx <= 4; radioIdx++) {
         // 检查当前电台的PTT位是否被设置
         bool isTransmit = (ptt_val_current & (1 << (radioIdx - 1))) != 0;
 
-        // 创建RadioStatus对象
-        RadioStatus status;
-        status.radioState = isTransmit ? RADIO_TRANSMIT : RADIO_RECEIVE;
-
-        // 更新globalStatusMap
-        QMutexLocker locker(&globalMutex);
-        globalStatusMap[radioIdx] = status;
+        // 只改收发状态，txPower由遥测服务维护
+        RadioStatusBoard::instance()->setState(radioIdx, isTransmit ? RADIO_TRANSMIT : RADIO_RECEIVE);
 
         // 输出调试信息
-        qDebug() << "电台" << radioIdx << "状态更新为:" << (isTransmit ? "发送" : "接收");
+        LOG_DEBUG("radio", "电台 {} 状态更新为: {}", radioIdx, (isTransmit ? "发送" : "接收"));
     }
 }
 
@@ -223,14 +233,14 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ModelParaSetting& p
     qDebug() << "[信道参数设置] 信道开关：" << params.switchFlag;
 #endif
     if(!IS_VALID_DAC_CHANNEL(dacIndex)){
-        qDebug() << "[信道参数设置] 通道号错误 -dac 通道:" << dacIndex;
+        LOG_WARN("radio", "[信道参数设置] 通道号错误 -dac 通道: {}", dacIndex);
         return;
     }
     if(!IS_VALID_DYNAMIC_CHANNEL(qAbs(params.channelNum))){
-        qDebug() << "[信道参数设置] 缓存中的信道号错误 - 信道号:" << params.channelNum;
+        LOG_WARN("radio", "[信道参数设置] 缓存中的信道号错误 - 信道号: {}", params.channelNum);
         return;
     }
-    qDebug() << "------------------------------信道参数设置-------------------------------------";
+    LOG_DEBUG("radio", "------------------------------信道参数设置-------------------------------------");
 
     //1、1/4选路
     int objRadioNumber=-1;//目标电台号
@@ -244,30 +254,30 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ModelParaSetting& p
     }
 
     if(objRadioNumber<0){
-        qDebug() << "[信道参数设置] 1、1/4选路设置失败 - 目标电台号错误";
+        LOG_WARN("radio", "[信道参数设置] 1、1/4选路设置失败 - 目标电台号错误");
         return;
     }
 
-    qDebug() << "[信道参数设置] 1、设置1/4选路 - 通道:" << dacIndex << " 值: "<<objRadioNumber-1;
+    LOG_DEBUG("radio", "[信道参数设置] 1、设置1/4选路 - 通道: {} 值: {}", dacIndex, objRadioNumber-1);
     int retsw4 = set_chl_sw4(static_cast<RS_OUT_E>(dacIndex), objRadioNumber-1);
     if (retsw4 != FPGA_OK) {
-        qDebug() << "[信道参数设置] 1、1/4选路设置失败 - 错误码:" << retsw4;
+        LOG_WARN("radio", "[信道参数设置] 1、1/4选路设置失败 - 错误码: {}", retsw4);
     } else {
-        qDebug() << "[信道参数设置] 1、1/4选路设置成功";
+        LOG_DEBUG("radio", "[信道参数设置] 1、1/4选路设置成功");
     }
 
     //2、衰减 —— 对应信道参数21
-    qDebug() << "[信道参数设置] 2、设置信号衰减 - 通道:" << dacIndex << " 值:" << params.signalAnt;
+    LOG_DEBUG("radio", "[信道参数设置] 2、设置信号衰减 - 通道: {} 值: {}", dacIndex, params.signalAnt);
     int retatt = set_chl_att(static_cast<RS_OUT_E>(dacIndex), static_cast<float>(params.signalAnt));
     if (retatt != FPGA_OK) {
-        qDebug() << "[信道参数设置] 2、信号衰减设置失败 - 错误码:" << retatt;
+        LOG_WARN("radio", "[信道参数设置] 2、信号衰减设置失败 - 错误码: {}", retatt);
     } else {
-        qDebug() << "[信道参数设置] 2、信号衰减设置成功";
+        LOG_DEBUG("radio", "[信道参数设置] 2、信号衰减设置成功");
     }
 
     //3、算法参数 —— 对应信道参数0-19
     // 多径参数
-    qDebug() << "[信道参数设置] 3、设置多径参数 - 通道:" << dacIndex;
+    LOG_DEBUG("radio", "[信道参数设置] 3、设置多径参数 - 通道: {}", dacIndex);
     for (const auto& path : params.multipathType) {
 #if 0
         qDebug() << "  [路径" << path.pathNum << "] 路径编号:" << path.pathNum;
@@ -280,54 +290,54 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ModelParaSetting& p
 #endif
         //时延
         if(!IS_VALID_PATH(path.pathNum)){
-            qDebug() << "  [路径" << path.pathNum << "] 路径编号错误 - 路径:" << path.pathNum;
+            LOG_WARN("radio", "  [路径{}] 路径编号错误 - 路径: {}", path.pathNum, path.pathNum);
             continue;
         }
 
-        qDebug() << "  [路径" << path.pathNum << "] 设置相对时延 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.relativDelay << "ns";
+        LOG_DEBUG("radio", "  [路径{}] 设置相对时延 - 通道: {} 路径: {} 值: {} ns", path.pathNum, dacIndex, path.pathNum, path.relativDelay);
         int retdelay = set_chl_delay(static_cast<RS_OUT_E>(dacIndex),static_cast<ALG_PATH_E>(path.pathNum-1), path.relativDelay);
         if (retdelay != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 相对时延设置失败 - 错误码:" << retdelay;
+            LOG_WARN("radio", "  [路径{}] 相对时延设置失败 - 错误码: {}", path.pathNum, retdelay);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 相对时延设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 相对时延设置成功", path.pathNum);
         }
 
         //频移
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径频移 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.freShift << "Hz";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径频移 - 通道: {} 路径: {} 值: {} Hz", path.pathNum, dacIndex, path.pathNum, path.freShift);
         int retshift = set_dpl_dfs(static_cast<RS_OUT_E>(dacIndex),static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.freShift));
         if (retshift != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频移设置失败 - 错误码:" << retshift;
+            LOG_WARN("radio", "  [路径{}] 路径频移设置失败 - 错误码: {}", path.pathNum, retshift);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频移设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径频移设置成功", path.pathNum);
         }
 
         //频扩
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径频扩 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.freSpread << "Hz";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径频扩 - 通道: {} 路径: {} 值: {} Hz", path.pathNum, dacIndex, path.pathNum, path.freSpread);
         int retspread = set_dpl_df(static_cast<RS_OUT_E>(dacIndex), static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.freSpread));
         if (retspread != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频扩设置失败 - 错误码:" << retspread;
+            LOG_WARN("radio", "  [路径{}] 路径频扩设置失败 - 错误码: {}", path.pathNum, retspread);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频扩设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径频扩设置成功", path.pathNum);
         }
 
         //衰减值
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径衰减功率 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.antPower << "dB";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径衰减功率 - 通道: {} 路径: {} 值: {} dB", path.pathNum, dacIndex, path.pathNum, path.antPower);
         int retgain = set_gain(static_cast<RS_OUT_E>(dacIndex), static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.antPower));
         if (retgain != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径衰减功率设置失败 - 错误码:" << retgain;
+            LOG_WARN("radio", "  [路径{}] 路径衰减功率设置失败 - 错误码: {}", path.pathNum, retgain);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径衰减功率设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径衰减功率设置成功", path.pathNum);
         }
     }
 
     //4、信道开关 —— 对应信道参数 20
-    qDebug() << "[信道参数设置] 4、设置信道开关 - 通道:" << dacIndex << " 值:" << params.switchFlag;
+    LOG_DEBUG("radio", "[信道参数设置] 4、设置信道开关 - 通道: {} 值: {}", dacIndex, params.switchFlag);
     int switchFlag= params.switchFlag ? 1:0;
     int retsw = set_chl_sw(static_cast<RS_OUT_E>(dacIndex), switchFlag);
     if (retsw != FPGA_OK) {
-        qDebug() << "[信道参数设置] 4、信道开关设置失败 - 错误码:" << retsw;
+        LOG_WARN("radio", "[信道参数设置] 4、信道开关设置失败 - 错误码: {}", retsw);
     } else {
-        qDebug() << "[信道参数设置] 4、信道开关设置成功" << " 值:" << switchFlag;
+        LOG_DEBUG("radio", "[信道参数设置] 4、信道开关设置成功 值: {}", switchFlag);
     }
 
     //5、算法初始值 —— 暂未知如何取
@@ -337,22 +347,21 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ModelParaSetting& p
     //qDebug() << "[信道参数设置] 6、设置滤波器参数 - 通道:" << dacIndex << " 滤波器编号:" << params.filterNum;
 
     //qDebug() << "[信道参数设置] 所有参数设置完成 - 通道:" << dacIndex;
-    qDebug() << "-------------------------------信道参数设置------------------------------------";
+    LOG_DEBUG("radio", "-------------------------------信道参数设置------------------------------------");
 }
 
 void RadioChannelManager::sendToHardware(int dacIndex, const ChannelSetting& params)
 {
     if(!IS_VALID_DAC_CHANNEL(dacIndex)){
-        qDebug() << "[ChannelSetting参数设置] 通道号错误 -dac 通道:" << dacIndex;
+        LOG_WARN("radio", "[ChannelSetting参数设置] 通道号错误 -dac 通道: {}", dacIndex);
         return;
     }
 
     if(!IS_VALID_DYNAMIC_CHANNEL(qAbs(params.channelNum))){
-        qDebug() << "[信道参数设置] 缓存中的信道号错误 - 信道号:" << params.channelNum;
+        LOG_WARN("radio", "[信道参数设置] 缓存中的信道号错误 - 信道号: {}", params.channelNum);
         return;
     }
-    qDebug() <<"";
-    qDebug() << "-------------------------------信道参数设置------------------------------------";
+    LOG_DEBUG("radio", "-------------------------------信道参数设置------------------------------------");
     // 打印ChannelSetting参数信息
     // qDebug() << "[ChannelSetting参数设置] 将参数设置到信道" << dacIndex;
     // qDebug() << "[ChannelSetting参数设置] 信号衰减:" << params.signalAnt;
@@ -372,30 +381,30 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ChannelSetting& par
     }
 
     if(objRadioNumber<0){
-        qDebug() << "[信道参数设置] 1、1/4选路设置失败 - 目标电台号错误";
+        LOG_WARN("radio", "[信道参数设置] 1、1/4选路设置失败 - 目标电台号错误");
         return;
     }
 
-    qDebug() << "[信道参数设置] 1、设置1/4选路 - 通道:" << dacIndex << " 目标电台idnex值(电台号-1): "<<objRadioNumber-1;
+    LOG_DEBUG("radio", "[信道参数设置] 1、设置1/4选路 - 通道: {} 目标电台idnex值(电台号-1): {}", dacIndex, objRadioNumber-1);
     int retsw4 = set_chl_sw4(static_cast<RS_OUT_E>(dacIndex), objRadioNumber-1);
     if (retsw4 != FPGA_OK) {
-        qDebug() << "[信道参数设置] 1、1/4选路设置失败 - 错误码:" << retsw4;
+        LOG_WARN("radio", "[信道参数设置] 1、1/4选路设置失败 - 错误码: {}", retsw4);
     } else {
-        qDebug() << "[信道参数设置] 1、1/4选路设置成功";
+        LOG_DEBUG("radio", "[信道参数设置] 1、1/4选路设置成功");
     }
 
     //2、衰减 —— 对应信道参数21
-    qDebug() << "[信道参数设置] 2、设置信号衰减 - 通道:" << dacIndex << " 值:" << params.signalAnt;
+    LOG_DEBUG("radio", "[信道参数设置] 2、设置信号衰减 - 通道: {} 值: {}", dacIndex, params.signalAnt);
     int retatt = set_chl_att(static_cast<RS_OUT_E>(dacIndex), static_cast<float>(params.signalAnt));
     if (retatt != FPGA_OK) {
-        qDebug() << "[信道参数设置] 2、信号衰减设置失败 - 错误码:" << retatt;
+        LOG_WARN("radio", "[信道参数设置] 2、信号衰减设置失败 - 错误码: {}", retatt);
     } else {
-        qDebug() << "[信道参数设置] 2、信号衰减设置成功";
+        LOG_DEBUG("radio", "[信道参数设置] 2、信号衰减设置成功");
     }
 
     //3、算法参数 —— 对应信道参数0-19
     // 多径参数
-    qDebug() << "[信道参数设置] 3、设置多径参数 - 通道:" << dacIndex;
+    LOG_DEBUG("radio", "[信道参数设置] 3、设置多径参数 - 通道: {}", dacIndex);
     for (const auto& path : params.multipathType) {
 #if 0
         qDebug() << "  [路径" << path.pathNum << "] 路径编号:" << path.pathNum;
@@ -406,58 +415,56 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ChannelSetting& par
         qDebug() << "  [路径" << path.pathNum << "] 多普勒谱类型:" << path.dopplerType;
         qDebug() << "  [路径" << path.pathNum << "] ------------------------------";
 #endif
-        qDebug() <<"";
         //时延
         if(!IS_VALID_PATH(path.pathNum)){
-            qDebug() << "  [路径" << path.pathNum << "] 路径编号错误 - 路径:" << path.pathNum;
+            LOG_WARN("radio", "  [路径{}] 路径编号错误 - 路径: {}", path.pathNum, path.pathNum);
             continue;
         }
 
-        qDebug() << "  [路径" << path.pathNum << "] 设置相对时延 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.relativDelay << "ns";
+        LOG_DEBUG("radio", "  [路径{}] 设置相对时延 - 通道: {} 路径: {} 值: {} ns", path.pathNum, dacIndex, path.pathNum, path.relativDelay);
         int retdelay = set_chl_delay(static_cast<RS_OUT_E>(dacIndex),static_cast<ALG_PATH_E>(path.pathNum-1), path.relativDelay);
         if (retdelay != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 相对时延设置失败 - 错误码:" << retdelay;
+            LOG_WARN("radio", "  [路径{}] 相对时延设置失败 - 错误码: {}", path.pathNum, retdelay);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 相对时延设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 相对时延设置成功", path.pathNum);
         }
 
         //频移
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径频移 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.freShift << "Hz";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径频移 - 通道: {} 路径: {} 值: {} Hz", path.pathNum, dacIndex, path.pathNum, path.freShift);
         int retshift = set_dpl_dfs(static_cast<RS_OUT_E>(dacIndex),static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.freShift));
         if (retshift != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频移设置失败 - 错误码:" << retshift;
+            LOG_WARN("radio", "  [路径{}] 路径频移设置失败 - 错误码: {}", path.pathNum, retshift);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频移设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径频移设置成功", path.pathNum);
         }
 
         //频扩
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径频扩 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.freSpread << "Hz";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径频扩 - 通道: {} 路径: {} 值: {} Hz", path.pathNum, dacIndex, path.pathNum, path.freSpread);
         int retspread = set_dpl_df(static_cast<RS_OUT_E>(dacIndex), static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.freSpread));
         if (retspread != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频扩设置失败 - 错误码:" << retspread;
+            LOG_WARN("radio", "  [路径{}] 路径频扩设置失败 - 错误码: {}", path.pathNum, retspread);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径频扩设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径频扩设置成功", path.pathNum);
         }
 
         //衰减值
-        qDebug() << "  [路径" << path.pathNum << "] 设置路径衰减功率 - 通道:" << dacIndex << " 路径:" << path.pathNum << " 值:" << path.antPower << "dB";
+        LOG_DEBUG("radio", "  [路径{}] 设置路径衰减功率 - 通道: {} 路径: {} 值: {} dB", path.pathNum, dacIndex, path.pathNum, path.antPower);
         int retgain = set_gain(static_cast<RS_OUT_E>(dacIndex), static_cast<ALG_PATH_E>(path.pathNum-1), static_cast<float>(path.antPower));
         if (retgain != FPGA_OK) {
-            qDebug() << "  [路径" << path.pathNum << "] 路径衰减功率设置失败 - 错误码:" << retgain;
+            LOG_WARN("radio", "  [路径{}] 路径衰减功率设置失败 - 错误码: {}", path.pathNum, retgain);
         } else {
-            qDebug() << "  [路径" << path.pathNum << "] 路径衰减功率设置成功";
+            LOG_DEBUG("radio", "  [路径{}] 路径衰减功率设置成功", path.pathNum);
         }
-        qDebug() <<"";
     }
 
     //4、信道开关 —— 对应信道参数 20
-    qDebug() << "[信道参数设置] 4、设置信道开关 - 通道:" << dacIndex << " 值:" << params.switchFlag;
+    LOG_DEBUG("radio", "[信道参数设置] 4、设置信道开关 - 通道: {} 值: {}", dacIndex, params.switchFlag);
     int switchFlag= params.switchFlag ? 1:0;
     int retsw = set_chl_sw(static_cast<RS_OUT_E>(dacIndex), switchFlag);
     if (retsw != FPGA_OK) {
-        qDebug() << "[信道参数设置] 4、信道开关设置失败 - 错误码:" << retsw;
+        LOG_WARN("radio", "[信道参数设置] 4、信道开关设置失败 - 错误码: {}", retsw);
     } else {
-        qDebug() << "[信道参数设置] 4、信道开关设置成功" << " 值:" << switchFlag;
+        LOG_DEBUG("radio", "[信道参数设置] 4、信道开关设置成功 值: {}", switchFlag);
     }
 
     //5、算法初始值 —— 暂未知如何取
@@ -467,7 +474,7 @@ void RadioChannelManager::sendToHardware(int dacIndex, const ChannelSetting& par
     //qDebug() << "[信道参数设置] 6、设置滤波器参数 - 通道:" << dacIndex << " 滤波器编号:" << params.filterNum;
 
     //qDebug() << "[信道参数设置] 所有参数设置完成 - 通道:" << dacIndex;
-    qDebug() << "-------------------------------信道参数设置------------------------------------";
+    LOG_DEBUG("radio", "-------------------------------信道参数设置------------------------------------");
 }
 
 UINT8 RadioChannelManager::getCurrentPtt() const
@@ -493,51 +500,49 @@ QString RadioChannelManager::getStatusString() const
 bool RadioChannelManager::releaseFpgaChl(int dacNum,int chl)
 {
     if(!IS_VALID_DAC_CHANNEL(dacNum)){
-        qDebug() << "[FPGA通道释放] 通道号错误 - 通道:" << dacNum;
+        LOG_WARN("radio", "[FPGA通道释放] 通道号错误 - 通道: {}", dacNum);
         return false;
     }
-    qDebug() <<"";
-    qDebug() << "-----------------------------FPGA通道释放--------------------------------------";
-    qDebug() << "[FPGA通道释放] 开始释放FPGA通道:" << dacNum << " 信道编号" << chl;
+    LOG_DEBUG("radio", "-----------------------------FPGA通道释放--------------------------------------");
+    LOG_DEBUG("radio", "[FPGA通道释放] 开始释放FPGA通道: {} 信道编号 {}", dacNum, chl);
 
     // 设置DAC输出选择
-    qDebug() << "[FPGA通道释放] 1、设置DAC输出选择 - 通道:" << dacNum << " 信道编号:" << DATA_SRC_NONE;
+    LOG_DEBUG("radio", "[FPGA通道释放] 1、设置DAC输出选择 - 通道: {} 信道编号: {}", dacNum, DATA_SRC_NONE);
     int setChlRet=set_chl_out_sel(static_cast<RS_OUT_E>(dacNum),DATA_SRC_NONE);
     if (setChlRet != FPGA_OK) {
-        qDebug() << "[FPGA通道释放] 1、DAC输出选择设置失败 - 错误码:" << setChlRet;
+        LOG_WARN("radio", "[FPGA通道释放] 1、DAC输出选择设置失败 - 错误码: {}", setChlRet);
         return false;
     } else {
-        qDebug() << "[FPGA通道释放] 1、DAC输出选择设置成功";
+        LOG_DEBUG("radio", "[FPGA通道释放] 1、DAC输出选择设置成功");
     }
 
     //设置通道开关
-    qDebug() << "[FPGA通道释放] 4、设置信道开关 - 通道:" << dacNum << " 值:" << false;
+    LOG_DEBUG("radio", "[FPGA通道释放] 4、设置信道开关 - 通道: {} 值: {}", dacNum, false);
     int retsw = set_chl_sw(static_cast<RS_OUT_E>(dacNum), false);
     if (retsw != FPGA_OK) {
-        qDebug() << "[FPGA通道释放] 4、信道开关设置失败 - 错误码:" << retsw;
+        LOG_WARN("radio", "[FPGA通道释放] 4、信道开关设置失败 - 错误码: {}", retsw);
     } else {
-        qDebug() << "[FPGA通道释放] 4、信道开关设置成功";
+        LOG_DEBUG("radio", "[FPGA通道释放] 4、信道开关设置成功");
     }
 
     // 输出最终结果
-    qDebug() << "[FPGA通道释放] 通道:" << dacNum << " 信道编号" << chl << "释放成功";
-    qDebug() << "-----------------------------FPGA通道释放--------------------------------------";
+    LOG_DEBUG("radio", "[FPGA通道释放] 通道: {} 信道编号 {} 释放成功", dacNum, chl);
+    LOG_DEBUG("radio", "-----------------------------FPGA通道释放--------------------------------------");
 
     return true;
 }
 
 bool RadioChannelManager::resetFpgaChl(int dacNum,int chl){
     if(!IS_VALID_DAC_CHANNEL(dacNum)){
-        qDebug() << "[FPGA通道设置] 通道号错误 - 通道:" << dacNum;
+        LOG_WARN("radio", "[FPGA通道设置] 通道号错误 - 通道: {}", dacNum);
         return false;
     }
     if(!IS_VALID_DYNAMIC_CHANNEL(qAbs(chl))){
-        qDebug() << "[FPGA通道设置] 缓存中的信道号错误 - 信道号:" << chl;
+        LOG_WARN("radio", "[FPGA通道设置] 缓存中的信道号错误 - 信道号: {}", chl);
         return false;
     }
-    qDebug() <<"";
-    qDebug() << "-----------------------------FPGA通道设置--------------------------------------";
-    qDebug() << "[FPGA通道设置] 开始设置FPGA通道:" << dacNum << " 信道编号" << chl;
+    LOG_DEBUG("radio", "-----------------------------FPGA通道设置--------------------------------------");
+    LOG_DEBUG("radio", "[FPGA通道设置] 开始设置FPGA通道: {} 信道编号 {}", dacNum, chl);
 
     // 设置DAC输出选择
     // 查找信道对应的源电台号
@@ -553,19 +558,19 @@ bool RadioChannelManager::resetFpgaChl(int dacNum,int chl){
             break;
         }
     }
-    qDebug() << "[FPGA通道设置] 信道" << chl << "对应的源电台号:" << sourceRadio;
-    qDebug() << "[FPGA通道设置] 1、设置DAC输出选择 - 通道:" << dacNum << " 源电台:" << sourceRadio;
+    LOG_DEBUG("radio", "[FPGA通道设置] 信道 {} 对应的源电台号: {}", chl, sourceRadio);
+    LOG_DEBUG("radio", "[FPGA通道设置] 1、设置DAC输出选择 - 通道: {} 源电台: {}", dacNum, sourceRadio);
     int setChlRet=set_chl_out_sel(static_cast<RS_OUT_E>(dacNum),static_cast<DATA_SRC>(sourceRadio));
     if (setChlRet != FPGA_OK) {
-        qDebug() << "[FPGA通道设置] 1、DAC输出选择设置失败 - 错误码:" << setChlRet;
+        LOG_WARN("radio", "[FPGA通道设置] 1、DAC输出选择设置失败 - 错误码: {}", setChlRet);
         return false;
     } else {
-        qDebug() << "[FPGA通道设置] 1、DAC输出选择设置成功";
+        LOG_DEBUG("radio", "[FPGA通道设置] 1、DAC输出选择设置成功");
     }
 
     // 输出最终结果
-    qDebug() << "[FPGA通道设置] 通道:" << dacNum << " 信道编号" << chl << "设置信道成功";
-    qDebug() << "-----------------------------FPGA通道设置--------------------------------------";
+    LOG_DEBUG("radio", "[FPGA通道设置] 通道: {} 信道编号 {} 设置信道成功", dacNum, chl);
+    LOG_DEBUG("radio", "-----------------------------FPGA通道设置--------------------------------------");
 
     return true;
 }
@@ -658,7 +663,7 @@ void RadioChannelManager::dacLoadChannel(INT8 chl)
             return;
         }
     }
-    qWarning() << "exception no free dac";
+    LOG_WARN("radio", "exception no free dac");
 }
 
 void RadioChannelManager::allocateDacChl(UINT8 ptt)
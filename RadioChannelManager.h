@@ -17,6 +17,8 @@ class RadioChannelManager : public QObject
     Q_OBJECT
 
 public:
+    static const int DAC_COUNT = 4;
+
     explicit RadioChannelManager(ConfigManager* configManager, QObject *parent = nullptr);
     ~RadioChannelManager();
 
@@ -29,12 +31,17 @@ public:
     // 获取当前所有DAC的选择器状态
     QVector<INT8> getDacSelections() const;
 
+    // 同上，复制到调用方的数组(各DAC_COUNT个)，不分配内存；selections可为空
+    void getDacState(INT8* channels, INT8* selections) const;
+
     // 发送参数到硬件
     void sendToHardware(int dacIndex, const ModelParaSetting& params);
     // 发送ChannelSetting参数到硬件
     void sendToHardware(int dacIndex, const ChannelSetting& params);
     //重设 dacNum:通道号 [1-4] chl:信道号 [-6,6]
     bool resetFpgaChl(int dacNum,int chl);
+    // 热重启时恢复DAC信道分配，硬件已是该状态，不下发
+    void restoreState(UINT8 ptt, const QVector<INT8>& channels, const QVector<INT8>& selections);
 private:
     //释放 dacNum:通道号 [1-4]    //chl:信道号 [-6,6]
     bool releaseFpgaChl(int dacNum,int chl);
@@ -43,6 +50,8 @@ private:
 
     // 获取信道的描述字符串
     QString getChannelDescription(INT8 channel) const;
+    // 同上，返回静态字符串，写日志时不分配内存
+    static const char* channelName(INT8 channel);
 
     // 获取当前PTT值
     UINT8 getCurrentPtt() const;
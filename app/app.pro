@@ -0,0 +1,53 @@
+# 触摸屏界面程序
+QT += core gui widgets
+TARGET = ChannelSimu
+
+include(../core/core.pri)
+
+#定义USE_TOUCH_EVENT宏以支持触摸事件
+DEFINES += USE_TOUCH_EVENT
+
+SRC_ROOT = $$PWD/..
+
+SOURCES += \
+    $$SRC_ROOT/channelbasicpara.cpp \
+    $$SRC_ROOT/channelmodelselect.cpp \
+    $$SRC_ROOT/channelselect.cpp \
+    $$SRC_ROOT/datamanager.cpp \
+    $$SRC_ROOT/lazypage.cpp \
+    $$SRC_ROOT/main.cpp \
+    $$SRC_ROOT/mainwindow.cpp \
+    $$SRC_ROOT/matrixwidget.cpp \
+    $$SRC_ROOT/multipathpara.cpp \
+    $$SRC_ROOT/pageindicator.cpp \
+    $$SRC_ROOT/screenadapter.cpp \
+    $$SRC_ROOT/screensaver.cpp \
+    $$SRC_ROOT/simulistview.cpp \
+    $$SRC_ROOT/subwindow.cpp \
+    $$SRC_ROOT/swipestackedwidget.cpp \
+    $$SRC_ROOT/systemsetting.cpp
+
+HEADERS += \
+    $$SRC_ROOT/channelbasicpara.h \
+    $$SRC_ROOT/channelmodelselect.h \
+    $$SRC_ROOT/channelselect.h \
+    $$SRC_ROOT/datamanager.h \
+    $$SRC_ROOT/lazypage.h \
+    $$SRC_ROOT/mainwindow.h \
+    $$SRC_ROOT/matrixwidget.h \
+    $$SRC_ROOT/multipathpara.h \
+    $$SRC_ROOT/pageindicator.h \
+    $$SRC_ROOT/screenadapter.h \
+    $$SRC_ROOT/screensaver.h \
+    $$SRC_ROOT/simulistview.h \
+    $$SRC_ROOT/subwindow.h \
+    $$SRC_ROOT/swipestackedwidget.h \
+    $$SRC_ROOT/systemsetting.h
+
+RESOURCES += \
+    $$SRC_ROOT/res.qrc
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,543 @@
+#include "asynclogger.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+AsyncLogger* AsyncLogger::m_instance = nullptr;
+QMutex AsyncLogger::m_instanceMutex;
+std::atomic<int> AsyncLogger::s_level(static_cast<int>(LogLevel::Off));
+
+namespace {
+
+// 线程退出时标记缓冲，由写文件线程读空后释放
+struct ThreadBufferHolder
+{
+    LogRingBuffer *buffer = nullptr;
+
+    ~ThreadBufferHolder()
+    {
+        if (buffer) {
+            buffer->retire();
+        }
+    }
+};
+
+thread_local ThreadBufferHolder t_bufferHolder;
+
+void appendFormatted(QByteArray &out, const char *format, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (length < 0) {
+        return;
+    }
+    if (length < int(sizeof(buf))) {
+        out.append(buf, length);
+        return;
+    }
+
+    // 超长时按实际长度重新格式化
+    QByteArray large(length + 1, Qt::Uninitialized);
+    va_start(args, format);
+    vsnprintf(large.data(), large.size(), format, args);
+    va_end(args);
+    out.append(large.constData(), length);
+}
+
+// 可变参数中不足int的整数先提升为int
+int promotedSize(const LogRecord &record, int index)
+{
+    return qMax<int>(record.sizes[index], sizeof(int));
+}
+
+long long argAsSigned(const LogRecord &record, int index)
+{
+    const LogRecord::Value &value = record.values[index];
+    switch (record.types[index]) {
+    case LogRecord::Signed:
+    case LogRecord::Bool: return value.i;
+    case LogRecord::Unsigned:
+        // 与printf("%d", uint32_t)一致：按提升后的位宽解释为有符号，不足int的先提升为int
+        if (promotedSize(record, index) < 8) {
+            return static_cast<int32_t>(static_cast<uint32_t>(value.u));
+        }
+        return static_cast<long long>(value.u);
+    case LogRecord::Double: return static_cast<long long>(value.d);
+    case LogRecord::Pointer: return static_cast<long long>(reinterpret_cast<intptr_t>(value.p));
+    default: return 0;
+    }
+}
+
+unsigned long long argAsUnsigned(const LogRecord &record, int index)
+{
+    const LogRecord::Value &value = record.values[index];
+    switch (record.types[index]) {
+    case LogRecord::Signed:
+        // 负数按提升后的位宽输出，与printf("%X", int)一致
+        if (promotedSize(record, index) < 8) {
+            return static_cast<uint32_t>(value.i);
+        }
+        return static_cast<uint64_t>(value.i);
+    case LogRecord::Bool: return static_cast<uint64_t>(value.i);
+    case LogRecord::Unsigned: return value.u;
+    case LogRecord::Double: return static_cast<unsigned long long>(static_cast<long long>(value.d));
+    case LogRecord::Pointer: return reinterpret_cast<uintptr_t>(value.p);
+    default: return 0;
+    }
+}
+
+double argAsDouble(const LogRecord &record, int index)
+{
+    const LogRecord::Value &value = record.values[index];
+    switch (record.types[index]) {
+    case LogRecord::Signed:
+    case LogRecord::Bool: return static_cast<double>(value.i);
+    case LogRecord::Unsigned: return static_cast<double>(value.u);
+    case LogRecord::Double: return value.d;
+    default: return 0;
+    }
+}
+
+// "{}"及类型不匹配的%s按参数类型的默认格式输出
+void appendDefault(QByteArray &out, const LogRecord &record, int index)
+{
+    const LogRecord::Value &value = record.values[index];
+    switch (record.types[index]) {
+    case LogRecord::Signed: appendFormatted(out, "%lld", static_cast<long long>(value.i)); break;
+    case LogRecord::Unsigned: appendFormatted(out, "%llu", static_cast<unsigned long long>(value.u)); break;
+    case LogRecord::Double: appendFormatted(out, "%g", value.d); break;
+    case LogRecord::Bool: out.append(value.i ? "true" : "false"); break;
+    case LogRecord::Pointer: appendFormatted(out, "%p", value.p); break;
+    case LogRecord::Text: out.append(record.text + value.text.offset, value.text.length); break;
+    }
+}
+
+void appendConverted(QByteArray &out, const LogRecord &record, int index, QByteArray spec, char conversion)
+{
+    switch (conversion) {
+    case 'd':
+    case 'i':
+        appendFormatted(out, spec.append("lld").constData(), argAsSigned(record, index));
+        break;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        appendFormatted(out, spec.append("ll").append(conversion).constData(), argAsUnsigned(record, index));
+        break;
+    case 'c':
+        appendFormatted(out, spec.append('c').constData(), static_cast<int>(argAsSigned(record, index)));
+        break;
+    case 's':
+        if (record.types[index] == LogRecord::Text) {
+            QByteArray text(record.text + record.values[index].text.offset, record.values[index].text.length);
+            appendFormatted(out, spec.append('s').constData(), text.constData());
+        } else {
+            appendDefault(out, record, index);
+        }
+        break;
+    case 'p':
+        appendFormatted(out, spec.append('p').constData(), record.values[index].p);
+        break;
+    default:
+        // 浮点转换
+        appendFormatted(out, spec.append(conversion).constData(), argAsDouble(record, index));
+        break;
+    }
+}
+
+// p处的占位符长度："{}"为2，"{:x}"/"{:X}"(十六进制)为4，不是占位符时为0
+int placeholderLength(const char *p)
+{
+    if (p[0] != '{') {
+        return 0;
+    }
+    if (p[1] == '}') {
+        return 2;
+    }
+    if (p[1] == ':' && (p[2] == 'x' || p[2] == 'X') && p[3] == '}') {
+        return 4;
+    }
+    return 0;
+}
+
+} // namespace
+
+namespace AsyncLogDetail {
+
+void captureText(LogRecord &record, const char *data, int length)
+{
+    int available = LogRecord::TEXT_SIZE - record.textUsed;
+    if (length < 0) {
+        length = int(strnlen(data, available + 1));
+    }
+    if (length > available) {
+        // 截断时不拆开UTF-8多字节字符
+        length = available;
+        while (length > 0 && (static_cast<unsigned char>(data[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+
+    int index = record.argCount++;
+    record.types[index] = LogRecord::Text;
+    record.values[index].text.offset = record.textUsed;
+    record.values[index].text.length = static_cast<uint16_t>(length);
+    memcpy(record.text + record.textUsed, data, length);
+    record.textUsed += length;
+}
+
+} // namespace AsyncLogDetail
+
+LogRingBuffer::LogRingBuffer(uint16_t threadIndex)
+    : m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_retired(false)
+    , m_threadIndex(threadIndex)
+{
+}
+
+bool LogRingBuffer::read(LogRecord *record)
+{
+    uint32_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *record = m_records[tail & (CAPACITY - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRingBuffer::isEmpty() const
+{
+    return m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_acquire);
+}
+
+AsyncLogger::AsyncLogger()
+    : m_retiredDropped(0)
+    , m_nextThreadIndex(0)
+    , m_fileSize(0)
+    , m_maxBytes(DEFAULT_MAX_BYTES)
+    , m_maxFiles(DEFAULT_MAX_FILES)
+    , m_consoleEcho(false)
+    , m_level(LogLevel::Debug)
+    , m_thread(nullptr)
+    , m_running(false)
+    , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stop();
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+    }
+}
+
+AsyncLogger *AsyncLogger::instance()
+{
+    if (!m_instance) {
+        QMutexLocker locker(&m_instanceMutex);
+        if (!m_instance) {
+            m_instance = new AsyncLogger();
+        }
+    }
+    return m_instance;
+}
+
+bool AsyncLogger::start(const QString &filePath, qint64 maxBytes, int maxFiles)
+{
+    stop();
+
+    QMutexLocker locker(&m_drainMutex);
+    m_maxBytes = qMax<qint64>(4096, maxBytes);
+    m_maxFiles = qMax(1, maxFiles);
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "打开日志文件失败:" << filePath << m_file.errorString();
+        return false;
+    }
+    m_fileSize = m_file.size();
+
+    m_running.store(true);
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("AsyncLogger");
+    m_thread->start(QThread::LowPriority);
+
+    s_level.store(qMax(static_cast<int>(m_level), ASYNC_LOG_MIN_LEVEL), std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncLogger::stop()
+{
+    if (!m_thread) {
+        return;
+    }
+    s_level.store(static_cast<int>(LogLevel::Off), std::memory_order_relaxed);
+
+    // 写文件线程退出前读空所有缓冲
+    m_running.store(false);
+    wake();
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    QMutexLocker locker(&m_drainMutex);
+    m_file.close();
+}
+
+void AsyncLogger::flush()
+{
+    QMutexLocker locker(&m_drainMutex);
+    if (m_file.isOpen()) {
+        drain();
+        m_file.flush();
+    }
+}
+
+bool AsyncLogger::isRunning() const
+{
+    return m_running.load();
+}
+
+void AsyncLogger::setLevel(LogLevel level)
+{
+    m_level = level;
+    if (isRunning()) {
+        s_level.store(qMax(static_cast<int>(level), ASYNC_LOG_MIN_LEVEL), std::memory_order_relaxed);
+    }
+}
+
+LogLevel AsyncLogger::level() const
+{
+    return m_level;
+}
+
+void AsyncLogger::setConsoleEcho(bool echo)
+{
+    QMutexLocker locker(&m_drainMutex);
+    m_consoleEcho = echo;
+}
+
+quint64 AsyncLogger::droppedCount() const
+{
+    QMutexLocker locker(&m_buffersMutex);
+    quint64 dropped = m_retiredDropped;
+    for (LogRingBuffer *buffer : m_buffers) {
+        dropped += buffer->dropped();
+    }
+    return dropped;
+}
+
+LogRingBuffer *AsyncLogger::threadBuffer()
+{
+    if (Q_UNLIKELY(!t_bufferHolder.buffer)) {
+        t_bufferHolder.buffer = instance()->registerBuffer();
+    }
+    return t_bufferHolder.buffer;
+}
+
+LogRingBuffer *AsyncLogger::registerBuffer()
+{
+    QMutexLocker locker(&m_buffersMutex);
+    LogRingBuffer *buffer = new LogRingBuffer(m_nextThreadIndex++);
+    m_buffers.append(buffer);
+    return buffer;
+}
+
+int64_t AsyncLogger::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void AsyncLogger::wake()
+{
+    // 写日志的线程(包括PTT线程)调用，只有一次write系统调用，不获取互斥锁
+    // 计数已满(EAGAIN)时说明已有未处理的唤醒，忽略即可
+    int fd = instance()->m_wakeFd;
+    if (fd >= 0) {
+        uint64_t one = 1;
+        ssize_t ret = ::write(fd, &one, sizeof(one));
+        Q_UNUSED(ret);
+    }
+}
+
+void AsyncLogger::run()
+{
+    while (m_running.load()) {
+        {
+            QMutexLocker locker(&m_drainMutex);
+            if (drain() > 0) {
+                m_file.flush();
+            }
+        }
+        // 等待唤醒或超时；eventfd创建失败时fd为-1，poll忽略该项，退化为按周期轮询
+        struct pollfd pfd;
+        pfd.fd = m_wakeFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, FLUSH_INTERVAL_MS) > 0 && (pfd.revents & POLLIN)) {
+            uint64_t count = 0;
+            ssize_t ret = ::read(m_wakeFd, &count, sizeof(count));
+            Q_UNUSED(ret);
+        }
+    }
+
+    QMutexLocker locker(&m_drainMutex);
+    drain();
+    m_file.flush();
+}
+
+int AsyncLogger::drain()
+{
+    QVector<LogRingBuffer *> buffers;
+    {
+        QMutexLocker locker(&m_buffersMutex);
+        buffers = m_buffers;
+    }
+
+    int count = 0;
+    LogRecord record;
+    for (LogRingBuffer *buffer : buffers) {
+        while (buffer->read(&record)) {
+            writeLine(formatRecord(record));
+            count++;
+        }
+    }
+
+    // 释放已退出线程的缓冲；先判断退出标志，之后不会再有写入
+    QMutexLocker locker(&m_buffersMutex);
+    for (int i = m_buffers.size() - 1; i >= 0; i--) {
+        LogRingBuffer *buffer = m_buffers[i];
+        if (buffer->isRetired() && buffer->isEmpty()) {
+            m_retiredDropped += buffer->dropped();
+            m_buffers.remove(i);
+            delete buffer;
+        }
+    }
+    return count;
+}
+
+void AsyncLogger::writeLine(const QByteArray &line)
+{
+    if (m_consoleEcho) {
+        fwrite(line.constData(), 1, line.size(), stderr);
+    }
+    if (!m_file.isOpen()) {
+        return;
+    }
+    if (m_fileSize > 0 && m_fileSize + line.size() > m_maxBytes) {
+        rotate();
+    }
+    m_fileSize += m_file.write(line);
+}
+
+void AsyncLogger::rotate()
+{
+    QString path = m_file.fileName();
+    m_file.close();
+
+    // channelsim.log -> channelsim.log.1 -> ... -> channelsim.log.N，最旧的删除
+    QFile::remove(QString("%1.%2").arg(path).arg(m_maxFiles));
+    for (int i = m_maxFiles - 1; i >= 1; i--) {
+        QFile::rename(QString("%1.%2").arg(path).arg(i), QString("%1.%2").arg(path).arg(i + 1));
+    }
+    QFile::rename(path, path + ".1");
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fprintf(stderr, "日志文件轮转失败: %s\n", qPrintable(m_file.errorString()));
+    }
+    m_fileSize = 0;
+}
+
+QByteArray AsyncLogger::formatRecord(const LogRecord &record)
+{
+    static const char LEVEL_NAMES[] = "TDIWE";
+
+    QByteArray line;
+    line.reserve(160);
+    line.append(QDateTime::fromMSecsSinceEpoch(record.timestampUs / 1000)
+                    .toString("yyyy-MM-dd hh:mm:ss.zzz").toLatin1());
+    appendFormatted(line, "%03d %c T%u [%s] %s:%d ",
+                    int(record.timestampUs % 1000),
+                    record.level < 5 ? LEVEL_NAMES[record.level] : '?',
+                    unsigned(record.threadIndex),
+                    record.category, record.function, int(record.line));
+    line.append(formatMessage(record));
+    line.append('\n');
+    return line;
+}
+
+QByteArray AsyncLogger::formatMessage(const LogRecord &record)
+{
+    QByteArray out;
+    out.reserve(128);
+
+    const char *p = record.format;
+    int arg = 0;
+    while (*p) {
+        // 普通文本整段追加
+        const char *run = p;
+        while (*p && *p != '%' && placeholderLength(p) == 0) {
+            p++;
+        }
+        out.append(run, int(p - run));
+        if (!*p) {
+            break;
+        }
+
+        if (*p == '{') {
+            int length = placeholderLength(p);
+            if (arg >= record.argCount) {
+                out.append(p, length);
+            } else if (length == 2) {
+                appendDefault(out, record, arg++);
+            } else {
+                appendConverted(out, record, arg++, QByteArray("%"), p[2]);
+            }
+            p += length;
+            continue;
+        }
+
+        if (p[1] == '%') {
+            out.append('%');
+            p += 2;
+            continue;
+        }
+
+        // 解析转换说明：标志、宽度、精度保留，长度修饰符按参数类型重新生成
+        const char *start = p++;
+        QByteArray spec("%");
+        while (*p && strchr("-+ #0", *p)) spec.append(*p++);
+        while (*p >= '0' && *p <= '9') spec.append(*p++);
+        if (*p == '.') {
+            spec.append(*p++);
+            while (*p >= '0' && *p <= '9') spec.append(*p++);
+        }
+        while (*p && strchr("hlLqjzt", *p)) p++;
+
+        char conversion = *p;
+        if (!conversion || !strchr("diouxXcfFeEgGaAsp", conversion) || arg >= record.argCount) {
+            // 无法识别或缺少参数时原样输出
+            if (conversion) p++;
+            out.append(start, int(p - start));
+            continue;
+        }
+        p++;
+        appendConverted(out, record, arg++, spec, conversion);
+    }
+    return out;
+}
@@ -0,0 +1,315 @@
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 异步日志：热路径只把格式串指针和原始参数写入本线程的环形缓冲，
+// 格式化和写文件在后台线程进行；级别关闭时只有一次原子读
+//
+// 用法：LOG_DEBUG("fpga", "addr:0x%X, value:%d", addr, value);
+//      LOG_INFO("ptt", "PTT 0x{:X} -> 0x{:X}", oldPtt, newPtt);
+// 格式串支持printf转换符(长度修饰符可省略，按参数实际类型输出)和"{}"(按参数类型默认格式)、"{:x}"/"{:X}"(十六进制)
+// 新代码统一使用"{}"风格，printf转换符保留给从C代码移植的模块(fpga_driver)
+// 格式串和分类必须是字面量，只保存指针
+
+enum class LogLevel : int
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5
+};
+
+// 编译期级别：低于该级别的LOG_xxx整体编译掉，参数也不求值
+// 可在.pro中用DEFINES += ASYNC_LOG_MIN_LEVEL=2覆盖
+#ifndef ASYNC_LOG_MIN_LEVEL
+#define ASYNC_LOG_MIN_LEVEL 1
+#endif
+
+// 一条日志记录，固定大小，在环形缓冲中原地填写
+struct LogRecord
+{
+    static const int MAX_ARGS = 8;
+    static const int TEXT_SIZE = 96;     // 字符串参数拷贝区，超出部分截断
+
+    enum ArgType : uint8_t {
+        Signed,
+        Unsigned,
+        Double,
+        Bool,
+        Pointer,
+        Text
+    };
+
+    struct TextRef {
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    union Value {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void *p;
+        TextRef text;
+    };
+
+    int64_t timestampUs;
+    const char *category;
+    const char *format;
+    const char *function;
+    int32_t line;
+    uint16_t threadIndex;
+    uint8_t level;
+    uint8_t argCount;
+    uint8_t textUsed;
+    uint8_t types[MAX_ARGS];
+    uint8_t sizes[MAX_ARGS];             // 整数参数的原始字节数，按无符号输出时截取
+    Value values[MAX_ARGS];
+    char text[TEXT_SIZE];
+};
+
+// 单生产者单消费者环形缓冲：每个写日志的线程一个，只由写文件线程读取
+// 缓冲满时丢弃新日志并计数，不阻塞写日志的线程
+class LogRingBuffer
+{
+public:
+    static const uint32_t CAPACITY = 1024;     // 2的幂
+
+    explicit LogRingBuffer(uint16_t threadIndex);
+
+    // 取一个空闲槽位，满时返回nullptr
+    LogRecord *beginWrite()
+    {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+            m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_records[head & (CAPACITY - 1)];
+    }
+
+    // 提交槽位，返回提交后缓冲中的条数
+    uint32_t commitWrite()
+    {
+        uint32_t head = m_head.load(std::memory_order_relaxed) + 1;
+        m_head.store(head, std::memory_order_release);
+        return head - m_tail.load(std::memory_order_relaxed);
+    }
+
+    // 消费端：取出一条，空时返回false
+    bool read(LogRecord *record);
+    bool isEmpty() const;
+
+    uint16_t threadIndex() const { return m_threadIndex; }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // 所属线程退出后置位，缓冲读空后由写文件线程释放
+    void retire() { m_retired.store(true, std::memory_order_release); }
+    bool isRetired() const { return m_retired.load(std::memory_order_acquire); }
+
+private:
+    alignas(64) std::atomic<uint32_t> m_head;
+    alignas(64) std::atomic<uint32_t> m_tail;
+    alignas(64) std::atomic<uint64_t> m_dropped;
+    std::atomic<bool> m_retired;
+    uint16_t m_threadIndex;
+    LogRecord m_records[CAPACITY];
+};
+
+namespace AsyncLogDetail {
+
+template <typename T>
+struct DependentFalse : std::false_type {};
+
+void captureText(LogRecord &record, const char *data, int length);
+
+template <typename T>
+inline void captureArg(LogRecord &record, const T &value)
+{
+    if constexpr (std::is_enum<T>::value) {
+        captureArg(record, static_cast<typename std::underlying_type<T>::type>(value));
+    } else if constexpr (std::is_same<T, QString>::value) {
+        // 只在级别开启时转换
+        QByteArray utf8 = value.toUtf8();
+        captureText(record, utf8.constData(), utf8.size());
+    } else if constexpr (std::is_same<T, QByteArray>::value) {
+        captureText(record, value.constData(), value.size());
+    } else if constexpr (std::is_convertible<const T &, const char *>::value) {
+        const char *str = value;
+        captureText(record, str ? str : "(null)", -1);
+    } else {
+        int index = record.argCount++;
+        if constexpr (std::is_same<T, bool>::value) {
+            record.types[index] = LogRecord::Bool;
+            record.values[index].i = value ? 1 : 0;
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            record.types[index] = LogRecord::Signed;
+            record.sizes[index] = sizeof(T);
+            record.values[index].i = value;
+        } else if constexpr (std::is_integral<T>::value) {
+            record.types[index] = LogRecord::Unsigned;
+            record.sizes[index] = sizeof(T);
+            record.values[index].u = value;
+        } else if constexpr (std::is_floating_point<T>::value) {
+            record.types[index] = LogRecord::Double;
+            record.values[index].d = value;
+        } else if constexpr (std::is_pointer<T>::value) {
+            record.types[index] = LogRecord::Pointer;
+            record.values[index].p = static_cast<const void *>(value);
+        } else {
+            static_assert(DependentFalse<T>::value, "不支持的日志参数类型");
+        }
+    }
+}
+
+} // namespace AsyncLogDetail
+
+class AsyncLogger
+{
+public:
+    static const qint64 DEFAULT_MAX_BYTES = 4 * 1024 * 1024;
+    static const int DEFAULT_MAX_FILES = 5;
+    static const int FLUSH_INTERVAL_MS = 20;
+
+    static AsyncLogger *instance();
+
+    // 启动写文件线程：filePath为当前文件，超过maxBytes后依次轮转为.1到.maxFiles
+    // 启动前及停止后所有日志调用直接返回
+    bool start(const QString &filePath, qint64 maxBytes = DEFAULT_MAX_BYTES, int maxFiles = DEFAULT_MAX_FILES);
+    // 写完已缓存的日志后停止
+    void stop();
+    // 在调用线程中写出所有已提交的日志
+    void flush();
+    bool isRunning() const;
+
+    // 运行期级别，不能低于编译期级别
+    void setLevel(LogLevel level);
+    LogLevel level() const;
+    // 同时输出到stderr，调试时使用
+    void setConsoleEcho(bool echo);
+
+    // 缓冲满被丢弃的日志条数
+    quint64 droppedCount() const;
+
+    static bool isEnabled(LogLevel level)
+    {
+        return static_cast<int>(level) >= s_level.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    static void write(LogLevel level, const char *category, const char *function, int line,
+                      const char *format, const Args &... args)
+    {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "日志参数过多");
+        LogRingBuffer *buffer = threadBuffer();
+        LogRecord *record = buffer->beginWrite();
+        if (!record) {
+            return;
+        }
+        record->timestampUs = nowUs();
+        record->category = category;
+        record->format = format;
+        record->function = function;
+        record->line = line;
+        record->threadIndex = buffer->threadIndex();
+        record->level = static_cast<uint8_t>(level);
+        record->argCount = 0;
+        record->textUsed = 0;
+        (AsyncLogDetail::captureArg(*record, args), ...);
+        // 缓冲过半时提前唤醒写文件线程，平时只按周期读取
+        if (buffer->commitWrite() == LogRingBuffer::CAPACITY / 2) {
+            wake();
+        }
+    }
+
+    // 把记录格式化为一行文本(含时间、级别、分类和位置)，写文件线程和测试使用
+    static QByteArray formatRecord(const LogRecord &record);
+    // 只格式化消息部分
+    static QByteArray formatMessage(const LogRecord &record);
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    static LogRingBuffer *threadBuffer();
+    static int64_t nowUs();
+    static void wake();
+    LogRingBuffer *registerBuffer();
+
+    void run();
+    // 读出全部缓冲写入文件，返回写出的条数；调用方持有m_drainMutex
+    int drain();
+    void writeLine(const QByteArray &line);
+    void rotate();
+
+    static std::atomic<int> s_level;
+
+    mutable QMutex m_buffersMutex;             // 保护m_buffers，只在线程首次写日志和drain时加锁
+    QVector<LogRingBuffer *> m_buffers;
+    quint64 m_retiredDropped;
+    uint16_t m_nextThreadIndex;
+
+    QMutex m_drainMutex;                 // 保证同一时刻只有一个消费者
+    QFile m_file;
+    qint64 m_fileSize;
+    qint64 m_maxBytes;
+    int m_maxFiles;
+    bool m_consoleEcho;
+    LogLevel m_level;                    // 设置的级别，未运行时s_level为Off
+
+    QThread *m_thread;
+    std::atomic<bool> m_running;
+    int m_wakeFd;                        // eventfd：wake()只写一次计数，不加锁；创建失败时按周期轮询
+
+    static AsyncLogger *m_instance;
+    static QMutex m_instanceMutex;
+};
+
+#define ASYNC_LOG_WRITE(level, category, ...) \
+    do { \
+        if (AsyncLogger::isEnabled(level)) { \
+            AsyncLogger::write(level, category, __FUNCTION__, __LINE__, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define ASYNC_LOG_DISCARD() do {} while (0)
+
+#if ASYNC_LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(category, ...) ASYNC_LOG_WRITE(LogLevel::Trace, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ASYNC_LOG_DISCARD()
+#endif
+
+#if ASYNC_LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(category, ...) ASYNC_LOG_WRITE(LogLevel::Debug, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ASYNC_LOG_DISCARD()
+#endif
+
+#if ASYNC_LOG_MIN_LEVEL <= 2
+#define LOG_INFO(category, ...) ASYNC_LOG_WRITE(LogLevel::Info, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ASYNC_LOG_DISCARD()
+#endif
+
+#if ASYNC_LOG_MIN_LEVEL <= 3
+#define LOG_WARN(category, ...) ASYNC_LOG_WRITE(LogLevel::Warning, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ASYNC_LOG_DISCARD()
+#endif
+
+#define LOG_ERROR(category, ...) ASYNC_LOG_WRITE(LogLevel::Error, category, __VA_ARGS__)
+
+#endif // ASYNCLOGGER_H
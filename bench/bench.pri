@@ -0,0 +1,12 @@
+# 基准测试公共配置
+QT += testlib
+QT -= gui
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+# 公用初始化和数据构造，场景配置与单元测试共用tests/testutil.h
+INCLUDEPATH += $$PWD $$PWD/../tests
+HEADERS += $$PWD/benchutil.h $$PWD/../tests/testutil.h
@@ -0,0 +1,12 @@
+# 性能基准测试（QBENCHMARK），每个热点路径一个独立可执行程序
+# 运行示例：./bench_channelcache -tickcounter   或   ./bench_database -iterations 20
+# 在ARM目标板上优化前后各跑一次，对比结果作为基线
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    channelcache \
+    configmanager \
+    mqttparser \
+    iohandler \
+    database \
+    matrixwidget
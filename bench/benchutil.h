@@ -0,0 +1,29 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <QLoggingCategory>
+#include <QString>
+#include "testutil.h"
+
+// 基准测试公用的初始化和数据构造，由bench.pri加入各基准程序的包含路径
+namespace BenchUtil {
+
+// 默认关闭qDebug输出，避免终端打印干扰测量；设置BENCH_VERBOSE可恢复
+// quietWarnings为true时同时关闭qWarning（例如解析失败用例会大量告警）
+inline void quietOutput(bool quietWarnings = false)
+{
+    if (qEnvironmentVariableIsEmpty("BENCH_VERBOSE")) {
+        QLoggingCategory::setFilterRules(quietWarnings ? "default.debug=false\ndefault.warning=false"
+                                                       : "default.debug=false");
+    }
+}
+
+// 第index个场景配置：名称"场景<index>"，信道按1~15循环，pathCount条多径
+inline ModelParaSetting makeConfig(int index, int pathCount = 4)
+{
+    return TestUtil::makeConfig(QString("场景%1").arg(index), index % 15 + 1, pathCount);
+}
+
+}
+
+#endif // BENCHUTIL_H
@@ -0,0 +1,6 @@
+include(../bench.pri)
+
+TARGET = bench_channelcache
+
+SOURCES += \
+    tst_bench_channelcache.cpp
@@ -0,0 +1,148 @@
+#include <QtTest>
+#include <QThread>
+#include <atomic>
+#include "channelcachemanager.h"
+#include "benchutil.h"
+
+// ChannelCacheManager读写性能基准：
+// PTT线程频繁调用getAllChannelSettings，界面/MQTT线程调用updateChannelParameters，
+// 这里分别在不同数量的后台竞争线程下测量两者的耗时
+class BenchChannelCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void getAllChannelSettings_data();
+    void getAllChannelSettings();
+
+    void updateChannelParameters_data();
+    void updateChannelParameters();
+
+private:
+    static ChannelSetting makeSetting(int channelNum, int pathCount);
+
+    // 启动/停止后台竞争线程
+    void startContenders(int count, bool writer);
+    void stopContenders();
+
+    QList<QThread*> m_contenders;
+    std::atomic<bool> m_stop{false};
+};
+
+ChannelSetting BenchChannelCache::makeSetting(int channelNum, int pathCount)
+{
+    ChannelSetting setting;
+    setting.channelNum = channelNum;
+    setting.signalAnt = 10.0;
+    setting.filterNum = 1;
+    for (int i = 1; i <= pathCount; ++i) {
+        MultiPathType path;
+        path.pathNum = i;
+        path.relativDelay = i * 100;
+        path.antPower = -i;
+        path.freShift = i * 10;
+        path.freSpread = i * 5;
+        path.dopplerType = 0;
+        setting.multipathType.append(path);
+    }
+    return setting;
+}
+
+void BenchChannelCache::initTestCase()
+{
+    BenchUtil::quietOutput();
+
+    // 用满配多径填充缓存，模拟实际运行状态
+    for (int ch = 1; ch <= 15; ++ch) {
+        ChannelCacheManager::instance()->updateChannelParameters(ch, makeSetting(ch, 4));
+    }
+}
+
+void BenchChannelCache::startContenders(int count, bool writer)
+{
+    m_stop = false;
+    for (int i = 0; i < count; ++i) {
+        QThread *thread = QThread::create([this, writer, i]() {
+            ChannelSetting setting = makeSetting(i % 15 + 1, 4);
+            int ch = 0;
+            while (!m_stop.load(std::memory_order_relaxed)) {
+                if (writer) {
+                    ChannelCacheManager::instance()->updateChannelParameters(ch % 15 + 1, setting);
+                } else {
+                    QMap<int, ChannelSetting> all = ChannelCacheManager::instance()->getAllChannelSettings();
+                    Q_UNUSED(all)
+                }
+                ++ch;
+            }
+        });
+        thread->start();
+        m_contenders.append(thread);
+    }
+}
+
+void BenchChannelCache::stopContenders()
+{
+    m_stop = true;
+    for (QThread *thread : m_contenders) {
+        thread->wait();
+        delete thread;
+    }
+    m_contenders.clear();
+}
+
+void BenchChannelCache::getAllChannelSettings_data()
+{
+    QTest::addColumn<int>("writers");
+    QTest::newRow("no-contention") << 0;
+    QTest::newRow("1-writer") << 1;
+    QTest::newRow("4-writers") << 4;
+}
+
+void BenchChannelCache::getAllChannelSettings()
+{
+    QFETCH(int, writers);
+    startContenders(writers, true);
+
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    QBENCHMARK {
+        QMap<int, ChannelSetting> all = cache->getAllChannelSettings();
+        // 模拟PTT线程遍历读取
+        for (auto it = all.constBegin(); it != all.constEnd(); ++it) {
+            if (it.value().isChange) {
+                break;
+            }
+        }
+    }
+
+    stopContenders();
+}
+
+void BenchChannelCache::updateChannelParameters_data()
+{
+    QTest::addColumn<int>("readers");
+    QTest::newRow("no-contention") << 0;
+    QTest::newRow("1-reader") << 1;
+    QTest::newRow("4-readers") << 4;
+}
+
+void BenchChannelCache::updateChannelParameters()
+{
+    QFETCH(int, readers);
+    startContenders(readers, false);
+
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ChannelSetting setting = makeSetting(1, 4);
+    int ch = 0;
+    QBENCHMARK {
+        cache->updateChannelParameters(ch % 15 + 1, setting);
+        ++ch;
+    }
+
+    stopContenders();
+}
+
+QTEST_GUILESS_MAIN(BenchChannelCache)
+
+#include "tst_bench_channelcache.moc"
@@ -0,0 +1,6 @@
+include(../bench.pri)
+
+TARGET = bench_configmanager
+
+SOURCES += \
+    tst_bench_configmanager.cpp
@@ -0,0 +1,153 @@
+#include <QtTest>
+#include "configmanager.h"
+#include "benchutil.h"
+
+// ConfigManager的增删改查基准，场景数量分别取10/100/1000
+class BenchConfigManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void addConfigToMap_data();
+    void addConfigToMap();
+
+    void getConfigFromMap_data();
+    void getConfigFromMap();
+
+    void updateConfigInMap_data();
+    void updateConfigInMap();
+
+    void getAllConfigKeys_data();
+    void getAllConfigKeys();
+
+    void removeConfigFromMap_data();
+    void removeConfigFromMap();
+
+private:
+    void fillMap(int count);
+    void addSizeRows();
+
+    ConfigManager m_manager;
+};
+
+void BenchConfigManager::fillMap(int count)
+{
+    m_manager.clearGlobalMap();
+    for (int i = 0; i < count; ++i) {
+        m_manager.addConfigToMap(QString("场景%1").arg(i), BenchUtil::makeConfig(i));
+    }
+}
+
+void BenchConfigManager::addSizeRows()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void BenchConfigManager::initTestCase()
+{
+    BenchUtil::quietOutput();
+}
+
+void BenchConfigManager::cleanup()
+{
+    m_manager.clearGlobalMap();
+}
+
+void BenchConfigManager::addConfigToMap_data()
+{
+    addSizeRows();
+}
+
+void BenchConfigManager::addConfigToMap()
+{
+    QFETCH(int, size);
+    fillMap(size);
+
+    // 每轮加入map中不存在的键后再删除，测的是插入路径而不是重复键被拒绝，map规模保持不变
+    ModelParaSetting config = BenchUtil::makeConfig(size);
+    const QString key = config.modelName;
+    QBENCHMARK {
+        m_manager.addConfigToMap(key, config);
+        m_manager.removeConfigFromMap(key);
+    }
+    QCOMPARE(m_manager.getAllConfigKeys().size(), size);
+}
+
+void BenchConfigManager::getConfigFromMap_data()
+{
+    addSizeRows();
+}
+
+void BenchConfigManager::getConfigFromMap()
+{
+    QFETCH(int, size);
+    fillMap(size);
+
+    const QString key = QString("场景%1").arg(size / 2);
+    QBENCHMARK {
+        ModelParaSetting config = m_manager.getConfigFromMap(key);
+        Q_UNUSED(config)
+    }
+}
+
+void BenchConfigManager::updateConfigInMap_data()
+{
+    addSizeRows();
+}
+
+void BenchConfigManager::updateConfigInMap()
+{
+    QFETCH(int, size);
+    fillMap(size);
+
+    ModelParaSetting config = BenchUtil::makeConfig(size / 2);
+    const QString key = config.modelName;
+    QBENCHMARK {
+        m_manager.updateConfigInMap(key, config);
+    }
+}
+
+void BenchConfigManager::getAllConfigKeys_data()
+{
+    addSizeRows();
+}
+
+void BenchConfigManager::getAllConfigKeys()
+{
+    QFETCH(int, size);
+    fillMap(size);
+
+    QBENCHMARK {
+        QList<QString> keys = m_manager.getAllConfigKeys();
+        Q_UNUSED(keys)
+    }
+}
+
+void BenchConfigManager::removeConfigFromMap_data()
+{
+    addSizeRows();
+}
+
+void BenchConfigManager::removeConfigFromMap()
+{
+    QFETCH(int, size);
+    fillMap(size);
+
+    // 删除后立即加回，保持map规模不变
+    ModelParaSetting config = BenchUtil::makeConfig(size / 2);
+    const QString key = config.modelName;
+    QBENCHMARK {
+        m_manager.removeConfigFromMap(key);
+        m_manager.addConfigToMap(key, config);
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchConfigManager)
+
+#include "tst_bench_configmanager.moc"
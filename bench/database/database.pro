@@ -0,0 +1,6 @@
+include(../bench.pri)
+
+TARGET = bench_database
+
+SOURCES += \
+    tst_bench_database.cpp
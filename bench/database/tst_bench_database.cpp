@@ -0,0 +1,160 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "databasemanager.h"
+#include "scenariopack.h"
+#include "benchutil.h"
+
+// DatabaseManager在1万条场景记录下的加载、批量导入和批量删除基准
+// 目标：整库加载远小于1秒
+class BenchDatabase : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getAllConfigs();
+    void getScenarioSummaries();
+    void getParaConfig();
+    void searchConfigs();
+    void openScenarioPack();
+    void packLookup();
+    void insertParaConfigs();
+    void deleteParaConfigs();
+
+private:
+    static constexpr int ROW_COUNT = 10000;
+
+    QTemporaryDir m_dir;
+    DatabaseManager m_db;
+};
+
+void BenchDatabase::initTestCase()
+{
+    BenchUtil::quietOutput();
+
+    QVERIFY(m_dir.isValid());
+    QVERIFY(m_db.openDatabase(m_dir.filePath("bench.db")));
+    QVERIFY(m_db.createTable());
+
+    // 批量写入测试数据，只有准备阶段，不计入测量
+    QVector<ModelParaSetting> configs;
+    for (int i = 0; i < ROW_COUNT; ++i) {
+        configs.append(BenchUtil::makeConfig(i));
+    }
+    QVERIFY(m_db.insertParaConfigs(configs));
+}
+
+void BenchDatabase::cleanupTestCase()
+{
+    m_db.closeDatabase();
+}
+
+void BenchDatabase::getAllConfigs()
+{
+    QBENCHMARK {
+        QVector<ModelParaSetting> configs = m_db.getAllConfigs();
+        QCOMPARE(configs.size(), ROW_COUNT);
+    }
+}
+
+void BenchDatabase::getScenarioSummaries()
+{
+    // 启动时场景库只加载摘要
+    QBENCHMARK {
+        QVector<ScenarioSummary> summaries = m_db.getScenarioSummaries();
+        QCOMPARE(summaries.size(), ROW_COUNT);
+    }
+}
+
+void BenchDatabase::getParaConfig()
+{
+    ModelParaSetting config;
+    QBENCHMARK {
+        QVERIFY(m_db.getParaConfig("场景5000", &config));
+    }
+    QCOMPARE(config.multipathType.size(), 4);
+}
+
+void BenchDatabase::searchConfigs()
+{
+    // 信道3且存在频移不小于30的路径
+    ScenarioFilter filter;
+    filter.channelNum = 3;
+    filter.freShift.setMin(30);
+
+    QBENCHMARK {
+        QVector<ModelParaSetting> configs = m_db.searchConfigs(filter);
+        QCOMPARE(configs.size(), 667);
+    }
+}
+
+void BenchDatabase::openScenarioPack()
+{
+    // 场景库缓存文件：映射后读取全部摘要，与getScenarioSummaries对比
+    QString packPath = m_dir.filePath("bench.db.pack");
+    QVERIFY(ScenarioPack::write(packPath, m_db.getAllConfigs(), m_db.libraryRevision()));
+
+    QBENCHMARK {
+        ScenarioPack pack;
+        QVERIFY(pack.open(packPath));
+        QVector<ScenarioSummary> summaries;
+        summaries.reserve(pack.count());
+        for (int i = 0; i < pack.count(); ++i) {
+            ScenarioSummary summary;
+            summary.modelName = pack.name(i);
+            summary.channelNum = pack.record(i)->channelNum;
+            summaries.append(summary);
+        }
+        QCOMPARE(summaries.size(), ROW_COUNT);
+    }
+}
+
+void BenchDatabase::packLookup()
+{
+    ScenarioPack pack;
+    QVERIFY(pack.open(m_dir.filePath("bench.db.pack")));
+
+    ModelParaSetting config;
+    QBENCHMARK {
+        int index = pack.indexOf("场景5000");
+        QVERIFY(index >= 0);
+        config = pack.scenario(index);
+    }
+    QCOMPARE(config.multipathType.size(), 4);
+    QCOMPARE(config.modelName, QString("场景5000"));
+}
+
+void BenchDatabase::insertParaConfigs()
+{
+    // 另一组名称，导入后由deleteParaConfigs删除
+    QVector<ModelParaSetting> configs;
+    for (int i = 0; i < ROW_COUNT; ++i) {
+        ModelParaSetting config = BenchUtil::makeConfig(i);
+        config.modelName = QString("导入%1").arg(i);
+        configs.append(config);
+    }
+
+    QBENCHMARK_ONCE {
+        QVERIFY(m_db.insertParaConfigs(configs));
+    }
+    QCOMPARE(m_db.getAllConfigs().size(), ROW_COUNT * 2);
+}
+
+void BenchDatabase::deleteParaConfigs()
+{
+    QStringList names;
+    for (int i = 0; i < ROW_COUNT; ++i) {
+        names.append(QString("导入%1").arg(i));
+    }
+
+    QBENCHMARK_ONCE {
+        QVERIFY(m_db.deleteParaConfigs(names));
+    }
+    QCOMPARE(m_db.getAllConfigs().size(), ROW_COUNT);
+}
+
+QTEST_GUILESS_MAIN(BenchDatabase)
+
+#include "tst_bench_database.moc"
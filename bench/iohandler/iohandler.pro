@@ -0,0 +1,6 @@
+include(../bench.pri)
+
+TARGET = bench_iohandler
+
+SOURCES += \
+    tst_bench_iohandler.cpp
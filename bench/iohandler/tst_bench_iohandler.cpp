@@ -0,0 +1,164 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "iohandler.h"
+#include "benchutil.h"
+
+// IOHandler四种文件格式的导入/导出基准，以及5000个场景的批量迁移
+class BenchIOHandler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void exportData_data();
+    void exportData();
+
+    void importData_data();
+    void importData();
+
+    void exportArchive_data();
+    void exportArchive();
+    void importArchive_data();
+    void importArchive();
+
+    void exportFiles();
+    void importFiles();
+
+private:
+    static constexpr int BULK_COUNT = 5000;
+    static QList<ModelParaSetting> makeLibrary();
+    void addFormatRows();
+
+    QTemporaryDir m_dir;
+};
+
+QList<ModelParaSetting> BenchIOHandler::makeLibrary()
+{
+    QList<ModelParaSetting> library;
+    for (int i = 0; i < BULK_COUNT; ++i) {
+        ModelParaSetting config = BenchUtil::makeConfig(0);
+        config.modelName = QString("场景%1").arg(i);
+        library.append(config);
+    }
+    return library;
+}
+
+void BenchIOHandler::addFormatRows()
+{
+    // format为exportData使用的格式字符串，suffix为文件扩展名
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QString>("suffix");
+    QTest::newRow("CSV") << "CSV" << "csv";
+    QTest::newRow("JSON") << "JSON" << "json";
+    QTest::newRow("XML") << "XML" << "xml";
+    QTest::newRow("INI") << "INI" << "ini";
+}
+
+void BenchIOHandler::initTestCase()
+{
+    BenchUtil::quietOutput();
+    QVERIFY(m_dir.isValid());
+}
+
+void BenchIOHandler::exportData_data()
+{
+    addFormatRows();
+}
+
+void BenchIOHandler::exportData()
+{
+    QFETCH(QString, format);
+    QFETCH(QString, suffix);
+
+    IOHandler handler;
+    ModelParaSetting config = BenchUtil::makeConfig(0);
+    const QString filePath = m_dir.filePath("export." + suffix);
+    QBENCHMARK {
+        QVERIFY(handler.exportData(config, filePath, format));
+    }
+}
+
+void BenchIOHandler::importData_data()
+{
+    addFormatRows();
+}
+
+void BenchIOHandler::importData()
+{
+    QFETCH(QString, format);
+    QFETCH(QString, suffix);
+
+    IOHandler handler;
+    const QString filePath = m_dir.filePath("import." + suffix);
+    QVERIFY(handler.exportData(BenchUtil::makeConfig(0), filePath, format));
+
+    // 与界面导入路径一致，按扩展名/内容自动识别格式
+    QBENCHMARK {
+        ModelParaSetting config = handler.importDataAutoDetect(filePath);
+        Q_UNUSED(config)
+    }
+}
+
+void BenchIOHandler::exportArchive_data()
+{
+    addFormatRows();
+}
+
+void BenchIOHandler::exportArchive()
+{
+    QFETCH(QString, format);
+    QFETCH(QString, suffix);
+
+    IOHandler handler;
+    QList<ModelParaSetting> library = makeLibrary();
+    const QString filePath = m_dir.filePath("archive." + suffix);
+    QBENCHMARK {
+        QVERIFY(handler.exportArchive(library, filePath, format));
+    }
+}
+
+void BenchIOHandler::importArchive_data()
+{
+    addFormatRows();
+}
+
+void BenchIOHandler::importArchive()
+{
+    QFETCH(QString, format);
+    QFETCH(QString, suffix);
+
+    IOHandler handler;
+    const QString filePath = m_dir.filePath("archive_in." + suffix);
+    QVERIFY(handler.exportArchive(makeLibrary(), filePath, format));
+
+    QBENCHMARK {
+        QList<ModelParaSetting> configs = handler.importArchive(filePath);
+        QCOMPARE(configs.size(), int(BULK_COUNT));
+    }
+}
+
+void BenchIOHandler::exportFiles()
+{
+    IOHandler handler;
+    QList<ModelParaSetting> library = makeLibrary();
+    QVERIFY(QDir(m_dir.path()).mkpath("files"));
+    const QString dirPath = m_dir.filePath("files");
+    QBENCHMARK_ONCE {
+        QVERIFY(handler.exportFiles(library, dirPath, "JSON"));
+    }
+}
+
+void BenchIOHandler::importFiles()
+{
+    IOHandler handler;
+    const QString dirPath = m_dir.filePath("files");
+    QBENCHMARK_ONCE {
+        QList<ModelParaSetting> configs = handler.importDirectory(dirPath);
+        QCOMPARE(configs.size(), int(BULK_COUNT));
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchIOHandler)
+
+#include "tst_bench_iohandler.moc"
@@ -0,0 +1,17 @@
+include(../bench.pri)
+
+# 需要界面，bench.pri默认去掉了gui
+QT += gui widgets
+# 与界面程序一致，走触摸事件路径
+DEFINES += USE_TOUCH_EVENT
+
+TARGET = bench_matrixwidget
+
+SRC_ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_bench_matrixwidget.cpp \
+    $$SRC_ROOT/matrixwidget.cpp
+
+HEADERS += \
+    $$SRC_ROOT/matrixwidget.h
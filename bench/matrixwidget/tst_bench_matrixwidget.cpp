@@ -0,0 +1,94 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include "matrixwidget.h"
+#include "benchutil.h"
+
+// 信道矩阵触摸到重绘完成的延迟，以及整表重绘耗时
+// 无显示环境下运行：QT_QPA_PLATFORM=offscreen ./bench_matrixwidget
+class BenchMatrixWidget : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void tapToPaint();
+    void repaintMatrix();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    // 单元格中心，MatrixWidget坐标
+    QPoint cellCenter(int row, int column) const;
+
+    MatrixWidget *m_widget = nullptr;
+    QTouchDevice *m_device = nullptr;
+    int m_paintCount = 0;
+};
+
+void BenchMatrixWidget::initTestCase()
+{
+    BenchUtil::quietOutput();
+
+    m_device = QTest::createTouchDevice();
+    m_widget = new MatrixWidget();
+    m_widget->resize(800, 480);
+    m_widget->viewport()->installEventFilter(this);
+    m_widget->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_widget));
+}
+
+void BenchMatrixWidget::cleanupTestCase()
+{
+    delete m_widget;
+    m_widget = nullptr;
+}
+
+bool BenchMatrixWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint) {
+        m_paintCount++;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+QPoint BenchMatrixWidget::cellCenter(int row, int column) const
+{
+    QRect rect = m_widget->visualItemRect(m_widget->item(row, column));
+    return m_widget->viewport()->mapToParent(rect.center());
+}
+
+void BenchMatrixWidget::tapToPaint()
+{
+    // 信道7，每次短按在凸起/取消之间切换，两种情况都需要重绘
+    QPoint pos = cellCenter(4, 0);
+    QElapsedTimer guard;
+
+    QBENCHMARK {
+        int painted = m_paintCount;
+        QTest::touchEvent(m_widget, m_device).press(0, pos, m_widget);
+        QTest::touchEvent(m_widget, m_device).release(0, pos, m_widget);
+
+        // 等待本次点击引起的重绘完成
+        guard.start();
+        while (m_paintCount == painted) {
+            QCoreApplication::processEvents();
+            if (guard.elapsed() > 1000) {
+                QFAIL("touch did not trigger a repaint");
+            }
+        }
+    }
+}
+
+void BenchMatrixWidget::repaintMatrix()
+{
+    QBENCHMARK {
+        m_widget->viewport()->repaint();
+    }
+}
+
+QTEST_MAIN(BenchMatrixWidget)
+
+#include "tst_bench_matrixwidget.moc"
@@ -0,0 +1,6 @@
+include(../bench.pri)
+
+TARGET = bench_mqttparser
+
+SOURCES += \
+    tst_bench_mqttparser.cpp
@@ -0,0 +1,155 @@
+#include <QtTest>
+#include <QCborValue>
+#include "mqttmessageparser.h"
+#include "reportbuilder.h"
+#include "benchutil.h"
+
+// MqttMessageParser信道参数消息的解析/生成基准
+class BenchMqttParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parseChannelParamJson_data();
+    void parseChannelParamJson();
+
+    void createChannelParamJsonMessage();
+
+    void channelParamReport_data();
+    void channelParamReport();
+
+    void detectFormat_data();
+    void detectFormat();
+
+private:
+    // 按CHANNEL_SIMU_PARAM的报文结构生成指定规模的负载
+    static QByteArray makeChannelParamPayload(int channelCount, int pathCount);
+};
+
+QByteArray BenchMqttParser::makeChannelParamPayload(int channelCount, int pathCount)
+{
+    QJsonObject rootObj;
+    rootObj["ExamID"] = QString::number(1943573142583222273);
+
+    QJsonArray modelParaArray;
+    for (int ch = 0; ch < channelCount; ++ch) {
+        QJsonObject modelObj;
+        modelObj["modelType"] = QString::number(1);
+        modelObj["modelName"] = QString("场景%1").arg(ch);
+        modelObj["channelNum"] = QString::number(ch % 15 + 1);
+        modelObj["channelID"] = QString("channel-%1-id").arg(ch + 1);
+        modelObj["noisePower"] = QString::number(2000);
+        modelObj["signalAnt"] = QString::number(10);
+        modelObj["comDistance"] = QString::number(3000);
+        modelObj["filterNum"] = QString::number(1);
+        modelObj["multipathNum"] = QString::number(pathCount);
+
+        QJsonArray multiPathArray;
+        for (int p = 0; p < pathCount; ++p) {
+            QJsonObject pathObj;
+            pathObj["pathNum"] = QString::number(p + 1);
+            pathObj["relativDelay"] = QString::number(p * 100);
+            pathObj["antPower"] = QString::number(-p);
+            pathObj["freShift"] = QString::number(p * 10);
+            pathObj["freSpread"] = QString::number(p * 5);
+            multiPathArray.append(pathObj);
+        }
+        modelObj["MultiPath"] = multiPathArray;
+        modelParaArray.append(modelObj);
+    }
+    rootObj["ModelParaSetting"] = modelParaArray;
+
+    return QJsonDocument(rootObj).toJson(QJsonDocument::Compact);
+}
+
+void BenchMqttParser::initTestCase()
+{
+    BenchUtil::quietOutput(true);
+}
+
+void BenchMqttParser::parseChannelParamJson_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+    QTest::newRow("sample") << MqttMessageParser::createChannelParamJsonMessage();
+    QTest::newRow("1ch-4path") << makeChannelParamPayload(1, 4);
+    QTest::newRow("15ch-4path") << makeChannelParamPayload(15, 4);
+}
+
+void BenchMqttParser::parseChannelParamJson()
+{
+    QFETCH(QByteArray, payload);
+
+    // 只测解析和校验，入队由PTT监控线程消费，这里不涉及
+    QBENCHMARK {
+        QString examID;
+        QList<ModelParaSetting> settings;
+        QString error;
+        bool ok = MqttMessageParser::parseChannelParams(payload, &examID, &settings, &error);
+        Q_UNUSED(ok)
+    }
+}
+
+void BenchMqttParser::createChannelParamJsonMessage()
+{
+    QBENCHMARK {
+        QByteArray payload = MqttMessageParser::createChannelParamJsonMessage();
+        Q_UNUSED(payload)
+    }
+}
+
+void BenchMqttParser::channelParamReport_data()
+{
+    QTest::addColumn<int>("changedChannels");
+    QTest::newRow("unchanged") << 0;
+    QTest::newRow("1ch-changed") << 1;
+    QTest::newRow("15ch-changed") << 15;
+}
+
+void BenchMqttParser::channelParamReport()
+{
+    QFETCH(int, changedChannels);
+
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ReportBuilder builder;
+    builder.channelParamReport("1943573142583222273", nullptr);
+
+    ChannelSetting setting;
+    setting.filterNum = 1;
+    MultiPathType path = {1, 100, -3, 10, 5, 0};
+    setting.multipathType = {path, path, path, path};
+    double ant = 0;
+    QBENCHMARK {
+        // 每轮修改指定数量的信道，模拟心跳间隔内的参数变化
+        for (int chl = 1; chl <= changedChannels; ++chl) {
+            setting.channelNum = chl;
+            setting.signalAnt = ++ant;
+            cache->updateChannelParameters(chl, setting);
+        }
+        QByteArray payload = builder.channelParamReport("1943573142583222273", nullptr);
+        Q_UNUSED(payload)
+    }
+}
+
+void BenchMqttParser::detectFormat_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+    QTest::newRow("json") << makeChannelParamPayload(15, 4);
+    QTest::newRow("text") << QByteArray("heartbeat ok");
+    QTest::newRow("cbor") << QCborValue::fromJsonValue(QJsonDocument::fromJson(makeChannelParamPayload(15, 4)).object()).toCbor();
+}
+
+void BenchMqttParser::detectFormat()
+{
+    QFETCH(QByteArray, payload);
+
+    QBENCHMARK {
+        MessageFormat format = MqttMessageParser::detectFormat(payload);
+        Q_UNUSED(format)
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchMqttParser)
+
+#include "tst_bench_mqttparser.moc"
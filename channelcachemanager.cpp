@@ -1,4 +1,7 @@
 #include "channelcachemanager.h"
+#include "wakeupnotifier.h"
+#include <QCoreApplication>
+#include <QThread>
 
 // 初始化静态成员变量
 ChannelCacheManager* ChannelCacheManager::m_instance = nullptr;
@@ -6,9 +9,15 @@ QMutex ChannelCacheManager::m_mutex;
 
 ChannelCacheManager::ChannelCacheManager(QObject *parent)
     : QObject(parent)
+    , m_generation(0)
+    , m_pendingBatchMask(0)
 {
     // 初始化缓存
     initCache();
+
+    // PTT线程批量写入后用eventfd唤醒代替投递排队信号，避免在PTT线程分配事件和信道列表
+    m_batchNotifier = new WakeupNotifier(this);
+    connect(m_batchNotifier, &WakeupNotifier::activated, this, &ChannelCacheManager::emitPendingBatch);
 }
 
 ChannelCacheManager* ChannelCacheManager::instance()
@@ -18,6 +27,10 @@ ChannelCacheManager* ChannelCacheManager::instance()
         QMutexLocker locker(&m_mutex);
         if (!m_instance) {
             m_instance = new ChannelCacheManager();
+            // 可能由PTT线程首次创建，批量通知统一在主线程发出
+            if (QCoreApplication::instance()) {
+                m_instance->moveToThread(QCoreApplication::instance()->thread());
+            }
         }
     }
     return m_instance;
@@ -72,6 +85,7 @@ void ChannelCacheManager::updateChannelParameters(int channelKey, const ChannelS
     ChannelSetting updatedSetting = newSetting;
     updatedSetting.switchFlag = oldSwitchFlag;
     updatedSetting.isChange = true;
+    updatedSetting.generation = ++m_generation;
 
     // 更新缓存
     m_channelCache[absKey] = updatedSetting;
@@ -80,6 +94,74 @@ void ChannelCacheManager::updateChannelParameters(int channelKey, const ChannelS
     emit parameterChanged(absKey, updatedSetting);
 }
 
+void ChannelCacheManager::updateChannelParametersBatch(const QList<ChannelSetting>& settings)
+{
+    // 信道只有1~15，用位图记录本批次变化的信道，不分配内存
+    quint32 changedMask = 0;
+    {
+        // 整批在一次写锁内完成，读者看不到只更新了一半的批次
+        QWriteLocker locker(&m_rwLock);
+        quint64 generation = ++m_generation;
+        for (const ChannelSetting& newSetting : settings) {
+            int absKey = abs(newSetting.channelNum);
+            if (absKey < 1 || absKey > 15) {
+                continue;
+            }
+            // 缓存从不与快照共享(见getAllChannelSettings)，find不会分离复制
+            auto it = m_channelCache.find(absKey);
+            if (it == m_channelCache.end()) {
+                continue;
+            }
+
+            // 保留旧的开关状态
+            ChannelSetting updatedSetting = newSetting;
+            updatedSetting.switchFlag = it.value().switchFlag;
+            updatedSetting.isChange = true;
+            updatedSetting.generation = generation;
+            it.value() = updatedSetting;
+            changedMask |= 1u << absKey;
+        }
+    }
+
+    if (changedMask == 0) {
+        return;
+    }
+
+    if (QThread::currentThread() != thread()) {
+        // 其他线程：合并到待通知位图，由本对象线程发出信号
+        m_pendingBatchMask.fetch_or(changedMask, std::memory_order_release);
+        m_batchNotifier->notify();
+        return;
+    }
+
+    // 本线程调用：按批次顺序同步发出
+    QList<int> changedKeys;
+    for (const ChannelSetting& newSetting : settings) {
+        int absKey = abs(newSetting.channelNum);
+        if (absKey >= 1 && absKey <= 15 && (changedMask & (1u << absKey))) {
+            changedKeys.append(absKey);
+            changedMask &= ~(1u << absKey);
+        }
+    }
+    emit parametersBatchChanged(changedKeys);
+}
+
+void ChannelCacheManager::emitPendingBatch()
+{
+    quint32 mask = m_pendingBatchMask.exchange(0, std::memory_order_acquire);
+    if (mask == 0) {
+        return;
+    }
+
+    QList<int> changedKeys;
+    for (int key = 1; key <= 15; ++key) {
+        if (mask & (1u << key)) {
+            changedKeys.append(key);
+        }
+    }
+    emit parametersBatchChanged(changedKeys);
+}
+
 void ChannelCacheManager::updateChannelSwitch(int channelKey, bool switchFlag)
 {
     // 检查信道键是否在有效范围内（对负key取绝对值）
@@ -105,6 +187,7 @@ void ChannelCacheManager::updateChannelSwitch(int channelKey, bool switchFlag)
         ChannelSetting updatedSetting = oldSetting;
         updatedSetting.switchFlag = switchFlag;
         updatedSetting.isChange = true;
+        updatedSetting.generation = ++m_generation;
 
         m_channelCache[absKey] = updatedSetting;
 
@@ -146,11 +229,30 @@ ChannelSetting ChannelCacheManager::getChannelSetting(int channelKey)
     return defaultSetting;
 }
 
+bool ChannelCacheManager::getChannelSetting(int channelKey, ChannelSetting* setting)
+{
+    QReadLocker locker(&m_rwLock);
+
+    // constFind不会使共享的缓存分离
+    auto it = m_channelCache.constFind(abs(channelKey));
+    if (it == m_channelCache.constEnd()) {
+        return false;
+    }
+    *setting = it.value();
+    return true;
+}
+
 QMap<int, ChannelSetting> ChannelCacheManager::getAllChannelSettings()
 {
     // 使用读锁保护缓存访问
     QReadLocker locker(&m_rwLock);
-    return m_channelCache;
+
+    // 逐项复制而不是返回隐式共享的缓存：快照存活期间PTT线程写缓存会分离整个QMap，在写锁内分配内存
+    QMap<int, ChannelSetting> snapshot;
+    for (auto it = m_channelCache.constBegin(); it != m_channelCache.constEnd(); ++it) {
+        snapshot.insert(snapshot.constEnd(), it.key(), it.value());
+    }
+    return snapshot;
 }
 
 ChannelSetting ChannelCacheManager::getValue(int key)
@@ -182,3 +284,27 @@ void ChannelCacheManager::setChannelNotChanged(int channelKey)
         }
     }
 }
+
+void ChannelCacheManager::restoreSettings(const QMap<int, ChannelSetting>& settings)
+{
+    // 使用写锁保护缓存更新
+    QWriteLocker locker(&m_rwLock);
+    quint64 generation = ++m_generation;
+
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        // 只恢复有效范围内已存在的信道
+        if (!m_channelCache.contains(it.key())) {
+            continue;
+        }
+        ChannelSetting restored = it.value();
+        restored.channelNum = it.key();
+        restored.isChange = false;
+        restored.generation = generation;
+        m_channelCache[it.key()] = restored;
+    }
+}
+
+quint64 ChannelCacheManager::generation() const
+{
+    return m_generation.load();
+}
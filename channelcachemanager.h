@@ -6,8 +6,11 @@
 #include <QMutex>
 #include <QReadWriteLock>
 #include <QList>
+#include <atomic>
 #include "channelparaconifg.h"
 
+class WakeupNotifier;
+
 // 信道缓存管理使用的结构体
 typedef struct ChannelSetting
 {
@@ -17,6 +20,7 @@ typedef struct ChannelSetting
     QList<MultiPathType> multipathType; // 多径类型列表
     bool switchFlag = false;      // 开关状态
     bool isChange = false;        // 是否改变
+    quint64 generation = 0;       // 修改代数，每次参数或开关变化时更新，用于上报增量重建
 }ChannelSetting;
 
 class ChannelCacheManager : public QObject
@@ -30,13 +34,21 @@ public:
     // 更新信道设置（除开关外的参数）
     void updateChannelParameters(int channelKey, const ChannelSetting& setting);
 
+    // 批量更新多个信道的参数（除开关外），整批写入后只发一次批量改变信号
+    // 在本对象所属线程调用时同步发出信号；其他线程(PTT线程)调用时只记录变化的信道并用eventfd唤醒，
+    // 信号在本对象线程中发出，调用方不分配内存
+    void updateChannelParametersBatch(const QList<ChannelSetting>& settings);
+
     // 更新开关状态
     void updateChannelSwitch(int channelKey, bool switchFlag);
 
     // 获取信道设置
     ChannelSetting getChannelSetting(int channelKey);
 
-    // 获取所有信道设置
+    // 同上，信道不存在时返回false；只复制共享的多径列表引用，不分配内存，供PTT线程使用
+    bool getChannelSetting(int channelKey, ChannelSetting* setting);
+
+    // 获取所有信道设置，返回独立的副本，缓存本身不与调用方共享
     QMap<int, ChannelSetting> getAllChannelSettings();
 
     // 根据key获取值（额外接口）
@@ -45,6 +57,12 @@ public:
     // 更新isChange为false
     void setChannelNotChanged(int channelKey);
 
+    // 热重启时恢复日志中的信道缓存，硬件已是该状态，不触发信号
+    void restoreSettings(const QMap<int, ChannelSetting>& settings);
+
+    // 缓存整体修改代数，任一信道参数或开关变化时递增
+    quint64 generation() const;
+
 signals:
     // 开关状态改变信号
     void switchStateChanged(int channelKey, bool switchFlag);
@@ -52,6 +70,13 @@ signals:
     // 参数改变信号
     void parameterChanged(int channelKey, const ChannelSetting& newSetting);
 
+    // 批量参数改变信号，channelKeys为本批次更新的信道；其他线程的连续多批在发出前合并
+    void parametersBatchChanged(const QList<int>& channelKeys);
+
+private slots:
+    // 本对象线程执行：发出其他线程批量更新累积的参数改变信号
+    void emitPendingBatch();
+
 private:
     // 构造函数私有化
     explicit ChannelCacheManager(QObject *parent = nullptr);
@@ -68,6 +93,13 @@ private:
 
     // 信道设置缓存
     QMap<int, ChannelSetting> m_channelCache;
+
+    // 修改代数，在写锁内递增
+    std::atomic<quint64> m_generation;
+
+    // 其他线程批量更新后待通知的信道，第n位表示信道n
+    std::atomic<quint32> m_pendingBatchMask;
+    WakeupNotifier* m_batchNotifier;
 };
 
 #endif // CHANNELCACHEMANAGER_H
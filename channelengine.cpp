@@ -0,0 +1,394 @@
+#include "channelengine.h"
+#include <QDebug>
+#include "fpga_driver.h"
+#include "channel_utils.h"
+#include "startupprofiler.h"
+#include "channelparamqueue.h"
+#include "telemetryservice.h"
+#include "telemetryrecorder.h"
+
+// 硬件状态日志文件，与channel.db同目录
+static const char *HARDWARE_JOURNAL_FILE = "hardware_state.json";
+// 日志写入合并间隔(ms)
+static const int JOURNAL_DELAY_MS = 200;
+// 运行配置文件
+static const char *SETTINGS_FILE = "ChannelSettings.ini";
+
+// initFpga判定可以热重启时暂存日志内容，由ChannelEngine构造时恢复
+static bool s_warmStart = false;
+static HardwareState s_warmState;
+
+ChannelEngine::ChannelEngine(QObject *parent)
+    : QObject(parent)
+    , m_configManager(new ConfigManager(this))
+    , m_dbManager(new DatabaseManager(this))
+    , m_scenarioLibrary(new ScenarioLibrary(m_dbManager, this))
+    , m_pttMonitorThread(nullptr)
+    , m_journal(HARDWARE_JOURNAL_FILE)
+    , m_journalTimer(new QTimer(this))
+{
+    // 信道管理器初始化
+    ChannelCacheManager::instance();
+
+    // 连接ChannelCacheManager的参数改变信号到槽函数
+    connect(ChannelCacheManager::instance(), &ChannelCacheManager::parameterChanged, this, &ChannelEngine::handleParameterChanged);
+    // 连接批量参数改变信号（MQTT整场景下发）
+    connect(ChannelCacheManager::instance(), &ChannelCacheManager::parametersBatchChanged, this, &ChannelEngine::handleParametersBatchChanged);
+    // 连接ChannelCacheManager的开关状态改变信号到槽函数
+    connect(ChannelCacheManager::instance(), &ChannelCacheManager::switchStateChanged, this, &ChannelEngine::onChannelSwitchChanged);
+
+    // 创建PTT监控线程，由start()启动
+    m_pttMonitorThread = new PttMonitorThread(m_configManager, this);
+
+    // 热重启：恢复信道缓存和DAC分配，硬件保持原状态
+    if (s_warmStart) {
+        ChannelCacheManager::instance()->restoreSettings(s_warmState.channels);
+        m_pttMonitorThread->restoreState(s_warmState.ptt, s_warmState.dacChannels, s_warmState.dacSelections);
+        s_warmStart = false;
+        qDebug() << "[热重启] 已恢复信道缓存和DAC分配";
+    }
+
+    // MQTT线程入队参数后唤醒PTT监控线程
+    PttMonitorThread *pttThread = m_pttMonitorThread;
+    ChannelParamQueue::instance()->setNotifier([pttThread]() {
+        pttThread->wakeUp();
+    });
+
+    // 每轮下发完成后写入硬件状态日志
+    m_journalTimer->setSingleShot(true);
+    m_journalTimer->setInterval(JOURNAL_DELAY_MS);
+    connect(m_journalTimer, &QTimer::timeout, this, &ChannelEngine::saveJournal);
+    connect(m_pttMonitorThread, &PttMonitorThread::hardwareCommitted, this, &ChannelEngine::scheduleJournal);
+    connect(m_pttMonitorThread, &PttMonitorThread::hardwareCommitted, this, &ChannelEngine::recordAssignment);
+}
+
+ChannelEngine::~ChannelEngine()
+{
+    // 停止并释放PTT监控线程
+    ChannelParamQueue::instance()->setNotifier(nullptr);
+    stop();
+    delete m_pttMonitorThread;
+    m_pttMonitorThread = nullptr;
+
+    int ret = fpga_deinit();
+    if (ret != FPGA_OK) {
+        qDebug() << "fpga delete fail";
+    }
+}
+
+void ChannelEngine::lockProcessMemory()
+{
+    // mlockall作用于整个进程，不能放在PTT线程启动时执行
+    QStringList errors;
+    RtProfile profile = RtProfile::load(SETTINGS_FILE);
+    if (!profile.lockProcessMemory(&errors)) {
+        for (const QString &error : errors) {
+            qWarning() << "[实时调度]" << error;
+        }
+    } else if (profile.enabled && profile.lockMemory) {
+        qDebug() << "[实时调度] 已锁定进程内存";
+    }
+}
+
+bool ChannelEngine::initFpga(QString *errorMessage)
+{
+    // 日志存在且影子寄存器与日志一致，说明硬件仍是上次提交的状态，跳过复位
+    HardwareJournal journal(HARDWARE_JOURNAL_FILE);
+    HardwareState state;
+    if (journal.load(&state) && fpga_attach() == FPGA_OK) {
+        QVector<quint32> shadowRegs(FPGA_SHADOW_REG_NUM);
+        if (fpga_read_shadow_regs(shadowRegs.data()) == FPGA_OK && shadowRegs == state.shadowRegs) {
+            s_warmStart = true;
+            s_warmState = state;
+            qDebug() << "[热重启] 硬件状态与日志一致，跳过fpga初始化";
+            return true;
+        }
+        qDebug() << "[热重启] 硬件状态与日志不一致，执行冷启动";
+        fpga_deinit();
+    }
+    // 冷启动后旧日志作废
+    journal.remove();
+
+    // 初始化fpga
+    int ret = fpga_init();
+    if (ret != FPGA_OK) {
+        qDebug() << "fpga init fail";
+        if (errorMessage) *errorMessage = "FPGA初始化失败";
+        return false;
+    }
+    qDebug() << "fpga init successful";
+
+    //初始化干扰和解调
+    for (int gr_out = GR_OUT_1; gr_out < GR_OUT_MAX; gr_out++) {
+        ret = set_gr_out_sel((GR_OUT_E)gr_out, DATA_SRC_ADC1_ALG);
+        if (ret != FPGA_OK) {
+            qDebug() << "fpga init fail";
+            if (errorMessage) *errorMessage = "FPGA初始化失败 - 干扰器初始化失败";
+            return false;
+        }
+    }
+
+    for (int rs_jt = RS_JT_1; rs_jt < RS_JT_MAX; rs_jt++) {
+        ret = set_jt_out_sel((RS_JT_E)rs_jt, static_cast<DATA_SRC>(rs_jt + 1));
+        if (ret != FPGA_OK) {
+            qDebug() << "fpga init fail";
+            if (errorMessage) *errorMessage = "FPGA初始化失败 - 解调器初始化失败";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ChannelEngine::initDataBase(const QString &dbName, QString *errorMessage)
+{
+    if (!m_dbManager->openDatabase(dbName)) {
+        if (errorMessage) *errorMessage = "Failed to open database!";
+        return false;
+    }
+
+    if (!m_dbManager->createTable()) {
+        if (errorMessage) *errorMessage = "Failed to create table!";
+        return false;
+    }
+
+    // 启动时只加载场景摘要
+    m_scenarioLibrary->load();
+
+    // 遥测历史写入同一数据库文件
+    TelemetryRecorder::instance()->setDatabaseName(m_dbManager->databaseName());
+    return true;
+}
+
+void ChannelEngine::start()
+{
+    if (m_pttMonitorThread && !m_pttMonitorThread->isRunning()) {
+        // 实时调度配置与MQTT配置同在ChannelSettings.ini，界面程序和守护进程共用
+        m_pttMonitorThread->setRtProfile(RtProfile::load(SETTINGS_FILE));
+        m_pttMonitorThread->start();
+        StartupProfiler::mark("PTT就绪");
+    }
+
+    // 遥测采样与PTT监控相互独立，不影响PTT就绪时间
+    TelemetryService *telemetry = TelemetryService::instance();
+    if (!telemetry->isRunning()) {
+        telemetry->start();
+    }
+
+    TelemetryRecorder *recorder = TelemetryRecorder::instance();
+    if (!recorder->isRunning()) {
+        recorder->start(QThread::LowPriority);
+    }
+}
+
+void ChannelEngine::stop()
+{
+    if (m_pttMonitorThread && m_pttMonitorThread->isRunning()) {
+        m_pttMonitorThread->stop();
+        m_pttMonitorThread->wait();
+    }
+
+    TelemetryService *telemetry = TelemetryService::instance();
+    if (telemetry->isRunning()) {
+        telemetry->stop();
+        telemetry->wait();
+    }
+
+    // 采样停止后写完剩余数据
+    TelemetryRecorder *recorder = TelemetryRecorder::instance();
+    if (recorder->isRunning()) {
+        recorder->stop();
+        recorder->wait();
+    }
+
+    // 退出前写入尚未落盘的日志
+    if (m_journalTimer->isActive()) {
+        m_journalTimer->stop();
+        saveJournal();
+    }
+
+    // 场景有修改时重新生成场景库缓存，下次启动直接映射
+    if (!m_scenarioLibrary->isCacheCurrent()) {
+        m_scenarioLibrary->writeCache();
+    }
+}
+
+void ChannelEngine::scheduleJournal()
+{
+    if (!m_journalTimer->isActive()) {
+        m_journalTimer->start();
+    }
+}
+
+void ChannelEngine::saveJournal()
+{
+    HardwareState state;
+    m_pttMonitorThread->committedState(&state.ptt, &state.dacChannels, &state.dacSelections);
+    if (state.dacChannels.isEmpty()) {
+        // 冷启动后PTT线程尚未下发过，DAC均未分配
+        state.dacChannels.fill(0, 4);
+        state.dacSelections.fill(0, 4);
+    }
+    state.channels = ChannelCacheManager::instance()->getAllChannelSettings();
+
+    state.shadowRegs.resize(FPGA_SHADOW_REG_NUM);
+    if (fpga_read_shadow_regs(state.shadowRegs.data()) != FPGA_OK) {
+        qDebug() << "[硬件日志] 读取影子寄存器失败，本次不写入";
+        return;
+    }
+
+    if (!m_journal.save(state)) {
+        qDebug() << "[硬件日志] 写入失败";
+    }
+}
+
+void ChannelEngine::recordAssignment()
+{
+    QVector<INT8> dacChannels;
+    m_pttMonitorThread->committedState(nullptr, &dacChannels, nullptr);
+    TelemetryRecorder::instance()->recordAssignment(dacChannels);
+}
+
+ConfigManager *ChannelEngine::configManager() const
+{
+    return m_configManager;
+}
+
+DatabaseManager *ChannelEngine::databaseManager() const
+{
+    return m_dbManager;
+}
+
+ScenarioLibrary *ChannelEngine::scenarioLibrary() const
+{
+    return m_scenarioLibrary;
+}
+
+PttMonitorThread *ChannelEngine::pttMonitorThread() const
+{
+    return m_pttMonitorThread;
+}
+
+//配置侦察设备信道参数
+void ChannelEngine::setJtCfg(int chl, const ChannelSetting &config)
+{
+    //衰减器
+    qDebug() << "[侦察设备配置] 开始配置侦察设备参数 - 信道:" << chl;
+    // 将侦察设备信道编号(7-10)转换为RS_JT_E索引(0-3)
+    int jtIndex = chl - 7;
+    int ret = set_jt_att_value((static_cast<RS_JT_E>(jtIndex)), config.signalAnt);
+    if (ret != FPGA_OK) {
+        qDebug() << "[侦察设备配置] 1、衰减器设置失败 - 信道:" << chl << " 错误码:" << ret;
+    } else {
+        qDebug() << "[侦察设备配置] 1、衰减器设置成功 - 信道:" << chl << " 值:" << config.signalAnt;
+    }
+}
+
+//配置干扰器信道参数
+void ChannelEngine::setGrCfg(int chl, const ChannelSetting &config)
+{
+    qDebug() << "[干扰器配置] 开始配置干扰器参数 - 信道:" << chl;
+    // 将干扰器信道编号(11-15)转换为GR_OUT_E索引(0-4)
+    int grIndex = chl - 11;
+    int ret = set_gr_att((static_cast<GR_OUT_E>(grIndex)), config.signalAnt);
+    if (ret != FPGA_OK) {
+        qDebug() << "[干扰器配置] 1、衰减器设置失败 - 信道:" << chl << " 错误码:" << ret;
+    } else {
+        qDebug() << "[干扰器配置] 1、衰减器设置成功 - 信道:" << chl << " 值:" << config.signalAnt;
+    }
+}
+
+void ChannelEngine::handleParameterChanged(int channelKey, const ChannelSetting &newSetting)
+{
+    qDebug() << "[参数变更处理] 收到参数变更通知 - 信道:" << channelKey;
+    if (IS_VALID_DYNAMIC_CHANNEL(channelKey)) { // DAC动态分配信道
+        // 处理参数变化，唤醒PTT监控线程
+        if (m_pttMonitorThread) {
+            m_pttMonitorThread->wakeUp();
+            qDebug() << "[参数变更处理] 1、DAC动态信道参数更新，唤醒PTT监控线程 - 信道:" << channelKey;
+        }
+    } else if (IS_VALID_RECON_CHANNEL(channelKey)) { // 侦察设备
+        qDebug() << "[参数变更处理] 1、侦察设备参数更新，准备配置硬件 - 信道:" << channelKey;
+        setJtCfg(channelKey, newSetting);
+        scheduleJournal();
+    } else if (IS_VALID_JAMMER(channelKey)) { // 干扰器
+        qDebug() << "[参数变更处理] 1、干扰器参数更新，准备配置硬件 - 信道:" << channelKey;
+        setGrCfg(channelKey, newSetting);
+        scheduleJournal();
+    } else {
+        qDebug() << "[参数变更处理] 1、无效信道参数更新 - 信道:" << channelKey;
+    }
+}
+
+void ChannelEngine::handleParametersBatchChanged(const QList<int> &channelKeys)
+{
+    qDebug() << "[参数变更处理] 收到批量参数变更通知 - 信道:" << channelKeys;
+    // 批次由PTT监控线程从ChannelParamQueue取出写入缓存，DAC信道在同一轮已下发，这里不再唤醒
+    bool hwChanged = false;
+    for (int channelKey : channelKeys) {
+        if (IS_VALID_RECON_CHANNEL(channelKey)) { // 侦察设备
+            setJtCfg(channelKey, ChannelCacheManager::instance()->getChannelSetting(channelKey));
+            hwChanged = true;
+        } else if (IS_VALID_JAMMER(channelKey)) { // 干扰器
+            setGrCfg(channelKey, ChannelCacheManager::instance()->getChannelSetting(channelKey));
+            hwChanged = true;
+        }
+    }
+
+    if (hwChanged) {
+        scheduleJournal();
+    }
+}
+
+// 控制侦察设备的开关状态
+int ChannelEngine::setReconSw(int chl, bool flag)
+{
+    qDebug() << "[侦察设备配置] 开始设置侦察设备开关状态 - 信道:" << chl;
+    // 将侦察设备信道编号(7-10)转换为RS_JT_E索引(0-3)
+    int jtIndex = chl - 7;
+    int retsw = set_jt_sw(static_cast<RS_JT_E>(jtIndex), flag);
+
+    if (retsw != FPGA_OK) {
+        qDebug() << "[侦察设备配置] 1、开关状态设置失败 - 信道:" << chl << " 错误码:" << retsw;
+    } else {
+        qDebug() << "[侦察设备配置] 1、开关状态设置成功 - 信道:" << chl << " 值:" << flag;
+    }
+
+    return retsw;
+}
+
+// 控制干扰器的开关状态
+int ChannelEngine::setJammerSw(int chl, bool flag)
+{
+    qDebug() << "[干扰器配置] 开始设置干扰器开关状态 - 信道:" << chl;
+    // 将干扰器信道编号(11-15)转换为GR_OUT_E索引(0-4)
+    int grIndex = chl - 11;
+    int retsw = set_gr_sw(static_cast<GR_OUT_E>(grIndex), flag);
+
+    if (retsw != FPGA_OK) {
+        qDebug() << "[干扰器配置] 1、开关状态设置失败 - 信道:" << chl << " 错误码:" << retsw;
+    } else {
+        qDebug() << "[干扰器配置] 1、开关状态设置成功 - 信道:" << chl << " 值:" << flag;
+    }
+
+    return retsw;
+}
+
+void ChannelEngine::onChannelSwitchChanged(int channelNum, bool switchFlag)
+{
+    qDebug() << "接收到通道开关状态变化信号: channel=" << channelNum << ", switchFlag=" << switchFlag;
+    // 信道开关控制
+    if (IS_VALID_DYNAMIC_CHANNEL(channelNum)) { // DAC动态分配信道
+        // 处理参数变化，唤醒PTT监控线程
+        if (m_pttMonitorThread) {
+            m_pttMonitorThread->wakeUp();
+            qDebug() << "开关状态变化，唤醒PTT监控线程,信道编号:" << channelNum;
+        }
+    } else if (IS_VALID_RECON_CHANNEL(channelNum)) { // 侦察设备
+        setReconSw(channelNum, switchFlag);
+        scheduleJournal();
+    } else if (IS_VALID_JAMMER(channelNum)) { // 干扰器
+        setJammerSw(channelNum, switchFlag);
+        scheduleJournal();
+    }
+}
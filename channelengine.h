@@ -0,0 +1,78 @@
+#ifndef CHANNELENGINE_H
+#define CHANNELENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include "configmanager.h"
+#include "databasemanager.h"
+#include "PttMonitorThread.h"
+#include "channelcachemanager.h"
+#include "hardwarejournal.h"
+#include "scenariolibrary.h"
+
+// 信道引擎：FPGA初始化、PTT监控线程、场景数据库以及侦察/干扰通道的硬件配置
+// 不依赖任何界面，界面程序和无界面守护进程共用
+class ChannelEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChannelEngine(QObject *parent = nullptr);
+    ~ChannelEngine();
+
+    // 按ChannelSettings.ini的[Realtime]配置锁定进程内存(mlockall，对所有线程生效)
+    // 在启动任何线程之前调用一次，未启用时不做任何事
+    static void lockProcessMemory();
+
+    // 初始化fpga及干扰器、侦察设备的输出选择，失败时返回false并给出错误描述
+    // 硬件状态日志与影子寄存器一致时热重启：不复位硬件，由构造函数恢复缓存和DAC分配
+    static bool initFpga(QString *errorMessage = nullptr);
+
+    // 打开场景数据库并加载场景摘要，完整参数由ScenarioLibrary按需读取
+    bool initDataBase(const QString &dbName, QString *errorMessage = nullptr);
+
+    // 启动/停止PTT监控线程
+    void start();
+    void stop();
+
+    ConfigManager *configManager() const;
+    DatabaseManager *databaseManager() const;
+    ScenarioLibrary *scenarioLibrary() const;
+    PttMonitorThread *pttMonitorThread() const;
+
+public slots:
+    // 处理参数变化信号的槽函数
+    void handleParameterChanged(int channelKey, const ChannelSetting &newSetting);
+    // 处理批量参数变化：配置其中的侦察设备和干扰器信道
+    void handleParametersBatchChanged(const QList<int> &channelKeys);
+    // 处理通道开关状态变化信号的槽函数
+    void onChannelSwitchChanged(int channelNum, bool switchFlag);
+
+private slots:
+    // 合并短时间内的多次提交，写一次硬件状态日志
+    void scheduleJournal();
+    void saveJournal();
+    // 记录DAC信道分配变化到遥测历史
+    void recordAssignment();
+
+private:
+    // 控制侦察设备的开关状态
+    int setReconSw(int chl, bool flag);
+    // 控制干扰器的开关状态
+    int setJammerSw(int chl, bool flag);
+    //配置侦察设备信道参数
+    void setJtCfg(int chl, const ChannelSetting &config);
+    //配置干扰器信道参数
+    void setGrCfg(int chl, const ChannelSetting &config);
+
+    ConfigManager *m_configManager;
+    DatabaseManager *m_dbManager;
+    ScenarioLibrary *m_scenarioLibrary;
+    PttMonitorThread *m_pttMonitorThread;
+
+    HardwareJournal m_journal;
+    QTimer *m_journalTimer;
+};
+
+#endif // CHANNELENGINE_H
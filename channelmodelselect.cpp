@@ -1,5 +1,6 @@
 #include "channelmodelselect.h"
 #include <QDialogButtonBox>
+#include <algorithm>
 
 // AddSceneDialog 实现
 AddSceneDialog::AddSceneDialog(QWidget *parent)
@@ -91,9 +92,117 @@ AddSceneDialog::AddSceneDialog(QWidget *parent)
     m_nameLineEdit->setFocus();
 }
 
+ScenarioListModel::ScenarioListModel(const ScenarioIndex *index, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_index(index)
+{
+}
+
+int ScenarioListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_positions.size();
+}
+
+QVariant ScenarioListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_positions.size()) {
+        return QVariant();
+    }
+
+    const ScenarioSummary &summary = m_index->summary(m_positions.at(index.row()));
+    switch (role) {
+    case Qt::DisplayRole:
+        return summary.modelName;
+    case Qt::ToolTipRole:
+        if (m_descriptions.contains(summary.modelName)) {
+            return m_descriptions.value(summary.modelName);
+        }
+        return QString("信道%1，%2条多径，最大频移%3")
+                .arg(summary.channelNum).arg(summary.multipathNum).arg(summary.maxDoppler);
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+void ScenarioListModel::setQuery(const ScenarioQuery &query)
+{
+    beginResetModel();
+    m_query = query;
+    m_positions = m_index->search(query);
+    endResetModel();
+}
+
+void ScenarioListModel::positionInserted(int position)
+{
+    int row = int(std::lower_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin());
+    for (int i = row; i < m_positions.size(); i++) {
+        ++m_positions[i];
+    }
+    if (m_index->matches(position, m_query)) {
+        beginInsertRows(QModelIndex(), row, row);
+        m_positions.insert(row, position);
+        endInsertRows();
+    }
+}
+
+void ScenarioListModel::positionRemoved(int position)
+{
+    int row = int(std::lower_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin());
+    bool shown = row < m_positions.size() && m_positions.at(row) == position;
+    if (shown) {
+        beginRemoveRows(QModelIndex(), row, row);
+        m_positions.remove(row);
+    }
+    for (int i = row; i < m_positions.size(); i++) {
+        --m_positions[i];
+    }
+    if (shown) {
+        endRemoveRows();
+    }
+}
+
+void ScenarioListModel::positionUpdated(int position)
+{
+    int row = rowOf(position);
+    bool match = m_index->matches(position, m_query);
+    if (row >= 0 && match) {
+        emit dataChanged(index(row), index(row));
+    } else if (row >= 0) {
+        beginRemoveRows(QModelIndex(), row, row);
+        m_positions.remove(row);
+        endRemoveRows();
+    } else if (match) {
+        row = int(std::lower_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin());
+        beginInsertRows(QModelIndex(), row, row);
+        m_positions.insert(row, position);
+        endInsertRows();
+    }
+}
+
+int ScenarioListModel::positionAt(int row) const
+{
+    return (row >= 0 && row < m_positions.size()) ? m_positions.at(row) : -1;
+}
+
+int ScenarioListModel::rowOf(int position) const
+{
+    auto it = std::lower_bound(m_positions.begin(), m_positions.end(), position);
+    return (it != m_positions.end() && *it == position) ? int(it - m_positions.begin()) : -1;
+}
+
+void ScenarioListModel::setDescription(const QString &name, const QString &description)
+{
+    m_descriptions.insert(name, description);
+}
+
+void ScenarioListModel::removeDescription(const QString &name)
+{
+    m_descriptions.remove(name);
+}
+
 ChannelModelSelect::ChannelModelSelect(QWidget *parent)
     : QWidget(parent)
-    , m_radioButtonCounter(0)
 {
 #if 0
     m_modelTitle = {
@@ -131,21 +240,18 @@ ChannelModelSelect::ChannelModelSelect(QWidget *parent)
 
     setupUI();
 
-    // 创建初始的7个单选按钮
+    // 创建初始的7个预设场景
     for (int i = 0; i < PROTECTED_BUTTON_COUNT; ++i) {
-        createRadioButton(m_modelTitle[i], m_modelTips[i], true);
+        ScenarioSummary summary;
+        summary.modelName = m_modelTitle[i];
+        insertScenario(summary, m_modelTips[i], true);
     }
 
-    reorganizeLayout();
     updateButtonStates();
-    setupButtonTooltips(); // 设置按钮提示
 }
 
 ChannelModelSelect::~ChannelModelSelect()
 {
-    for (auto layout : m_columnLayouts) {
-        delete layout;
-    }
 }
 
 void ChannelModelSelect::setupUI()
@@ -190,50 +296,56 @@ void ChannelModelSelect::setupUI()
             margin: 4px 0px;  /* 添加边距 */
         }
 
-        /* RadioButton样式 */
-        QRadioButton {
-            spacing: 4px;  /* 2px -> 4px */
+        /* 场景列表样式 */
+        QListView {
             color: #4CAF50;
             font-family: "Microsoft YaHei";
-            font-size: 16px;  /* 14px -> 16px */
+            font-size: 16px;
             font-weight: bold;
             background-color: transparent;
             border: none;
-            padding: 8px 12px;  /* 6px 10px -> 8px 12px */
-            border-radius: 6px;  /* 4px -> 6px */
-            margin: 4px 0px;  /* 2px 0px -> 4px 0px */
+            outline: none;
         }
 
-        QRadioButton:hover {
-            background-color: #224444;
-            color: #CCEEEE;
+        QListView::item {
+            padding: 8px 12px;
+            margin: 4px 4px;
+            border: 3px solid transparent;
+            border-radius: 6px;
         }
 
-        QRadioButton::indicator {
-            width: 16px;  /* 12px -> 16px */
-            height: 16px;  /* 12px -> 16px */
-            border-radius: 3px;  /* 2px -> 3px */
-            border: 3px solid #00C6FF;  /* 2px -> 3px */
-            background-color: #336666;
+        QListView::item:hover {
+            background-color: #224444;
+            color: #CCEEEE;
         }
 
-        QRadioButton::indicator:checked {
-            background-color: #00C6FF;
-            border: 3px solid #00C6FF;  /* 2px -> 3px */
+        QListView::item:selected {
+            background-color: #224444;
+            color: #00C6FF;
+            border: 3px solid #00C6FF;
         }
 
-        QRadioButton::indicator:unchecked {
-            background-color: #336666;
-            border: 3px solid #99CCCC;  /* 2px -> 3px */
+        /* 检索条件样式 */
+        QLineEdit, QSpinBox {
+            padding: 4px 8px;
+            border: 2px solid #559999;
+            border-radius: 6px;
+            background-color: #224444;
+            color: #CCEEEE;
+            font-family: "Microsoft YaHei";
+            font-size: 14px;
+            min-height: 28px;
         }
 
-        QRadioButton::indicator:checked:hover {
-            background-color: #CCEEEE;
-            border: 3px solid #CCEEEE;  /* 2px -> 3px */
+        QLineEdit:focus, QSpinBox:focus {
+            border: 2px solid #66AAAA;
         }
 
-        QRadioButton::indicator:unchecked:hover {
-            border: 3px solid #CCEEEE;  /* 2px -> 3px */
+        QCheckBox {
+            color: #99CCCC;
+            font-family: "Microsoft YaHei";
+            font-size: 14px;
+            font-weight: bold;
         }
 
         /* 按钮样式 */
@@ -361,136 +473,140 @@ void ChannelModelSelect::setupUI()
     controlLayout->addStretch();
     controlLayout->addLayout(buttonLayout);
 
-    // 添加垂直分隔线
-    QFrame *verticalLine = new QFrame();
-    verticalLine->setFrameShape(QFrame::VLine);
-    verticalLine->setFrameShadow(QFrame::Sunken);
-    verticalLine->setStyleSheet("background-color: #559999; min-width: 2px; max-width: 2px; margin: 0px 15px;");
-
-    // === 单选按钮区域 - 占4份 ===
-    QWidget *radioWidget = new QWidget();
-    QVBoxLayout *radioWidgetLayout = new QVBoxLayout(radioWidget);
-    radioWidgetLayout->setContentsMargins(0, 0, 0, 0);
-
-    // 单选按钮容器
-    m_radioButtonContainer = new QWidget();
-    m_radioButtonLayout = new QHBoxLayout(m_radioButtonContainer);
-    m_radioButtonLayout->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-    m_radioButtonLayout->setSpacing(10);
-
-    radioWidgetLayout->addWidget(m_radioButtonContainer);
+    // === 场景列表区域 - 占6份 ===
+    QWidget *listWidget = new QWidget();
+    QVBoxLayout *listWidgetLayout = new QVBoxLayout(listWidget);
+    listWidgetLayout->setContentsMargins(0, 0, 0, 0);
+    listWidgetLayout->setSpacing(6);
+
+    listWidgetLayout->addWidget(createFilterBar());
+
+    // 场景按列排列，每列自上而下，超出宽度时横向滚动
+    // 行高一致，布局不逐项计算尺寸；只绘制可见的场景
+    m_listModel = new ScenarioListModel(&m_index, this);
+    m_listView = new QListView();
+    m_listView->setModel(m_listModel);
+    m_listView->setFlow(QListView::TopToBottom);
+    m_listView->setWrapping(true);
+    m_listView->setResizeMode(QListView::Adjust);
+    m_listView->setUniformItemSizes(true);
+    m_listView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_listView->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    connect(m_listView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &ChannelModelSelect::updateButtonStates);
+    listWidgetLayout->addWidget(m_listView, 1);
 
     // 添加到主水平布局
-    mainGroupLayout->addWidget(radioWidget);
-    //mainGroupLayout->addWidget(verticalLine);
+    mainGroupLayout->addWidget(listWidget);
     mainGroupLayout->addWidget(controlWidget);
 
-    // 设置比例：控制区域1份，单选按钮区域4份
-    mainGroupLayout->setStretchFactor(radioWidget, 6);
+    // 设置比例：控制区域1份，场景列表区域6份
+    mainGroupLayout->setStretchFactor(listWidget, 6);
     mainGroupLayout->setStretchFactor(controlWidget, 1);
 
     m_mainLayout->addWidget(m_mainGroup);
     setLayout(m_mainLayout);
-
-    // 创建按钮组
-    m_buttonGroup = new QButtonGroup(this);
-    m_buttonGroup->setExclusive(true);
-
 }
 
-void ChannelModelSelect::createRadioButton(const QString &text, const QString &tooltip, bool isProtected)
+QWidget *ChannelModelSelect::createFilterBar()
 {
-    QString buttonText = text.isEmpty() ? QString("场景 %1").arg(++m_radioButtonCounter) : text;
-
-    QRadioButton *radioButton = new QRadioButton(buttonText);
-    radioButton->setObjectName(buttonText);
-
-    // 设置受保护属性
-    if (isProtected) {
-        radioButton->setProperty("protected", true);
-        m_protectedButtons.push_back(radioButton);
+    QWidget *filterBar = new QWidget();
+    QGridLayout *filterLayout = new QGridLayout(filterBar);
+    filterLayout->setContentsMargins(0, 0, 0, 0);
+    filterLayout->setHorizontalSpacing(6);
+    filterLayout->setVerticalSpacing(4);
+
+    // 名称检索
+    m_searchEdit = new QLineEdit();
+    m_searchEdit->setPlaceholderText("搜索场景名称");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_prefixCheck = new QCheckBox("前缀");
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &ChannelModelSelect::applyQuery);
+    connect(m_prefixCheck, &QCheckBox::toggled, this, &ChannelModelSelect::applyQuery);
+    filterLayout->addWidget(m_searchEdit, 0, 0, 1, 8);
+    filterLayout->addWidget(m_prefixCheck, 0, 8);
+
+    // 数值范围，"不限"表示该端不限
+    m_channelMin = createRangeSpinBox(15);
+    m_channelMax = createRangeSpinBox(15);
+    m_pathMin = createRangeSpinBox(99);
+    m_pathMax = createRangeSpinBox(99);
+    m_dopplerMin = createRangeSpinBox(100000);
+    m_dopplerMax = createRangeSpinBox(100000);
+
+    struct RangeRow { const char *title; QSpinBox *min; QSpinBox *max; };
+    const RangeRow rows[] = {
+        {"信道", m_channelMin, m_channelMax},
+        {"多径", m_pathMin, m_pathMax},
+        {"频移", m_dopplerMin, m_dopplerMax},
+    };
+    int column = 0;
+    for (const RangeRow &row : rows) {
+        filterLayout->addWidget(new QLabel(row.title), 1, column++);
+        filterLayout->addWidget(row.min, 1, column++);
+        filterLayout->addWidget(row.max, 1, column++);
     }
 
-    m_buttonGroup->addButton(radioButton);
-    m_buttonTooltips[radioButton] = tooltip;
-
-    connect(radioButton, &QRadioButton::toggled, this, &ChannelModelSelect::updateButtonStates);
+    return filterBar;
 }
 
-void ChannelModelSelect::reorganizeLayout()
+QSpinBox *ChannelModelSelect::createRangeSpinBox(int maximum)
 {
-    // 清空所有列布局
-    for (auto layout : m_columnLayouts) {
-        QLayoutItem* item;
-        while ((item = layout->takeAt(0)) != nullptr) {
-            delete item;
-        }
-        delete layout;
-    }
-    m_columnLayouts.clear();
-
-    // 清空主布局中的所有列
-    QLayoutItem* item;
-    while ((item = m_radioButtonLayout->takeAt(0)) != nullptr) {
-        delete item;
-    }
-
-    // 获取所有单选按钮
-    QList<QAbstractButton*> abstractButtons = m_buttonGroup->buttons();
-    QList<QRadioButton*> buttons;
-    for (QAbstractButton* abstractButton : abstractButtons) {
-        QRadioButton* radioButton = qobject_cast<QRadioButton*>(abstractButton);
-        if (radioButton) {
-            buttons.append(radioButton);
-        }
-    }
-
-    int totalButtons = buttons.size();
-
-    // 计算需要多少列
-    int numColumns = (totalButtons + MAX_ROWS_PER_COLUMN - 1) / MAX_ROWS_PER_COLUMN;
+    QSpinBox *spinBox = new QSpinBox();
+    spinBox->setRange(-1, maximum);
+    spinBox->setValue(-1);
+    spinBox->setSpecialValueText("不限");
+    connect(spinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &ChannelModelSelect::applyQuery);
+    return spinBox;
+}
 
-    // 创建列布局
-    for (int col = 0; col < numColumns; ++col) {
-        QVBoxLayout *columnLayout = new QVBoxLayout();
-        columnLayout->setAlignment(Qt::AlignTop);
-        columnLayout->setSpacing(2);
-        m_columnLayouts.push_back(columnLayout);
+void ChannelModelSelect::applyQuery()
+{
+    auto readRange = [](QSpinBox *min, QSpinBox *max) {
+        ValueRange range;
+        if (min->value() >= 0) range.setMin(min->value());
+        if (max->value() >= 0) range.setMax(max->value());
+        return range;
+    };
 
-        // 添加列布局到主水平布局
-        m_radioButtonLayout->addLayout(columnLayout);
+    ScenarioQuery query;
+    query.text = m_searchEdit->text().trimmed();
+    query.prefixOnly = m_prefixCheck->isChecked();
+    query.channelNum = readRange(m_channelMin, m_channelMax);
+    query.multipathNum = readRange(m_pathMin, m_pathMax);
+    query.maxDoppler = readRange(m_dopplerMin, m_dopplerMax);
+
+    // 重置模型会清空选中，检索后恢复
+    QString selected = m_selectedName;
+    m_listModel->setQuery(query);
+    selectScenario(selected);
+    updateButtonStates();
+}
 
-        // 设置列间距，除了最后一列
-        if (col < numColumns - 1) {
-            m_radioButtonLayout->addSpacing(2);
-        }
+void ChannelModelSelect::insertScenario(const ScenarioSummary &summary, const QString &description, bool isProtected)
+{
+    if (!m_index.insert(summary)) {
+        return;
     }
-
-    // 将单选按钮分配到各列
-    for (int i = 0; i < totalButtons; ++i) {
-        int col = i / MAX_ROWS_PER_COLUMN;
-        int row = i % MAX_ROWS_PER_COLUMN;
-
-        if (col < m_columnLayouts.size()) {
-            m_columnLayouts[col]->addWidget(buttons[i]);
-        }
+    if (!description.isEmpty()) {
+        m_listModel->setDescription(summary.modelName, description);
     }
-
-    // 在各列中添加弹性空间，使内容靠上对齐
-    for (auto columnLayout : m_columnLayouts) {
-        columnLayout->addStretch();
+    if (isProtected) {
+        m_protectedNames.insert(summary.modelName);
     }
+    m_listModel->positionInserted(m_index.indexOf(summary.modelName));
 }
 
-void ChannelModelSelect::setupButtonTooltips()
+void ChannelModelSelect::selectScenario(const QString &name)
 {
-    for (auto& pair : m_buttonTooltips) {
-        QRadioButton* button = pair.first;
-        const QString& tooltip = pair.second;
-        if (!tooltip.isEmpty()) {
-            button->setToolTip(tooltip);
-        }
+    int row = m_listModel->rowOf(m_index.indexOf(name));
+    if (row < 0) {
+        return;
     }
+    QModelIndex index = m_listModel->index(row);
+    m_listView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+    m_listView->scrollTo(index);
 }
 
 void ChannelModelSelect::addRadioButton()
@@ -506,56 +622,72 @@ void ChannelModelSelect::addRadioButton()
             QMessageBox::warning(this, "输入错误", "场景名称不能为空！");
             return;
         }
+        if (m_index.contains(sceneName)) {
+            QMessageBox::warning(this, "输入错误", "场景名称已存在！");
+            return;
+        }
 
-        createRadioButton(sceneName, sceneDescription, false);
-
-        // 重新组织布局
-        reorganizeLayout();
-        setupButtonTooltips();
-        updateButtonStates();
+        ScenarioSummary summary;
+        summary.modelName = sceneName;
+        insertScenario(summary, sceneDescription, false);
+        selectScenario(sceneName);
     }
 
-    // 重新组织布局
-    reorganizeLayout();
-    setupButtonTooltips();
     updateButtonStates();
 }
 
-void ChannelModelSelect::deleteSelectedRadioButton()
+void ChannelModelSelect::addScenarios(const QVector<ScenarioSummary> &summaries)
 {
-    QRadioButton *selectedButton = nullptr;
+    if (summaries.isEmpty()) {
+        return;
+    }
 
-    QList<QAbstractButton*> abstractButtons = m_buttonGroup->buttons();
-    for (QAbstractButton* abstractButton : abstractButtons) {
-        QRadioButton* button = qobject_cast<QRadioButton*>(abstractButton);
-        if (button && button->isChecked()) {
-            selectedButton = button;
-            break;
-        }
+    // 批量添加时一次建索引、一次重置列表；已有场景在前，重名的保留已有的
+    QVector<ScenarioSummary> all;
+    all.reserve(m_index.size() + summaries.size());
+    for (int i = 0; i < m_index.size(); i++) {
+        all.append(m_index.summary(i));
     }
+    all += summaries;
+    m_index.reset(all);
+    applyQuery();
+}
 
-    if (selectedButton) {
-        // 检查是否是受保护的按钮
-        if (std::find(m_protectedButtons.begin(), m_protectedButtons.end(), selectedButton) != m_protectedButtons.end()) {
-            QMessageBox::information(this, "提示", "这是系统预设场景，不可删除。");
-            return;
-        }
+void ChannelModelSelect::updateScenario(const ScenarioSummary &summary)
+{
+    if (m_index.update(summary)) {
+        m_listModel->positionUpdated(m_index.indexOf(summary.modelName));
+    } else {
+        insertScenario(summary, QString(), false);
+    }
+}
 
-        // 从按钮组中移除
-        m_buttonGroup->removeButton(selectedButton);
+void ChannelModelSelect::removeScenario(const QString &name)
+{
+    if (m_protectedNames.contains(name)) {
+        return;
+    }
+    int position = m_index.remove(name);
+    if (position < 0) {
+        return;
+    }
+    m_listModel->removeDescription(name);
+    m_listModel->positionRemoved(position);
+    updateButtonStates();
+}
 
-        // 从tooltip映射中移除
-        auto tooltipIt = m_buttonTooltips.find(selectedButton);
-        if (tooltipIt != m_buttonTooltips.end()) {
-            m_buttonTooltips.erase(tooltipIt);
-        }
+void ChannelModelSelect::deleteSelectedRadioButton()
+{
+    QString selectedName = getSelectedRadioButtonName();
 
-        // 删除对象
-        selectedButton->deleteLater();
+    if (!selectedName.isEmpty()) {
+        // 检查是否是受保护的场景
+        if (m_protectedNames.contains(selectedName)) {
+            QMessageBox::information(this, "提示", "这是系统预设场景，不可删除。");
+            return;
+        }
 
-        // 重新组织布局
-        reorganizeLayout();
-        updateButtonStates();
+        removeScenario(selectedName);
     } else {
         QMessageBox::information(this, "提示", "请先选择一个要删除的场景。");
     }
@@ -563,59 +695,30 @@ void ChannelModelSelect::deleteSelectedRadioButton()
 
 void ChannelModelSelect::updateButtonStates()
 {
-    QRadioButton *selectedButton = nullptr;
-
-    QList<QAbstractButton*> abstractButtons = m_buttonGroup->buttons();
-    for (QAbstractButton* abstractButton : abstractButtons) {
-        QRadioButton* button = qobject_cast<QRadioButton*>(abstractButton);
-        if (button && button->isChecked()) {
-            selectedButton = button;
-            break;
-        }
-    }
-
-    // 如果选中的是受保护按钮，禁用删除按钮
-    if (selectedButton) {
-        bool isProtected = std::find(m_protectedButtons.begin(), m_protectedButtons.end(), selectedButton) != m_protectedButtons.end();
-        m_deleteButton->setEnabled(!isProtected);
-    } else {
-        m_deleteButton->setEnabled(false);
+    // 只在有可见选中项时记录，检索隐藏选中项时保留原名称
+    QString selectedName = getSelectedRadioButtonName();
+    if (!selectedName.isEmpty()) {
+        m_selectedName = selectedName;
+    } else if (!m_index.contains(m_selectedName)) {
+        m_selectedName.clear();
     }
 
-    m_deleteButton->setEnabled(selectedButton != nullptr);
+    m_deleteButton->setEnabled(!selectedName.isEmpty());
     m_addButton->setEnabled(true);
 }
 
 QString ChannelModelSelect::getSelectedRadioButtonName() const
 {
-    // 获取当前选中的单选按钮
-    QAbstractButton* checkedButton = m_buttonGroup->checkedButton();
-
-    if (checkedButton) {
-        // 转换为 QRadioButton 并获取对象名称
-        QRadioButton* radioButton = qobject_cast<QRadioButton*>(checkedButton);
-        if (radioButton) {
-            return radioButton->objectName();
-        }
+    // 当前选中的场景，被检索条件隐藏的不算
+    QModelIndexList selected = m_listView->selectionModel()->selectedIndexes();
+    if (selected.isEmpty()) {
+        return QString();
     }
-
-    // 如果没有选中的按钮，返回空字符串
-    return QString();
+    return m_index.summary(m_listModel->positionAt(selected.first().row())).modelName;
 }
 
 QString ChannelModelSelect::getSelectedRadioButtonText() const
 {
-    // 获取当前选中的单选按钮
-    QAbstractButton* checkedButton = m_buttonGroup->checkedButton();
-
-    if (checkedButton) {
-        // 转换为 QRadioButton 并获取显示文本
-        QRadioButton* radioButton = qobject_cast<QRadioButton*>(checkedButton);
-        if (radioButton) {
-            return radioButton->text();
-        }
-    }
-
-    // 如果没有选中的按钮，返回空字符串
-    return QString();
+    // 显示文本即场景名称
+    return getSelectedRadioButtonName();
 }
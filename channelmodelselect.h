@@ -2,19 +2,22 @@
 #define CHANNELMODELSELECT_H
 
 #include <QWidget>
-#include <QButtonGroup>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
-#include <QRadioButton>
 #include <QPushButton>
 #include <QLabel>
 #include <QGroupBox>
 #include <QLineEdit>
-#include <QScrollArea>
+#include <QListView>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QAbstractListModel>
 #include <QMessageBox>
 #include <QFrame>
-#include <vector>
+#include <QSet>
+#include "databasemanager.h"
+#include "scenarioindex.h"
 
 // 添加场景对话框
 class AddSceneDialog : public QDialog
@@ -31,6 +34,39 @@ private:
     QLineEdit *m_descLineEdit;
 };
 
+// 场景列表模型：只保存检索结果在索引中的位置，QListView只绘制可见行，不为场景创建控件
+class ScenarioListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ScenarioListModel(const ScenarioIndex *index, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // 按条件重新检索
+    void setQuery(const ScenarioQuery &query);
+
+    // 索引增删后调用，只通知变化的一行
+    void positionInserted(int position);
+    void positionRemoved(int position);
+    void positionUpdated(int position);
+
+    int positionAt(int row) const;
+    int rowOf(int position) const;
+
+    // 场景备注，显示为提示信息；未设置时显示场景参数
+    void setDescription(const QString &name, const QString &description);
+    void removeDescription(const QString &name);
+
+private:
+    const ScenarioIndex *m_index;
+    ScenarioQuery m_query;
+    QVector<int> m_positions;      // 升序
+    QHash<QString, QString> m_descriptions;
+};
+
 class ChannelModelSelect : public QWidget
 {
     Q_OBJECT
@@ -39,49 +75,60 @@ public:
     ChannelModelSelect(QWidget *parent = nullptr);
     ~ChannelModelSelect();
 
-    //获取当前选中的单选按钮名称
+    //获取当前选中的场景名称
     QString getSelectedRadioButtonName() const;
     QString getSelectedRadioButtonText() const; // 可选：获取显示文本
 
+    // 添加场景库中的场景，已存在的名称跳过
+    void addScenarios(const QVector<ScenarioSummary> &summaries);
+    // 场景库保存场景后调用：已存在时更新参数，否则添加
+    void updateScenario(const ScenarioSummary &summary);
+    // 场景库删除场景后调用，预设场景不删除
+    void removeScenario(const QString &name);
+
 private slots:
     void addRadioButton();
     void deleteSelectedRadioButton();
     void updateButtonStates();
+    // 检索条件变化时重新检索
+    void applyQuery();
 
 private:
     void setupUI();
-    void createRadioButton(const QString &text, const QString &tooltip = "", bool isProtected = false);
-    void reorganizeLayout(); // 重新组织布局
-    void setupButtonTooltips(); // 设置按钮提示信息
+    QWidget *createFilterBar();
+    QSpinBox *createRangeSpinBox(int maximum);
+    void insertScenario(const ScenarioSummary &summary, const QString &description, bool isProtected);
+    void selectScenario(const QString &name);
 
     QVBoxLayout *m_mainLayout;
 
     // 主GroupBox
     QGroupBox *m_mainGroup;
-    QHBoxLayout *m_mainGroupLayout;
-
-    // 标题区域
-    QLabel *m_titleLabel;
 
-    QVBoxLayout *m_controlLayout;
-    QLineEdit *m_inputLineEdit;
     QPushButton *m_addButton;
     QPushButton *m_deleteButton;
 
-    // 单选按钮区域
-    QWidget *m_radioButtonContainer;
-    QHBoxLayout *m_radioButtonLayout;
-    std::vector<QVBoxLayout*> m_columnLayouts;
+    // 检索条件
+    QLineEdit *m_searchEdit;
+    QCheckBox *m_prefixCheck;
+    QSpinBox *m_channelMin;
+    QSpinBox *m_channelMax;
+    QSpinBox *m_pathMin;
+    QSpinBox *m_pathMax;
+    QSpinBox *m_dopplerMin;
+    QSpinBox *m_dopplerMax;
+
+    // 场景列表
+    ScenarioIndex m_index;
+    ScenarioListModel *m_listModel;
+    QListView *m_listView;
+    QString m_selectedName;         // 检索后仍在结果中时恢复选中
 
-    QButtonGroup *m_buttonGroup;
     QVector<QString> m_modelTitle;
     QVector<QString> m_modelTips;
-    std::map<QRadioButton*, QString> m_buttonTooltips; // 存储按钮和对应的备注信息
-    std::vector<QRadioButton*> m_protectedButtons; // 受保护的按钮（前7个）
+    QSet<QString> m_protectedNames; // 受保护的场景（前7个）
 
-    int m_radioButtonCounter;
-    const int MAX_ROWS_PER_COLUMN = 5; // 每列最大行数
-    const int PROTECTED_BUTTON_COUNT = 7; // 前7个按钮受保护
+    const int PROTECTED_BUTTON_COUNT = 7; // 前7个场景受保护
 };
 
 #endif // CHANNELMODELSELECT_H
@@ -48,13 +48,8 @@ void ChannelParaConifg::getRadioConfig()
     //打桩函数
     for(i = 1; i <= 4; i++)
     {
-        RadioStatus radiostatus;
-        radiostatus.radioState = RADIO_TRANSMIT;
-        radiostatus.txPower = 12;
-        {
-            QMutexLocker locker(&globalMutex);
-            globalStatusMap.insert(i, radiostatus);
-        }
+        RadioStatusBoard::instance()->setState(i, RADIO_TRANSMIT);
+        RadioStatusBoard::instance()->setTxPower(i, 12);
     }
 
 #if 0
@@ -0,0 +1,119 @@
+#include "channelparamqueue.h"
+#include <QThread>
+#include <time.h>
+#include "asynclogger.h"
+
+// 初始化静态成员变量
+ChannelParamQueue* ChannelParamQueue::m_instance = nullptr;
+QMutex ChannelParamQueue::m_instanceMutex;
+
+ChannelParamQueue::ChannelParamQueue()
+    : m_head(0)
+    , m_tail(0)
+    , m_notifier(nullptr)
+    , m_notifierUsers(0)
+    , m_latencyCount(0)
+    , m_latencySumUs(0)
+    , m_latencyLastUs(0)
+    , m_latencyMinUs(0)
+    , m_latencyMaxUs(0)
+{
+}
+
+ChannelParamQueue* ChannelParamQueue::instance()
+{
+    // 双重检查锁定模式，确保线程安全的单例实例创建
+    if (!m_instance) {
+        QMutexLocker locker(&m_instanceMutex);
+        if (!m_instance) {
+            m_instance = new ChannelParamQueue();
+        }
+    }
+    return m_instance;
+}
+
+bool ChannelParamQueue::push(const ChannelParamBatch& batch)
+{
+    quint32 tail = m_tail.load(std::memory_order_relaxed);
+    quint32 head = m_head.load(std::memory_order_acquire);
+    if (tail - head >= CAPACITY) {
+        return false;
+    }
+
+    m_slots[tail & (CAPACITY - 1)] = batch;
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    // 先登记再取函数指针，setNotifier替换后能看到本次调用
+    m_notifierUsers.fetch_add(1);
+    std::function<void()> *notifier = m_notifier.load();
+    if (notifier) {
+        (*notifier)();
+    }
+    m_notifierUsers.fetch_sub(1);
+    return true;
+}
+
+bool ChannelParamQueue::pop(ChannelParamBatch* batch)
+{
+    quint32 head = m_head.load(std::memory_order_relaxed);
+    quint32 tail = m_tail.load(std::memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+
+    ChannelParamBatch &slot = m_slots[head & (CAPACITY - 1)];
+    *batch = slot;
+    slot.settings.clear();
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void ChannelParamQueue::setNotifier(const std::function<void()>& notifier)
+{
+    std::function<void()> *next = notifier ? new std::function<void()>(notifier) : nullptr;
+    std::function<void()> *previous = m_notifier.exchange(next);
+
+    // 等待可能仍在调用旧函数的生产者返回，之后才能释放
+    while (m_notifierUsers.load() != 0) {
+        QThread::yieldCurrentThread();
+    }
+    delete previous;
+}
+
+void ChannelParamQueue::recordApplyLatency(qint64 receivedNs)
+{
+    qint64 latencyUs = (nowNs() - receivedNs) / 1000;
+    quint64 count = m_latencyCount.load(std::memory_order_relaxed);
+
+    m_latencyLastUs.store(latencyUs, std::memory_order_relaxed);
+    m_latencySumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    if (count == 0 || latencyUs < m_latencyMinUs.load(std::memory_order_relaxed)) {
+        m_latencyMinUs.store(latencyUs, std::memory_order_relaxed);
+    }
+    if (latencyUs > m_latencyMaxUs.load(std::memory_order_relaxed)) {
+        m_latencyMaxUs.store(latencyUs, std::memory_order_relaxed);
+    }
+    m_latencyCount.store(count + 1, std::memory_order_release);
+
+    LOG_DEBUG("mqtt", "[MQTT时延] 接收到下发完成: {}us", latencyUs);
+}
+
+ApplyLatencyStats ChannelParamQueue::latencyStats() const
+{
+    ApplyLatencyStats stats;
+    stats.count = m_latencyCount.load(std::memory_order_acquire);
+    stats.lastUs = m_latencyLastUs.load(std::memory_order_relaxed);
+    stats.minUs = m_latencyMinUs.load(std::memory_order_relaxed);
+    stats.maxUs = m_latencyMaxUs.load(std::memory_order_relaxed);
+    if (stats.count > 0) {
+        stats.avgUs = m_latencySumUs.load(std::memory_order_relaxed) / static_cast<qint64>(stats.count);
+    }
+    return stats;
+}
+
+qint64 ChannelParamQueue::nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
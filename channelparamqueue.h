@@ -0,0 +1,79 @@
+#ifndef CHANNELPARAMQUEUE_H
+#define CHANNELPARAMQUEUE_H
+
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <atomic>
+#include <functional>
+#include "channelcachemanager.h"
+
+// 一条信道参数消息解析出的整批信道参数
+struct ChannelParamBatch
+{
+    QString examID;
+    QList<ChannelSetting> settings;
+    qint64 receivedNs = 0;      // 收到消息的时刻(单调时钟ns)，用于统计接收到下发的时延
+};
+
+// 接收到下发的时延统计(us)
+struct ApplyLatencyStats
+{
+    quint64 count = 0;
+    qint64 lastUs = 0;
+    qint64 minUs = 0;
+    qint64 maxUs = 0;
+    qint64 avgUs = 0;
+};
+
+// MQTT线程到PTT监控线程的信道参数队列
+// 单生产者(MQTT线程)单消费者(PTT监控线程)无锁环形队列，入队后通过通知函数唤醒消费者
+class ChannelParamQueue
+{
+public:
+    static const quint32 CAPACITY = 64;     // 必须是2的幂
+
+    // 获取单例实例
+    static ChannelParamQueue* instance();
+
+    // 生产者：入队，队列满时返回false
+    bool push(const ChannelParamBatch& batch);
+
+    // 消费者：出队，队列空时返回false
+    bool pop(ChannelParamBatch* batch);
+
+    // 设置入队后的唤醒函数，传空函数取消；返回后不再有生产者调用旧函数
+    void setNotifier(const std::function<void()>& notifier);
+
+    // 消费者：记录一批参数从接收到下发完成的时延
+    void recordApplyLatency(qint64 receivedNs);
+    ApplyLatencyStats latencyStats() const;
+
+    // 单调时钟(ns)
+    static qint64 nowNs();
+
+private:
+    ChannelParamQueue();
+
+    // 单例实例
+    static ChannelParamQueue* m_instance;
+    static QMutex m_instanceMutex;
+
+    ChannelParamBatch m_slots[CAPACITY];
+    std::atomic<quint32> m_head;    // 消费者位置
+    std::atomic<quint32> m_tail;    // 生产者位置
+
+    // 唤醒函数在引擎创建/销毁时替换，入队线程不加锁读取
+    // m_notifierUsers为正在调用唤醒函数的生产者数，替换后等其归零再释放旧函数
+    std::atomic<std::function<void()>*> m_notifier;
+    std::atomic<int> m_notifierUsers;
+
+    // 时延统计只由消费者写
+    std::atomic<quint64> m_latencyCount;
+    std::atomic<qint64> m_latencySumUs;
+    std::atomic<qint64> m_latencyLastUs;
+    std::atomic<qint64> m_latencyMinUs;
+    std::atomic<qint64> m_latencyMaxUs;
+};
+
+#endif // CHANNELPARAMQUEUE_H
@@ -1,11 +1,126 @@
 #include "configmanager.h"
 #include <QDebug>
 #include <QMap>
+#include <QCoreApplication>
+#include "wakeupnotifier.h"
 
+RadioStatusBoard* RadioStatusBoard::m_instance = nullptr;
+QMutex RadioStatusBoard::m_instanceMutex;
 
-QMutex globalMutex;
-QMap<QString, ModelParaSetting>globalParaMap; // 定义全局 Map
-QMap<int, RadioStatus>globalStatusMap; // 定义全局 Map
+RadioStatusBoard::RadioStatusBoard()
+    : m_sequence(0)
+    , m_changedMask(0)
+    , m_notifyPending(0)
+{
+    for (int i = 0; i < RADIO_COUNT; i++) {
+        m_state[i].storeRelaxed(RADIO_DISABLE);
+        m_txPower[i].storeRelaxed(0);
+    }
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setSingleShot(true);
+    connect(m_frameTimer, &QTimer::timeout, this, &RadioStatusBoard::notify);
+
+    // PTT线程每次收发切换都会写状态，用eventfd唤醒代替投递排队调用，避免每帧分配事件对象
+    m_wakeup = new WakeupNotifier(this);
+    connect(m_wakeup, &WakeupNotifier::activated, this, &RadioStatusBoard::scheduleNotify);
+}
+
+RadioStatusBoard* RadioStatusBoard::instance()
+{
+    // 双重检查锁定模式，确保线程安全的单例实例创建
+    if (!m_instance) {
+        QMutexLocker locker(&m_instanceMutex);
+        if (!m_instance) {
+            m_instance = new RadioStatusBoard();
+            // 可能由PTT线程首次创建，通知统一在主线程发出
+            if (QCoreApplication::instance()) {
+                m_instance->moveToThread(QCoreApplication::instance()->thread());
+            }
+        }
+    }
+    return m_instance;
+}
+
+RadioStatus RadioStatusBoard::status(int radio) const
+{
+    RadioStatus status;
+    status.radioState = RADIO_DISABLE;
+    status.txPower = 0;
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return status;
+    }
+    status.radioState = static_cast<RadioState>(m_state[radio - 1].loadAcquire());
+    status.txPower = m_txPower[radio - 1].loadAcquire();
+    return status;
+}
+
+QMap<int, RadioStatus> RadioStatusBoard::snapshot() const
+{
+    QMap<int, RadioStatus> result;
+    for (int radio = 1; radio <= RADIO_COUNT; radio++) {
+        result.insert(radio, status(radio));
+    }
+    return result;
+}
+
+void RadioStatusBoard::setState(int radio, RadioState state)
+{
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return;
+    }
+    if (m_state[radio - 1].fetchAndStoreRelease(state) != state) {
+        markChanged(radio);
+    }
+}
+
+void RadioStatusBoard::setTxPower(int radio, int txPower)
+{
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return;
+    }
+    if (m_txPower[radio - 1].fetchAndStoreRelease(txPower) != txPower) {
+        markChanged(radio);
+    }
+}
+
+quint32 RadioStatusBoard::sequence() const
+{
+    return m_sequence.loadAcquire();
+}
+
+void RadioStatusBoard::markChanged(int radio)
+{
+    m_sequence.fetchAndAddRelease(1);
+    m_changedMask.fetchAndOrRelease(1u << (radio - 1));
+
+    // 一帧内的多次变化只唤醒一次
+    if (m_notifyPending.testAndSetAcquire(0, 1)) {
+        m_wakeup->notify();
+    }
+}
+
+void RadioStatusBoard::scheduleNotify()
+{
+    qint64 elapsed = m_lastNotify.isValid() ? m_lastNotify.elapsed() : FRAME_INTERVAL_MS;
+    if (elapsed >= FRAME_INTERVAL_MS) {
+        notify();
+    } else if (!m_frameTimer->isActive()) {
+        m_frameTimer->start(static_cast<int>(FRAME_INTERVAL_MS - elapsed));
+    }
+}
+
+void RadioStatusBoard::notify()
+{
+    // 先清除待发标志再取变化位，之后的变化会重新投递
+    m_notifyPending.storeRelease(0);
+    quint32 mask = m_changedMask.fetchAndStoreAcquire(0);
+    if (mask == 0) {
+        return;
+    }
+    m_lastNotify.restart();
+    emit statusChanged(mask);
+}
 
 ConfigManager::ConfigManager(QObject *parent)
     : QObject{parent}
@@ -15,20 +130,20 @@ ConfigManager::ConfigManager(QObject *parent)
 // 添加配置到 Map
 void ConfigManager::addConfigToMap(const QString& key, const ModelParaSetting& config)
 {
-    QMutexLocker locker(&globalMutex);
-    if (globalParaMap.contains(key)) {
+    QMutexLocker locker(&m_mutex);
+    if (m_configs.contains(key)) {
         qWarning() << "Key already exists:" << key;
         return;
     }
-    globalParaMap.insert(key, config);
+    m_configs.insert(key, config);
     qDebug() << "Added config:" << key;
 }
 
 // 从 Map 中移除配置
 bool ConfigManager::removeConfigFromMap(const QString& key)
 {
-    QMutexLocker locker(&globalMutex);
-    if (globalParaMap.remove(key) > 0) {
+    QMutexLocker locker(&m_mutex);
+    if (m_configs.remove(key) > 0) {
         qDebug() << "Removed config:" << key;
         return true;
     }
@@ -39,38 +154,43 @@ bool ConfigManager::removeConfigFromMap(const QString& key)
 // 获取配置
 ModelParaSetting ConfigManager::getConfigFromMap(const QString& key)
 {
-    QMutexLocker locker(&globalMutex);
-    if (!globalParaMap.contains(key)) {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_configs.constFind(key);
+    if (it == m_configs.constEnd()) {
         qWarning() << "Config not found:" << key;
+        return ModelParaSetting{};
     }
-    return globalParaMap[key];
+    return it.value();
 }
 
 // 更新配置
 bool ConfigManager::updateConfigInMap(const QString& key, const ModelParaSetting& config)
 {
-    QMutexLocker locker(&globalMutex);
-    if (globalParaMap.contains(key)) {
-        globalParaMap[key] = config;
-        qDebug() << "Updated config:" << key;
-        emit configUpdated(key, config);
-        return true;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_configs.find(key);
+        if (it == m_configs.end()) {
+            qWarning() << "Config not found for update:" << key;
+            return false;
+        }
+        it.value() = config;
     }
-    qWarning() << "Config not found for update:" << key;
-    return false;
+    qDebug() << "Updated config:" << key;
+    emit configUpdated(key, config);
+    return true;
 }
 
 // 获取所有配置键
 QList<QString> ConfigManager::getAllConfigKeys()
 {
-    QMutexLocker locker(&globalMutex);
-    return globalParaMap.keys();
+    QMutexLocker locker(&m_mutex);
+    return m_configs.keys();
 }
 
 // 清空 Map
 void ConfigManager::clearGlobalMap()
 {
-    QMutexLocker locker(&globalMutex);
-    globalParaMap.clear();
+    QMutexLocker locker(&m_mutex);
+    m_configs.clear();
     qDebug() << "Global map cleared";
 }
@@ -4,15 +4,74 @@
 #include <QObject>
 #include <QSettings>
 #include <QString>
+#include <QHash>
 #include <QMap>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QTimer>
 #include "channelparaconifg.h"
 
-extern QMutex globalMutex;
-extern QMap<QString, ModelParaSetting> globalParaMap; // 定义全局 Map
-extern QMap<int, RadioStatus> globalStatusMap; // 定义全局 Map
+class WakeupNotifier;
 
+// 电台状态：每部电台的收发状态和发射功率各为独立原子量
+// PTT线程写收发状态、遥测线程写功率、界面读取，互不加锁
+// 状态变化合并后在主线程发出statusChanged，两次通知间隔不小于一帧
+class RadioStatusBoard : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int RADIO_COUNT = 4;
+    static const quint32 ALL_RADIOS = (1u << RADIO_COUNT) - 1;
+    static const int FRAME_INTERVAL_MS = 16;
+
+    static RadioStatusBoard* instance();
+
+    // 电台编号1~4，越界时返回未启用
+    RadioStatus status(int radio) const;
+    // 全部电台状态，键为电台编号
+    QMap<int, RadioStatus> snapshot() const;
+
+    void setState(int radio, RadioState state);
+    void setTxPower(int radio, int txPower);
+
+    // 任一电台状态变化时递增，界面据此跳过无变化的刷新
+    quint32 sequence() const;
+
+signals:
+    // radioMask第n位表示电台n+1有变化
+    void statusChanged(quint32 radioMask);
+
+private slots:
+    // 主线程执行：距上次通知不足一帧时延后到帧边界
+    void scheduleNotify();
+    void notify();
+
+private:
+    RadioStatusBoard();
+    RadioStatusBoard(const RadioStatusBoard&) = delete;
+    RadioStatusBoard& operator=(const RadioStatusBoard&) = delete;
+
+    // 写线程调用：记录变化，本帧第一次变化时唤醒一次主线程，不分配内存
+    void markChanged(int radio);
+
+    QAtomicInt m_state[RADIO_COUNT];
+    QAtomicInt m_txPower[RADIO_COUNT];
+    QAtomicInteger<quint32> m_sequence;
+
+    QAtomicInteger<quint32> m_changedMask;
+    QAtomicInt m_notifyPending;
+    QElapsedTimer m_lastNotify;
+    QTimer *m_frameTimer;
+    WakeupNotifier *m_wakeup;
+
+    static RadioStatusBoard* m_instance;
+    static QMutex m_instanceMutex;
+};
+
+// 场景配置操作接口，配置按名称保存在本对象中
 class ConfigManager : public QObject
 {
     Q_OBJECT
@@ -31,6 +90,10 @@ public:
     bool updateConfigInMap(const QString& key, const ModelParaSetting& config);
     QList<QString> getAllConfigKeys();
     void clearGlobalMap();
+
+private:
+    QMutex m_mutex;
+    QHash<QString, ModelParaSetting> m_configs;
 };
 
 #endif // CONFIGMANAGER_H
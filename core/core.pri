@@ -0,0 +1,12 @@
+# 链接libchannelsim_core的公共配置，供app/daemon/tests/bench引用
+CONFIG += c++17
+QT += core sql mqtt concurrent
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+CORE_LIB_DIR = $$shadowed($$PWD)
+LIBS += -L$$CORE_LIB_DIR -lchannelsim_core
+PRE_TARGETDEPS += $$CORE_LIB_DIR/libchannelsim_core.a
+
+QMAKE_RPATHDIR += /opt/firefly_qt5.15/lib
@@ -0,0 +1,77 @@
+# libchannelsim_core：信道引擎核心库，只依赖QtCore/Sql/Mqtt
+TEMPLATE = lib
+TARGET = channelsim_core
+CONFIG += staticlib c++17
+
+QT = core sql concurrent
+#ARM交叉编译配置 MQTT
+QT += mqtt
+
+# # GCC构建配置 - 手动链接MQTT
+# QT_INSTALL_DIR = /home/dlj/Qt/5.15.2
+# INCLUDEPATH += $$QT_INSTALL_DIR/gcc_64/include/QtMqtt
+# LIBS += -L$$QT_INSTALL_DIR/gcc_64/lib -lQt5Mqtt
+
+# 定义USE_FPGA_TEST宏以支持FPGA测试功能
+# DEFINES += USE_FPGA_TEST
+
+SRC_ROOT = $$PWD/..
+INCLUDEPATH += $$SRC_ROOT
+DEPENDPATH += $$SRC_ROOT
+
+SOURCES += \
+    $$SRC_ROOT/PttMonitorThread.cpp \
+    $$SRC_ROOT/RadioChannelManager.cpp \
+    $$SRC_ROOT/asynclogger.cpp \
+    $$SRC_ROOT/channelcachemanager.cpp \
+    $$SRC_ROOT/channelengine.cpp \
+    $$SRC_ROOT/channelparamqueue.cpp \
+    $$SRC_ROOT/channelparaconifg.cpp \
+    $$SRC_ROOT/configmanager.cpp \
+    $$SRC_ROOT/databasemanager.cpp \
+    $$SRC_ROOT/fpga_driver.cpp \
+    $$SRC_ROOT/hardwarejournal.cpp \
+    $$SRC_ROOT/iohandler.cpp \
+    $$SRC_ROOT/mqttclient.cpp \
+    $$SRC_ROOT/mqttmessageparser.cpp \
+    $$SRC_ROOT/mqttservice.cpp \
+    $$SRC_ROOT/reportbuilder.cpp \
+    $$SRC_ROOT/rtprofile.cpp \
+    $$SRC_ROOT/scenarioindex.cpp \
+    $$SRC_ROOT/scenariolibrary.cpp \
+    $$SRC_ROOT/scenariopack.cpp \
+    $$SRC_ROOT/scenariotablemodel.cpp \
+    $$SRC_ROOT/settingmanager.cpp \
+    $$SRC_ROOT/startupprofiler.cpp \
+    $$SRC_ROOT/telemetryrecorder.cpp \
+    $$SRC_ROOT/telemetryservice.cpp \
+    $$SRC_ROOT/wakeupnotifier.cpp
+
+HEADERS += \
+    $$SRC_ROOT/PttMonitorThread.h \
+    $$SRC_ROOT/RadioChannelManager.h \
+    $$SRC_ROOT/asynclogger.h \
+    $$SRC_ROOT/channel_utils.h \
+    $$SRC_ROOT/channelcachemanager.h \
+    $$SRC_ROOT/channelengine.h \
+    $$SRC_ROOT/channelparamqueue.h \
+    $$SRC_ROOT/channelparaconifg.h \
+    $$SRC_ROOT/configmanager.h \
+    $$SRC_ROOT/databasemanager.h \
+    $$SRC_ROOT/fpga_driver.h \
+    $$SRC_ROOT/hardwarejournal.h \
+    $$SRC_ROOT/iohandler.h \
+    $$SRC_ROOT/mqttclient.h \
+    $$SRC_ROOT/mqttmessageparser.h \
+    $$SRC_ROOT/mqttservice.h \
+    $$SRC_ROOT/reportbuilder.h \
+    $$SRC_ROOT/rtprofile.h \
+    $$SRC_ROOT/scenarioindex.h \
+    $$SRC_ROOT/scenariolibrary.h \
+    $$SRC_ROOT/scenariopack.h \
+    $$SRC_ROOT/scenariotablemodel.h \
+    $$SRC_ROOT/settingmanager.h \
+    $$SRC_ROOT/startupprofiler.h \
+    $$SRC_ROOT/telemetryrecorder.h \
+    $$SRC_ROOT/telemetryservice.h \
+    $$SRC_ROOT/wakeupnotifier.h
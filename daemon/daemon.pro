@@ -0,0 +1,13 @@
+# 无界面守护进程，只依赖libchannelsim_core
+QT -= gui
+TARGET = channelsimd
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp
+
+unix:!android: target.path = /opt/ChannelSimu/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,111 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMetaType>
+#include <csignal>
+#include "asynclogger.h"
+#include "channelengine.h"
+#include "channelparaconifg.h"
+#include "mqttservice.h"
+#include "settingmanager.h"
+#include "startupprofiler.h"
+#include "wakeupnotifier.h"
+
+// 默认MQTT服务器，ChannelSettings.ini中未配置时使用
+static const char *DEFAULT_MQTT_HOST = "10.43.15.178";
+static const quint16 DEFAULT_MQTT_PORT = 1883;
+
+// SIGINT/SIGTERM时退出事件循环，保证PTT线程停止、fpga释放
+// 信号处理函数中只能调用异步信号安全的函数，这里只写eventfd，由主线程事件循环调用quit()
+static WakeupNotifier *s_quitNotifier = nullptr;
+
+static void handleQuitSignal(int)
+{
+    if (s_quitNotifier) {
+        s_quitNotifier->notify();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    StartupProfiler::mark("QCoreApplication");
+    app.setApplicationName("channelsimd");
+    app.setApplicationVersion("1.0");
+
+    // 注册自定义类型用于跨线程信号槽传递
+    qRegisterMetaType<ModelParaSetting>("ModelParaSetting");
+
+    WakeupNotifier quitNotifier;
+    QObject::connect(&quitNotifier, &WakeupNotifier::activated, &app, &QCoreApplication::quit);
+    s_quitNotifier = &quitNotifier;
+    std::signal(SIGINT, handleQuitSignal);
+    std::signal(SIGTERM, handleQuitSignal);
+
+    // PTT线程和fpga驱动的日志由后台线程写文件，需在初始化fpga前启动
+    AsyncLogger::instance()->start("channelsimd.log");
+#ifdef QT_DEBUG
+    AsyncLogger::instance()->setConsoleEcho(true);
+#endif
+
+    // 锁内存是进程级设置，在fpga初始化和各工作线程启动之前完成
+    ChannelEngine::lockProcessMemory();
+
+    // 初始化fpga及干扰和解调
+    QString errorMessage;
+    if (!ChannelEngine::initFpga(&errorMessage)) {
+        qCritical() << errorMessage;
+        return -1;
+    }
+    StartupProfiler::mark("fpga初始化");
+
+    // 信道引擎：PTT监控线程、数据库、侦察/干扰硬件配置
+    ChannelEngine engine;
+    if (!engine.initDataBase("channel.db", &errorMessage)) {
+        qCritical() << errorMessage;
+        return -1;
+    }
+    StartupProfiler::mark("数据库加载");
+    engine.start();
+
+    // 与界面程序共用ChannelSettings.ini中的MQTT配置
+    SettingManager settingMgr("ChannelSettings.ini");
+    QString mqttHost = DEFAULT_MQTT_HOST;
+    quint16 mqttPort = DEFAULT_MQTT_PORT;
+    if (settingMgr.loadConfig()) {
+        if (!settingMgr.getDomain().isEmpty()) {
+            mqttHost = settingMgr.getDomain();
+        }
+        if (settingMgr.getPort().toUInt() > 0) {
+            mqttPort = settingMgr.getPort().toUShort();
+        }
+    }
+
+    // MQTT收发和解析运行在独立线程
+    MqttService mqttClient;
+    QObject::connect(&mqttClient, &MqttService::connectionStatusChanged, [](bool connected) {
+        qDebug() << "连接状态:" << (connected ? "已连接" : "已断开");
+    });
+    QObject::connect(&mqttClient, &MqttService::errorOccurred, [](const QString &error) {
+        qDebug() << "错误:" << error;
+    });
+
+    // 连接到MQTT服务器并订阅消息
+    mqttClient.connectToBroker(mqttHost, mqttPort);
+    mqttClient.subscribeToTopic(EXAM_START_TOPIC);
+    mqttClient.subscribeToTopic(EXAM_END_TOPIC);
+    mqttClient.subscribeToTopic(CHANNEL_SIMU_PARAM);
+
+    qDebug() << "channelsimd started, mqtt:" << mqttHost << mqttPort;
+
+    int ret = app.exec();
+
+    // 退出阶段不再响应信号，避免处理函数访问已销毁的通知对象
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    s_quitNotifier = nullptr;
+
+    mqttClient.disconnectFromBroker();
+    engine.stop();
+    AsyncLogger::instance()->stop();
+    return ret;
+}
@@ -1,4 +1,3 @@
-#include "configmanager.h"
 #include "databasemanager.h"
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -25,13 +24,37 @@ bool DatabaseManager::openDatabase(const QString &dbName)
         return false;
     }
 
+    // WAL模式：读写互不阻塞，遥测写线程与场景库查询可并发
+    // synchronous=NORMAL在WAL下掉电只丢失最后的事务，不会损坏数据库
+    QSqlQuery pragma(m_database);
+    if (!pragma.exec("PRAGMA journal_mode=WAL")) {
+        qWarning() << "Error: Failed to enable WAL:" << pragma.lastError().text();
+    }
+    pragma.exec("PRAGMA synchronous=NORMAL");
+    pragma.exec("PRAGMA temp_store=MEMORY");
+    pragma.exec("PRAGMA foreign_keys=ON");
+
     qDebug() << "Database opened successfully!";
     return true;
 }
 
+QSqlQuery *DatabaseManager::statement(const QString &sql)
+{
+    auto it = m_statements.find(sql);
+    if (it == m_statements.end()) {
+        QSqlQuery query(m_database);
+        if (!query.prepare(sql)) {
+            qWarning() << "Error: Failed to prepare statement:" << query.lastError().text();
+            return nullptr;
+        }
+        it = m_statements.insert(sql, query);
+    }
+    return &it.value();
+}
+
 bool DatabaseManager::createTable()
 {
-    QSqlQuery query;
+    QSqlQuery query(m_database);
     QString createTableQuery =
         "CREATE TABLE IF NOT EXISTS configs ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT, "
@@ -49,10 +72,179 @@ bool DatabaseManager::createTable()
         return false;
     }
 
+    // 多径参数子表，每条路径一行
+    QString createPathsQuery =
+        "CREATE TABLE IF NOT EXISTS paths ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "configId INTEGER NOT NULL REFERENCES configs(id) ON DELETE CASCADE, "
+        "pathNum INTEGER NOT NULL, "
+        "relativDelay INTEGER NOT NULL, "
+        "antPower INTEGER NOT NULL, "
+        "freShift INTEGER NOT NULL, "
+        "freSpread INTEGER NOT NULL, "
+        "dopplerType INTEGER NOT NULL DEFAULT 0)";
+
+    if (!query.exec(createPathsQuery)) {
+        qWarning() << "Error: Failed to create paths table:" << query.lastError().text();
+        return false;
+    }
+
+    if (!migrateSchema()) {
+        return false;
+    }
+
     qDebug() << "Table created successfully!";
     return true;
 }
+
+bool DatabaseManager::migrateSchema()
+{
+    QSqlQuery query(m_database);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        qWarning() << "Error: Failed to read schema version:" << query.lastError().text();
+        return false;
+    }
+    int version = query.value(0).toInt();
+    query.finish();
+    if (version >= SCHEMA_VERSION) {
+        return true;
+    }
+
+    qDebug() << "Database schema migrate from" << version << "to" << SCHEMA_VERSION;
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
+
+    bool ok = true;
+    if (version < 1) {
+        ok = migrateToVersion1();
+    }
+    if (ok && version < 2) {
+        ok = migrateToVersion2();
+    }
+    ok = ok && query.exec(QString("PRAGMA user_version = %1").arg(SCHEMA_VERSION));
+
+    if (!ok || !m_database.commit()) {
+        qWarning() << "Error: Failed to migrate schema:" << query.lastError().text();
+        m_database.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::migrateToVersion1()
+{
+    QSqlQuery query(m_database);
+    bool ok = true;
+    // 旧库允许同名场景，建唯一索引前只保留最后写入的一条，与配置存储加载结果一致
+    ok = ok && query.exec("DELETE FROM configs WHERE id NOT IN (SELECT MAX(id) FROM configs GROUP BY modelName)");
+    if (ok && query.numRowsAffected() > 0) {
+        qDebug() << "Removed duplicate configs:" << query.numRowsAffected();
+    }
+
+    // JSON列拆分到paths表
+    if (ok) {
+        QSqlQuery select(m_database);
+        select.setForwardOnly(true);
+        ok = select.exec("SELECT id, multiPathType FROM configs WHERE multiPathType IS NOT NULL");
+        QSqlQuery insert(m_database);
+        ok = ok && insert.prepare("INSERT INTO paths (configId, pathNum, relativDelay, antPower, freShift, freSpread, dopplerType) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?)");
+        while (ok && select.next()) {
+            int configId = select.value(0).toInt();
+            for (const MultiPathType &path : parseJsonArray(select.value(1).toByteArray())) {
+                insert.addBindValue(configId);
+                insert.addBindValue(path.pathNum);
+                insert.addBindValue(path.relativDelay);
+                insert.addBindValue(path.antPower);
+                insert.addBindValue(path.freShift);
+                insert.addBindValue(path.freSpread);
+                insert.addBindValue(path.dopplerType);
+                ok = insert.exec();
+            }
+        }
+    }
+
+    // JSON列迁移后不再读写，清空避免与paths表不一致；升级后的库不再支持旧版本程序读取多径参数
+    // 列本身保留：SQLite 3.35之前不支持DROP COLUMN
+    ok = ok && query.exec("UPDATE configs SET multiPathType = NULL");
+    ok = ok && query.exec("CREATE UNIQUE INDEX IF NOT EXISTS idx_configs_modelName ON configs(modelName)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS idx_configs_channelNum ON configs(channelNum)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS idx_paths_configId ON paths(configId)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS idx_paths_freShift ON paths(freShift)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS idx_paths_freSpread ON paths(freSpread)");
+    if (!ok) {
+        qWarning() << "Error: Failed to migrate to version 1:" << query.lastError().text();
+    }
+    return ok;
+}
+
+bool DatabaseManager::migrateToVersion2()
+{
+    QSqlQuery query(m_database);
+    bool ok = query.exec("CREATE TABLE IF NOT EXISTS library_meta (key TEXT PRIMARY KEY, value INTEGER NOT NULL)");
+    ok = ok && query.exec("INSERT OR IGNORE INTO library_meta (key, value) VALUES ('revision', 1)");
+
+    // configs/paths任何修改都递增修订号，场景库缓存文件据此判断是否过期
+    // 由触发器维护，旧版本程序直接修改数据库也能被发现
+    const char *tables[] = {"configs", "paths"};
+    const char *events[] = {"INSERT", "UPDATE", "DELETE"};
+    for (const char *table : tables) {
+        for (const char *event : events) {
+            ok = ok && query.exec(QString("CREATE TRIGGER IF NOT EXISTS trg_%1_%2 AFTER %3 ON %1 BEGIN "
+                                          "UPDATE library_meta SET value = value + 1 WHERE key = 'revision'; END")
+                                  .arg(table, QString(event).toLower(), event));
+        }
+    }
+    if (!ok) {
+        qWarning() << "Error: Failed to migrate to version 2:" << query.lastError().text();
+    }
+    return ok;
+}
+
 bool DatabaseManager::insertParaConfig(const ModelParaSetting &config)
+{
+    // 场景行和路径行在同一事务中写入
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
+
+    if (!execInsert(config) || !m_database.commit()) {
+        m_database.rollback();
+        return false;
+    }
+
+    qDebug() << "Data inserted successfully!";
+    return true;
+}
+
+bool DatabaseManager::insertParaConfigs(const QVector<ModelParaSetting> &configs)
+{
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
+
+    for (const ModelParaSetting &config : configs) {
+        if (!execInsert(config)) {
+            m_database.rollback();
+            return false;
+        }
+    }
+
+    if (!m_database.commit()) {
+        qWarning() << "Error: Failed to commit configs:" << m_database.lastError().text();
+        m_database.rollback();
+        return false;
+    }
+
+    qDebug() << "Data inserted successfully! count:" << configs.size();
+    return true;
+}
+
+bool DatabaseManager::execInsert(const ModelParaSetting &config)
 {
     // 验证modelName不为空
     if (config.modelName.isEmpty()) {
@@ -60,53 +252,227 @@ bool DatabaseManager::insertParaConfig(const ModelParaSetting &config)
         return false;
     }
 
-    QSqlQuery query;
-    query.prepare("INSERT INTO configs (channelNum, modelName, noisePower, signalAnt, comDistance, multipathNum, filterNum, multiPathType) "
-                  "VALUES (:channelNum, :modelName, :noisePower, :signalAnt, :comDistance, :multipathNum, :filterNum, :multiPathType)");
-    query.bindValue(":channelNum", config.channelNum);
-    query.bindValue(":modelName", config.modelName);
-    query.bindValue(":noisePower", config.noisePower);
-    query.bindValue(":signalAnt", config.signalAnt);
-    query.bindValue(":comDistance", config.comDistance);
-    query.bindValue(":multipathNum", config.multipathNum);
-    query.bindValue(":filterNum", config.filterNum);
-    query.bindValue(":multiPathType", buildJsonArray(config.multipathType));
+    // 同名场景覆盖，与配置存储按名称保存一致
+    if (!execDelete(config.modelName)) {
+        return false;
+    }
 
-    if (!query.exec()) {
-        qWarning() << "Error: Failed to insert data:" << query.lastError().text();
+    QSqlQuery *query = statement("INSERT INTO configs (channelNum, modelName, noisePower, signalAnt, comDistance, multipathNum, filterNum) "
+                                 "VALUES (:channelNum, :modelName, :noisePower, :signalAnt, :comDistance, :multipathNum, :filterNum)");
+    if (!query) {
         return false;
     }
+    query->bindValue(":channelNum", config.channelNum);
+    query->bindValue(":modelName", config.modelName);
+    query->bindValue(":noisePower", config.noisePower);
+    query->bindValue(":signalAnt", config.signalAnt);
+    query->bindValue(":comDistance", config.comDistance);
+    query->bindValue(":multipathNum", config.multipathNum);
+    query->bindValue(":filterNum", config.filterNum);
 
-    qDebug() << "Data inserted successfully!";
+    if (!query->exec()) {
+        qWarning() << "Error: Failed to insert data:" << query->lastError().text();
+        return false;
+    }
+
+    return execInsertPaths(query->lastInsertId().toLongLong(), config.multipathType);
+}
+
+bool DatabaseManager::execInsertPaths(qint64 configId, const QList<MultiPathType> &paths)
+{
+    QSqlQuery *query = statement("INSERT INTO paths (configId, pathNum, relativDelay, antPower, freShift, freSpread, dopplerType) "
+                                 "VALUES (:configId, :pathNum, :relativDelay, :antPower, :freShift, :freSpread, :dopplerType)");
+    if (!query) {
+        return false;
+    }
+
+    for (const MultiPathType &path : paths) {
+        query->bindValue(":configId", configId);
+        query->bindValue(":pathNum", path.pathNum);
+        query->bindValue(":relativDelay", path.relativDelay);
+        query->bindValue(":antPower", path.antPower);
+        query->bindValue(":freShift", path.freShift);
+        query->bindValue(":freSpread", path.freSpread);
+        query->bindValue(":dopplerType", path.dopplerType);
+        if (!query->exec()) {
+            qWarning() << "Error: Failed to insert path:" << query->lastError().text();
+            return false;
+        }
+    }
     return true;
 }
 
 QVector<ModelParaSetting> DatabaseManager::getAllConfigs()
 {
-    QVector<ModelParaSetting> ParaConfigs;
     qDebug() << "Data get!";
-    QSqlQuery query("SELECT id, channelNum, modelName, noisePower, signalAnt, comDistance, multipathNum, filterNum,"
-                    "multiPathType FROM configs ORDER BY id");
+    return loadConfigs(QString(), QVariantList());
+}
+
+quint64 DatabaseManager::libraryRevision()
+{
+    QSqlQuery *query = statement("SELECT value FROM library_meta WHERE key = 'revision'");
+    if (!query || !query->exec() || !query->next()) {
+        qWarning() << "Error: Failed to read library revision:" << (query ? query->lastError().text() : QString());
+        return 0;
+    }
+    quint64 revision = query->value(0).toULongLong();
+    query->finish();
+    return revision;
+}
+
+QVector<ScenarioSummary> DatabaseManager::getScenarioSummaries()
+{
+    QVector<ScenarioSummary> summaries;
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    // 最大频移由paths表按configId索引聚合，不读取完整路径
+    if (!query.exec("SELECT modelName, channelNum, multipathNum, noisePower, signalAnt, "
+                    "(SELECT MAX(ABS(freShift)) FROM paths WHERE paths.configId = configs.id) "
+                    "FROM configs ORDER BY id")) {
+        qWarning() << "Error: Failed to load summaries:" << query.lastError().text();
+        return summaries;
+    }
+
+    while (query.next()) {
+        ScenarioSummary summary;
+        summary.modelName = query.value(0).toString();
+        summary.channelNum = query.value(1).toInt();
+        summary.multipathNum = query.value(2).toInt();
+        summary.noisePower = query.value(3).toDouble();
+        summary.signalAnt = query.value(4).toDouble();
+        summary.maxDoppler = query.value(5).toInt();
+        summaries.append(summary);
+    }
+    return summaries;
+}
+
+bool DatabaseManager::getParaConfig(const QString &name, ModelParaSetting *config)
+{
+    // modelName唯一索引查找
+    QVector<ModelParaSetting> configs = loadConfigs("modelName = ?", QVariantList() << name);
+    if (configs.isEmpty()) {
+        return false;
+    }
+    if (config) *config = configs.first();
+    return true;
+}
+
+QVector<ModelParaSetting> DatabaseManager::searchConfigs(const ScenarioFilter &filter)
+{
+    QStringList conditions;
+    QVariantList binds;
+
+    auto addRange = [&conditions, &binds](const QString &column, const ValueRange &range) {
+        if (range.hasMin) {
+            conditions << column + " >= ?";
+            binds << range.min;
+        }
+        if (range.hasMax) {
+            conditions << column + " <= ?";
+            binds << range.max;
+        }
+    };
+
+    if (filter.channelNum > 0) {
+        conditions << "channelNum = ?";
+        binds << filter.channelNum;
+    }
+    addRange("CAST(noisePower AS REAL)", filter.noisePower);
+    addRange("CAST(signalAnt AS REAL)", filter.signalAnt);
+    addRange("CAST(comDistance AS REAL)", filter.comDistance);
+
+    // 路径条件：至少一条路径同时满足全部范围
+    QStringList pathConditions;
+    QVariantList pathBinds;
+    auto addPathRange = [&pathConditions, &pathBinds](const QString &column, const ValueRange &range) {
+        if (range.hasMin) {
+            pathConditions << "p." + column + " >= ?";
+            pathBinds << range.min;
+        }
+        if (range.hasMax) {
+            pathConditions << "p." + column + " <= ?";
+            pathBinds << range.max;
+        }
+    };
+    addPathRange("relativDelay", filter.relativDelay);
+    addPathRange("antPower", filter.antPower);
+    addPathRange("freShift", filter.freShift);
+    addPathRange("freSpread", filter.freSpread);
+    if (!pathConditions.isEmpty()) {
+        conditions << "EXISTS (SELECT 1 FROM paths p WHERE p.configId = configs.id AND "
+                      + pathConditions.join(" AND ") + ")";
+        binds += pathBinds;
+    }
+
+    return loadConfigs(conditions.join(" AND "), binds);
+}
+
+QVector<ModelParaSetting> DatabaseManager::loadConfigs(const QString &where, const QVariantList &binds)
+{
+    QVector<ModelParaSetting> configs;
+    // 场景id到结果下标
+    QHash<qint64, int> indexById;
+
+    QString condition = where.isEmpty() ? QString() : " WHERE " + where;
+    QSqlQuery query(m_database);
+    // 只向前遍历，驱动不缓存已读行
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, channelNum, modelName, noisePower, signalAnt, comDistance, multipathNum, filterNum "
+                  "FROM configs" + condition + " ORDER BY id");
+    for (const QVariant &value : binds) {
+        query.addBindValue(value);
+    }
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to load configs:" << query.lastError().text();
+        return configs;
+    }
 
     while (query.next()) {
         ModelParaSetting config;
         config.channelNum = query.value(1).toInt();
+        config.modelType = 0;
         config.modelName = query.value(2).toString();
         config.noisePower = query.value(3).toDouble();
         config.signalAnt = query.value(4).toDouble();
         config.comDistance = query.value(5).toDouble();
         config.multipathNum = query.value(6).toInt();
         config.filterNum = query.value(7).toInt();
-        QString JsonArrayString = query.value(8).toString();
-        config.multipathType = parseJsonArray(JsonArrayString);
-        ParaConfigs.append(config);
-        {
-            QMutexLocker locker(&globalMutex);
-            globalParaMap[config.modelName] = config;
+        indexById.insert(query.value(0).toLongLong(), configs.size());
+        configs.append(config);
+    }
+    if (configs.isEmpty()) {
+        return configs;
+    }
+
+    // 路径按场景一次查出后归并
+    QSqlQuery pathQuery(m_database);
+    pathQuery.setForwardOnly(true);
+    pathQuery.prepare("SELECT configId, pathNum, relativDelay, antPower, freShift, freSpread, dopplerType FROM paths "
+                      "WHERE configId IN (SELECT id FROM configs" + condition + ") ORDER BY configId, pathNum");
+    for (const QVariant &value : binds) {
+        pathQuery.addBindValue(value);
+    }
+    if (!pathQuery.exec()) {
+        qWarning() << "Error: Failed to load paths:" << pathQuery.lastError().text();
+        return configs;
+    }
+
+    while (pathQuery.next()) {
+        auto it = indexById.constFind(pathQuery.value(0).toLongLong());
+        if (it == indexById.constEnd()) {
+            continue;
         }
+        MultiPathType path;
+        path.pathNum = pathQuery.value(1).toInt();
+        path.relativDelay = pathQuery.value(2).toInt();
+        path.antPower = pathQuery.value(3).toInt();
+        path.freShift = pathQuery.value(4).toInt();
+        path.freSpread = pathQuery.value(5).toInt();
+        path.dopplerType = pathQuery.value(6).toInt();
+        configs[it.value()].multipathType.append(path);
     }
 
-    return ParaConfigs;
+    return configs;
 }
 
 bool DatabaseManager::updateParaConfig(const QString &name, ModelParaSetting &config)
@@ -117,23 +483,66 @@ bool DatabaseManager::updateParaConfig(const QString &name, ModelParaSetting &co
         return false;
     }
 
-    QSqlQuery query;
-    query.prepare("UPDATE configs SET channelNum = :channelNum, modelName = :modelName, noisePower = :noisePower, "
-                  "signalAnt = :signalAnt, comDistance = :comDistance, multipathNum = :multipathNum, filterNum = :filterNum, "
-                  "multipathType = :multipathType WHERE modelName = :oldModelName");
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
 
-    query.bindValue(":oldModelName", name);
-    query.bindValue(":channelNum", config.channelNum);
-    query.bindValue(":modelName", config.modelName);
-    query.bindValue(":noisePower", config.noisePower);
-    query.bindValue(":signalAnt", config.signalAnt);
-    query.bindValue(":comDistance", config.comDistance);
-    query.bindValue(":multipathNum", config.multipathNum);
-    query.bindValue(":filterNum", config.filterNum);
-    query.bindValue(":multiPathType", buildJsonArray(config.multipathType));
+    // 先按旧名称取id，之后的修改和路径替换都按id进行
+    QSqlQuery *idQuery = statement("SELECT id FROM configs WHERE modelName = :modelName");
+    if (!idQuery) {
+        m_database.rollback();
+        return false;
+    }
+    idQuery->bindValue(":modelName", name);
+    if (!idQuery->exec()) {
+        qWarning() << "Error: Failed to update config:" << idQuery->lastError().text();
+        m_database.rollback();
+        return false;
+    }
+    if (!idQuery->next()) {
+        qWarning() << "Error: Config not found for update:" << name;
+        idQuery->finish();
+        m_database.rollback();
+        return false;
+    }
+    qint64 configId = idQuery->value(0).toLongLong();
+    idQuery->finish();
 
-    if (!query.exec()) {
-        qWarning() << "Error: Failed to update config:" << query.lastError().text();
+    // 改名为已存在的名称时违反modelName唯一索引，执行失败
+    QSqlQuery *query = statement("UPDATE configs SET channelNum = :channelNum, modelName = :modelName, noisePower = :noisePower, "
+                                 "signalAnt = :signalAnt, comDistance = :comDistance, multipathNum = :multipathNum, filterNum = :filterNum "
+                                 "WHERE id = :configId");
+    if (!query) {
+        m_database.rollback();
+        return false;
+    }
+
+    query->bindValue(":configId", configId);
+    query->bindValue(":channelNum", config.channelNum);
+    query->bindValue(":modelName", config.modelName);
+    query->bindValue(":noisePower", config.noisePower);
+    query->bindValue(":signalAnt", config.signalAnt);
+    query->bindValue(":comDistance", config.comDistance);
+    query->bindValue(":multipathNum", config.multipathNum);
+    query->bindValue(":filterNum", config.filterNum);
+
+    if (!query->exec() || query->numRowsAffected() != 1) {
+        qWarning() << "Error: Failed to update config:" << query->lastError().text();
+        m_database.rollback();
+        return false;
+    }
+
+    // 路径整体替换
+    QSqlQuery *deletePaths = statement("DELETE FROM paths WHERE configId = :configId");
+    if (!deletePaths) {
+        m_database.rollback();
+        return false;
+    }
+    deletePaths->bindValue(":configId", configId);
+    if (!deletePaths->exec() || !execInsertPaths(configId, config.multipathType) || !m_database.commit()) {
+        qWarning() << "Error: Failed to update config:" << m_database.lastError().text();
+        m_database.rollback();
         return false;
     }
 
@@ -143,12 +552,13 @@ bool DatabaseManager::updateParaConfig(const QString &name, ModelParaSetting &co
 
 bool DatabaseManager::deleteParaConfig(const QString &name)
 {
-    QSqlQuery query;
-    query.prepare("DELETE FROM configs WHERE modelName = :modelName");
-    query.bindValue(":modelName", name);
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
 
-    if (!query.exec()) {
-        qWarning() << "Error: Failed to delete config:" << query.lastError().text();
+    if (!execDelete(name) || !m_database.commit()) {
+        m_database.rollback();
         return false;
     }
 
@@ -156,21 +566,71 @@ bool DatabaseManager::deleteParaConfig(const QString &name)
     return true;
 }
 
+bool DatabaseManager::deleteParaConfigs(const QStringList &names)
+{
+    if (!m_database.transaction()) {
+        qWarning() << "Error: Failed to begin transaction:" << m_database.lastError().text();
+        return false;
+    }
+
+    for (const QString &name : names) {
+        if (!execDelete(name)) {
+            m_database.rollback();
+            return false;
+        }
+    }
+
+    if (!m_database.commit()) {
+        qWarning() << "Error: Failed to commit delete:" << m_database.lastError().text();
+        m_database.rollback();
+        return false;
+    }
+
+    qDebug() << "config deleted successfully! count:" << names.size();
+    return true;
+}
+
+bool DatabaseManager::execDelete(const QString &name)
+{
+    // 先删路径，不依赖外键级联(旧库可能未开启foreign_keys)
+    QSqlQuery *pathQuery = statement("DELETE FROM paths WHERE configId IN (SELECT id FROM configs WHERE modelName = :modelName)");
+    QSqlQuery *query = statement("DELETE FROM configs WHERE modelName = :modelName");
+    if (!pathQuery || !query) {
+        return false;
+    }
+    pathQuery->bindValue(":modelName", name);
+    query->bindValue(":modelName", name);
+
+    if (!pathQuery->exec() || !query->exec()) {
+        qWarning() << "Error: Failed to delete config:" << query->lastError().text() << pathQuery->lastError().text();
+        return false;
+    }
+    return true;
+}
+
 void DatabaseManager::closeDatabase()
 {
+    // 预编译语句需在关闭连接前释放
+    m_statements.clear();
     if (m_database.isOpen()) {
         m_database.close();
         qDebug() << "Database closed successfully!";
     }
 }
 
-QList<MultiPathType> DatabaseManager::parseJsonArray(QString &jsonArrayString)
+QString DatabaseManager::databaseName() const
+{
+    return m_database.databaseName();
+}
+
+QList<MultiPathType> DatabaseManager::parseJsonArray(const QByteArray &jsonArray)
 {
     QList<MultiPathType> multiParas;
-    QJsonDocument doc = QJsonDocument::fromJson(jsonArrayString.toUtf8());
+    QJsonDocument doc = QJsonDocument::fromJson(jsonArray);
 
     if (doc.isArray()) {
         QJsonArray array = doc.array();
+        multiParas.reserve(array.size());
 
         for (const QJsonValue &value : array) {
             QJsonObject obj = value.toObject();
@@ -180,27 +640,9 @@ QList<MultiPathType> DatabaseManager::parseJsonArray(QString &jsonArrayString)
             config.antPower = obj["antPower"].toInt();
             config.freShift = obj["freShift"].toInt();
             config.freSpread = obj["freSpread"].toInt();
+            config.dopplerType = obj["dopplerType"].toInt();
             multiParas.append(config);
         }
     }
     return multiParas;
 }
-
-QString DatabaseManager::buildJsonArray(QList<MultiPathType> multiParas)
-{
-    QJsonArray jsonArray;
-    for(const MultiPathType &config : multiParas)
-    {
-        QJsonObject obj;
-        obj["pathNum"] = config.pathNum;
-        obj["relativDelay"] = config.relativDelay;
-        obj["antPower"] = config.antPower;
-        obj["freShift"] = config.freShift;
-        obj["freSpread"] = config.freSpread;
-
-        jsonArray.append(obj);
-    }
-
-    QJsonDocument doc(jsonArray);
-    return doc.toJson();
-}
@@ -6,8 +6,47 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include <QHash>
+#include <QStringList>
 #include "channelparaconifg.h"
 
+// 场景摘要：列表显示用，不含多径参数
+struct ScenarioSummary
+{
+    QString modelName;
+    int channelNum = 0;
+    int multipathNum = 0;
+    double noisePower = 0;
+    double signalAnt = 0;
+    int maxDoppler = 0;     // 各路径频移绝对值的最大值
+};
+
+// 数值范围条件，未设置的一端不限
+struct ValueRange
+{
+    bool hasMin = false;
+    bool hasMax = false;
+    double min = 0;
+    double max = 0;
+
+    void setMin(double value) { hasMin = true; min = value; }
+    void setMax(double value) { hasMax = true; max = value; }
+};
+
+// 场景检索条件，各条件之间为与关系
+struct ScenarioFilter
+{
+    int channelNum = 0;         // 0表示不限
+    ValueRange noisePower;
+    ValueRange signalAnt;
+    ValueRange comDistance;
+    // 路径条件：至少一条路径同时满足
+    ValueRange relativDelay;
+    ValueRange antPower;
+    ValueRange freShift;
+    ValueRange freSpread;
+};
+
 class DatabaseManager : public QObject
 {
     Q_OBJECT
@@ -19,16 +58,55 @@ public:
     bool openDatabase(const QString &dbName);
     bool createTable();
     bool insertParaConfig(const ModelParaSetting &config);
+    // 批量导入，一个事务内完成，任一条失败则全部回滚
+    bool insertParaConfigs(const QVector<ModelParaSetting> &configs);
+    // 读取全部场景及其路径
     QVector<ModelParaSetting> getAllConfigs();
+    // 只读取场景摘要，不读paths表
+    QVector<ScenarioSummary> getScenarioSummaries();
+    // 按名称查找单个场景
+    bool getParaConfig(const QString &name, ModelParaSetting *config);
+    // 按参数范围检索场景
+    QVector<ModelParaSetting> searchConfigs(const ScenarioFilter &filter);
     bool updateParaConfig(const QString &name, ModelParaSetting &config);
     bool deleteParaConfig(const QString &name);
+    // 批量删除，一个事务内完成
+    bool deleteParaConfigs(const QStringList &names);
     void closeDatabase();
 
+    // 数据库文件名，其他线程以独立连接打开同一文件
+    QString databaseName() const;
+
+    // 场景数据修订号，configs/paths每次修改后递增，读取失败时返回0
+    quint64 libraryRevision();
+
 private:
+    // 数据库结构版本，记录在PRAGMA user_version
+    // 1: 多径参数由configs的JSON列拆分到paths表，modelName唯一
+    // 2: library_meta记录场景数据修订号
+    static const int SCHEMA_VERSION = 2;
+
     QSqlDatabase m_database;
+    // 预编译语句缓存，按SQL文本复用
+    QHash<QString, QSqlQuery> m_statements;
+
+    // 取缓存的预编译语句，首次使用时prepare
+    QSqlQuery *statement(const QString &sql);
+
+    // 旧版本库升级到SCHEMA_VERSION
+    bool migrateSchema();
+    bool migrateToVersion1();
+    bool migrateToVersion2();
+
+    bool execInsert(const ModelParaSetting &config);
+    bool execInsertPaths(qint64 configId, const QList<MultiPathType> &paths);
+    bool execDelete(const QString &name);
+
+    // 按条件读取场景及其路径，where为空时读取全部
+    QVector<ModelParaSetting> loadConfigs(const QString &where, const QVariantList &binds);
 
-    QList<MultiPathType> parseJsonArray(QString &jsonArrayString);
-    QString buildJsonArray(QList<MultiPathType> multiParas);
+    // 迁移时解析旧版JSON列
+    QList<MultiPathType> parseJsonArray(const QByteArray &jsonArray);
 };
 
 #endif // DATABASEMANAGER_H
@@ -0,0 +1,20 @@
+# FPGA寄存器命令行调试工具，直接编译fpga_driver.cpp中_TEST_段的main()/help()
+# 用法：fpga_cli set_chl_sw [rs_out] [sw]，不带参数时参考help()
+TEMPLATE = app
+TARGET = fpga_cli
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+DEFINES += _TEST_
+
+SRC_ROOT = $$PWD/..
+INCLUDEPATH += $$SRC_ROOT
+
+SOURCES += \
+    $$SRC_ROOT/fpga_driver.cpp
+
+HEADERS += \
+    $$SRC_ROOT/fpga_driver.h
+
+unix:!android: target.path = /opt/ChannelSimu/bin
+!isEmpty(target.path): INSTALLS += target
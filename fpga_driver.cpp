@@ -10,18 +10,22 @@
 #include <sys/mman.h>
 #include <errno.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
 #include "fpga_driver.h"
 #ifdef  USE_FPGA_TEST
 #include <QDebug>
 #endif
-#ifdef __QT__
-#include <QDebug>
-#define SO_DEBUG(format, ...) qDebug() << QString(format).arg(__VA_ARGS__)
-#else
+#ifdef _TEST_
+// 命令行工具不链接Qt，直接打印
 #define SO_DEBUG(format, ...) \
 do { \
         printf("%s,%d->" format "\n", __FUNCTION__, __LINE__, ## __VA_ARGS__); \
 } while(0)
+#else
+// 寄存器读写在PTT线程中调用，走异步日志，不在调用线程中格式化和写终端
+#include "asynclogger.h"
+#define SO_DEBUG(format, ...) LOG_DEBUG("fpga", format, ## __VA_ARGS__)
 #endif
 
 typedef struct {         //写寄存器
@@ -97,6 +101,7 @@ typedef struct {         //写寄存器
 #define REG_ATT_POWER_2 0x004a
 #define REG_ATT_POWER_3 0x004c
 #define REG_ATT_POWER_4 0x004e
+const uint32_t ATT_POWER_REGS[4] = { REG_ATT_POWER_1, REG_ATT_POWER_2, REG_ATT_POWER_3, REG_ATT_POWER_4 };
 /*
     低速adc
 */
@@ -346,7 +351,32 @@ const uint32_t REG_DPL_BYPASS[4] = {
 /**************************************************************************************************************/
 
 
-static int g_spi_fd;
+static int g_spi_fd = -1;
+
+// 批量下发复位镜像期间置1，write_reg跳过写后回读
+static int g_skip_readback = 0;
+
+// PTT线程和遥测线程都会访问寄存器，多寄存器的读写序列持锁执行，不互相穿插
+// 使用优先级继承，普通优先级的遥测线程持锁时不阻塞实时PTT线程
+static pthread_mutex_t g_reg_mutex;
+static pthread_once_t g_reg_mutex_once = PTHREAD_ONCE_INIT;
+
+static void init_reg_mutex() {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&g_reg_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+static void lock_reg() {
+    pthread_once(&g_reg_mutex_once, init_reg_mutex);
+    pthread_mutex_lock(&g_reg_mutex);
+}
+
+static void unlock_reg() {
+    pthread_mutex_unlock(&g_reg_mutex);
+}
 
 //打开设备
 int open_device() {
@@ -358,8 +388,18 @@ int open_device() {
     return 0;
 }
 
-void close_device() {
-    close(g_spi_fd);
+//关闭设备，未打开时直接返回
+int close_device() {
+    if (g_spi_fd < 0) {
+        return 0;
+    }
+    int ret = close(g_spi_fd);
+    g_spi_fd = -1;
+    if (ret < 0) {
+        SO_DEBUG("close /dev/fpga_spi error, errno=%d\r\n", errno);
+        return -1;
+    }
+    return 0;
 }
 
 // 根据错误码获取错误信息
@@ -400,7 +440,8 @@ const char* fpga_strerror(FPGA_ERR err) {
 }
 
 /***************************************寄存器读写函数********************************************************/
-int read_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t* out_value) {
+// 不加锁的读寄存器，调用方已持有g_reg_mutex
+static int read_reg_locked(FPGA_IDX idx, uint32_t reg_addr, uint32_t* out_value) {
     CTL_REG reg = {idx, reg_addr, 0};
     int ret;
 
@@ -414,7 +455,14 @@ int read_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t* out_value) {
     //SO_DEBUG("addr:0x%X, value:0x%X", reg_addr, reg.value);
     return 0;
 }
-int write_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t value) {
+int read_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t* out_value) {
+    lock_reg();
+    int ret = read_reg_locked(idx, reg_addr, out_value);
+    unlock_reg();
+    return ret;
+}
+// 不加锁的写寄存器(含回读)，调用方已持有g_reg_mutex
+static int write_reg_locked(FPGA_IDX idx, uint32_t reg_addr, uint32_t value) {
     CTL_REG reg = {idx, reg_addr, value };
     int ret;
 
@@ -426,6 +474,10 @@ int write_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t value) {
     }
     //SO_DEBUG("addr:0x%X, value:0x%X", reg_addr, value);
 
+    if (g_skip_readback) {
+        return 0;
+    }
+
     reg.fpga_idx = idx;
     reg.addr = reg_addr;
     reg.value = 0;
@@ -438,6 +490,13 @@ int write_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t value) {
     //SO_DEBUG("addr:0x%X, value:0x%X", reg_addr, reg.value);
     return 0;
 }
+// 写和回读之间不插入其他线程的访问
+int write_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t value) {
+    lock_reg();
+    int ret = write_reg_locked(idx, reg_addr, value);
+    unlock_reg();
+    return ret;
+}
 
 /****************************************增益控制函数********************************************************/
 /*
@@ -624,13 +683,26 @@ int set_att_l_gate(float dbfs) {
 int get_low_adc(struct low_adc *lowadc) {
     uint32_t lowadc_value[4];
     uint32_t ptt_state;
-    read_reg(FPGA1, REG_PTT_STATE, &ptt_state);
+    // 同一次采样的PTT和4路ADC持锁连续读取
+    lock_reg();
+    read_reg_locked(FPGA1, REG_PTT_STATE, &ptt_state);
 
     lowadc->radio_sta = ptt_state & 0XF;
     for (int i = 0; i < 4; i++) {
-        read_reg(FPGA1, LOW_ADC[i], &lowadc_value[i]);
+        read_reg_locked(FPGA1, LOW_ADC[i], &lowadc_value[i]);
         lowadc->low_adc_buf[i] = lowadc_value[i];
     }
+    unlock_reg();
+    return FPGA_OK;
+}
+
+// 功率统计值换算为dBFS，统计长度或功率为0时返回下限，避免log10(0)
+static double power_to_db(uint32_t power_value, uint32_t len) {
+    const double scale = (1ULL << 22);  // 2^22
+    if (power_value == 0 || len == 0) {
+        return FPGA_POWER_FLOOR_DB;
+    }
+    return 10 * log10(power_value / (len * scale));
 }
 
 /*
@@ -648,45 +720,39 @@ int get_ptt_sta_power(struct radios* dt) {
     static int index = 0;
 
     if (dt != nullptr) {
+        // PTT线程和遥测线程都会调用，索引在寄存器锁内推进
+        lock_reg();
         // 从数组中循环取值
         dt->radio_sta = test_ptt[index];
         qDebug() << "测试模式: radio_sta = 0x" << QString::number(dt->radio_sta, 16);
+        for (int i = 0; i < 4; i++) {
+            dt->radio_power[i] = ((dt->radio_sta >> i) & 0x1) ? -10.0 : FPGA_POWER_FLOOR_DB;
+        }
 
         // 更新索引，使其循环
         index = (index + 1) % 15;
+        unlock_reg();
     }
 
     return FPGA_OK;
 #endif
-    int ret;
     uint32_t ptt_state;
-    uint32_t power_value_1;
-    uint32_t power_value_2;
-    uint32_t power_value_3;
-    uint32_t power_value_4;
-    uint64_t power_value;
-    uint64_t reg_power_value;
+    uint32_t power_value[4];
     uint32_t len;
-    const double   scale = (1ULL << 22);  // 2^22
 
-    read_reg(FPGA1, REG_PTT_STATE, &ptt_state);
+    // PTT、统计长度和4路功率属于同一次采样，持锁连续读取，换算放在锁外
+    lock_reg();
+    read_reg_locked(FPGA1, REG_PTT_STATE, &ptt_state);
+    read_reg_locked(FPGA1, REG_ATT_LEN, &len);
+    for (int i = 0; i < 4; i++) {
+        read_reg_locked(FPGA1, ATT_POWER_REGS[i], &power_value[i]);
+    }
+    unlock_reg();
+
     dt->radio_sta = ptt_state & 0XF;
-    read_reg(FPGA1, REG_ATT_LEN, &len);
-    read_reg(FPGA1, REG_ATT_POWER_1, &power_value_1);
-    reg_power_value = 10 * log10(power_value_1 / (len * scale)) ;
-    dt->radio_power[0] = reg_power_value;
-
-    read_reg(FPGA1, REG_ATT_POWER_2, &power_value_2);
-    reg_power_value = 10 * log10(power_value_2 / (len * scale)) ;
-    dt->radio_power[1] = reg_power_value;
-
-    read_reg(FPGA1, REG_ATT_POWER_3, &power_value_3);
-    reg_power_value = 10 * log10(power_value_3 / (len * scale)) ;
-    dt->radio_power[2] = reg_power_value;
-
-    read_reg(FPGA1, REG_ATT_POWER_4, &power_value_4);
-    reg_power_value = 10 * log10(power_value_4 / (len * scale)) ;
-    dt->radio_power[3] = reg_power_value;
+    for (int i = 0; i < 4; i++) {
+        dt->radio_power[i] = power_to_db(power_value[i], len);
+    }
     return FPGA_OK;
 }
 
@@ -1868,114 +1934,172 @@ int set_bypass_dpl_iq_2(GR_OUT_E gr_in, ALG_PATH_E path_id, int dfs_sw, int fd_s
 
 /**************************************初始化*********************************************************************/
 
+// 单调时钟，单位us，用于统计初始化各阶段耗时
+static uint64_t init_now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+// 读改写：清除clear_mask对应位后置set_bits，一次读一次写
+static int init_update_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t clear_mask, uint32_t set_bits) {
+    uint32_t value = 0;
+    if (read_reg(idx, reg_addr, &value) < 0) {
+        return -1;
+    }
+    value = (value & ~clear_mask) | set_bits;
+    return write_reg(idx, reg_addr, value);
+}
+
+/*
+    上电复位镜像
+    各通道的开关/选路/旁路都是按位共享的寄存器，原先每个setter各自读改写一次，
+    这里把同一寄存器上所有通道的目标值合并，每个寄存器只读一次写一次；
+    衰减器需要按时序触发锁存，仍调用原setter。
+    复位期间写寄存器不回读。
+*/
 int fpga_init() {
 #ifdef  USE_FPGA_TEST
     qDebug() << "成功调用fpga_init()";
     return FPGA_OK;
 #endif
+    uint64_t t_start = init_now_us();
+    uint64_t t_phase = t_start;
+    int ret;
+
     //打开设备
-    int ret = open_device();
+    ret = open_device();
     if (ret != FPGA_OK) {
         return -1;
     }
+    SO_DEBUG("[fpga_init] open_device: %llu us", (unsigned long long)(init_now_us() - t_phase));
+    t_phase = init_now_us();
 
+    g_skip_readback = 1;
 
-
-    for (int rs_in = RS_IN_1; rs_in < RS_IN_MAX; rs_in++) {
-        //开关模式设置为自动
-        ret = set_rx_sw_mode((RS_IN_E)rs_in, 1);
-        if (ret != FPGA_OK) {
-            return ret;
+    //RS_IN: 开关模式全部设置为自动
+    if (init_update_reg(FPGA1, REG_RX_SW_MODE, 0x0, 0xFU) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_RX_SWITCH;
+    }
+    //DAC输出来源（低16位RS_OUT，高16位RS_JT）全部初始化为空
+    if (write_reg(FPGA1, REG_DAC_OUT_SEL, 0x0) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_CH_ATT_SEL;
+    }
+    //RS_JT: 解调开关全部关闭
+    if (init_update_reg(FPGA1, REG_JT_ATT_TX_EN, 0xFU, 0x0) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_JT_ATT_TX_EN;
+    }
+    //RS_OUT: 二选一开关关闭，四选一开关按通道号直连（每通道2位：0,1,2,3）
+    if (init_update_reg(FPGA1, REG_CH_ATT_TX_EN, 0xFU, 0x0) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_CH_ATT_TX_EN;
+    }
+    if (init_update_reg(FPGA1, REG_CH_ATT_V1V2, 0xFFU, 0xE4U) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_CH_ATT_V1V2;
+    }
+    //RS_OUT: 带阻(bit12)、IQ分离(bit0)、低通(bit1)旁路，5条路径的频移/频扩(bit0-bit9)旁路
+    for (int rs_out = RS_OUT_1; rs_out < RS_OUT_MAX; rs_out++) {
+        if (init_update_reg(FPGA1, REG_DPL_BYPASS[rs_out], 0x0, (1U << 12) | 0x3FFU) < 0) {
+            g_skip_readback = 0;
+            return FPGA_ERR_DPL_BYPASS;
         }
+    }
+    //GR_OUT: 干扰开关全部关闭，输出来源全部为空
+    if (init_update_reg(FPGA2, REG_GR_ATT_TX_EN, 0x1FU, 0x0) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_GR_ATT_TX_EN;
+    }
+    if (init_update_reg(FPGA2, REG_DAC_OUT_SEL2, 0xFFFFFU, 0x0) < 0) {
+        g_skip_readback = 0;
+        return FPGA_ERR_GR_ATT_SEL;
+    }
+    SO_DEBUG("[fpga_init] switch/select image: %llu us", (unsigned long long)(init_now_us() - t_phase));
+    t_phase = init_now_us();
 
-
-
-        //设置为手动增益，衰减设置为0
+    //衰减器全部置0（设置为手动增益）
+    for (int rs_in = RS_IN_1; rs_in < RS_IN_MAX; rs_in++) {
         set_rx_att_value((RS_IN_E)rs_in, 0.0f);
-        //通道数据源初始化为空
-        set_chl_out_sel((RS_OUT_E)rs_in, DATA_SRC_NONE);
-
-        //set_rx_att_auto((RS_IN_E)rs_in, true);
-
     }
-
     for (int rs_jt = RS_JT_1; rs_jt < RS_JT_MAX; rs_jt++) {
-        ret = set_jt_sw((RS_JT_E)rs_jt, 0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
-
-        ret = set_jt_att_value((RS_JT_E)rs_jt, 0.0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
-
-        set_jt_out_sel((RS_JT_E)rs_jt, DATA_SRC_NONE);
+        set_jt_att_value((RS_JT_E)rs_jt, 0.0f);
     }
-
     for (int rs_out = RS_OUT_1; rs_out < RS_OUT_MAX; rs_out++) {
-        ret = set_chl_sw((RS_OUT_E)rs_out, 0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
-
-        ret = set_chl_sw4((RS_OUT_E)rs_out, rs_out);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
-
-        ret = set_chl_att((RS_OUT_E)rs_out, 0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
+        set_chl_att((RS_OUT_E)rs_out, 0.0f);
+    }
+    for (int gr_out = GR_OUT_1; gr_out < GR_OUT_MAX; gr_out++) {
+        set_gr_att((GR_OUT_E)gr_out, 0.0f);
+    }
+    SO_DEBUG("[fpga_init] attenuators: %llu us", (unsigned long long)(init_now_us() - t_phase));
+    t_phase = init_now_us();
 
+    //设置ptt门限和fpga读取adc时间
+    set_ptt_gate(0x350);
+    set_ladc_tap(2000);
 
-        ret = set_bypass_raxis((RS_OUT_E)rs_out, 1);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
+    g_skip_readback = 0;
 
-        ret = set_bypass_iq((RS_OUT_E)rs_out, 1);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
+    SO_DEBUG("[fpga_init] ptt: %llu us, total: %llu us",
+             (unsigned long long)(init_now_us() - t_phase),
+             (unsigned long long)(init_now_us() - t_start));
+    return FPGA_OK;
+}
 
-        ret = set_bypass_laxis((RS_OUT_E)rs_out, 1);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
+/*
+    热重启：程序崩溃或升级后重新打开设备，不复位寄存器，保持正在运行的链路
+    是否可以热重启由上层比对影子寄存器决定
+*/
+int fpga_attach() {
+#ifdef  USE_FPGA_TEST
+    qDebug() << "成功调用fpga_attach()";
+    return FPGA_OK;
+#endif
+    if (open_device() != FPGA_OK) {
+        return -1;
     }
+    return FPGA_OK;
+}
 
-    for (int gr_out = GR_OUT_1; gr_out < GR_OUT_MAX; gr_out++) {
-        ret = set_gr_sw((GR_OUT_E)gr_out, 0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
+//影子寄存器：各通道开关/选路的汇总寄存器，热重启时用于判断硬件状态是否与日志一致
+static const struct {
+    FPGA_IDX idx;
+    uint32_t addr;
+} SHADOW_REGS[FPGA_SHADOW_REG_NUM] = {
+    {FPGA1, REG_DAC_OUT_SEL},
+    {FPGA1, REG_CH_ATT_TX_EN},
+    {FPGA1, REG_CH_ATT_V1V2},
+    {FPGA1, REG_JT_ATT_TX_EN},
+    {FPGA2, REG_GR_ATT_TX_EN},
+    {FPGA2, REG_DAC_OUT_SEL2},
+};
 
-        ret = set_gr_att((GR_OUT_E)gr_out, 0.0);
-        if (ret != FPGA_OK) {
-            return ret;
-        }
-        set_gr_out_sel((GR_OUT_E)gr_out,DATA_SRC_NONE);
+int fpga_read_shadow_regs(uint32_t *values) {
+    if (values == NULL) {
+        return FPGA_ERR_NULL_P;
     }
-
-    //设置ptt门限和fpga读取adc时间
-    ret = set_ptt_gate(0x350);
-    ret = set_ladc_tap(2000);
-
-    //算法关闭
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 5; j++) {
-            set_bypass_dpl_iq(static_cast<RS_OUT_E>(i), static_cast<ALG_PATH_E>(j), 1, 1);
+#ifdef  USE_FPGA_TEST
+    for (int i = 0; i < FPGA_SHADOW_REG_NUM; i++) {
+        values[i] = 0;
+    }
+    return FPGA_OK;
+#endif
+    for (int i = 0; i < FPGA_SHADOW_REG_NUM; i++) {
+        if (read_reg(SHADOW_REGS[i].idx, SHADOW_REGS[i].addr, &values[i]) < 0) {
+            return -1;
         }
     }
-
     return FPGA_OK;
 }
 
 int fpga_deinit()
 {
-    close_device();
+    if (close_device() < 0) {
+        return -1;
+    }
+    return FPGA_OK;
 }
 
 /**************************************主函数*********************************************************************/
@@ -2034,6 +2158,11 @@ void help(char* p) {
 #ifdef _TEST_
 
 int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        help(argv[0]);
+        return 1;
+    }
+
     if (open_device() < 0) {
         printf("Device open failed");
         return 1;
@@ -2186,7 +2315,7 @@ int main(int argc, char *argv[]) {
     } else if (strcmp(cmd, "set_jt_out_sel") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_jt_out_sel((RS_OUT_E)iv1, (DATA_SRC)iv2);
+        set_jt_out_sel((RS_JT_E)iv1, (DATA_SRC)iv2);
         printf("set_jt_out_sel DAC:%d SEL:%d\r\n", iv1, iv2);
     } else if (strcmp(cmd, "set_dds") == 0 && argc == 3) {
         fv1 = atof(argv[2]);
@@ -2240,22 +2369,22 @@ int main(int argc, char *argv[]) {
         iv2 = atoi(argv[3]);
         iv3 = atoi(argv[4]);
         iv4 = atoi(argv[5]);
-        set_bypass_dpl_iq((RS_OUT_E)iv1, iv2, iv3, iv4);
+        set_bypass_dpl_iq((RS_OUT_E)iv1, (ALG_PATH_E)iv2, iv3, iv4);
         printf("set_bypass chnl:%d path:%d dfs_sw:%d fd_sw:%d\r\n", iv1, iv2, iv3,iv4);
     }else if (strcmp(cmd, "set_gr_sw") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_gr_sw(iv1, iv2);
+        set_gr_sw((GR_OUT_E)iv1, iv2);
         printf("set_gr_sw");
     } else if (strcmp(cmd, "set_gr_att") == 0 && argc == 4) {
         iv1 = (int32_t)atoi(argv[2]);
         fv2 = atof(argv[3]);
-        set_gr_att(iv1, fv2);
+        set_gr_att((GR_OUT_E)iv1, fv2);
         printf("set_gr_att");
     } else if (strcmp(cmd, "set_gr_out_sel") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_gr_out_sel((RS_OUT_E)iv1, (DATA_SRC)iv2);
+        set_gr_out_sel((GR_OUT_E)iv1, (DATA_SRC)iv2);
         printf("set_gr_out_sel DAC:%d SEL:%d\r\n", iv1, iv2);
     } else if (strcmp(cmd, "set_dds_2") == 0 && argc == 3) {
         fv1 = atof(argv[2]);
@@ -2263,53 +2392,53 @@ int main(int argc, char *argv[]) {
         printf("set_dds_2 freq:%f\r\n", fv1);
     } else if (strcmp(cmd, "set_axis_2") == 0 && argc == 3) {
         iv1 = atoi(argv[2]);
-        set_axis_2((RS_OUT_E)iv1, &cfg);
+        set_axis_2((GR_OUT_E)iv1, &cfg);
         printf("set_axis_2 success");
     } else if (strcmp(cmd, "set_chl_delay_2") == 0 && argc == 5) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
         iv3 = atoi(argv[4]);
-        set_chl_delay_2((RS_OUT_E)iv1, (ALG_PATH_E)iv2, iv3);
+        set_chl_delay_2((GR_OUT_E)iv1, (ALG_PATH_E)iv2, iv3);
         printf("set_chl_delay_2 chl:%d path:%d delay:%d\r\n", iv1, iv2, iv3);
     } else if (strcmp(cmd, "set_dpl_df_2") == 0 && argc == 5) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
         fv2 = atof(argv[4]);
-        set_dpl_df_2((RS_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
+        set_dpl_df_2((GR_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
         printf("set_dpl_df_2 chl:%d path:%d freq:%f\r\n", iv1, iv2, fv3);
     } else if (strcmp(cmd, "set_dpl_dfs_2") == 0 && argc == 5) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
         fv2 = atof(argv[4]);
-        set_dpl_dfs_2((RS_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
+        set_dpl_dfs_2((GR_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
         printf("set_dpl_dfs_2 chl:%d path:%d freq:%f\r\n", iv1, iv2, fv3);
     } else if (strcmp(cmd, "set_gain_2") == 0 && argc == 5) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
         fv2 = atof(argv[4]);
-        set_gain_2((RS_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
+        set_gain_2((GR_OUT_E)iv1, (ALG_PATH_E)iv2, fv2);
         printf("set_gain_2 chl:%d path:%d gain:%f\r\n", iv1, iv2, fv3);
     } else if (strcmp(cmd, "set_bypass_raxis_2") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_bypass_raxis_2((RS_OUT_E)iv1, iv2);
+        set_bypass_raxis_2((GR_OUT_E)iv1, iv2);
         printf("set_bypass_raxis_2 chl:%d sw:%d\r\n", iv1, iv2);
     } else if (strcmp(cmd, "set_bypass_iq_2") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_bypass_iq_2((RS_OUT_E)iv1, iv2);
+        set_bypass_iq_2((GR_OUT_E)iv1, iv2);
         printf("set_bypass_iq_2 chl:%d sw:%d\r\n", iv1, iv2);
     } else if (strcmp(cmd, "set_bypass_laxis_2") == 0 && argc == 4) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
-        set_bypass_laxis_2((RS_OUT_E)iv1, iv2);
+        set_bypass_laxis_2((GR_OUT_E)iv1, iv2);
         printf("set_bypass_laxis_2 chl:%d sw:%d\r\n", iv1, iv2);
     } else if (strcmp(cmd, "set_bypass_dpl_iq_2") == 0 && argc == 6) {
         iv1 = atoi(argv[2]);
         iv2 = atoi(argv[3]);
         iv3 = atoi(argv[4]);
         iv4 = atoi(argv[5]);
-        set_bypass_dpl_iq_2((RS_OUT_E)iv1, iv2, iv3, iv4);
+        set_bypass_dpl_iq_2((GR_OUT_E)iv1, (ALG_PATH_E)iv2, iv3, iv4);
         printf("set_bypass_dpl_iq_2 chnl:%d path:%d dfs_sw:%d fd_sw:%d\r\n", iv1, iv2, iv3,iv4);
     }else if (strcmp(cmd, "fpga_init") == 0 && argc == 2) {
         fpga_init();
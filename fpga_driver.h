@@ -116,10 +116,13 @@ typedef enum {
     FPGA_ERR_NULL_P,
 } FPGA_ERR;
 
+//功率统计为0时的下限(dBFS)
+#define FPGA_POWER_FLOOR_DB (-120.0)
+
 //电台状态和功率
 struct radios {
     uint8_t radio_sta;  //0001 :4321  1发送、4接收
-    uint64_t radio_power[4];
+    double radio_power[4];  //功率(dBFS)，无信号时为FPGA_POWER_FLOOR_DB
 };
 struct low_adc {
     uint8_t radio_sta;  //0001 :4321  1发送、4接收
@@ -132,7 +135,7 @@ struct bs_axis {
 
 //打开设备
 int open_device();
-void close_device();
+int close_device();
 
 int read_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t *out_value);
 int write_reg(FPGA_IDX idx, uint32_t reg_addr, uint32_t value);
@@ -186,6 +189,12 @@ int set_bypass_dpl_iq_2(GR_OUT_E gr_in, ALG_PATH_E path_id, int dfs_sw, int fd_s
 int fpga_init();
 int fpga_deinit();
 
+//热重启：只打开设备，不复位寄存器
+int fpga_attach();
+//读取影子寄存器，values至少FPGA_SHADOW_REG_NUM个
+#define FPGA_SHADOW_REG_NUM 6
+int fpga_read_shadow_regs(uint32_t *values);
+
 // C++兼容性声明结束
 #ifdef __cplusplus
 }
@@ -0,0 +1,154 @@
+#include "hardwarejournal.h"
+#include <QSaveFile>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+// 日志格式版本，字段变化时递增，版本不符的日志直接按冷启动处理
+static const int JOURNAL_VERSION = 1;
+
+HardwareJournal::HardwareJournal(const QString &filePath)
+    : m_filePath(filePath)
+{
+}
+
+QString HardwareJournal::filePath() const
+{
+    return m_filePath;
+}
+
+bool HardwareJournal::save(const HardwareState &state)
+{
+    QJsonObject root;
+    root["version"] = JOURNAL_VERSION;
+    root["ptt"] = state.ptt;
+
+    QJsonArray dacChannels;
+    for (qint8 chl : state.dacChannels) {
+        dacChannels.append(chl);
+    }
+    root["dacChannels"] = dacChannels;
+
+    QJsonArray dacSelections;
+    for (qint8 sel : state.dacSelections) {
+        dacSelections.append(sel);
+    }
+    root["dacSelections"] = dacSelections;
+
+    QJsonArray shadowRegs;
+    for (quint32 value : state.shadowRegs) {
+        shadowRegs.append(static_cast<qint64>(value));
+    }
+    root["shadowRegs"] = shadowRegs;
+
+    QJsonArray channels;
+    for (auto it = state.channels.constBegin(); it != state.channels.constEnd(); ++it) {
+        const ChannelSetting &setting = it.value();
+        QJsonObject channel;
+        channel["channelNum"] = it.key();
+        channel["signalAnt"] = setting.signalAnt;
+        channel["filterNum"] = setting.filterNum;
+        channel["switchFlag"] = setting.switchFlag;
+
+        QJsonArray paths;
+        for (const MultiPathType &path : setting.multipathType) {
+            QJsonObject pathObj;
+            pathObj["pathNum"] = path.pathNum;
+            pathObj["relativDelay"] = path.relativDelay;
+            pathObj["antPower"] = path.antPower;
+            pathObj["freShift"] = path.freShift;
+            pathObj["freSpread"] = path.freSpread;
+            pathObj["dopplerType"] = path.dopplerType;
+            paths.append(pathObj);
+        }
+        channel["multipathType"] = paths;
+        channels.append(channel);
+    }
+    root["channels"] = channels;
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[硬件日志] 打开失败:" << m_filePath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qDebug() << "[硬件日志] 写入失败:" << m_filePath << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool HardwareJournal::load(HardwareState *state) const
+{
+    if (!state) {
+        return false;
+    }
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qDebug() << "[硬件日志] 解析失败:" << error.errorString();
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    if (root["version"].toInt() != JOURNAL_VERSION) {
+        qDebug() << "[硬件日志] 版本不符:" << root["version"].toInt();
+        return false;
+    }
+
+    HardwareState loaded;
+    loaded.ptt = static_cast<quint8>(root["ptt"].toInt());
+    for (const QJsonValue &value : root["dacChannels"].toArray()) {
+        loaded.dacChannels.append(static_cast<qint8>(value.toInt()));
+    }
+    for (const QJsonValue &value : root["dacSelections"].toArray()) {
+        loaded.dacSelections.append(static_cast<qint8>(value.toInt()));
+    }
+    for (const QJsonValue &value : root["shadowRegs"].toArray()) {
+        loaded.shadowRegs.append(static_cast<quint32>(value.toVariant().toLongLong()));
+    }
+
+    for (const QJsonValue &value : root["channels"].toArray()) {
+        QJsonObject channel = value.toObject();
+        ChannelSetting setting;
+        setting.channelNum = channel["channelNum"].toInt();
+        setting.signalAnt = channel["signalAnt"].toDouble();
+        setting.filterNum = channel["filterNum"].toInt();
+        setting.switchFlag = channel["switchFlag"].toBool();
+        setting.isChange = false;
+        for (const QJsonValue &pathValue : channel["multipathType"].toArray()) {
+            QJsonObject pathObj = pathValue.toObject();
+            MultiPathType path;
+            path.pathNum = pathObj["pathNum"].toInt();
+            path.relativDelay = pathObj["relativDelay"].toInt();
+            path.antPower = pathObj["antPower"].toInt();
+            path.freShift = pathObj["freShift"].toInt();
+            path.freSpread = pathObj["freSpread"].toInt();
+            path.dopplerType = pathObj["dopplerType"].toInt();
+            setting.multipathType.append(path);
+        }
+        loaded.channels[setting.channelNum] = setting;
+    }
+
+    if (loaded.dacChannels.size() != 4 || loaded.dacSelections.size() != 4 || loaded.channels.isEmpty()) {
+        qDebug() << "[硬件日志] 内容不完整";
+        return false;
+    }
+
+    *state = loaded;
+    return true;
+}
+
+void HardwareJournal::remove()
+{
+    QFile::remove(m_filePath);
+}
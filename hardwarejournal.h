@@ -0,0 +1,36 @@
+#ifndef HARDWAREJOURNAL_H
+#define HARDWAREJOURNAL_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "channelcachemanager.h"
+
+// 已下发到硬件的状态：DAC信道分配、信道缓存和影子寄存器
+struct HardwareState
+{
+    quint8 ptt = 0;                 // 分配DAC时的PTT值
+    QVector<qint8> dacChannels;     // DAC通道承载的信道号
+    QVector<qint8> dacSelections;   // DAC通道的目的电台号
+    QMap<int, ChannelSetting> channels;   // 信道缓存
+    QVector<quint32> shadowRegs;    // 影子寄存器值
+};
+
+// 硬件状态日志：每次提交整体写入临时文件后原子替换，崩溃时不会留下半个文件
+class HardwareJournal
+{
+public:
+    explicit HardwareJournal(const QString &filePath);
+
+    bool save(const HardwareState &state);
+    bool load(HardwareState *state) const;
+    // 冷启动后旧日志作废
+    void remove();
+
+    QString filePath() const;
+
+private:
+    QString m_filePath;
+};
+
+#endif // HARDWAREJOURNAL_H
@@ -1,14 +1,65 @@
 #include "iohandler.h"
 #include <QFileInfo>
+#include <QDir>
 #include <QDebug>
 #include <QMetaEnum>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include "scenariopack.h"
 
-IOHandler::IOHandler(QObject *parent) : QObject(parent)
+// 流式读取的块大小
+static const qint64 READ_CHUNK_SIZE = 64 * 1024;
+
+// 多场景XML的根节点
+static const char *XML_LIST_ELEMENT = "ModelParaSettingList";
+
+// CSV中每个场景以基础参数表头开始
+static const char *CSV_CONFIG_HEADER = "channelNum,";
+
+// 场景名称作文件名时的最大长度，留出序号和扩展名
+static const int FILE_NAME_MAX = 100;
+
+// 场景名称转文件名：替换路径分隔符、保留字符和控制字符，去掉开头的点，
+// 避免写到目标目录之外或生成隐藏文件
+static QString sanitizeFileName(const QString &name)
+{
+    static const QString reserved = QStringLiteral("\\/:*?\"<>|");
+    QString result;
+    result.reserve(name.size());
+    for (QChar c : name) {
+        result += (c.unicode() < 0x20 || reserved.contains(c)) ? QChar('_') : c;
+    }
+    result = result.left(FILE_NAME_MAX).trimmed();
+    while (result.startsWith('.')) {
+        result.remove(0, 1);
+    }
+    if (result.isEmpty()) {
+        result = QStringLiteral("场景");
+    }
+    return result;
+}
+
+IOHandler::IOHandler(QObject *parent)
+    : QObject(parent)
+    , m_canceled(0)
+    , m_done(0)
+    , m_lastPercent(0)
+    , m_total(0)
 {
 }
 
 bool IOHandler::exportData(const ModelParaSetting &data, const QString &filePath,
                            const QString &format, QString *errorMessage)
+{
+    if (!writeScenarioFile(data, filePath, format, errorMessage)) {
+        return false;
+    }
+    emit exportProgress(100);
+    return true;
+}
+
+bool IOHandler::writeScenarioFile(const ModelParaSetting &data, const QString &filePath,
+                                  const QString &format, QString *errorMessage)
 {
     try {
         switch (stringToEnum(format)) {
@@ -20,6 +71,9 @@ bool IOHandler::exportData(const ModelParaSetting &data, const QString &filePath
             return exportToXML(data, filePath, errorMessage);
         case INI:
             return exportToXML(data, filePath, errorMessage);
+        case PACK:
+            return ScenarioPack::write(filePath, QVector<ModelParaSetting>() << data, 0,
+                                       QHash<QString, QVector<quint32>>(), errorMessage);
         default:
             if (errorMessage) *errorMessage = "不支持的文件格式";
             return false;
@@ -45,6 +99,19 @@ ModelParaSetting IOHandler::importData(const QString &filePath, FileFormat forma
         case XML:
             config = importFromXML(filePath, errorMessage);
             return config;
+        case PACK: {
+            // 单场景导入取场景库中的第一个场景
+            ScenarioPack pack;
+            if (!pack.open(filePath, errorMessage)) {
+                return config;
+            }
+            if (pack.count() == 0) {
+                if (errorMessage) *errorMessage = "场景库为空";
+                return config;
+            }
+            config = pack.scenario(0);
+            return config;
+        }
         default:
             if (errorMessage) *errorMessage = "不支持的文件格式";
             return config;
@@ -61,19 +128,435 @@ ModelParaSetting IOHandler::importDataAutoDetect(const QString &filePath, QStrin
     return importData(filePath, format, errorMessage);
 }
 
+void IOHandler::cancel()
+{
+    m_canceled.storeRelaxed(1);
+}
+
+bool IOHandler::isCanceled() const
+{
+    return m_canceled.loadRelaxed() != 0;
+}
+
+void IOHandler::beginBatch(int total)
+{
+    m_canceled.storeRelaxed(0);
+    m_done.storeRelaxed(0);
+    m_lastPercent.storeRelaxed(0);
+    m_total = qMax(1, total);
+}
+
+void IOHandler::advanceBatch(bool import)
+{
+    int done = m_done.fetchAndAddRelaxed(1) + 1;
+    int percent = static_cast<int>(static_cast<qint64>(done) * 100 / m_total);
+    int last = m_lastPercent.loadRelaxed();
+    // 只有把进度推进的线程发出信号，避免重复和倒退
+    if (percent > last && m_lastPercent.testAndSetRelaxed(last, percent)) {
+        if (import) {
+            emit importProgress(percent);
+        } else {
+            emit exportProgress(percent);
+        }
+    }
+}
+
+QList<ModelParaSetting> IOHandler::importFiles(const QStringList &filePaths, QString *errorMessage)
+{
+    // 每个文件一个任务，结果按文件顺序合并
+    struct ImportJob {
+        QString filePath;
+        QList<ModelParaSetting> configs;
+        QString error;
+    };
+    QVector<ImportJob> jobs;
+    jobs.reserve(filePaths.size());
+    for (const QString &filePath : filePaths) {
+        ImportJob job;
+        job.filePath = filePath;
+        jobs.append(job);
+    }
+
+    beginBatch(jobs.size());
+    QtConcurrent::blockingMap(jobs, [this](ImportJob &job) {
+        if (isCanceled()) {
+            return;
+        }
+        job.configs = readScenarios(job.filePath, &job.error, nullptr);
+        advanceBatch(true);
+    });
+
+    QList<ModelParaSetting> result;
+    QStringList errors;
+    for (const ImportJob &job : jobs) {
+        result += job.configs;
+        if (!job.error.isEmpty()) {
+            errors << QString("%1: %2").arg(QFileInfo(job.filePath).fileName(), job.error);
+        }
+    }
+    if (isCanceled()) {
+        errors.prepend("导入已取消");
+    }
+    if (errorMessage) *errorMessage = errors.join("\n");
+
+    qDebug() << "批量导入完成，文件数:" << filePaths.size() << "场景数:" << result.size();
+    return result;
+}
+
+QList<ModelParaSetting> IOHandler::importDirectory(const QString &dirPath, QString *errorMessage)
+{
+    QDir dir(dirPath);
+    QStringList filePaths;
+    const QStringList names = dir.entryList(QStringList() << "*.csv" << "*.json" << "*.xml" << "*.cspk",
+                                            QDir::Files, QDir::Name);
+    for (const QString &name : names) {
+        filePaths << dir.filePath(name);
+    }
+    return importFiles(filePaths, errorMessage);
+}
+
+QList<ModelParaSetting> IOHandler::importArchive(const QString &filePath, QString *errorMessage)
+{
+    beginBatch(100);
+    QList<ModelParaSetting> result = readScenarios(filePath, errorMessage,
+                                                   [this](qint64 pos, qint64 size) {
+        int percent = size > 0 ? static_cast<int>(pos * 100 / size) : 100;
+        int last = m_lastPercent.loadRelaxed();
+        if (percent > last && m_lastPercent.testAndSetRelaxed(last, percent)) {
+            emit importProgress(percent);
+        }
+    });
+    if (isCanceled() && errorMessage) {
+        *errorMessage = "导入已取消";
+    }
+    return result;
+}
+
+bool IOHandler::exportFiles(const QList<ModelParaSetting> &dataList, const QString &dirPath,
+                            const QString &format, QString *errorMessage)
+{
+    struct ExportJob {
+        int index;
+        const ModelParaSetting *config;
+        bool ok;
+    };
+    QVector<ExportJob> jobs;
+    jobs.reserve(dataList.size());
+    for (int i = 0; i < dataList.size(); ++i) {
+        jobs.append({i, &dataList.at(i), false});
+    }
+
+    QDir dir(dirPath);
+    beginBatch(jobs.size());
+    QtConcurrent::blockingMap(jobs, [this, &dir, &format](ExportJob &job) {
+        if (isCanceled()) {
+            return;
+        }
+        // 文件名：场景名称_序号.格式（避免重复），名称来自外部导入，需先清理
+        // 一次替换全部占位符，名称中的"%2"之类不会被再次替换
+        QString fileName = QString("%1_%2.%3").arg(sanitizeFileName(job.config->modelName),
+                                                   QString::number(job.index + 1), format.toLower());
+        job.ok = writeScenarioFile(*job.config, dir.filePath(fileName), format.toUpper(), nullptr);
+        advanceBatch(false);
+    });
+
+    int failed = 0;
+    for (const ExportJob &job : jobs) {
+        if (!job.ok) {
+            failed++;
+        }
+    }
+    if (failed > 0 && errorMessage) {
+        *errorMessage = isCanceled() ? QString("导出已取消") : QString("%1个文件导出失败").arg(failed);
+    }
+    return failed == 0;
+}
+
+bool IOHandler::exportArchive(const QList<ModelParaSetting> &dataList, const QString &filePath,
+                              const QString &format, QString *errorMessage)
+{
+    FileFormat fileFormat = stringToEnum(format.toUpper());
+
+    // 二进制场景库整体生成，内部同样先写临时文件再替换
+    if (fileFormat == PACK) {
+        beginBatch(1);
+        bool ok = ScenarioPack::write(filePath, dataList.toVector(), 0,
+                                      QHash<QString, QVector<quint32>>(), errorMessage);
+        advanceBatch(false);
+        return ok;
+    }
+
+    // 写完整后再替换目标文件，取消或失败时不留下半个文件
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (errorMessage) *errorMessage = "无法创建文件";
+        return false;
+    }
+
+    beginBatch(dataList.size());
+    if (fileFormat == JSON) {
+        file.write("[\n");
+        for (int i = 0; i < dataList.size() && !isCanceled(); ++i) {
+            if (i > 0) {
+                file.write(",\n");
+            }
+            file.write(QJsonDocument(configToJson(dataList.at(i))).toJson(QJsonDocument::Compact));
+            advanceBatch(false);
+        }
+        file.write("\n]\n");
+    } else if (fileFormat == CSV) {
+        for (int i = 0; i < dataList.size() && !isCanceled(); ++i) {
+            file.write(configToCsv(dataList.at(i)).toUtf8());
+            file.write("\n");
+            advanceBatch(false);
+        }
+    } else {
+        // XML和INI都按XML写出，与exportData一致
+        QXmlStreamWriter xmlWriter(&file);
+        xmlWriter.setAutoFormatting(true);
+        xmlWriter.writeStartDocument();
+        xmlWriter.writeStartElement(XML_LIST_ELEMENT);
+        for (int i = 0; i < dataList.size() && !isCanceled(); ++i) {
+            configToXml(xmlWriter, dataList.at(i));
+            advanceBatch(false);
+        }
+        xmlWriter.writeEndElement();
+        xmlWriter.writeEndDocument();
+    }
+
+    if (isCanceled()) {
+        file.cancelWriting();
+        if (errorMessage) *errorMessage = "导出已取消";
+        return false;
+    }
+    if (!file.commit()) {
+        if (errorMessage) *errorMessage = "写入文件失败";
+        return false;
+    }
+    return true;
+}
+
+QList<ModelParaSetting> IOHandler::readScenarios(const QString &filePath, QString *errorMessage,
+                                                 const std::function<void(qint64, qint64)> &progress)
+{
+    FileFormat format = detectFileFormat(filePath);
+    if (format == PACK) {
+        return readPackScenarios(filePath, errorMessage, progress);
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (errorMessage) *errorMessage = "无法打开文件";
+        return QList<ModelParaSetting>();
+    }
+
+    switch (format) {
+    case JSON:
+        return readJsonScenarios(file, errorMessage, progress);
+    case XML:
+        return readXmlScenarios(file, errorMessage, progress);
+    default:
+        return readCsvScenarios(file, progress);
+    }
+}
+
+QList<ModelParaSetting> IOHandler::readJsonScenarios(QFile &file, QString *errorMessage,
+                                                     const std::function<void(qint64, qint64)> &progress)
+{
+    QList<ModelParaSetting> result;
+    qint64 size = file.size();
+
+    // 逐块扫描顶层数组，每得到一个完整对象就解析，内存中只保留当前对象
+    QByteArray buffer;
+    int depth = 0;
+    int objectStart = -1;
+    bool inString = false;
+    bool escape = false;
+    bool topLevelChecked = false;
+    int scanPos = 0;
+
+    while (!file.atEnd() && !isCanceled()) {
+        buffer += file.read(READ_CHUNK_SIZE);
+
+        if (!topLevelChecked) {
+            QByteArray head = buffer.trimmed();
+            if (head.isEmpty()) {
+                continue;
+            }
+            topLevelChecked = true;
+            if (head.startsWith('{')) {
+                // 单场景文件
+                buffer += file.readAll();
+                QJsonDocument doc = QJsonDocument::fromJson(buffer);
+                if (!doc.isObject()) {
+                    if (errorMessage) *errorMessage = "无效的JSON格式";
+                    return result;
+                }
+                result.append(configFromJson(doc.object()));
+                if (progress) progress(size, size);
+                return result;
+            }
+        }
+
+        for (int i = scanPos; i < buffer.size(); ++i) {
+            char c = buffer.at(i);
+            if (inString) {
+                if (escape) {
+                    escape = false;
+                } else if (c == '\\') {
+                    escape = true;
+                } else if (c == '"') {
+                    inString = false;
+                }
+                continue;
+            }
+
+            if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                if (c == '{' && depth == 1) {
+                    objectStart = i;
+                }
+                depth++;
+            } else if (c == '}' || c == ']') {
+                depth--;
+                if (c == '}' && depth == 1 && objectStart >= 0) {
+                    QJsonParseError parseError;
+                    QJsonDocument doc = QJsonDocument::fromJson(buffer.mid(objectStart, i - objectStart + 1), &parseError);
+                    if (doc.isObject()) {
+                        result.append(configFromJson(doc.object()));
+                    } else if (errorMessage) {
+                        *errorMessage = parseError.errorString();
+                    }
+                    objectStart = -1;
+                }
+            }
+        }
+
+        // 丢弃已处理的部分，只保留未完成的对象
+        if (objectStart >= 0) {
+            buffer.remove(0, objectStart);
+            scanPos = buffer.size();
+            objectStart = 0;
+        } else {
+            buffer.clear();
+            scanPos = 0;
+        }
+
+        if (progress) progress(file.pos(), size);
+    }
+
+    if (depth != 0 && !isCanceled() && errorMessage) {
+        *errorMessage = "JSON文件不完整";
+    }
+    return result;
+}
+
+QList<ModelParaSetting> IOHandler::readXmlScenarios(QFile &file, QString *errorMessage,
+                                                    const std::function<void(qint64, qint64)> &progress)
+{
+    QList<ModelParaSetting> result;
+    qint64 size = file.size();
+    QXmlStreamReader reader(&file);
+
+    // 根节点为单个ModelParaSetting或ModelParaSettingList
+    while (reader.readNextStartElement() && !isCanceled()) {
+        if (reader.name() == QLatin1String(XML_LIST_ELEMENT)) {
+            while (reader.readNextStartElement() && !isCanceled()) {
+                if (reader.name() == "ModelParaSetting") {
+                    result.append(configFromXmlElement(reader));
+                    if (progress) progress(file.pos(), size);
+                } else {
+                    reader.skipCurrentElement();
+                }
+            }
+        } else if (reader.name() == "ModelParaSetting") {
+            result.append(configFromXmlElement(reader));
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if (reader.hasError() && errorMessage) {
+        *errorMessage = reader.errorString();
+    }
+    if (progress) progress(size, size);
+    return result;
+}
+
+QList<ModelParaSetting> IOHandler::readCsvScenarios(QFile &file,
+                                                    const std::function<void(qint64, qint64)> &progress)
+{
+    QList<ModelParaSetting> result;
+    qint64 size = file.size();
+
+    QTextStream stream(&file);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    stream.setCodec("UTF-8");
+#else
+    stream.setEncoding(QStringConverter::Utf8);
+#endif
+
+    // 逐行读取，遇到下一个基础参数表头时结束上一个场景
+    QStringList lines;
+    int lineCount = 0;
+    while (!stream.atEnd() && !isCanceled()) {
+        QString line = stream.readLine();
+        if (line.trimmed().isEmpty()) {
+            continue;
+        }
+        if (line.startsWith(CSV_CONFIG_HEADER) && !lines.isEmpty()) {
+            result.append(configFromCsvLines(lines));
+            lines.clear();
+        }
+        lines << line;
+
+        if (progress && ++lineCount % 1024 == 0) {
+            progress(file.pos(), size);
+        }
+    }
+    if (!lines.isEmpty()) {
+        result.append(configFromCsvLines(lines));
+    }
+
+    if (progress) progress(size, size);
+    return result;
+}
+
+QList<ModelParaSetting> IOHandler::readPackScenarios(const QString &filePath, QString *errorMessage,
+                                                     const std::function<void(qint64, qint64)> &progress)
+{
+    QList<ModelParaSetting> result;
+    ScenarioPack pack;
+    if (!pack.open(filePath, errorMessage)) {
+        return result;
+    }
+
+    // 记录已是定长二进制，逐条解码，按场景数计算进度
+    int count = pack.count();
+    result.reserve(count);
+    for (int i = 0; i < count && !isCanceled(); ++i) {
+        result.append(pack.scenario(i));
+        if (progress && (i & 0xFF) == 0) progress(i, count);
+    }
+    if (progress) progress(count, count);
+    return result;
+}
+
 QString IOHandler::getFormatFilter(FileFormat format)
 {
     switch (format) {
     case CSV: return "CSV文件 (*.csv)";
     case JSON: return "JSON文件 (*.json)";
     case XML: return "XML文件 (*.xml)";
+    case PACK: return "场景库文件 (*.cspk)";
     default: return "所有文件 (*.*)";
     }
 }
 
 QString IOHandler::getAllSupportedFilters()
 {
-    return "CSV文件 (*.csv);;JSON文件 (*.json);;XML文件 (*.xml);;所有文件 (*.*)";
+    return "CSV文件 (*.csv);;JSON文件 (*.json);;XML文件 (*.xml);;场景库文件 (*.cspk);;所有文件 (*.*)";
 }
 
 QString IOHandler::enumToString(FileFormat value)
@@ -121,7 +604,6 @@ bool IOHandler::exportToCSV(const ModelParaSetting &data, const QString &filePat
     stream << configToCsv(data);
 
     file.close();
-    emit exportProgress(100);
     return true;
 }
 
@@ -235,6 +717,7 @@ bool IOHandler::exportToXML(const ModelParaSetting &data, const QString &filePat
     xmlWriter.writeStartDocument();
 
     configToXml(xmlWriter, data);
+    xmlWriter.writeEndDocument();
     file.close();
     return true;
 }
@@ -264,6 +747,7 @@ IOHandler::FileFormat IOHandler::detectFileFormat(const QString &filePath)
     if (suffix == "csv") return CSV;
     if (suffix == "json") return JSON;
     if (suffix == "xml") return XML;
+    if (suffix == "cspk") return PACK;
 
     // 尝试通过文件内容检测
     QFile file(filePath);
@@ -395,8 +879,8 @@ MultiPathType IOHandler::pathFromXml(QXmlStreamReader &reader)
 // ModelParaSetting 转 XML
 void IOHandler::configToXml(QXmlStreamWriter &writer, const ModelParaSetting &config) const
 {
-    writer.writeStartDocument(); // XML 文档头
-    writer.writeStartElement("ModelParaSetting"); // 根节点
+    // 文档头由调用者写入，多场景文件中每个场景一个节点
+    writer.writeStartElement("ModelParaSetting");
 
     // 基础参数
     writer.writeTextElement("channelNum", QString::number(config.channelNum));
@@ -416,7 +900,6 @@ void IOHandler::configToXml(QXmlStreamWriter &writer, const ModelParaSetting &co
     writer.writeEndElement(); // </MultiPathList>
 
     writer.writeEndElement(); // </ModelParaSetting>
-    writer.writeEndDocument();
 }
 
 // XML 转 ModelParaSetting
@@ -424,36 +907,50 @@ ModelParaSetting IOHandler::configFromXml(QXmlStreamReader &reader)
 {
     ModelParaSetting config;
 
-    // 遍历 XML 节点
+    // 遍历 XML 节点，取第一个场景
     while (reader.readNextStartElement()) {
         if (reader.name() == "ModelParaSetting") {
-            // 解析根节点子元素
+            config = configFromXmlElement(reader);
+            break;
+        } else if (reader.name() != QLatin1String(XML_LIST_ELEMENT)) {
+            reader.skipCurrentElement();
+        }
+    }
+
+    // 检查 XML 错误
+    if (reader.hasError()) {
+        qWarning() << "XML 解析错误：" << reader.errorString();
+    }
+    return config;
+}
+
+ModelParaSetting IOHandler::configFromXmlElement(QXmlStreamReader &reader)
+{
+    ModelParaSetting config;
+
+    // 解析根节点子元素
+    while (reader.readNextStartElement()) {
+        if (reader.name() == "channelNum") {
+            config.channelNum = reader.readElementText().toInt();
+        } else if (reader.name() == "modelType") {
+            config.modelType = reader.readElementText().toInt();
+        } else if (reader.name() == "modelName") {
+            config.modelName = reader.readElementText();
+        } else if (reader.name() == "noisePower") {
+            config.noisePower = reader.readElementText().toDouble();
+        } else if (reader.name() == "signalAnt") {
+            config.signalAnt = reader.readElementText().toDouble();
+        } else if (reader.name() == "comDistance") {
+            config.comDistance = reader.readElementText().toDouble();
+        } else if (reader.name() == "multipathNum") {
+            config.multipathNum = reader.readElementText().toInt();
+        } else if (reader.name() == "filterNum") {
+            config.filterNum = reader.readElementText().toInt();
+        } else if (reader.name() == "MultiPathList") {
+            // 解析多径列表
             while (reader.readNextStartElement()) {
-                if (reader.name() == "channelNum") {
-                    config.channelNum = reader.readElementText().toInt();
-                } else if (reader.name() == "modelType") {
-                    config.modelType = reader.readElementText().toInt();
-                } else if (reader.name() == "modelName") {
-                    config.modelName = reader.readElementText();
-                } else if (reader.name() == "noisePower") {
-                    config.noisePower = reader.readElementText().toDouble();
-                } else if (reader.name() == "signalAnt") {
-                    config.signalAnt = reader.readElementText().toDouble();
-                } else if (reader.name() == "comDistance") {
-                    config.comDistance = reader.readElementText().toDouble();
-                } else if (reader.name() == "multipathNum") {
-                    config.multipathNum = reader.readElementText().toInt();
-                } else if (reader.name() == "filterNum") {
-                    config.filterNum = reader.readElementText().toInt();
-                } else if (reader.name() == "MultiPathList") {
-                    // 解析多径列表
-                    while (reader.readNextStartElement()) {
-                        if (reader.name() == "MultiPath") {
-                            config.multipathType.append(pathFromXml(reader));
-                        } else {
-                            reader.skipCurrentElement();
-                        }
-                    }
+                if (reader.name() == "MultiPath") {
+                    config.multipathType.append(pathFromXml(reader));
                 } else {
                     reader.skipCurrentElement();
                 }
@@ -462,11 +959,6 @@ ModelParaSetting IOHandler::configFromXml(QXmlStreamReader &reader)
             reader.skipCurrentElement();
         }
     }
-
-    // 检查 XML 错误
-    if (reader.hasError()) {
-        qWarning() << "XML 解析错误：" << reader.errorString();
-    }
     return config;
 }
 
@@ -530,9 +1022,13 @@ QString IOHandler::configToCsv(const ModelParaSetting &config) const
 
 // CSV 转 ModelParaSetting
 ModelParaSetting IOHandler::configFromCsv(const QString &csvContent)
+{
+    return configFromCsvLines(csvContent.split("\n", Qt::SkipEmptyParts));
+}
+
+ModelParaSetting IOHandler::configFromCsvLines(const QStringList &lines)
 {
     ModelParaSetting config;
-    QStringList lines = csvContent.split("\n", Qt::SkipEmptyParts);
     if (lines.size() < 2) return config;
 
     // 解析基础参数（第2行，跳过表头）
@@ -13,6 +13,8 @@
 #include <QJsonObject>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
+#include <QAtomicInt>
+#include <functional>
 #include "channelparaconifg.h"
 
 class IOHandler : public QObject
@@ -25,7 +27,8 @@ public:
         CSV,
         JSON,
         XML,
-        INI
+        INI,
+        PACK        // 二进制场景库(.cspk)，只用于多场景导入导出
     };
     Q_ENUM(FileFormat)
 
@@ -46,6 +49,35 @@ public:
     ModelParaSetting importDataAutoDetect(const QString &filePath,
                                             QString *errorMessage = nullptr);
 
+    // 批量导入：多个文件在线程池中并行解析，每个文件可包含一个或多个场景
+    // 按文件计算进度，通过importProgress发出；取消后返回已解析的部分
+    QList<ModelParaSetting> importFiles(const QStringList &filePaths,
+                                        QString *errorMessage = nullptr);
+
+    // 导入目录下全部csv/json/xml/cspk文件
+    QList<ModelParaSetting> importDirectory(const QString &dirPath,
+                                            QString *errorMessage = nullptr);
+
+    // 流式读取单个多场景文件(JSON数组、XML列表、连续的CSV块或二进制场景库)，按读取字节计算进度
+    QList<ModelParaSetting> importArchive(const QString &filePath,
+                                          QString *errorMessage = nullptr);
+
+    // 批量导出为目录下的独立文件，文件名为"场景名称_序号.格式"，并行写入
+    bool exportFiles(const QList<ModelParaSetting> &dataList,
+                     const QString &dirPath,
+                     const QString &format,
+                     QString *errorMessage = nullptr);
+
+    // 导出为单个多场景文件，逐个场景流式写入
+    bool exportArchive(const QList<ModelParaSetting> &dataList,
+                       const QString &filePath,
+                       const QString &format,
+                       QString *errorMessage = nullptr);
+
+    // 取消正在进行的批量操作，可在任意线程调用
+    void cancel();
+    bool isCanceled() const;
+
     // 获取支持的文件格式过滤器
     static QString getFormatFilter(FileFormat format);
     static QString getAllSupportedFilters();
@@ -59,6 +91,27 @@ signals:
     void importProgress(int percent);
 
 private:
+    // 按格式写出单个场景文件，不发出进度
+    bool writeScenarioFile(const ModelParaSetting &data, const QString &filePath,
+                           const QString &format, QString *errorMessage);
+
+    // 读取一个文件中的全部场景，progress为已读字节/总字节回调
+    QList<ModelParaSetting> readScenarios(const QString &filePath, QString *errorMessage,
+                                          const std::function<void(qint64, qint64)> &progress);
+    QList<ModelParaSetting> readJsonScenarios(QFile &file, QString *errorMessage,
+                                              const std::function<void(qint64, qint64)> &progress);
+    QList<ModelParaSetting> readXmlScenarios(QFile &file, QString *errorMessage,
+                                             const std::function<void(qint64, qint64)> &progress);
+    QList<ModelParaSetting> readCsvScenarios(QFile &file,
+                                             const std::function<void(qint64, qint64)> &progress);
+    QList<ModelParaSetting> readPackScenarios(const QString &filePath, QString *errorMessage,
+                                              const std::function<void(qint64, qint64)> &progress);
+
+    // 批量操作开始时复位进度和取消标志
+    void beginBatch(int total);
+    // 完成一项后按百分比变化发出进度
+    void advanceBatch(bool import);
+
     // CSV格式处理
     bool exportToCSV(const ModelParaSetting &config, const QString &filePath, QString *errorMessage);
     ModelParaSetting importFromCSV(const QString &filePath, QString *errorMessage);
@@ -88,10 +141,19 @@ private:
     MultiPathType pathFromXml(QXmlStreamReader &reader);
     void configToXml(QXmlStreamWriter &writer, const ModelParaSetting &config) const;
     ModelParaSetting configFromXml(QXmlStreamReader &reader);
+    // 解析当前所在的ModelParaSetting节点
+    ModelParaSetting configFromXmlElement(QXmlStreamReader &reader);
     QString pathToCsvLine(const MultiPathType &path) const;
     MultiPathType pathFromCsvLine(const QString &line);
     QString configToCsv(const ModelParaSetting &config) const;
     ModelParaSetting configFromCsv(const QString &csvContent);
+    // 解析一个场景的CSV行：表头、基础参数、多径表头、多径参数
+    ModelParaSetting configFromCsvLines(const QStringList &lines);
+
+    QAtomicInt m_canceled;
+    QAtomicInt m_done;          // 批量操作已完成项数
+    QAtomicInt m_lastPercent;   // 最近一次发出的进度
+    int m_total;
 };
 
 #endif // IOHANDLER_H
@@ -0,0 +1,38 @@
+#include "lazypage.h"
+#include <QVBoxLayout>
+#include <QDebug>
+#include "startupprofiler.h"
+
+LazyPage::LazyPage(std::function<QWidget*()> factory, QWidget *parent)
+    : QWidget(parent)
+    , m_factory(std::move(factory))
+    , m_page(nullptr)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+}
+
+QWidget *LazyPage::page()
+{
+    if (!m_page && m_factory) {
+        qint64 start = StartupProfiler::elapsed();
+        m_page = m_factory();
+        layout()->addWidget(m_page);
+        qDebug() << "[延迟页面] 创建" << m_page->metaObject()->className()
+                 << "耗时:" << (StartupProfiler::elapsed() - start) << "ms";
+    }
+    return m_page;
+}
+
+bool LazyPage::isCreated() const
+{
+    return m_page != nullptr;
+}
+
+void LazyPage::showEvent(QShowEvent *event)
+{
+    // 显示前创建，避免出现空白页
+    page();
+    QWidget::showEvent(event);
+}
@@ -0,0 +1,27 @@
+#ifndef LAZYPAGE_H
+#define LAZYPAGE_H
+
+#include <QWidget>
+#include <functional>
+
+// 延迟构造的页面容器：先以空容器加入SwipeStackedWidget，
+// 第一次显示或第一次通过page()访问时才调用工厂函数创建真正的页面
+class LazyPage : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit LazyPage(std::function<QWidget*()> factory, QWidget *parent = nullptr);
+
+    // 获取页面，未创建时立即创建
+    QWidget *page();
+    bool isCreated() const;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private:
+    std::function<QWidget*()> m_factory;
+    QWidget *m_page;
+};
+
+#endif // LAZYPAGE_H
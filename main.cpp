@@ -2,34 +2,17 @@
 #include "subwindow.h"
 #include "screensaver.h"
 #include <QApplication>
-#include "fpga_driver.h"
+#include "channelengine.h"
 #include <QMessageBox>
 #include <QMetaType>
 #include "channelparaconifg.h"
-
-bool initGr(){
-    for (int gr_out = GR_OUT_1; gr_out < GR_OUT_MAX; gr_out++) {
-        int ret=set_gr_out_sel((GR_OUT_E)gr_out,DATA_SRC_ADC1_ALG);
-        if(ret != FPGA_OK) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool initJt(){
-    for (int rs_jt = RS_JT_1; rs_jt < RS_JT_MAX; rs_jt++) {
-        int ret=set_jt_out_sel((RS_JT_E)rs_jt, static_cast<DATA_SRC>(rs_jt+1));
-        if(ret != FPGA_OK) {
-            return false;
-        }
-    }
-    return true;
-}
+#include "startupprofiler.h"
+#include "asynclogger.h"
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
+    StartupProfiler::mark("QApplication");
 
     // 注册自定义类型用于跨线程信号槽传递
     qRegisterMetaType<ModelParaSetting>("ModelParaSetting");
@@ -51,32 +34,28 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("1.0");
     app.setOrganizationName("MyCompany");
 
-    // 初始化fpga
-    int ret=fpga_init();
-    if(ret!=FPGA_OK){
-        qDebug()<<"fpga init fail";
-        QMessageBox::critical(nullptr, "错误", "FPGA初始化失败");
-        return -1;
-    }else{
-        qDebug()<<"fpga init successful";
-    }
+    // PTT线程和fpga驱动的日志由后台线程写文件，需在初始化fpga前启动
+    AsyncLogger::instance()->start("channelsim.log");
+#ifdef QT_DEBUG
+    AsyncLogger::instance()->setConsoleEcho(true);
+#endif
 
-    //初始化干扰和解调
-    if(!initGr()){
-        qDebug()<<"fpga init fail";
-        QMessageBox::critical(nullptr, "错误", "FPGA初始化失败 - 干扰器初始化失败");
-        return -1;
-    }
+    // 锁内存是进程级设置，在fpga初始化和各工作线程启动之前完成
+    ChannelEngine::lockProcessMemory();
 
-    if(!initJt()){
-        qDebug()<<"fpga init fail";
-        QMessageBox::critical(nullptr, "错误", "FPGA初始化失败 - 解调器初始化失败");
+    // 初始化fpga及干扰和解调
+    QString errorMessage;
+    if (!ChannelEngine::initFpga(&errorMessage)) {
+        QMessageBox::critical(nullptr, "错误", errorMessage);
         return -1;
     }
+    StartupProfiler::mark("fpga初始化");
 
     // 创建主窗口和副窗口
     MainWindow *mainWindow = new MainWindow();
+    StartupProfiler::mark("主窗口(含数据库/PTT线程)");
     SubWindow *subWindow = new SubWindow();
+    StartupProfiler::mark("副窗口");
 
     // 设置窗口相互引用
     mainWindow->setSubWindow(subWindow);
@@ -84,7 +63,10 @@ int main(int argc, char *argv[])
 
     // 显示主窗口
     mainWindow->show();
+    StartupProfiler::mark("主窗口显示");
 
-    return app.exec();
+    int ret = app.exec();
+    AsyncLogger::instance()->stop();
+    return ret;
 }
 
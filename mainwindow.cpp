@@ -12,8 +12,6 @@
 #include <QStatusBar>
 #include <QMessageBox>
 #include <QApplication>
-#include "fpga_driver.h"
-#include "channel_utils.h"
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
@@ -23,168 +21,40 @@ MainWindow::MainWindow(QWidget *parent)
         "状态显示",
     };
     setStyleSheet("QMainWindow { background-color: #336666; }");
+
+    // 信道引擎：PTT监控线程、数据库、侦察/干扰硬件配置
+    m_engine = new ChannelEngine(this);
+    m_channelParaConfig = new ChannelParaConifg();
+
     setupUI();
     createPages();
     initDataBase();
 
 
+    // 电台状态变化时按帧合并通知，不再定时轮询
+    for (RadioStatus &shown : m_shownStatus) {
+        shown.radioState = static_cast<RadioState>(-1);
+        shown.txPower = 0;
+    }
+    connect(RadioStatusBoard::instance(), &RadioStatusBoard::statusChanged,
+            this, &MainWindow::updateStatusBar);
     updateStatusBar();
 
-    m_configManager = new ConfigManager();
-    m_channelParaConfig = new ChannelParaConifg();
-
-    // 信道管理器初始化
-    ChannelCacheManager::instance();
-
-    // 连接ChannelCacheManager的参数改变信号到槽函数
-    connect(ChannelCacheManager::instance(), &ChannelCacheManager::parameterChanged, this, &MainWindow::handleParameterChanged);
-    // 连接ChannelCacheManager的开关状态改变信号到槽函数
-    connect(ChannelCacheManager::instance(), &ChannelCacheManager::switchStateChanged, this, &MainWindow::onChannelSwitchChanged);
-
-    // 创建并启动PTT监控线程
-    m_pttMonitorThread = new PttMonitorThread(m_configManager, this);
-    m_pttMonitorThread->start();
-
-    // 创建定时器
-    m_timer = new QTimer(this);
-    connect(m_timer, &QTimer::timeout, this, &MainWindow::updateStatusBar);
-
-    // 启动定时器，每1000毫秒（1秒）触发一次
-    m_timer->start(1000);
+    // 启动PTT监控线程
+    m_engine->start();
 }
 
 MainWindow::~MainWindow()
 {
-    // 停止并释放PTT监控线程
-    if (m_pttMonitorThread) {
-        m_pttMonitorThread->stop();
-        m_pttMonitorThread->wait();
-        delete m_pttMonitorThread;
-        m_pttMonitorThread = nullptr;
-    }
-
-    // 停止并释放定时器
-    if (m_timer) {
-        m_timer->stop();
-        delete m_timer;
-        m_timer = nullptr;
-    }
-
-    // 释放配置管理器和通道参数配置
-    if (m_configManager) {
-        delete m_configManager;
-        m_configManager = nullptr;
-    }
-
     if (m_channelParaConfig) {
         delete m_channelParaConfig;
         m_channelParaConfig = nullptr;
     }
 
-    // 释放数据库管理器
-    if (m_dbManager) {
-        delete m_dbManager;
-        m_dbManager = nullptr;
-    }
-
-    int ret=fpga_deinit();
-    if(ret!=FPGA_OK){
-        qDebug()<<"fpga delete fail";
-    }
-}
-
-//配置侦察设备信道参数
-void MainWindow::setJtCfg(int chl,const ChannelSetting& config){
-    //衰减器
-    qDebug() << "[侦察设备配置] 开始配置侦察设备参数 - 信道:" << chl;
-    // 将侦察设备信道编号(7-10)转换为RS_JT_E索引(0-3)
-    int jtIndex = chl - 7;
-    int ret=set_jt_att_value((static_cast<RS_JT_E>(jtIndex)),config.signalAnt);
-    if(ret!=FPGA_OK){
-        qDebug() << "[侦察设备配置] 1、衰减器设置失败 - 信道:" << chl << " 错误码:" << ret;
-    } else {
-        qDebug() << "[侦察设备配置] 1、衰减器设置成功 - 信道:" << chl << " 值:" << config.signalAnt;
-    }
-}
-//配置干扰器信道参数
-void MainWindow::setGrCfg(int chl,const ChannelSetting& config){
-    qDebug() << "[干扰器配置] 开始配置干扰器参数 - 信道:" << chl;
-    // 将干扰器信道编号(11-15)转换为GR_OUT_E索引(0-4)
-    int grIndex = chl - 11;
-    int ret=set_gr_att((static_cast<GR_OUT_E>(grIndex)),config.signalAnt);
-    if(ret!=FPGA_OK){
-        qDebug() << "[干扰器配置] 1、衰减器设置失败 - 信道:" << chl << " 错误码:" << ret;
-    } else {
-        qDebug() << "[干扰器配置] 1、衰减器设置成功 - 信道:" << chl << " 值:" << config.signalAnt;
-    }
-}
-void MainWindow::handleParameterChanged(int channelKey, const ChannelSetting& newSetting){
-    qDebug() << "[参数变更处理] 收到参数变更通知 - 信道:" << channelKey;
-    if (IS_VALID_DYNAMIC_CHANNEL(channelKey)) { // DAC动态分配信道
-        // 处理参数变化，唤醒PTT监控线程
-        if (m_pttMonitorThread) {
-            m_pttMonitorThread->wakeUp();
-            qDebug() << "[参数变更处理] 1、DAC动态信道参数更新，唤醒PTT监控线程 - 信道:" << channelKey;
-        }
-    } else if (IS_VALID_RECON_CHANNEL(channelKey)) { // 侦察设备
-        qDebug() << "[参数变更处理] 1、侦察设备参数更新，准备配置硬件 - 信道:" << channelKey;
-        setJtCfg(channelKey,newSetting);
-    } else if (IS_VALID_JAMMER(channelKey)) { // 干扰器
-        qDebug() << "[参数变更处理] 1、干扰器参数更新，准备配置硬件 - 信道:" << channelKey;
-        setGrCfg(channelKey,newSetting);
-    } else {
-        qDebug() << "[参数变更处理] 1、无效信道参数更新 - 信道:" << channelKey;
-    }
-}
-
-// 控制侦察设备的开关状态
-int MainWindow::setReconSw(int chl, bool flag)
-{
-    qDebug() << "[侦察设备配置] 开始设置侦察设备开关状态 - 信道:" << chl;
-    // 将侦察设备信道编号(7-10)转换为RS_JT_E索引(0-3)
-    int jtIndex = chl - 7;
-    int retsw = set_jt_sw(static_cast<RS_JT_E>(jtIndex), flag);
-
-    if (retsw != FPGA_OK) {
-        qDebug() << "[侦察设备配置] 1、开关状态设置失败 - 信道:" << chl << " 错误码:" << retsw;
-    } else {
-        qDebug() << "[侦察设备配置] 1、开关状态设置成功 - 信道:" << chl << " 值:" << flag;
-    }
-
-    return retsw;
-}
-
-// 控制干扰器的开关状态
-int MainWindow::setJammerSw(int chl, bool flag)
-{
-    qDebug() << "[干扰器配置] 开始设置干扰器开关状态 - 信道:" << chl;
-    // 将干扰器信道编号(11-15)转换为GR_OUT_E索引(0-4)
-    int grIndex = chl - 11;
-    int retsw = set_gr_sw(static_cast<GR_OUT_E>(grIndex), flag);
-
-    if (retsw != FPGA_OK) {
-        qDebug() << "[干扰器配置] 1、开关状态设置失败 - 信道:" << chl << " 错误码:" << retsw;
-    } else {
-        qDebug() << "[干扰器配置] 1、开关状态设置成功 - 信道:" << chl << " 值:" << flag;
-    }
-
-    return retsw;
-}
-
-void MainWindow::onChannelSwitchChanged(int channelNum, bool switchFlag)
-{
-    qDebug() << "接收到通道开关状态变化信号: channel=" << channelNum << ", switchFlag=" << switchFlag;
-    // 信道开关控制
-    if (IS_VALID_DYNAMIC_CHANNEL(channelNum)) { // DAC动态分配信道
-        // 处理参数变化，唤醒PTT监控线程
-        if (m_pttMonitorThread) {
-            m_pttMonitorThread->wakeUp();
-            qDebug() << "开关状态变化，唤醒PTT监控线程,信道编号:" << channelNum;
-        }
-    } else if (IS_VALID_RECON_CHANNEL(channelNum)) { // 侦察设备
-        setReconSw(channelNum, switchFlag);
-    } else if (IS_VALID_JAMMER(channelNum)) { // 干扰器
-        setJammerSw(channelNum, switchFlag);
+    // 停止PTT监控线程并释放fpga
+    if (m_engine) {
+        delete m_engine;
+        m_engine = nullptr;
     }
 }
 
@@ -452,36 +322,52 @@ void MainWindow::initWindowSize()
 void MainWindow::createPages()
 {
     m_channelSelect = new ChannelSelect(m_stackedWidget);
-    m_simuListView = new SimuListView(m_stackedWidget);
+    // 模拟列表启动时不可见，延迟创建；系统设置负责MQTT连接，需立即创建
+    // 页面首次显示时数据库已打开，填入场景库摘要
+    ChannelEngine *engine = m_engine;
+    m_simuListPage = new LazyPage([engine]() {
+        SimuListView *view = new SimuListView();
+        view->setScenarioLibrary(engine->scenarioLibrary());
+        return view;
+    }, m_stackedWidget);
     m_systmSetting = new SystemSetting(m_stackedWidget);
     m_stackedWidget->addWidget(m_channelSelect);
-    m_stackedWidget->addWidget(m_simuListView);
+    m_stackedWidget->addWidget(m_simuListPage);
     m_stackedWidget->addWidget(m_systmSetting);
 
     // 连接ChannelSelect的通道开关状态变化信号
-    connect(m_channelSelect, &ChannelSelect::channelSwitchChanged, this, &MainWindow::onChannelSwitchChanged);
+    connect(m_channelSelect, &ChannelSelect::channelSwitchChanged, m_engine, &ChannelEngine::onChannelSwitchChanged);
+
+    // 页面内容变化后切换动画中的快照过期
+    connect(m_channelSelect, &ChannelSelect::channelSwitchChanged, this, [this]() {
+        invalidatePageSnapshot(m_channelSelect);
+    });
+    connect(engine->scenarioLibrary(), &ScenarioLibrary::summariesChanged, this, [this]() {
+        invalidatePageSnapshot(m_simuListPage);
+    });
 
     m_stackedWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
     m_pageIndicator->setCurrentIndex(0);
 }
 
+void MainWindow::invalidatePageSnapshot(QWidget *page)
+{
+    m_stackedWidget->invalidateSnapshot(m_stackedWidget->indexOf(page));
+}
+
+SimuListView *MainWindow::simuListView()
+{
+    return static_cast<SimuListView *>(m_simuListPage->page());
+}
+
 void MainWindow::initDataBase()
 {
     // 初始化数据库
-    m_dbManager = new DatabaseManager(this);
-    if (!m_dbManager->openDatabase("channel.db")) {
-        QMessageBox::critical(this, "Error", "Failed to open database!");
-        return;
+    QString errorMessage;
+    if (!m_engine->initDataBase("channel.db", &errorMessage)) {
+        QMessageBox::critical(this, "Error", errorMessage);
     }
-
-    if (!m_dbManager->createTable()) {
-        QMessageBox::critical(this, "Error", "Failed to create table!");
-        return;
-    }
-
-    // 获取数据库中数据
-    m_dbManager->getAllConfigs();
 }
 
 void MainWindow::onSwipeFinished()
@@ -546,12 +432,17 @@ int MainWindow::getChannelNum()
 
 void MainWindow::setChannelPara(const ModelParaSetting &config)
 {
-    m_configManager->addConfigToMap(config.modelName, config);
-    m_dbManager->insertParaConfig(config);
-    m_simuListView->insertScenarioData(config);
+    // 场景库写数据库并更新摘要和缓存
+    m_engine->scenarioLibrary()->save(config);
+    simuListView()->insertScenarioData(config);
     m_channelParaConfig->setChannelConfig(config);
 }
 
+ScenarioLibrary *MainWindow::scenarioLibrary() const
+{
+    return m_engine->scenarioLibrary();
+}
+
 QString MainWindow::getStatusStyle(const QString &status)
 {
     if (status == "发射" || status == "接收") {
@@ -567,86 +458,44 @@ QString MainWindow::getStatusStyle(const QString &status)
     }
 }
 
-void MainWindow::updateStatusBar()
+void MainWindow::updateStatusBar(quint32 radioMask)
 {
-    QMutexLocker locker(&globalMutex);
-    switch(globalStatusMap[1].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label1->setText(QString("电台1:停止"));
-        m_indicator1->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label1->setText(QString("电台1:接收"));
-        m_indicator1->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label1->setText(QString("电台1:发射，%1dbm").arg(globalStatusMap[1].txPower));
-        m_indicator1->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label1->setText(QString("电台1:发射，%1dbm").arg(globalStatusMap[1].txPower));
-        m_indicator1->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
-
-    switch(globalStatusMap[2].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label2->setText(QString("电台2:停止"));
-        m_indicator2->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label2->setText(QString("电台2:接收"));
-        m_indicator2->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label2->setText(QString("电台2:发射，%1dbm").arg(globalStatusMap[2].txPower));
-        m_indicator2->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label2->setText(QString("电台2:发射，%1dbm").arg(globalStatusMap[2].txPower));
-        m_indicator2->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
+    QLabel *labels[RadioStatusBoard::RADIO_COUNT] = {m_label1, m_label2, m_label3, m_label4};
+    QLabel *indicators[RadioStatusBoard::RADIO_COUNT] = {m_indicator1, m_indicator2, m_indicator3, m_indicator4};
+
+    // 只刷新有变化的电台；收发状态不变时不重设样式表，避免重新解析样式
+    RadioStatusBoard *board = RadioStatusBoard::instance();
+    for (int radio = 1; radio <= RadioStatusBoard::RADIO_COUNT; radio++) {
+        if (!(radioMask & (1u << (radio - 1)))) {
+            continue;
+        }
+        RadioStatus status = board->status(radio);
+        RadioStatus &shown = m_shownStatus[radio - 1];
+        bool stateChanged = status.radioState != shown.radioState;
+        bool showPower = status.radioState == RADIO_TRANSMIT || status.radioState == RADIO_ALARM;
+        if (!stateChanged && !(showPower && status.txPower != shown.txPower)) {
+            continue;
+        }
 
-    switch(globalStatusMap[3].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label3->setText(QString("电台3:停止"));
-        m_indicator3->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label3->setText(QString("电台3:接收"));
-        m_indicator3->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label3->setText(QString("电台3:发射，%1dbm").arg(globalStatusMap[3].txPower));
-        m_indicator3->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label3->setText(QString("电台3:发射，%1dbm").arg(globalStatusMap[3].txPower));
-        m_indicator3->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
+        QLabel *label = labels[radio - 1];
+        switch (status.radioState)
+        {
+        case RADIO_DISABLE:
+            label->setText(QString("电台%1:停止").arg(radio));
+            break;
+        case RADIO_RECEIVE:
+            label->setText(QString("电台%1:接收").arg(radio));
+            break;
+        case RADIO_TRANSMIT:
+        case RADIO_ALARM:
+            label->setText(QString("电台%1:发射，%2dbm").arg(radio).arg(status.txPower));
+            break;
+        }
 
-    switch(globalStatusMap[4].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label4->setText(QString("电台4:停止"));
-        m_indicator4->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label4->setText(QString("电台4:接收"));
-        m_indicator4->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label4->setText(QString("电台4:发射，%1dbm").arg(globalStatusMap[4].txPower));
-        m_indicator4->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label4->setText(QString("电台4:发射，%1dbm").arg(globalStatusMap[4].txPower));
-        m_indicator4->setStyleSheet(getStatusStyle("警告"));
-        break;
+        if (stateChanged) {
+            static const char *styleNames[] = {"停止", "接收", "发射", "警告"};
+            indicators[radio - 1]->setStyleSheet(getStatusStyle(styleNames[status.radioState]));
+        }
+        shown = status;
     }
 }
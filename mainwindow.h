@@ -10,10 +10,8 @@
 #include "channelselect.h"
 #include "simulistview.h"
 #include "systemsetting.h"
-#include "configmanager.h"
-#include "databasemanager.h"
-#include "PttMonitorThread.h"
-#include "channelcachemanager.h"
+#include "channelengine.h"
+#include "lazypage.h"
 class SwipeStackedWidget;
 class PageIndicator;
 class SubWindow;
@@ -30,6 +28,7 @@ public:
     void setSubWindow(SubWindow *subWindow);
     int getChannelNum();
     void setChannelPara(const ModelParaSetting &config);
+    ScenarioLibrary *scenarioLibrary() const;
 
 private slots:
     void onSwipeFinished();
@@ -40,36 +39,28 @@ private slots:
 
 public slots:
     void goToNextWindow();
-    void updateStatusBar();
+    // 刷新状态栏，radioMask为需要刷新的电台
+    void updateStatusBar(quint32 radioMask = RadioStatusBoard::ALL_RADIOS);
 
-private slots:
-    // 处理参数变化信号的槽函数
-    void handleParameterChanged(int channelKey, const ChannelSetting& newSetting);
-    // 处理通道开关状态变化信号的槽函数
-    void onChannelSwitchChanged(int channelNum, bool switchFlag);
 private:
+    // 页面内容变化后使其切换快照失效
+    void invalidatePageSnapshot(QWidget *page);
     void setupUI();
     void initWindowSize();
     void createPages();
+    // 模拟列表页面，未创建时立即创建
+    SimuListView *simuListView();
     // 初始化数据库
     void initDataBase();
 
     void setBtnSize(int width,int height);
 
-    // 控制侦察设备的开关状态
-    int setReconSw(int chl, bool flag);
-    // 控制干扰器的开关状态
-    int setJammerSw(int chl, bool flag);
-    //配置侦察设备信道参数
-    void setJtCfg(int chl,const ChannelSetting& config);
-    //配置干扰器信道参数
-    void setGrCfg(int chl,const ChannelSetting& config);
-
     // 获取电台状态样式
     QString getStatusStyle(const QString &status);
     SubWindow *m_subWindow;  // 副窗口引用
 
-    QTimer *m_timer;
+    // 状态栏当前显示的电台状态
+    RadioStatus m_shownStatus[RadioStatusBoard::RADIO_COUNT];
     QLabel *m_label1;
     QLabel *m_label2;
     QLabel *m_label3;
@@ -89,13 +80,11 @@ private:
     QPushButton *m_exitButton;
 
     ChannelSelect *m_channelSelect;
-    SimuListView *m_simuListView;
+    LazyPage *m_simuListPage;   // 模拟列表页面延迟到第一次显示或插入数据时创建
     SystemSetting *m_systmSetting;
 
-    DatabaseManager *m_dbManager;
-    ConfigManager *m_configManager;
+    ChannelEngine *m_engine;
     ChannelParaConifg *m_channelParaConfig;
-    PttMonitorThread *m_pttMonitorThread;
 
 };
 
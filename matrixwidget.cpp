@@ -1,7 +1,6 @@
 #include <QDebug>
 #include <QTimer>
-#include <QLabel>
-#include <QVBoxLayout>
+#include <QPainter>
 #include <QMessageBox>
 #include "datamanager.h"
 #include "matrixwidget.h"
@@ -12,6 +11,56 @@
 // 定义开关颜色常量
 const QColor MatrixWidget::SWITCH_COLOR_ON = QColor("#2E7D32");  // 绿色
 const QColor MatrixWidget::SWITCH_COLOR_OFF = QColor("#8B2323"); // 红色
+
+MatrixCellDelegate::MatrixCellDelegate(QWidget *parent)
+    : QStyledItemDelegate(parent)
+{
+    m_font = parent ? parent->font() : QFont();
+    m_font.setBold(true);
+    m_font.setPointSize(18);
+    m_raisedFont = m_font;
+    m_raisedFont.setPixelSize(12);
+
+    m_textPen = QPen(parent ? parent->palette().color(QPalette::Text) : QColor(Qt::black));
+    m_raisedTextPen = QPen(QColor(Qt::white));
+    m_lightPen = QPen(QColor("#d0d0d0"), 4, Qt::SolidLine, Qt::SquareCap, Qt::MiterJoin);
+    m_darkPen = QPen(QColor("#707070"), 4, Qt::SolidLine, Qt::SquareCap, Qt::MiterJoin);
+}
+
+void MatrixCellDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                               const QModelIndex &index) const
+{
+    const QRect rect = option.rect;
+    painter->save();
+
+    // 背景色由item设置(开关状态/空白单元格)
+    QVariant background = index.data(Qt::BackgroundRole);
+    if (background.canConvert<QBrush>()) {
+        painter->fillRect(rect, background.value<QBrush>());
+    }
+
+    bool raised = index.data(RaisedRole).toBool();
+    if (raised) {
+        // 立体凸起边框：左上亮、右下暗，与原outset边框效果一致
+        QRect r = rect.adjusted(4, 4, -4, -4);
+        const QPoint lightEdge[3] = {r.bottomLeft(), r.topLeft(), r.topRight()};
+        const QPoint darkEdge[3] = {r.topRight(), r.bottomRight(), r.bottomLeft()};
+        painter->setPen(m_darkPen);
+        painter->drawPolyline(darkEdge, 3);
+        painter->setPen(m_lightPen);
+        painter->drawPolyline(lightEdge, 3);
+    }
+
+    QVariant text = index.data(Qt::DisplayRole);
+    if (text.isValid()) {
+        painter->setFont(raised ? m_raisedFont : m_font);
+        painter->setPen(raised ? m_raisedTextPen : m_textPen);
+        painter->drawText(rect, Qt::AlignCenter, text.toString());
+    }
+
+    painter->restore();
+}
+
 MatrixWidget::MatrixWidget(QWidget *parent)
     : QTableWidget(5, 5, parent)
     , m_longPressTimer(new QTimer(this))
@@ -28,6 +77,10 @@ MatrixWidget::MatrixWidget(QWidget *parent)
         m_switchStates.insert(i, OFF);
     }
 
+    // 单元格统一由委托绘制
+    setItemDelegate(new MatrixCellDelegate(this));
+    setSelectionMode(QAbstractItemView::NoSelection);
+
     // 初始化表头
     initHeaders();
 
@@ -46,7 +99,6 @@ MatrixWidget::MatrixWidget(QWidget *parent)
 #else
     // 启用鼠标跟踪
     setMouseTracking(true);
-    setSelectionMode(QAbstractItemView::NoSelection);
     connect(this, &QTableWidget::cellClicked, this, &MatrixWidget::changeCellColor);
     qDebug() << "使用鼠标事件模式";
 #endif
@@ -70,19 +122,8 @@ void MatrixWidget::initHeaders()
     horizontalHeader()->setStyleSheet("QHeaderView::section {color:#FFFFFF; font-weight: bold;font-size: 18pt; background-color: #2A3B38;}");
     verticalHeader()->setStyleSheet("QHeaderView::section {color:#FFFFFF; font-weight: bold; font-size: 18pt;background-color: #2A3B38;}");
 
+    // 单元格外观由MatrixCellDelegate绘制，这里只设置角按钮
     this->setStyleSheet(
-        "QTableWidget::item {"
-        "   font-weight: bold;"
-        "   font-size: 18pt;"
-        "}"
-        "QTableWidget::item:selected {"
-        "   background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "                               stop: 0 #f0f0f0, stop: 1 #e0e0e0);"
-        "   border: 2px outset #909090;"
-        "   border-radius: 3px;"
-        "   font-weight: bold;"
-        "   font-size: 18pt;"
-        "}"
         "QTableWidget QTableCornerButton::section {"
         "   background-color: #2A3B38;"
         "}"
@@ -108,12 +149,13 @@ void MatrixWidget::initCells()
 
             int channelNum = channelMap[row][col];
             if (channelNum != -1) {
-                item->setBackground(SWITCH_COLOR_OFF); // 使用红色常量作为默认关闭状态
+                // 开关状态取自信道缓存（热重启时为恢复的状态，否则默认关闭）
+                bool switchOn = ChannelCacheManager::instance()->getChannelSetting(channelNum).switchFlag;
+                item->setBackground(switchOn ? SWITCH_COLOR_ON : SWITCH_COLOR_OFF);
                 // 将数字存储在item的自定义属性中
                 item->setData(Qt::UserRole, channelNum);
                 item->setText(QString::number(channelNum));
-                // 设置开关状态（默认关闭）
-                m_switchStates[channelNum] = OFF;
+                m_switchStates[channelNum] = switchOn ? ON : OFF;
             } else {
                 item->setBackground(QColor("#336666")); // 无数字的单元格显示背景色
             }
@@ -147,8 +189,8 @@ void MatrixWidget::handleTouchClick(int row, int column)
 
         // 无论开关状态如何，都可以创建凸起效果
         if (row == m_highlightedRow && column == m_highlightedCol) {
-            // 消除凸起效果的widget
-            removeCellWidget(row, column);
+            // 消除凸起效果
+            setCellRaised(row, column, false);
             m_highlightedRow = -1;
             m_highlightedCol = -1;
             m_selectedChannel = 0;
@@ -160,11 +202,11 @@ void MatrixWidget::handleTouchClick(int row, int column)
             if (m_highlightedRow != -1 && m_highlightedCol != -1)
             {
                 // 消除之前的凸起效果
-                removeCellWidget(m_highlightedRow, m_highlightedCol);
+                setCellRaised(m_highlightedRow, m_highlightedCol, false);
             }
 
-            // 创建凸起效果的widget
-            createRaisedCellWidget(row, column, item);
+            // 创建凸起效果
+            setCellRaised(row, column, true);
             m_highlightedRow = row;
             m_highlightedCol = column;
             m_selectedChannel = channelNum;
@@ -191,7 +233,7 @@ void MatrixWidget::handleTouchLongPress(int row, int column)
         // 更新开关状态
         setSwitchState(channelNum, newState);
 
-        // 设置新的背景颜色
+        // 设置新的背景颜色，凸起的单元格同样按背景色重绘
         item->setBackground(newState == ON ? SWITCH_COLOR_ON : SWITCH_COLOR_OFF);
 
         // 输出调试信息
@@ -201,15 +243,6 @@ void MatrixWidget::handleTouchLongPress(int row, int column)
             qDebug() << "长按变色 - 绿→红 行:" << row << "列:" << column << "开关状态:关" << "信道编号:" << channelNum;
         }
 
-        // 开关状态切换后，如果该单元格有凸起效果，更新凸起效果的背景色
-        if (row == m_highlightedRow && column == m_highlightedCol) {
-            // 先移除旧的凸起效果
-            removeCellWidget(row, column);
-            // 重新创建带有新颜色的凸起效果
-            createRaisedCellWidget(row, column, item);
-            qDebug() << "颜色改变，更新凸起效果背景色";
-        }
-
         m_pressedChannel = channelNum;
 
         // 更新ChannelCacheManager中的通道开关状态
@@ -218,53 +251,14 @@ void MatrixWidget::handleTouchLongPress(int row, int column)
     }
 }
 
-// 创建凸起效果的widget
-void MatrixWidget::createRaisedCellWidget(int row, int column, QTableWidgetItem *item)
+// 设置单元格凸起效果
+void MatrixWidget::setCellRaised(int row, int column, bool raised)
 {
-    // 创建凸起效果的widget
-    QWidget *cellWidget = new QWidget();
-    
-    // 获取通道号和开关状态，使用对应颜色
-    int channelNum = item->data(Qt::UserRole).toInt();
-    SwitchState state = getSwitchState(channelNum);
-    QColor bgColor = (state == ON) ? SWITCH_COLOR_ON : SWITCH_COLOR_OFF;
-    
-    QString styleSheet = QString(
-                             "QWidget {"
-                             "   border: 4px outset #a0a0a0;"
-                             "   background-color: %1;"
-                             "   border-radius: 6px;"
-                             "}"
-                             ).arg(bgColor.name());
-
-    cellWidget->setStyleSheet(styleSheet);
-
-    QLabel *label = new QLabel(item->text());
-    label->setAlignment(Qt::AlignCenter);
-    label->setStyleSheet(
-        "QLabel {"
-        "   color: white;"
-        "   font-weight: bold;"
-        "   font-size: 12px;"
-        "}"
-        );
-
-    QVBoxLayout *layout = new QVBoxLayout(cellWidget);
-    layout->setContentsMargins(4, 4, 4, 4);
-    layout->addWidget(label);
-
-    this->setCellWidget(row, column, cellWidget);
-}
-
-// 移除单元格widget
-void MatrixWidget::removeCellWidget(int row, int column)
-{
-    // 移除单元格widget，恢复为普通的QTableWidgetItem
-    QWidget *widget = cellWidget(row, column);
-    if (widget) {
-        widget->deleteLater();
+    QTableWidgetItem *item = this->item(row, column);
+    if (item) {
+        // 数据变化只触发该单元格重绘
+        item->setData(MatrixCellDelegate::RaisedRole, raised);
     }
-    setCellWidget(row, column, nullptr);
 }
 #ifdef  USE_TOUCH_EVENT
 // 触摸事件处理
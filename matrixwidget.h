@@ -6,6 +6,31 @@
 #include <QTouchEvent>
 #include <QMouseEvent>
 #include <QHeaderView>
+#include <QStyledItemDelegate>
+#include <QPen>
+#include <QFont>
+
+// 矩阵单元格绘制：背景色取自item，选中(凸起)的单元格画立体边框
+// 画笔和字体构造时创建，绘制时不解析样式表、不创建控件
+class MatrixCellDelegate : public QStyledItemDelegate
+{
+public:
+    // item中标记凸起效果的数据角色
+    static const int RaisedRole = Qt::UserRole + 1;
+
+    explicit MatrixCellDelegate(QWidget *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+
+private:
+    QFont m_font;
+    QFont m_raisedFont;
+    QPen m_textPen;
+    QPen m_raisedTextPen;
+    QPen m_lightPen;    // 凸起边框左上亮边
+    QPen m_darkPen;     // 凸起边框右下暗边
+};
 
 class MatrixWidget : public QTableWidget
 {
@@ -59,8 +84,8 @@ signals:
     void channelSwitchChanged(int channelNum, bool switchFlag);
 private:
     void initHeaders();
-    void createRaisedCellWidget(int row, int column, QTableWidgetItem *item);
-    void removeCellWidget(int row, int column);
+    // 设置/取消单元格凸起效果，只重绘该单元格
+    void setCellRaised(int row, int column, bool raised);
 
     QTimer *m_longPressTimer;
 
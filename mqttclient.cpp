@@ -9,7 +9,8 @@ MqttClient::MqttClient(QObject *parent) : QObject(parent)
     // 创建默认解析器
     m_parser = new MqttMessageParser(this);
 
-    m_timer = new QTimer();
+    // 以this为父对象，随MqttClient一起移到MQTT线程
+    m_timer = new QTimer(this);
 
     initConnections();
 
@@ -140,6 +141,8 @@ void MqttClient::onStateChanged(QMqttClient::ClientState state)
         break;
     case QMqttClient::Connected:
         qDebug() << "已成功连接到MQTT服务器";
+        // 重连后重新上报完整内容
+        m_reportBuilder.invalidate();
         // 连接成功后，处理所有缓存的订阅请求
         processPendingSubscriptions();
         break;
@@ -181,7 +184,18 @@ void MqttClient::onMessageReceived(const QByteArray &message, const QMqttTopicNa
     }
     else if(topic == CHANNEL_SIMU_PARAM)
     {
-        m_parser->parseChannelParamJson(topic, message);
+        // 上报编码跟随最近一条可解码的参数消息：下发端改用CBOR或切回JSON时上报随之切换
+        MessageFormat format = m_parser->parseChannelParamJson(topic, message);
+        ReportEncoding encoding = m_reportBuilder.encoding();
+        if (format == MessageFormat::CBOR) {
+            encoding = ReportEncoding::Cbor;
+        } else if (format == MessageFormat::JSON) {
+            encoding = ReportEncoding::Json;
+        }
+        if (encoding != m_reportBuilder.encoding()) {
+            qDebug() << "参数消息格式变化，上报切换为" << (encoding == ReportEncoding::Cbor ? "CBOR" : "JSON");
+            setReportEncoding(encoding);
+        }
         //emit paramMessageReceived(topic, message);
     }
     else if(topic == EXAM_END_TOPIC)
@@ -194,28 +208,27 @@ void MqttClient::onMessageReceived(const QByteArray &message, const QMqttTopicNa
     }
 }
 
+void MqttClient::setReportEncoding(ReportEncoding encoding)
+{
+    m_reportBuilder.setEncoding(encoding);
+}
+
 void MqttClient::onHeartBeats()
 {
     if(!m_connected) return;
 
-    QVariantMap HeartbeatParam;
-    QByteArray payload;
-    HeartbeatParam["state"] = 0x00;
-    payload = m_parser->createJsonMessage(HeartbeatParam);
-    publish(CHANNEL_HERAT_BEAT, payload, 0, false);
-
-    QVariantMap ChannelParam;
-    QByteArray payload1;
-    ChannelParam["ExamID"] = 12345;
-    ChannelParam["channelNum"] = 1;
-    ChannelParam["BitErrorRate"] = "10%";
-    ChannelParam["PacketLossRate"] = "5%";
-    ChannelParam["DataRate"] = "100";
-    payload1 = m_parser->createJsonMessage(ChannelParam);
-    publish(CHANNEL_STATUS_REPORT, payload1, 0, false);
-
-    QByteArray payload2;
-    payload2 = m_parser->createChannelParamJsonMessage();
-    publish(CHANNEL_PARAM_REPORT, payload2, 0, false);
+    publish(CHANNEL_HERAT_BEAT, m_reportBuilder.heartbeat(), 0, false);
+
+    // 状态和参数上报只在内容变化时发送，以retain发布，新订阅者可立即拿到最新内容
+    QString examID = m_parser->currentExamID();
+    bool changed = false;
+    QByteArray statusPayload = m_reportBuilder.channelStatusReport(examID, &changed);
+    if (changed) {
+        publish(CHANNEL_STATUS_REPORT, statusPayload, 0, true);
+    }
 
+    QByteArray paramPayload = m_reportBuilder.channelParamReport(examID, &changed);
+    if (changed) {
+        publish(CHANNEL_PARAM_REPORT, paramPayload, 0, true);
+    }
 }
@@ -5,6 +5,7 @@
 #include <QTimer>
 #include <QtMqtt/qmqttclient.h>
 #include "mqttmessageparser.h"
+#include "reportbuilder.h"
 
 #define EXAM_START_TOPIC            "0000020001/0000010001/00FF/0001"
 #define EXAM_END_TOPIC              "0000020001/0000010001/00FF/0003"
@@ -49,6 +50,9 @@ public:
     void publishJson(const QString &topic, const QVariantMap &data, quint8 qos = 0, bool retain = false);
     void publishText(const QString &topic, const QString &text, quint8 qos = 0, bool retain = false);
 
+    // 上报编码，默认JSON；收到CBOR格式的信道参数消息时自动切换为CBOR
+    void setReportEncoding(ReportEncoding encoding);
+
 signals:
     // 连接状态变化信号
     void connectionStatusChanged(bool connected);
@@ -82,6 +86,7 @@ private:
     bool m_connected;
     MqttMessageParser *m_parser;
     QTimer *m_timer;
+    ReportBuilder m_reportBuilder;  // 上报内容缓存，未变化时不重复组包和发送
 };
 
 #endif // MQTTCLIENT_H
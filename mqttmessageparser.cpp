@@ -1,6 +1,50 @@
 #include "mqttmessageparser.h"
 #include <QDebug>
 #include <QRegularExpression>
+#include <QSet>
+#include <QCborValue>
+#include <QCborMap>
+#include "channel_utils.h"
+#include "channelcachemanager.h"
+#include "channelparamqueue.h"
+#include "telemetryrecorder.h"
+
+// ExamID超出int范围，可能以字符串或数字下发
+static QString examIdToString(const QJsonValue &value)
+{
+    if (value.isString()) {
+        return value.toString();
+    }
+    if (value.isDouble()) {
+        return QString::number(static_cast<qint64>(value.toDouble()));
+    }
+    return QString();
+}
+
+// 信道参数消息中数值字段可能是字符串也可能是数字
+static bool jsonToInt(const QJsonValue &value, int *out)
+{
+    bool ok = false;
+    if (value.isDouble()) {
+        *out = value.toInt();
+        ok = true;
+    } else if (value.isString()) {
+        *out = value.toString().toInt(&ok);
+    }
+    return ok;
+}
+
+static bool jsonToDouble(const QJsonValue &value, double *out)
+{
+    bool ok = false;
+    if (value.isDouble()) {
+        *out = value.toDouble();
+        ok = true;
+    } else if (value.isString()) {
+        *out = value.toString().toDouble(&ok);
+    }
+    return ok;
+}
 
 MqttMessageParser::MqttMessageParser(QObject *parent) : QObject(parent)
 {
@@ -27,6 +71,11 @@ ParsedMessage MqttMessageParser::parseMessage(const QString &topic, const QByteA
         result.isValid = !result.data.isNull();
         break;
 
+    case MessageFormat::CBOR:
+        result.data = parseCbor(payload, result.errorString);
+        result.isValid = !result.data.isNull();
+        break;
+
     case MessageFormat::PlainText:
         result.data = parseText(payload);
         result.isValid = true;
@@ -66,6 +115,20 @@ MessageFormat MqttMessageParser::detectFormat(const QByteArray &payload)
         return MessageFormat::PlainText;
     }
 
+    // 检测CBOR：自描述标签55799(D9 D9 F7)，或首字节为map(0xA0-0xBF)且能完整解码
+    // 0xA0-0xBF不是UTF-8首字节，文本和JSON不会以此开头
+    const unsigned char first = static_cast<unsigned char>(payload.at(0));
+    if (payload.startsWith("\xD9\xD9\xF7")) {
+        return MessageFormat::CBOR;
+    }
+    if (first >= 0xA0 && first <= 0xBF) {
+        QCborParserError cborError;
+        QCborValue::fromCbor(payload, &cborError);
+        if (cborError.error == QCborError::NoError) {
+            return MessageFormat::CBOR;
+        }
+    }
+
     // 尝试检测JSON
     QByteArray trimmed = payload.trimmed();
     if ((trimmed.startsWith('{') && trimmed.endsWith('}')) ||
@@ -90,6 +153,21 @@ MessageFormat MqttMessageParser::detectFormat(const QByteArray &payload)
     return MessageFormat::Binary;
 }
 
+QVariant MqttMessageParser::parseCbor(const QByteArray &payload, QString &error)
+{
+    QCborParserError cborError;
+    QCborValue value = QCborValue::fromCbor(payload, &cborError);
+    if (cborError.error != QCborError::NoError) {
+        error = cborError.errorString();
+        return QVariant();
+    }
+    // 去掉自描述标签
+    if (value.isTag()) {
+        value = value.taggedValue();
+    }
+    return value.toVariant();
+}
+
 QVariant MqttMessageParser::parseJson(const QByteArray &payload, QString &error)
 {
     QJsonParseError parseError;
@@ -158,6 +236,11 @@ void MqttMessageParser::parseExamStartJson(const QString& topic, const QByteArra
     qDebug() << "device_name:" << deviceName;
     qDebug() << "device_model:" << deviceModel;
     qDebug() << "op:" << op;
+
+    m_currentExamID = examIdToString(jsonObj["ExamID"]);
+
+    // 以ExamID记录本场考试的遥测历史
+    TelemetryRecorder::instance()->beginExam(m_currentExamID);
 }
 
 void MqttMessageParser::parseExamEndJson(const QString& topic, const QByteArray& payload)
@@ -194,78 +277,195 @@ void MqttMessageParser::parseExamEndJson(const QString& topic, const QByteArray&
         qDebug() << "检测到op=0，执行对应逻辑...";
         // 这里添加op=0时的处理代码
     }
+
+    m_currentExamID.clear();
+    TelemetryRecorder::instance()->endExam();
 }
 
-void MqttMessageParser::parseChannelParamJson(const QString& topic, const QByteArray& payload)
+MessageFormat MqttMessageParser::parseChannelParamJson(const QString& topic, const QByteArray& payload)
 {
-    // 解析顶层JSON
-    QJsonParseError parseError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(payload, &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "JSON解析失败：" << parseError.errorString();
-        return;
+    qint64 receivedNs = ChannelParamQueue::nowNs();
+    QString examID;
+    QList<ModelParaSetting> settings;
+    QString error;
+    MessageFormat format = MessageFormat::Unknown;
+    if (!parseChannelParams(payload, &examID, &settings, &error, &format)) {
+        qWarning() << "信道参数消息无效：" << error;
+        emit parseError(topic, error);
+        return format;
     }
-    if (!jsonDoc.isObject()) {
-        qWarning() << "消息不是JSON对象";
-        return;
+
+    // 整条消息作为一个批次交给PTT监控线程，由其写入缓存并在同一轮下发硬件
+    ChannelParamBatch batch;
+    batch.examID = examID;
+    batch.receivedNs = receivedNs;
+    for (const ModelParaSetting &config : settings) {
+        ChannelSetting setting;
+        setting.channelNum = config.channelNum;
+        setting.signalAnt = config.signalAnt;
+        setting.filterNum = config.filterNum;
+        setting.multipathType = config.multipathType;
+        batch.settings.append(setting);
+    }
+    if (!ChannelParamQueue::instance()->push(batch)) {
+        qWarning() << "信道参数队列已满，丢弃消息 ExamID:" << examID;
+        emit parseError(topic, "信道参数队列已满");
+        return format;
     }
-    QJsonObject rootObj = jsonDoc.object();
 
-    // 提取顶层字段
-    QString examID = rootObj["ExamID"].toString(); // 大整数转字符串
-    qDebug() << "ExamID:" << examID;
+    m_currentExamID = examID;
+    qDebug() << "信道参数消息已入队 ExamID:" << examID << "信道数:" << settings.size();
+    emit channelParamsApplied(examID, settings);
+    return format;
+}
 
-    // 解析第一层嵌套：ModelParaSetting
-    if (rootObj.contains("ModelParaSetting") && rootObj["ModelParaSetting"].isObject()) {
-        QJsonObject modelObj = rootObj["ModelParaSetting"].toObject();
-
-        // 提取ModelParaSetting的字段
-        QString modelType = modelObj["modelType"].toString();
-        QString modelName = modelObj["modelName"].toString();
-        QString channelNum = modelObj["channelNum"].toString();
-        QString channelID = modelObj["channelID"].toString();
-        QString noisePower = modelObj["noisePower"].toString();
-        QString signalAnt = modelObj["signalAnt"].toString();
-        QString comDistance = modelObj["comDistance"].toString();
-        QString filterNum = modelObj["filterNum"].toString();
-        QString multipathNum = modelObj["multipathNum"].toString();
-
-        // 打印第一层嵌套字段
-        qDebug() << "\nModelParaSetting:";
-        qDebug() << "modelType:" << modelType;
-        qDebug() << "modelName:" << modelName;
-        qDebug() << "channelNum:" << channelNum;
-        qDebug() << "channelID:" << channelID;
-        qDebug() << "noisePower:" << noisePower;
-        qDebug() << "signalAnt:" << signalAnt;
-        qDebug() << "comDistance:" << comDistance;
-        qDebug() << "filterNum:" << filterNum;
-        qDebug() << "multipathNum:" << multipathNum;
-
-        // 解析第二层嵌套：MultiPath（在ModelParaSetting内部）
-        if (modelObj.contains("MultiPath") && modelObj["MultiPath"].isObject()) {
-            QJsonObject multiPathObj = modelObj["MultiPath"].toObject();
-
-            // 提取MultiPath的字段
-            QString pathNum = multiPathObj["pathNum"].toString();
-            QString relativDelay = multiPathObj["relativDelay"].toString();
-            QString antPower = multiPathObj["antPower"].toString();
-            QString freShift = multiPathObj["freShift"].toString();
-            QString freSpread = multiPathObj["freSpread"].toString();
-
-            // 打印第二层嵌套字段
-            qDebug() << "\nMultiPath:";
-            qDebug() << "pathNum:" << pathNum;
-            qDebug() << "relativDelay:" << relativDelay;
-            qDebug() << "antPower:" << antPower;
-            qDebug() << "freShift:" << freShift;
-            qDebug() << "freSpread:" << freSpread;
-        } else {
-            qWarning() << "ModelParaSetting中不包含有效的MultiPath对象";
+bool MqttMessageParser::parseChannelParams(const QByteArray& payload, QString* examID,
+                                           QList<ModelParaSetting>* settings, QString* error,
+                                           MessageFormat* format)
+{
+    QString err;
+    QList<ModelParaSetting> parsed;
+    QJsonObject rootObj;
+
+    // 与detectFormat相同的判断，但只看前几个字节，不为检测格式单独解码一次
+    const unsigned char first = payload.isEmpty() ? 0 : static_cast<unsigned char>(payload.at(0));
+    if (payload.startsWith("\xD9\xD9\xF7") || (first >= 0xA0 && first <= 0xBF)) {
+        // CBOR消息转换为JSON对象后按相同规则解析，数值为原生类型
+        QCborParserError cborError;
+        QCborValue value = QCborValue::fromCbor(payload, &cborError);
+        if (value.isTag()) {
+            value = value.taggedValue();
+        }
+        if (cborError.error != QCborError::NoError || !value.isMap()) {
+            if (error) *error = "CBOR消息不是有效的map";
+            return false;
+        }
+        if (format) *format = MessageFormat::CBOR;
+        rootObj = value.toMap().toJsonObject();
+        // ExamID超出double精度，整数形式时直接转字符串
+        QCborValue examValue = value.toMap().value(QStringLiteral("ExamID"));
+        if (examValue.isInteger()) {
+            rootObj["ExamID"] = QString::number(examValue.toInteger());
         }
     } else {
-        qWarning() << "消息中不包含有效的ModelParaSetting对象";
+        // 解析顶层JSON
+        QJsonParseError parseError;
+        QJsonDocument jsonDoc = QJsonDocument::fromJson(payload, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            if (error) *error = QString("JSON解析失败：%1").arg(parseError.errorString());
+            return false;
+        }
+        if (!jsonDoc.isObject()) {
+            if (error) *error = "消息不是JSON对象";
+            return false;
+        }
+        if (format) *format = MessageFormat::JSON;
+        rootObj = jsonDoc.object();
+    }
+
+    // ModelParaSetting为信道数组，每个信道带MultiPath数组
+    if (!rootObj["ModelParaSetting"].isArray()) {
+        if (error) *error = "消息中不包含ModelParaSetting数组";
+        return false;
+    }
+    QJsonArray modelArray = rootObj["ModelParaSetting"].toArray();
+    if (modelArray.isEmpty()) {
+        if (error) *error = "ModelParaSetting数组为空";
+        return false;
+    }
+
+    QSet<int> seenChannels;
+    for (int i = 0; i < modelArray.size() && err.isEmpty(); ++i) {
+        QJsonObject modelObj = modelArray[i].toObject();
+        ModelParaSetting config;
+        config.modelName = modelObj["modelName"].toString();
+
+        if (!jsonToInt(modelObj["channelNum"], &config.channelNum)
+            || config.channelNum == 0 || !IS_VALID_CHANNEL(config.channelNum)) {
+            err = QString("第%1个信道号无效").arg(i + 1);
+            break;
+        }
+        if (seenChannels.contains(qAbs(config.channelNum))) {
+            err = QString("信道%1重复").arg(config.channelNum);
+            break;
+        }
+        seenChannels.insert(qAbs(config.channelNum));
+
+        if (!jsonToInt(modelObj["modelType"], &config.modelType)) {
+            config.modelType = 0;
+        }
+        if (!jsonToDouble(modelObj["signalAnt"], &config.signalAnt) || config.signalAnt < 0) {
+            err = QString("信道%1信号衰减无效").arg(config.channelNum);
+            break;
+        }
+        if (!jsonToInt(modelObj["filterNum"], &config.filterNum) || config.filterNum < 0) {
+            err = QString("信道%1滤波器编号无效").arg(config.channelNum);
+            break;
+        }
+        if (!jsonToDouble(modelObj["noisePower"], &config.noisePower)) {
+            config.noisePower = 0;
+        }
+        if (!jsonToDouble(modelObj["comDistance"], &config.comDistance)) {
+            config.comDistance = 0;
+        }
+
+        // 多径：每条路径对应一个算法PATH，编号从1开始
+        QJsonArray multiPathArray = modelObj["MultiPath"].toArray();
+        if (multiPathArray.size() > ALG_PATH_MAX) {
+            err = QString("信道%1多径数量超过%2").arg(config.channelNum).arg(ALG_PATH_MAX);
+            break;
+        }
+        QSet<int> seenPaths;
+        for (const QJsonValue &pathValue : multiPathArray) {
+            QJsonObject pathObj = pathValue.toObject();
+            MultiPathType path;
+            bool ok = jsonToInt(pathObj["pathNum"], &path.pathNum)
+                      && jsonToInt(pathObj["relativDelay"], &path.relativDelay)
+                      && jsonToInt(pathObj["antPower"], &path.antPower)
+                      && jsonToInt(pathObj["freShift"], &path.freShift)
+                      && jsonToInt(pathObj["freSpread"], &path.freSpread);
+            if (!ok || !IS_VALID_PATH(path.pathNum - 1) || seenPaths.contains(path.pathNum)) {
+                err = QString("信道%1多径参数无效").arg(config.channelNum);
+                break;
+            }
+            seenPaths.insert(path.pathNum);
+            if (!jsonToInt(pathObj["dopplerType"], &path.dopplerType)) {
+                path.dopplerType = 0;
+            }
+            config.multipathType.append(path);
+        }
+        if (!err.isEmpty()) {
+            break;
+        }
+
+        // multipathNum可省略，给出时必须与数组长度一致
+        if (modelObj.contains("multipathNum")) {
+            if (!jsonToInt(modelObj["multipathNum"], &config.multipathNum)
+                || config.multipathNum != config.multipathType.size()) {
+                err = QString("信道%1多径数量与MultiPath不一致").arg(config.channelNum);
+                break;
+            }
+        } else {
+            config.multipathNum = config.multipathType.size();
+        }
+
+        config.isChange = true;
+        parsed.append(config);
+    }
+
+    if (!err.isEmpty()) {
+        if (error) *error = err;
+        return false;
     }
+
+    if (examID) *examID = examIdToString(rootObj["ExamID"]);
+    if (settings) *settings = parsed;
+    return true;
+}
+
+QString MqttMessageParser::currentExamID() const
+{
+    return m_currentExamID;
 }
 
 QVariantMap MqttMessageParser::extractTopicInfo(const QString &topic)
@@ -360,7 +560,7 @@ QByteArray MqttMessageParser::createChannelParamJsonMessage()
 
     // 转换为JSON字符串
     QJsonDocument jsonDoc(rootObj);
-    QByteArray jsonData = jsonDoc.toJson(QJsonDocument::Indented);
+    QByteArray jsonData = jsonDoc.toJson(QJsonDocument::Compact);
 
     //qDebug() << "循环创建的完整JSON:\n" << jsonData;
 
@@ -9,10 +9,12 @@
 #include <QVariant>
 #include <QDateTime>
 #include <QRegularExpression>
+#include "channelparaconifg.h"
 
 // 消息格式枚举
 enum class MessageFormat {
     JSON,       // JSON格式
+    CBOR,       // CBOR二进制格式（RFC 8949）
     XML,        // XML格式（需要额外处理）
     PlainText,  // 纯文本
     Binary,     // 二进制数据
@@ -46,12 +48,24 @@ public:
 
     // 各种格式的解析方法
     static QVariant parseJson(const QByteArray &payload, QString &error);
+    static QVariant parseCbor(const QByteArray &payload, QString &error);
     static QVariant parseText(const QByteArray &payload);
     static QVariant parseBinary(const QByteArray &payload);
 
     void parseExamStartJson(const QString& topic, const QByteArray& payload);
     void parseExamEndJson(const QString& topic, const QByteArray& payload);
-    void parseChannelParamJson(const QString& topic, const QByteArray& payload);
+    // 解析信道参数消息，校验通过后作为一个批次放入ChannelParamQueue
+    // 返回消息的编码格式(JSON/CBOR)，无法解码时返回Unknown，供上报编码跟随下发端
+    MessageFormat parseChannelParamJson(const QString& topic, const QByteArray& payload);
+
+    // 解析并校验信道参数消息，任一信道不合法时整条消息无效
+    // 消息只解码一次；format非空时返回解码出的格式，校验失败时也会设置
+    static bool parseChannelParams(const QByteArray& payload, QString* examID,
+                                   QList<ModelParaSetting>* settings, QString* error,
+                                   MessageFormat* format = nullptr);
+
+    // 当前考试ID，考试开始或收到信道参数时更新，考试结束时清空
+    QString currentExamID() const;
 
     // 工具方法：从主题中提取信息
     static QVariantMap extractTopicInfo(const QString &topic);
@@ -65,10 +79,14 @@ public:
 signals:
     void messageParsed(const QString &topic, const ParsedMessage &result);
     void parseError(const QString &topic, const QString &error);
+    // 信道参数消息已入队
+    void channelParamsApplied(const QString &examID, const QList<ModelParaSetting> &settings);
 
 private:
     // 主题模式匹配（用于智能解析）
     QList<QRegularExpression> m_topicPatterns;
+
+    QString m_currentExamID;
 };
 
 #endif // MQTTMESSAGEPARSER_H
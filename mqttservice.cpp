@@ -0,0 +1,67 @@
+#include "mqttservice.h"
+#include <QDebug>
+
+MqttService::MqttService(QObject *parent)
+    : QObject(parent)
+    , m_thread(new QThread(this))
+    , m_client(new MqttClient())
+{
+    m_thread->setObjectName("mqtt");
+    m_client->moveToThread(m_thread);
+    // 线程结束后在MQTT线程内释放客户端
+    connect(m_thread, &QThread::finished, m_client, &QObject::deleteLater);
+
+    // 转发MqttClient信号，跨线程自动排队
+    connect(m_client, &MqttClient::connectionStatusChanged, this, &MqttService::connectionStatusChanged);
+    connect(m_client, &MqttClient::errorOccurred, this, &MqttService::errorOccurred);
+    connect(m_client, &MqttClient::examStartMessageReceived, this, &MqttService::examStartMessageReceived);
+    connect(m_client, &MqttClient::examEndMessageReceived, this, &MqttService::examEndMessageReceived);
+    connect(m_client, &MqttClient::paramMessageReceived, this, &MqttService::paramMessageReceived);
+
+    m_thread->start();
+    qDebug() << "MQTT线程启动";
+}
+
+MqttService::~MqttService()
+{
+    // 在MQTT线程内断开连接后再退出线程
+    MqttClient *client = m_client;
+    QMetaObject::invokeMethod(m_client, [client]() {
+        client->disconnectFromBroker();
+    }, Qt::BlockingQueuedConnection);
+    m_thread->quit();
+    m_thread->wait();
+    qDebug() << "MQTT线程停止";
+}
+
+void MqttService::connectToBroker(const QString &hostname, quint16 port)
+{
+    MqttClient *client = m_client;
+    QMetaObject::invokeMethod(m_client, [client, hostname, port]() {
+        client->connectToBroker(hostname, port);
+    }, Qt::QueuedConnection);
+}
+
+void MqttService::disconnectFromBroker()
+{
+    MqttClient *client = m_client;
+    QMetaObject::invokeMethod(m_client, [client]() {
+        client->disconnectFromBroker();
+    }, Qt::QueuedConnection);
+}
+
+void MqttService::subscribeToTopic(const QString &topic, quint8 qos)
+{
+    MqttClient *client = m_client;
+    QMetaObject::invokeMethod(m_client, [client, topic, qos]() {
+        client->subscribeToTopic(topic, qos);
+    }, Qt::QueuedConnection);
+}
+
+void MqttService::setReportEncoding(ReportEncoding encoding)
+{
+    MqttClient *client = m_client;
+    QMetaObject::invokeMethod(m_client, [client, encoding]() {
+        client->setReportEncoding(encoding);
+    }, Qt::QueuedConnection);
+}
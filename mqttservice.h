@@ -0,0 +1,42 @@
+#ifndef MQTTSERVICE_H
+#define MQTTSERVICE_H
+
+#include <QObject>
+#include <QThread>
+#include "mqttclient.h"
+
+// MQTT服务：MqttClient、消息解析和上报组包都运行在独立线程，不占用界面事件循环
+// 接口可在任意线程调用，内部转发到MQTT线程执行；MqttClient的信号原样转发
+class MqttService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MqttService(QObject *parent = nullptr);
+    ~MqttService();
+
+    // 连接MQTT服务器
+    void connectToBroker(const QString &hostname, quint16 port = 1883);
+
+    // 断开连接
+    void disconnectFromBroker();
+
+    // 订阅主题
+    void subscribeToTopic(const QString &topic, quint8 qos = 0);
+
+    // 上报编码(JSON/CBOR)
+    void setReportEncoding(ReportEncoding encoding);
+
+signals:
+    void connectionStatusChanged(bool connected);
+    void errorOccurred(const QString &error);
+    void examStartMessageReceived(const QString &topic, const QByteArray &message);
+    void examEndMessageReceived(const QString &topic, const QByteArray &message);
+    void paramMessageReceived(const QString &topic, const QByteArray &message);
+
+private:
+    QThread *m_thread;
+    MqttClient *m_client;   // 属于m_thread，只能通过排队调用访问
+};
+
+#endif // MQTTSERVICE_H
@@ -0,0 +1,296 @@
+#include "reportbuilder.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCborMap>
+#include <QCborArray>
+#include <QCborValue>
+#include "asynclogger.h"
+#include "channelparamqueue.h"
+#include "telemetryservice.h"
+#include "fpga_driver.h"
+
+// CBOR自描述标签55799，接收端据此识别CBOR
+static const char CBOR_SELF_DESCRIBE[] = "\xD9\xD9\xF7";
+
+// 写入CBOR数据项头部（主类型+长度/数值）
+static void appendCborHead(QByteArray &out, quint8 majorType, quint64 value)
+{
+    quint8 major = static_cast<quint8>(majorType << 5);
+    if (value < 24) {
+        out += static_cast<char>(major | value);
+    } else if (value <= 0xFF) {
+        out += static_cast<char>(major | 24);
+        out += static_cast<char>(value);
+    } else if (value <= 0xFFFF) {
+        out += static_cast<char>(major | 25);
+        out += static_cast<char>(value >> 8);
+        out += static_cast<char>(value);
+    } else if (value <= 0xFFFFFFFFULL) {
+        out += static_cast<char>(major | 26);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            out += static_cast<char>(value >> shift);
+        }
+    } else {
+        out += static_cast<char>(major | 27);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out += static_cast<char>(value >> shift);
+        }
+    }
+}
+
+static void appendCborText(QByteArray &out, const QString &text)
+{
+    QByteArray utf8 = text.toUtf8();
+    appendCborHead(out, 3, static_cast<quint64>(utf8.size()));
+    out += utf8;
+}
+
+ReportBuilder::ReportBuilder()
+    : m_encoding(ReportEncoding::Json)
+    , m_paramValid(false)
+    , m_paramGeneration(0)
+    , m_statusValid(false)
+    , m_statusLatencyCount(0)
+{
+    buildHeartbeat();
+}
+
+void ReportBuilder::buildHeartbeat()
+{
+    if (m_encoding == ReportEncoding::Cbor) {
+        QCborMap heartbeat;
+        heartbeat[QStringLiteral("schema")] = REPORT_SCHEMA_VERSION;
+        heartbeat[QStringLiteral("state")] = 0x00;
+        m_heartbeat = QByteArray(CBOR_SELF_DESCRIBE) + heartbeat.toCborValue().toCbor();
+    } else {
+        QJsonObject heartbeat;
+        heartbeat["state"] = 0x00;
+        m_heartbeat = QJsonDocument(heartbeat).toJson(QJsonDocument::Compact);
+    }
+}
+
+void ReportBuilder::setEncoding(ReportEncoding encoding)
+{
+    if (encoding == m_encoding) {
+        return;
+    }
+    m_encoding = encoding;
+    m_fragments.clear();
+    m_fragmentGenerations.clear();
+    buildHeartbeat();
+    invalidate();
+}
+
+ReportEncoding ReportBuilder::encoding() const
+{
+    return m_encoding;
+}
+
+QByteArray ReportBuilder::heartbeat() const
+{
+    return m_heartbeat;
+}
+
+void ReportBuilder::invalidate()
+{
+    m_paramValid = false;
+    m_statusValid = false;
+}
+
+QByteArray ReportBuilder::buildChannelFragment(const ChannelSetting &setting)
+{
+    // 只含信道缓存中的字段(格式见reportbuilder.h)，不含场景的modelType/modelName/noisePower等
+    // 数值按字符串上报，switchFlag为布尔值
+    QJsonObject channelObj;
+    channelObj["channelNum"] = QString::number(setting.channelNum);
+    channelObj["signalAnt"] = QString::number(setting.signalAnt);
+    channelObj["filterNum"] = QString::number(setting.filterNum);
+    channelObj["switchFlag"] = setting.switchFlag;
+    channelObj["multipathNum"] = QString::number(setting.multipathType.size());
+
+    QJsonArray multiPathArray;
+    for (const MultiPathType &path : setting.multipathType) {
+        QJsonObject pathObj;
+        pathObj["pathNum"] = QString::number(path.pathNum);
+        pathObj["relativDelay"] = QString::number(path.relativDelay);
+        pathObj["antPower"] = QString::number(path.antPower);
+        pathObj["freShift"] = QString::number(path.freShift);
+        pathObj["freSpread"] = QString::number(path.freSpread);
+        pathObj["dopplerType"] = QString::number(path.dopplerType);
+        multiPathArray.append(pathObj);
+    }
+    channelObj["MultiPath"] = multiPathArray;
+
+    return QJsonDocument(channelObj).toJson(QJsonDocument::Compact);
+}
+
+QByteArray ReportBuilder::buildChannelFragmentCbor(const ChannelSetting &setting)
+{
+    QCborMap channelMap;
+    channelMap[QStringLiteral("channelNum")] = setting.channelNum;
+    channelMap[QStringLiteral("signalAnt")] = setting.signalAnt;
+    channelMap[QStringLiteral("filterNum")] = setting.filterNum;
+    channelMap[QStringLiteral("switchFlag")] = setting.switchFlag;
+    channelMap[QStringLiteral("multipathNum")] = setting.multipathType.size();
+
+    QCborArray multiPathArray;
+    for (const MultiPathType &path : setting.multipathType) {
+        QCborMap pathMap;
+        pathMap[QStringLiteral("pathNum")] = path.pathNum;
+        pathMap[QStringLiteral("relativDelay")] = path.relativDelay;
+        pathMap[QStringLiteral("antPower")] = path.antPower;
+        pathMap[QStringLiteral("freShift")] = path.freShift;
+        pathMap[QStringLiteral("freSpread")] = path.freSpread;
+        pathMap[QStringLiteral("dopplerType")] = path.dopplerType;
+        multiPathArray.append(pathMap);
+    }
+    channelMap[QStringLiteral("MultiPath")] = multiPathArray;
+
+    return channelMap.toCborValue().toCbor();
+}
+
+QByteArray ReportBuilder::channelParamReport(const QString &examID, bool *changed)
+{
+    // 缓存整体代数未变且考试未变，直接返回上次的内容
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    quint64 generation = cache->generation();
+    if (m_paramValid && generation == m_paramGeneration && examID == m_paramExamID) {
+        if (changed) *changed = false;
+        return m_paramPayload;
+    }
+
+    // 只重新序列化代数变化的信道
+    QMap<int, ChannelSetting> settings = cache->getAllChannelSettings();
+    int rebuilt = 0;
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        if (!m_fragments.contains(it.key()) || m_fragmentGenerations.value(it.key()) != it.value().generation) {
+            m_fragments[it.key()] = (m_encoding == ReportEncoding::Cbor)
+                                    ? buildChannelFragmentCbor(it.value())
+                                    : buildChannelFragment(it.value());
+            m_fragmentGenerations[it.key()] = it.value().generation;
+            rebuilt++;
+        }
+    }
+
+    QByteArray payload;
+    if (m_encoding == ReportEncoding::Cbor) {
+        // 拼接：标签 + map{schema, ExamID, ModelParaSetting:[片段,...]}，定长数组可直接连接片段
+        payload = CBOR_SELF_DESCRIBE;
+        appendCborHead(payload, 5, 3);
+        appendCborText(payload, QStringLiteral("schema"));
+        appendCborHead(payload, 0, REPORT_SCHEMA_VERSION);
+        appendCborText(payload, QStringLiteral("ExamID"));
+        appendCborText(payload, examID);
+        appendCborText(payload, QStringLiteral("ModelParaSetting"));
+        appendCborHead(payload, 4, static_cast<quint64>(settings.size()));
+        for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+            payload += m_fragments.value(it.key());
+        }
+    } else {
+        // 拼接：{"ExamID":"...","ModelParaSetting":[片段,...]}
+        QJsonObject header;
+        header["ExamID"] = examID;
+        payload = QJsonDocument(header).toJson(QJsonDocument::Compact);
+        payload.chop(1);
+        payload += ",\"ModelParaSetting\":[";
+        bool first = true;
+        for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+            if (!first) {
+                payload += ',';
+            }
+            payload += m_fragments.value(it.key());
+            first = false;
+        }
+        payload += "]}";
+    }
+
+    // 每次上报周期都可能重建，只在TRACE级别记录
+    LOG_TRACE("report", "[上报] 信道参数重建{}个信道，长度{}", rebuilt, payload.size());
+
+    // 代数变化但内容相同（例如开关来回切换）时不算变化
+    bool payloadChanged = !m_paramValid || payload != m_paramPayload;
+    m_paramPayload = payload;
+    m_paramGeneration = generation;
+    m_paramExamID = examID;
+    m_paramValid = true;
+    if (changed) *changed = payloadChanged;
+    return m_paramPayload;
+}
+
+QByteArray ReportBuilder::channelStatusReport(const QString &examID, bool *changed)
+{
+    // 各电台近1秒功率统计，取整到1dB，避免噪声抖动导致每次心跳都重发
+    QVector<int> power;
+    for (int radio = 1; radio <= TelemetryService::RADIO_COUNT; radio++) {
+        QVector<TelemetryBucket> buckets = TelemetryService::instance()->decimated(radio, 1.0, 1);
+        const TelemetryBucket &bucket = buckets.first();
+        if (bucket.count > 0) {
+            power << qRound(bucket.minPowerDb) << qRound(bucket.maxPowerDb) << qRound(bucket.meanPowerDb);
+        } else {
+            power << qRound(FPGA_POWER_FLOOR_DB) << qRound(FPGA_POWER_FLOOR_DB) << qRound(FPGA_POWER_FLOOR_DB);
+        }
+    }
+
+    // 状态内容只随时延统计、功率和考试变化
+    ApplyLatencyStats latency = ChannelParamQueue::instance()->latencyStats();
+    if (m_statusValid && latency.count == m_statusLatencyCount && examID == m_statusExamID
+            && power == m_statusPower) {
+        if (changed) *changed = false;
+        return m_statusPayload;
+    }
+
+    if (m_encoding == ReportEncoding::Cbor) {
+        // 比例以小数上报，速率为数值
+        QCborMap statusMap;
+        statusMap[QStringLiteral("schema")] = REPORT_SCHEMA_VERSION;
+        statusMap[QStringLiteral("ExamID")] = examID;
+        statusMap[QStringLiteral("channelNum")] = 1;
+        statusMap[QStringLiteral("BitErrorRate")] = 0.10;
+        statusMap[QStringLiteral("PacketLossRate")] = 0.05;
+        statusMap[QStringLiteral("DataRate")] = 100;
+        statusMap[QStringLiteral("ApplyLatencyLastUs")] = latency.lastUs;
+        statusMap[QStringLiteral("ApplyLatencyAvgUs")] = latency.avgUs;
+        statusMap[QStringLiteral("ApplyLatencyMaxUs")] = latency.maxUs;
+        QCborArray powerArray;
+        for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+            QCborMap radioMap;
+            radioMap[QStringLiteral("radio")] = i + 1;
+            radioMap[QStringLiteral("min")] = power[i * 3];
+            radioMap[QStringLiteral("max")] = power[i * 3 + 1];
+            radioMap[QStringLiteral("mean")] = power[i * 3 + 2];
+            powerArray.append(radioMap);
+        }
+        statusMap[QStringLiteral("RadioPowerDb")] = powerArray;
+        m_statusPayload = QByteArray(CBOR_SELF_DESCRIBE) + statusMap.toCborValue().toCbor();
+    } else {
+        QJsonObject statusObj;
+        statusObj["ExamID"] = examID;
+        statusObj["channelNum"] = 1;
+        statusObj["BitErrorRate"] = "10%";
+        statusObj["PacketLossRate"] = "5%";
+        statusObj["DataRate"] = "100";
+        // 参数消息接收到下发完成的时延(us)
+        statusObj["ApplyLatencyLastUs"] = latency.lastUs;
+        statusObj["ApplyLatencyAvgUs"] = latency.avgUs;
+        statusObj["ApplyLatencyMaxUs"] = latency.maxUs;
+        // 各电台近1秒功率(dBFS)
+        QJsonArray powerArray;
+        for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+            QJsonObject radioObj;
+            radioObj["radio"] = i + 1;
+            radioObj["min"] = power[i * 3];
+            radioObj["max"] = power[i * 3 + 1];
+            radioObj["mean"] = power[i * 3 + 2];
+            powerArray.append(radioObj);
+        }
+        statusObj["RadioPowerDb"] = powerArray;
+        m_statusPayload = QJsonDocument(statusObj).toJson(QJsonDocument::Compact);
+    }
+    m_statusLatencyCount = latency.count;
+    m_statusExamID = examID;
+    m_statusPower = power;
+    m_statusValid = true;
+    if (changed) *changed = true;
+    return m_statusPayload;
+}
@@ -0,0 +1,77 @@
+#ifndef REPORTBUILDER_H
+#define REPORTBUILDER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QMap>
+#include <QVector>
+#include "channelcachemanager.h"
+
+// 上报编码：JSON兼容旧格式（数值为字符串），CBOR使用原生数值类型并带schema版本
+enum class ReportEncoding {
+    Json,
+    Cbor
+};
+
+// CBOR上报的schema版本，字段变化时递增
+#define REPORT_SCHEMA_VERSION 1
+
+// MQTT上报组包：根据信道缓存生成上报内容并缓存序列化结果
+// 只有修改代数变化的信道才重新序列化，内容未变化时直接返回缓存
+class ReportBuilder
+{
+public:
+    ReportBuilder();
+
+    // 切换上报编码，切换后缓存失效
+    void setEncoding(ReportEncoding encoding);
+    ReportEncoding encoding() const;
+
+    // 心跳，内容固定
+    QByteArray heartbeat() const;
+
+    // 信道参数上报(CHANNEL_PARAM_REPORT)，changed为false表示与上次返回的内容相同
+    // 格式：{ExamID, ModelParaSetting:[信道,...]}，信道按信道号升序，每个信道为
+    //   {channelNum, signalAnt, filterNum, switchFlag, multipathNum,
+    //    MultiPath:[{pathNum, relativDelay, antPower, freShift, freSpread, dopplerType},...]}
+    // 只上报信道缓存中的字段，与createChannelParamJsonMessage生成的参数消息不同，不含modelType、
+    // modelName、channelID、noisePower、comDistance。JSON中除switchFlag(布尔)外数值均为字符串；
+    // CBOR为原生数值类型，顶层另有schema字段并以标签55799开头
+    QByteArray channelParamReport(const QString &examID, bool *changed);
+
+    // 信道状态上报(CHANNEL_STATUS_REPORT)
+    // 格式：{ExamID, channelNum, BitErrorRate, PacketLossRate, DataRate,
+    //   ApplyLatencyLastUs, ApplyLatencyAvgUs, ApplyLatencyMaxUs, RadioPowerDb:[{radio, min, max, mean},...]}
+    // JSON中误码率/丢包率为百分比字符串，CBOR为小数并带schema字段
+    QByteArray channelStatusReport(const QString &examID, bool *changed);
+
+    // 清除缓存，下次调用一定返回changed=true（例如重连后需要重新上报）
+    void invalidate();
+
+private:
+    // 单个信道的JSON/CBOR片段
+    static QByteArray buildChannelFragment(const ChannelSetting &setting);
+    static QByteArray buildChannelFragmentCbor(const ChannelSetting &setting);
+
+    void buildHeartbeat();
+
+    ReportEncoding m_encoding;
+    QByteArray m_heartbeat;
+
+    // 信道参数上报缓存
+    bool m_paramValid;
+    quint64 m_paramGeneration;
+    QString m_paramExamID;
+    QByteArray m_paramPayload;
+    QMap<int, quint64> m_fragmentGenerations;
+    QMap<int, QByteArray> m_fragments;
+
+    // 信道状态上报缓存
+    bool m_statusValid;
+    quint64 m_statusLatencyCount;
+    QString m_statusExamID;
+    QVector<int> m_statusPower;     // 各电台近1秒功率min/max/mean(dB取整)
+    QByteArray m_statusPayload;
+};
+
+#endif // REPORTBUILDER_H
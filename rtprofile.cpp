@@ -0,0 +1,186 @@
+#include "rtprofile.h"
+#include <QSettings>
+#include <QtGlobal>
+#include <alloca.h>
+#include <cmath>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+
+RtProfile RtProfile::load(const QString &iniPath)
+{
+    RtProfile profile;
+    QSettings settings(iniPath, QSettings::IniFormat);
+    settings.beginGroup("Realtime");
+    profile.enabled = settings.value("Enabled", profile.enabled).toBool();
+    profile.priority = qBound(MIN_PRIORITY, settings.value("Priority", profile.priority).toInt(), MAX_PRIORITY);
+    profile.cpu = settings.value("Cpu", profile.cpu).toInt();
+    profile.lockMemory = settings.value("LockMemory", profile.lockMemory).toBool();
+    profile.stackPrefaultKb = qBound(0, settings.value("StackPrefaultKb", profile.stackPrefaultKb).toInt(),
+                                     MAX_STACK_PREFAULT_KB);
+    int periodUs = settings.value("JitterPeriodUs", profile.jitterPeriodUs).toInt();
+    profile.jitterPeriodUs = periodUs > 0 ? qBound(MIN_JITTER_PERIOD_US, periodUs, MAX_JITTER_PERIOD_US) : 0;
+    profile.jitterReportSec = qMax(1, settings.value("JitterReportSec", profile.jitterReportSec).toInt());
+    settings.endGroup();
+    return profile;
+}
+
+// 写入一段栈空间，使对应的栈页在实时运行前完成缺页；不内联，返回后这段栈仍属于本线程
+static Q_DECL_NOINLINE void prefaultStack(int bytes)
+{
+    volatile char *stack = static_cast<volatile char *>(alloca(bytes));
+    for (int i = 0; i < bytes; i += 4096) {
+        stack[i] = 0;
+    }
+}
+
+bool RtProfile::lockProcessMemory(QStringList *errors) const
+{
+    if (!enabled || !lockMemory) {
+        return true;
+    }
+    // MCL_FUTURE使之后创建的线程栈和分配的内存也被锁定，包括PTT线程预取的栈页
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        if (errors) {
+            errors->append(QString("mlockall失败: %1").arg(strerror(errno)));
+        }
+        return false;
+    }
+    return true;
+}
+
+bool RtProfile::applyToCurrentThread(QStringList *errors) const
+{
+    bool ok = true;
+    auto fail = [&](const QString &message) {
+        ok = false;
+        if (errors) {
+            errors->append(message);
+        }
+    };
+
+    // 进程启动时已锁定内存的话，预取的栈页随即被锁定
+    if (stackPrefaultKb > 0) {
+        prefaultStack(stackPrefaultKb * 1024);
+    }
+
+    if (cpu >= 0) {
+        if (cpu >= CPU_SETSIZE) {
+            fail(QString("CPU编号无效: %1").arg(cpu));
+        } else {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            if (ret != 0) {
+                fail(QString("绑定CPU%1失败: %2").arg(cpu).arg(strerror(ret)));
+            }
+        }
+    }
+
+    // 需要root或CAP_SYS_NICE，失败时保持普通调度
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+        fail(QString("设置SCHED_FIFO优先级%1失败: %2").arg(priority).arg(strerror(ret)));
+    }
+    return ok;
+}
+
+JitterHistogram::JitterHistogram()
+{
+    reset();
+}
+
+void JitterHistogram::reset()
+{
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_overruns.store(0, std::memory_order_relaxed);
+    m_sumUs.store(0, std::memory_order_relaxed);
+    m_minUs.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+void JitterHistogram::record(qint64 latencyUs)
+{
+    if (latencyUs < 0) {
+        latencyUs = 0;
+    }
+    // 单写者，读-改-写无需原子指令
+    quint64 count = m_count.load(std::memory_order_relaxed);
+    if (count == 0 || latencyUs < m_minUs.load(std::memory_order_relaxed)) {
+        m_minUs.store(latencyUs, std::memory_order_relaxed);
+    }
+    if (latencyUs > m_maxUs.load(std::memory_order_relaxed)) {
+        m_maxUs.store(latencyUs, std::memory_order_relaxed);
+    }
+    m_sumUs.store(m_sumUs.load(std::memory_order_relaxed) + latencyUs, std::memory_order_relaxed);
+
+    std::atomic<quint64> &bucket = m_buckets[bucketOf(latencyUs)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_count.store(count + 1, std::memory_order_release);
+}
+
+void JitterHistogram::recordOverrun()
+{
+    m_overruns.store(m_overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+JitterStats JitterHistogram::stats() const
+{
+    JitterStats stats;
+    stats.count = m_count.load(std::memory_order_acquire);
+    stats.overruns = m_overruns.load(std::memory_order_relaxed);
+    if (stats.count == 0) {
+        return stats;
+    }
+    stats.minUs = m_minUs.load(std::memory_order_relaxed);
+    stats.maxUs = m_maxUs.load(std::memory_order_relaxed);
+    stats.avgUs = m_sumUs.load(std::memory_order_relaxed) / static_cast<qint64>(stats.count);
+
+    // 与写入并发时各档之和可能与count略有出入，按各档之和计算百分位
+    quint64 total = 0;
+    quint64 counts[BUCKET_COUNT];
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    const double quantiles[3] = {0.5, 0.99, 0.999};
+    qint64 *results[3] = {&stats.p50Us, &stats.p99Us, &stats.p999Us};
+    int q = 0;
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT && q < 3; i++) {
+        seen += counts[i];
+        while (q < 3 && seen > 0 && seen >= qMax<quint64>(1, static_cast<quint64>(std::ceil(quantiles[q] * total)))) {
+            // 不超过实际最大值
+            *results[q] = qMin(bucketUpperUs(i), stats.maxUs);
+            q++;
+        }
+    }
+    return stats;
+}
+
+int JitterHistogram::bucketOf(qint64 latencyUs)
+{
+    if (latencyUs < FINE_BUCKETS) {
+        return static_cast<int>(latencyUs);
+    }
+    qint64 coarse = (latencyUs - FINE_BUCKETS) / COARSE_WIDTH_US;
+    return FINE_BUCKETS + static_cast<int>(qMin<qint64>(coarse, COARSE_BUCKETS - 1));
+}
+
+qint64 JitterHistogram::bucketUpperUs(int bucket)
+{
+    if (bucket < FINE_BUCKETS) {
+        return bucket;
+    }
+    return FINE_BUCKETS + static_cast<qint64>(bucket - FINE_BUCKETS + 1) * COARSE_WIDTH_US - 1;
+}
@@ -0,0 +1,94 @@
+#ifndef RTPROFILE_H
+#define RTPROFILE_H
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+// PTT线程的实时调度配置，从ChannelSettings.ini的[Realtime]分组读取
+// Enabled=false(默认)时调度、绑核、锁内存、栈预取都不生效；抖动测量模式可单独开启，用于对比启用前后的延迟
+// 锁内存对整个进程生效，由进程启动时调用lockProcessMemory；其余各项只作用于PTT线程
+// 示例：
+//   [Realtime]
+//   Enabled=true
+//   Priority=80
+//   Cpu=3
+//   LockMemory=true
+//   StackPrefaultKb=256
+//   JitterPeriodUs=1000
+//   JitterReportSec=60
+struct RtProfile
+{
+    static constexpr int MIN_PRIORITY = 1;
+    static constexpr int MAX_PRIORITY = 99;
+    static constexpr int MAX_STACK_PREFAULT_KB = 4096;
+    static constexpr int MIN_JITTER_PERIOD_US = 100;
+    static constexpr int MAX_JITTER_PERIOD_US = 1000000;
+
+    bool enabled = false;           // 是否启用以下实时调度设置
+    int priority = 80;              // SCHED_FIFO优先级[1, 99]
+    int cpu = -1;                   // 绑定的CPU编号，-1不绑定；应选用isolcpus隔离出的核
+    bool lockMemory = true;         // 进程启动时mlockall锁定全部线程当前及以后的内存，避免运行中缺页
+    int stackPrefaultKb = 256;      // 启动时预先写入的栈大小(KB)，使栈页提前分配
+    int jitterPeriodUs = 0;         // >0时为抖动测量模式：按该周期轮询PTT并统计唤醒延迟
+    int jitterReportSec = 60;       // 抖动测量模式下写日志的间隔(s)
+
+    // 读取配置，越界的值收敛到有效范围
+    static RtProfile load(const QString &iniPath);
+
+    // 进程级：Enabled且LockMemory时mlockall锁定整个进程的内存，在启动线程之前调用一次
+    // 未启用时不做任何事并返回true
+    bool lockProcessMemory(QStringList *errors) const;
+
+    // 应用到调用线程：调度策略、CPU绑定和栈预取，不包括进程级的内存锁定
+    // 每一项失败都记录到errors并继续应用其余项，全部成功时返回true
+    bool applyToCurrentThread(QStringList *errors) const;
+
+    bool jitterMode() const { return jitterPeriodUs > 0; }
+};
+
+// 唤醒延迟分布统计
+struct JitterStats
+{
+    quint64 count = 0;
+    quint64 overruns = 0;       // 延迟超过一个周期、跳过周期的次数
+    qint64 minUs = 0;
+    qint64 avgUs = 0;
+    qint64 p50Us = 0;
+    qint64 p99Us = 0;
+    qint64 p999Us = 0;
+    qint64 maxUs = 0;
+};
+
+// 唤醒延迟直方图：1ms以内1us一档，1ms~11ms为100us一档，更大的计入最后一档(最大值单独记录)
+// 只由测量线程写入，不加锁、不分配内存；任意线程可读取统计
+class JitterHistogram
+{
+public:
+    static const int FINE_BUCKETS = 1000;
+    static const int COARSE_BUCKETS = 100;
+    static const int COARSE_WIDTH_US = 100;
+    static const int BUCKET_COUNT = FINE_BUCKETS + COARSE_BUCKETS;
+
+    JitterHistogram();
+
+    void reset();
+    void record(qint64 latencyUs);
+    void recordOverrun();
+
+    // 百分位按所在档的上界给出
+    JitterStats stats() const;
+
+private:
+    static int bucketOf(qint64 latencyUs);
+    static qint64 bucketUpperUs(int bucket);
+
+    std::atomic<quint64> m_buckets[BUCKET_COUNT];
+    std::atomic<quint64> m_count;
+    std::atomic<quint64> m_overruns;
+    std::atomic<qint64> m_sumUs;
+    std::atomic<qint64> m_minUs;
+    std::atomic<qint64> m_maxUs;
+};
+
+#endif // RTPROFILE_H
@@ -0,0 +1,195 @@
+#include "scenarioindex.h"
+#include <algorithm>
+
+bool ScenarioQuery::isEmpty() const
+{
+    return text.isEmpty()
+        && !channelNum.hasMin && !channelNum.hasMax
+        && !multipathNum.hasMin && !multipathNum.hasMax
+        && !maxDoppler.hasMin && !maxDoppler.hasMax;
+}
+
+ScenarioIndex::ScenarioIndex()
+{
+}
+
+void ScenarioIndex::clear()
+{
+    m_summaries.clear();
+    m_foldedNames.clear();
+    m_sorted.clear();
+    m_positionByName.clear();
+}
+
+void ScenarioIndex::reset(const QVector<ScenarioSummary> &summaries)
+{
+    clear();
+    m_summaries.reserve(summaries.size());
+    m_foldedNames.reserve(summaries.size());
+    m_positionByName.reserve(summaries.size());
+
+    for (const ScenarioSummary &summary : summaries) {
+        if (m_positionByName.contains(summary.modelName)) {
+            continue;
+        }
+        m_positionByName.insert(summary.modelName, m_summaries.size());
+        m_summaries.append(summary);
+        m_foldedNames.append(summary.modelName.toCaseFolded());
+    }
+
+    // 一次排序，不逐条插入
+    m_sorted.resize(m_summaries.size());
+    for (int i = 0; i < m_sorted.size(); i++) {
+        m_sorted[i] = i;
+    }
+    std::stable_sort(m_sorted.begin(), m_sorted.end(), [this](int a, int b) {
+        return m_foldedNames.at(a) < m_foldedNames.at(b);
+    });
+}
+
+bool ScenarioIndex::insert(const ScenarioSummary &summary)
+{
+    if (m_positionByName.contains(summary.modelName)) {
+        return false;
+    }
+
+    int position = m_summaries.size();
+    QString folded = summary.modelName.toCaseFolded();
+    m_positionByName.insert(summary.modelName, position);
+    m_summaries.append(summary);
+    m_foldedNames.append(folded);
+
+    // 同名(折叠后)的排在已有的之后
+    auto it = std::upper_bound(m_sorted.begin(), m_sorted.end(), folded, [this](const QString &key, int p) {
+        return key < m_foldedNames.at(p);
+    });
+    m_sorted.insert(it, position);
+    return true;
+}
+
+bool ScenarioIndex::update(const ScenarioSummary &summary)
+{
+    int position = indexOf(summary.modelName);
+    if (position < 0) {
+        return false;
+    }
+    // 名称不变，排序位置不变
+    m_summaries[position] = summary;
+    return true;
+}
+
+int ScenarioIndex::remove(const QString &name)
+{
+    int position = indexOf(name);
+    if (position < 0) {
+        return -1;
+    }
+
+    for (int k = lowerBound(m_foldedNames.at(position)); k < m_sorted.size(); k++) {
+        if (m_sorted.at(k) == position) {
+            m_sorted.remove(k);
+            break;
+        }
+    }
+    m_summaries.remove(position);
+    m_foldedNames.remove(position);
+    m_positionByName.remove(name);
+
+    // 其后的位置前移一位
+    for (int &p : m_sorted) {
+        if (p > position) {
+            --p;
+        }
+    }
+    for (auto it = m_positionByName.begin(); it != m_positionByName.end(); ++it) {
+        if (it.value() > position) {
+            --it.value();
+        }
+    }
+    return position;
+}
+
+int ScenarioIndex::size() const
+{
+    return m_summaries.size();
+}
+
+bool ScenarioIndex::contains(const QString &name) const
+{
+    return m_positionByName.contains(name);
+}
+
+int ScenarioIndex::indexOf(const QString &name) const
+{
+    return m_positionByName.value(name, -1);
+}
+
+const ScenarioSummary &ScenarioIndex::summary(int position) const
+{
+    return m_summaries.at(position);
+}
+
+bool ScenarioIndex::matches(int position, const ScenarioQuery &query) const
+{
+    if (position < 0 || position >= m_summaries.size()) {
+        return false;
+    }
+    if (!query.text.isEmpty()) {
+        const QString &name = m_foldedNames.at(position);
+        QString key = query.text.toCaseFolded();
+        if (query.prefixOnly ? !name.startsWith(key) : !name.contains(key)) {
+            return false;
+        }
+    }
+    return matchesRanges(position, query);
+}
+
+QVector<int> ScenarioIndex::search(const ScenarioQuery &query) const
+{
+    QVector<int> result;
+
+    if (query.text.isEmpty() || !query.prefixOnly) {
+        QString key = query.text.toCaseFolded();
+        for (int i = 0; i < m_summaries.size(); i++) {
+            if ((key.isEmpty() || m_foldedNames.at(i).contains(key)) && matchesRanges(i, query)) {
+                result.append(i);
+            }
+        }
+        return result;
+    }
+
+    // 前缀检索：排序数组中前缀相同的是连续的一段
+    QString key = query.text.toCaseFolded();
+    for (int k = lowerBound(key); k < m_sorted.size(); k++) {
+        int position = m_sorted.at(k);
+        if (!m_foldedNames.at(position).startsWith(key)) {
+            break;
+        }
+        if (matchesRanges(position, query)) {
+            result.append(position);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool ScenarioIndex::inRange(double value, const ValueRange &range)
+{
+    return (!range.hasMin || value >= range.min) && (!range.hasMax || value <= range.max);
+}
+
+bool ScenarioIndex::matchesRanges(int position, const ScenarioQuery &query) const
+{
+    const ScenarioSummary &summary = m_summaries.at(position);
+    return inRange(summary.channelNum, query.channelNum)
+        && inRange(summary.multipathNum, query.multipathNum)
+        && inRange(summary.maxDoppler, query.maxDoppler);
+}
+
+int ScenarioIndex::lowerBound(const QString &key) const
+{
+    auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), key, [this](int p, const QString &k) {
+        return m_foldedNames.at(p) < k;
+    });
+    return int(it - m_sorted.begin());
+}
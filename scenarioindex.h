@@ -0,0 +1,61 @@
+#ifndef SCENARIOINDEX_H
+#define SCENARIOINDEX_H
+
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include "databasemanager.h"
+
+// 场景检索条件：名称关键字与数值范围，各条件之间为与关系
+struct ScenarioQuery
+{
+    QString text;               // 名称关键字，空表示不限，不区分大小写
+    bool prefixOnly = false;    // true时只匹配名称前缀，否则匹配名称中任意位置
+    ValueRange channelNum;
+    ValueRange multipathNum;
+    ValueRange maxDoppler;
+
+    bool isEmpty() const;
+};
+
+// 场景名称和关键参数的内存索引，增删时增量维护，不重建
+// 位置为场景的添加顺序，删除后其后的位置前移；检索结果按位置升序
+// 名称按折叠大小写后排序，前缀检索为二分查找；子串检索顺序扫描折叠后的名称
+// 不加锁，只在界面线程使用
+class ScenarioIndex
+{
+public:
+    ScenarioIndex();
+
+    void clear();
+    // 整体替换，名称重复时保留第一个
+    void reset(const QVector<ScenarioSummary> &summaries);
+
+    // 追加到末尾，名称已存在时返回false
+    bool insert(const ScenarioSummary &summary);
+    // 更新已有场景的参数，位置不变
+    bool update(const ScenarioSummary &summary);
+    // 删除场景，返回原位置，不存在时返回-1
+    int remove(const QString &name);
+
+    int size() const;
+    bool contains(const QString &name) const;
+    int indexOf(const QString &name) const;
+    const ScenarioSummary &summary(int position) const;
+
+    bool matches(int position, const ScenarioQuery &query) const;
+    QVector<int> search(const ScenarioQuery &query) const;
+
+private:
+    static bool inRange(double value, const ValueRange &range);
+    bool matchesRanges(int position, const ScenarioQuery &query) const;
+    // m_sorted中折叠名称不小于key的第一个下标
+    int lowerBound(const QString &key) const;
+
+    QVector<ScenarioSummary> m_summaries;
+    QVector<QString> m_foldedNames;      // 与m_summaries一一对应
+    QVector<int> m_sorted;               // 按折叠名称排序的位置
+    QHash<QString, int> m_positionByName;
+};
+
+#endif // SCENARIOINDEX_H
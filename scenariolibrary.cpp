@@ -0,0 +1,208 @@
+#include "scenariolibrary.h"
+#include <QDebug>
+
+ScenarioLibrary::ScenarioLibrary(DatabaseManager *dbManager, QObject *parent)
+    : QObject(parent)
+    , m_dbManager(dbManager)
+    , m_packCurrent(false)
+    , m_cache(DEFAULT_CACHE_SIZE)
+{
+}
+
+void ScenarioLibrary::load()
+{
+    m_cache.clear();
+    m_packCurrent = false;
+    m_pack.close();
+
+    // 缓存文件与数据库修订号一致时直接使用
+    quint64 revision = m_dbManager->libraryRevision();
+    QString errorMessage;
+    if (revision > 0 && QFile::exists(cachePath())) {
+        if (!m_pack.open(cachePath(), &errorMessage)) {
+            qWarning() << "场景库缓存无效:" << errorMessage;
+        } else if (m_pack.sourceRevision() != revision) {
+            qDebug() << "场景库缓存已过期:" << m_pack.sourceRevision() << revision;
+            m_pack.close();
+        } else {
+            m_packCurrent = true;
+        }
+    }
+
+    if (m_packCurrent) {
+        m_summaries.clear();
+        m_summaries.reserve(m_pack.count());
+        for (int i = 0; i < m_pack.count(); i++) {
+            const PackScenarioRecord *r = m_pack.record(i);
+            ScenarioSummary summary;
+            summary.modelName = m_pack.name(i);
+            summary.channelNum = r->channelNum;
+            summary.multipathNum = r->multipathNum;
+            summary.noisePower = r->noisePower;
+            summary.signalAnt = r->signalAnt;
+            const PackPathRecord *paths = m_pack.paths(i);
+            for (quint32 p = 0; p < r->pathCount; p++) {
+                summary.maxDoppler = qMax(summary.maxDoppler, qAbs(paths[p].freShift));
+            }
+            m_summaries.append(summary);
+        }
+    } else {
+        m_summaries = m_dbManager->getScenarioSummaries();
+    }
+    rebuildIndex();
+
+    qDebug() << "场景库加载摘要:" << m_summaries.size() << (m_packCurrent ? "(缓存文件)" : "(数据库)");
+    emit summariesChanged();
+}
+
+bool ScenarioLibrary::writeCache()
+{
+    if (m_packCurrent) {
+        return true;
+    }
+    if (m_dbManager->databaseName().isEmpty() || m_dbManager->databaseName() == ":memory:") {
+        return false;
+    }
+
+    // 先取修订号再读数据，期间若有修改，下次启动时修订号不一致会重新生成
+    quint64 revision = m_dbManager->libraryRevision();
+    if (revision == 0) {
+        return false;
+    }
+    m_pack.close();
+    QString errorMessage;
+    if (!ScenarioPack::write(cachePath(), m_dbManager->getAllConfigs(), revision,
+                             QHash<QString, QVector<quint32>>(), &errorMessage)) {
+        qWarning() << "写场景库缓存失败:" << errorMessage;
+        return false;
+    }
+
+    m_packCurrent = m_pack.open(cachePath(), &errorMessage);
+    if (!m_packCurrent) {
+        qWarning() << "场景库缓存无效:" << errorMessage;
+    }
+    return m_packCurrent;
+}
+
+bool ScenarioLibrary::isCacheCurrent() const
+{
+    return m_packCurrent;
+}
+
+QString ScenarioLibrary::cachePath() const
+{
+    return m_dbManager->databaseName() + ".pack";
+}
+
+void ScenarioLibrary::invalidateCache()
+{
+    // 旧文件保留，下次启动时按修订号判定过期
+    m_packCurrent = false;
+    m_pack.close();
+}
+
+QVector<ScenarioSummary> ScenarioLibrary::summaries() const
+{
+    return m_summaries;
+}
+
+bool ScenarioLibrary::contains(const QString &name) const
+{
+    return m_indexByName.contains(name);
+}
+
+bool ScenarioLibrary::scenario(const QString &name, ModelParaSetting *config)
+{
+    ModelParaSetting *cached = m_cache.object(name);
+    if (!cached) {
+        if (!m_indexByName.contains(name)) {
+            return false;
+        }
+        ModelParaSetting loaded;
+        int packIndex = m_packCurrent ? m_pack.indexOf(name) : -1;
+        if (packIndex >= 0) {
+            loaded = m_pack.scenario(packIndex);
+        } else if (!m_dbManager->getParaConfig(name, &loaded)) {
+            return false;
+        }
+        // 完整场景只保存在LRU缓存中，内存占用不超过缓存上限
+        cached = new ModelParaSetting(loaded);
+        m_cache.insert(name, cached);
+    }
+
+    if (config) *config = *cached;
+    return true;
+}
+
+bool ScenarioLibrary::save(const ModelParaSetting &config)
+{
+    if (!m_dbManager->insertParaConfig(config)) {
+        return false;
+    }
+    invalidateCache();
+
+    // 同名覆盖：数据库中旧行已删除，摘要移到末尾与数据库顺序一致
+    if (m_indexByName.contains(config.modelName)) {
+        m_summaries.remove(m_indexByName.value(config.modelName));
+        rebuildIndex();
+    }
+    m_indexByName.insert(config.modelName, m_summaries.size());
+    m_summaries.append(summaryOf(config));
+    m_cache.insert(config.modelName, new ModelParaSetting(config));
+
+    emit scenarioSaved(m_summaries.last());
+    emit summariesChanged();
+    return true;
+}
+
+bool ScenarioLibrary::remove(const QString &name)
+{
+    if (!m_indexByName.contains(name)) {
+        return false;
+    }
+    if (!m_dbManager->deleteParaConfig(name)) {
+        return false;
+    }
+    invalidateCache();
+
+    m_summaries.remove(m_indexByName.value(name));
+    rebuildIndex();
+    m_cache.remove(name);
+
+    emit scenarioRemoved(name);
+    emit summariesChanged();
+    return true;
+}
+
+void ScenarioLibrary::setCacheSize(int count)
+{
+    m_cache.setMaxCost(qMax(1, count));
+}
+
+int ScenarioLibrary::cachedCount() const
+{
+    return m_cache.count();
+}
+
+void ScenarioLibrary::rebuildIndex()
+{
+    m_indexByName.clear();
+    m_indexByName.reserve(m_summaries.size());
+    for (int i = 0; i < m_summaries.size(); i++) {
+        m_indexByName.insert(m_summaries[i].modelName, i);
+    }
+}
+
+ScenarioSummary ScenarioLibrary::summaryOf(const ModelParaSetting &config)
+{
+    ScenarioSummary summary;
+    summary.modelName = config.modelName;
+    summary.channelNum = config.channelNum;
+    summary.multipathNum = config.multipathNum;
+    summary.noisePower = config.noisePower;
+    summary.signalAnt = config.signalAnt;
+    for (const MultiPathType &path : config.multipathType) {
+        summary.maxDoppler = qMax(summary.maxDoppler, qAbs(path.freShift));
+    }
+    return summary;
+}
@@ -0,0 +1,70 @@
+#ifndef SCENARIOLIBRARY_H
+#define SCENARIOLIBRARY_H
+
+#include <QObject>
+#include <QCache>
+#include <QVector>
+#include <QHash>
+#include "databasemanager.h"
+#include "scenariopack.h"
+
+// 场景库：启动时只加载摘要，完整参数在选中或下发时从数据库读取
+// 最近使用的完整场景保存在LRU缓存中；只在数据库所在线程(界面线程)使用
+// 数据库旁的"<数据库名>.pack"为二进制缓存，修订号与数据库一致时摘要和场景都直接从映射文件读取
+class ScenarioLibrary : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int DEFAULT_CACHE_SIZE = 64;
+
+    explicit ScenarioLibrary(DatabaseManager *dbManager, QObject *parent = nullptr);
+
+    // 加载场景摘要，缓存文件有效时不查询数据库
+    void load();
+
+    // 缓存文件过期时由数据库重新生成，退出前调用
+    bool writeCache();
+    bool isCacheCurrent() const;
+    QString cachePath() const;
+
+    // 全部场景摘要，按保存顺序
+    QVector<ScenarioSummary> summaries() const;
+    bool contains(const QString &name) const;
+
+    // 取完整场景，缓存未命中时读数据库
+    bool scenario(const QString &name, ModelParaSetting *config);
+
+    // 保存场景，同名覆盖
+    bool save(const ModelParaSetting &config);
+    // 删除场景
+    bool remove(const QString &name);
+
+    // 缓存的完整场景数量上限
+    void setCacheSize(int count);
+    int cachedCount() const;
+
+    static ScenarioSummary summaryOf(const ModelParaSetting &config);
+
+signals:
+    // 场景增删后发出
+    void summariesChanged();
+    // 单个场景保存/删除，供界面增量更新
+    void scenarioSaved(const ScenarioSummary &summary);
+    void scenarioRemoved(const QString &name);
+
+private:
+    void rebuildIndex();
+
+    // 场景修改后缓存文件不再可用
+    void invalidateCache();
+
+    DatabaseManager *m_dbManager;
+    ScenarioPack m_pack;
+    bool m_packCurrent;
+    QVector<ScenarioSummary> m_summaries;
+    QHash<QString, int> m_indexByName;     // 名称到m_summaries下标
+    QCache<QString, ModelParaSetting> m_cache;
+};
+
+#endif // SCENARIOLIBRARY_H
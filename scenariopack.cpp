@@ -0,0 +1,386 @@
+#include "scenariopack.h"
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+// 各区起始按8字节对齐
+static quint64 alignUp(quint64 value)
+{
+    return (value + 7) & ~quint64(7);
+}
+
+// 区段[offset, offset + count * recordSize)位于文件内，先比较offset再做减法，不会溢出
+static bool sectionFits(quint64 offset, quint64 count, quint64 recordSize, quint64 size)
+{
+    return offset <= size && count * recordSize <= size - offset;
+}
+
+// 名称按UTF-8字节序比较
+static int compareName(const char *a, quint32 aLength, const char *b, quint32 bLength)
+{
+    int cmp = std::memcmp(a, b, qMin(aLength, bLength));
+    if (cmp != 0) {
+        return cmp;
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+ScenarioPack::ScenarioPack()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_header(nullptr)
+    , m_scenarios(nullptr)
+    , m_paths(nullptr)
+    , m_index(nullptr)
+    , m_strings(nullptr)
+    , m_programs(nullptr)
+{
+}
+
+ScenarioPack::~ScenarioPack()
+{
+    close();
+}
+
+bool ScenarioPack::open(const QString &filePath, QString *errorMessage)
+{
+    close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    if (errorMessage) *errorMessage = "场景库格式为小端，不支持当前平台";
+    return false;
+#endif
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) *errorMessage = "无法打开文件";
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < static_cast<qint64>(sizeof(PackHeader))) {
+        if (errorMessage) *errorMessage = "文件过短";
+        close();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        if (errorMessage) *errorMessage = "映射文件失败: " + m_file.errorString();
+        close();
+        return false;
+    }
+
+    m_header = reinterpret_cast<const PackHeader *>(m_data);
+    if (!validate(errorMessage)) {
+        close();
+        return false;
+    }
+
+    m_scenarios = reinterpret_cast<const PackScenarioRecord *>(m_data + m_header->scenarioOffset);
+    m_paths = reinterpret_cast<const PackPathRecord *>(m_data + m_header->pathOffset);
+    m_index = reinterpret_cast<const PackIndexEntry *>(m_data + m_header->indexOffset);
+    m_strings = reinterpret_cast<const char *>(m_data + m_header->stringOffset);
+    m_programs = reinterpret_cast<const quint32 *>(m_data + m_header->programOffset);
+    return true;
+}
+
+bool ScenarioPack::validate(QString *errorMessage) const
+{
+    const PackHeader &h = *m_header;
+    if (h.magic != SCENARIO_PACK_MAGIC) {
+        if (errorMessage) *errorMessage = "不是场景库文件";
+        return false;
+    }
+    if (h.version != SCENARIO_PACK_VERSION || h.headerSize != sizeof(PackHeader)
+            || h.scenarioRecordSize != sizeof(PackScenarioRecord) || h.pathRecordSize != sizeof(PackPathRecord)) {
+        if (errorMessage) *errorMessage = QString("场景库版本不支持: %1").arg(h.version);
+        return false;
+    }
+    if (h.fileSize != static_cast<quint64>(m_size)) {
+        if (errorMessage) *errorMessage = "场景库文件不完整";
+        return false;
+    }
+
+    // 各区不越界；偏移量来自文件，不能直接相加
+    quint64 size = static_cast<quint64>(m_size);
+    bool ok = sectionFits(h.scenarioOffset, h.scenarioCount, sizeof(PackScenarioRecord), size)
+            && sectionFits(h.pathOffset, h.pathCount, sizeof(PackPathRecord), size)
+            && sectionFits(h.indexOffset, h.scenarioCount, sizeof(PackIndexEntry), size)
+            && sectionFits(h.stringOffset, 0, 1, size)
+            && sectionFits(h.programOffset, h.programWordCount, sizeof(quint32), size);
+    if (!ok) {
+        if (errorMessage) *errorMessage = "场景库布局错误";
+        return false;
+    }
+
+    // 程序区按quint32数组直接访问，须4字节对齐(映射起始地址按页对齐)
+    if (h.programOffset % alignof(quint32) != 0) {
+        if (errorMessage) *errorMessage = "场景库程序区未对齐";
+        return false;
+    }
+
+    // 记录引用的路径、名称和程序不越界，之后的访问不再检查
+    quint64 stringSize = size - h.stringOffset;
+    const PackScenarioRecord *scenarios = reinterpret_cast<const PackScenarioRecord *>(m_data + h.scenarioOffset);
+    for (quint32 i = 0; i < h.scenarioCount; ++i) {
+        const PackScenarioRecord &r = scenarios[i];
+        if (quint64(r.pathIndex) + r.pathCount > h.pathCount
+                || quint64(r.nameOffset) + r.nameLength > stringSize
+                || quint64(r.programIndex) + r.programLength > h.programWordCount) {
+            if (errorMessage) *errorMessage = QString("场景记录%1越界").arg(i);
+            return false;
+        }
+    }
+    const PackIndexEntry *index = reinterpret_cast<const PackIndexEntry *>(m_data + h.indexOffset);
+    for (quint32 i = 0; i < h.scenarioCount; ++i) {
+        if (index[i].scenarioIndex >= h.scenarioCount
+                || quint64(index[i].nameOffset) + index[i].nameLength > stringSize) {
+            if (errorMessage) *errorMessage = QString("索引%1越界").arg(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+void ScenarioPack::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_scenarios = nullptr;
+    m_paths = nullptr;
+    m_index = nullptr;
+    m_strings = nullptr;
+    m_programs = nullptr;
+}
+
+bool ScenarioPack::isOpen() const
+{
+    return m_header != nullptr;
+}
+
+int ScenarioPack::count() const
+{
+    return m_header ? static_cast<int>(m_header->scenarioCount) : 0;
+}
+
+quint64 ScenarioPack::sourceRevision() const
+{
+    return m_header ? m_header->sourceRevision : 0;
+}
+
+int ScenarioPack::indexOf(const QString &name) const
+{
+    if (!m_header) {
+        return -1;
+    }
+
+    QByteArray key = name.toUtf8();
+    const PackIndexEntry *first = m_index;
+    const PackIndexEntry *last = m_index + m_header->scenarioCount;
+    const char *strings = m_strings;
+    const PackIndexEntry *it = std::lower_bound(first, last, key,
+                                                [strings](const PackIndexEntry &entry, const QByteArray &k) {
+        return compareName(strings + entry.nameOffset, entry.nameLength, k.constData(), k.size()) < 0;
+    });
+    if (it == last || compareName(strings + it->nameOffset, it->nameLength, key.constData(), key.size()) != 0) {
+        return -1;
+    }
+    return static_cast<int>(it->scenarioIndex);
+}
+
+const PackScenarioRecord *ScenarioPack::record(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return nullptr;
+    }
+    return m_scenarios + index;
+}
+
+const PackPathRecord *ScenarioPack::paths(int index) const
+{
+    const PackScenarioRecord *r = record(index);
+    return r ? m_paths + r->pathIndex : nullptr;
+}
+
+const quint32 *ScenarioPack::program(int index, int *wordCount) const
+{
+    const PackScenarioRecord *r = record(index);
+    if (!r || r->programLength == 0) {
+        if (wordCount) *wordCount = 0;
+        return nullptr;
+    }
+    if (wordCount) *wordCount = static_cast<int>(r->programLength);
+    return m_programs + r->programIndex;
+}
+
+QByteArray ScenarioPack::nameUtf8(int index) const
+{
+    const PackScenarioRecord *r = record(index);
+    if (!r) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(m_strings + r->nameOffset, static_cast<int>(r->nameLength));
+}
+
+QString ScenarioPack::name(int index) const
+{
+    const PackScenarioRecord *r = record(index);
+    if (!r) {
+        return QString();
+    }
+    return QString::fromUtf8(m_strings + r->nameOffset, static_cast<int>(r->nameLength));
+}
+
+ModelParaSetting ScenarioPack::scenario(int index) const
+{
+    ModelParaSetting config;
+    const PackScenarioRecord *r = record(index);
+    if (!r) {
+        return config;
+    }
+
+    config.channelNum = r->channelNum;
+    config.modelType = r->modelType;
+    config.modelName = name(index);
+    config.noisePower = r->noisePower;
+    config.signalAnt = r->signalAnt;
+    config.comDistance = r->comDistance;
+    config.multipathNum = r->multipathNum;
+    config.filterNum = r->filterNum;
+
+    const PackPathRecord *p = m_paths + r->pathIndex;
+    config.multipathType.reserve(static_cast<int>(r->pathCount));
+    for (quint32 i = 0; i < r->pathCount; ++i) {
+        MultiPathType path;
+        path.pathNum = p[i].pathNum;
+        path.relativDelay = p[i].relativDelay;
+        path.antPower = p[i].antPower;
+        path.freShift = p[i].freShift;
+        path.freSpread = p[i].freSpread;
+        path.dopplerType = p[i].dopplerType;
+        config.multipathType.append(path);
+    }
+    return config;
+}
+
+bool ScenarioPack::write(const QString &filePath, const QVector<ModelParaSetting> &configs,
+                         quint64 sourceRevision, const QHash<QString, QVector<quint32>> &programs,
+                         QString *errorMessage)
+{
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    if (errorMessage) *errorMessage = "场景库格式为小端，不支持当前平台";
+    return false;
+#endif
+
+    QVector<PackScenarioRecord> scenarios(configs.size());
+    QVector<PackPathRecord> paths;
+    QVector<PackIndexEntry> index(configs.size());
+    QByteArray strings;
+    QVector<quint32> programWords;
+
+    for (int i = 0; i < configs.size(); ++i) {
+        const ModelParaSetting &config = configs.at(i);
+        PackScenarioRecord &r = scenarios[i];
+        std::memset(&r, 0, sizeof(r));
+        r.channelNum = config.channelNum;
+        r.modelType = config.modelType;
+        r.multipathNum = config.multipathNum;
+        r.filterNum = config.filterNum;
+        r.noisePower = config.noisePower;
+        r.signalAnt = config.signalAnt;
+        r.comDistance = config.comDistance;
+
+        QByteArray name = config.modelName.toUtf8();
+        r.nameOffset = static_cast<quint32>(strings.size());
+        r.nameLength = static_cast<quint32>(name.size());
+        strings += name;
+
+        r.pathIndex = static_cast<quint32>(paths.size());
+        r.pathCount = static_cast<quint32>(config.multipathType.size());
+        for (const MultiPathType &path : config.multipathType) {
+            PackPathRecord p;
+            p.pathNum = path.pathNum;
+            p.relativDelay = path.relativDelay;
+            p.antPower = path.antPower;
+            p.freShift = path.freShift;
+            p.freSpread = path.freSpread;
+            p.dopplerType = path.dopplerType;
+            paths.append(p);
+        }
+
+        auto program = programs.constFind(config.modelName);
+        if (program != programs.constEnd()) {
+            r.programIndex = static_cast<quint32>(programWords.size());
+            r.programLength = static_cast<quint32>(program->size());
+            programWords += *program;
+        }
+
+        index[i].nameOffset = r.nameOffset;
+        index[i].nameLength = r.nameLength;
+        index[i].scenarioIndex = static_cast<quint32>(i);
+        index[i].reserved = 0;
+    }
+
+    // 索引按名称排序
+    const char *stringData = strings.constData();
+    std::sort(index.begin(), index.end(), [stringData](const PackIndexEntry &a, const PackIndexEntry &b) {
+        return compareName(stringData + a.nameOffset, a.nameLength, stringData + b.nameOffset, b.nameLength) < 0;
+    });
+
+    PackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = SCENARIO_PACK_MAGIC;
+    header.version = SCENARIO_PACK_VERSION;
+    header.headerSize = sizeof(PackHeader);
+    header.scenarioCount = static_cast<quint32>(scenarios.size());
+    header.pathCount = static_cast<quint32>(paths.size());
+    header.scenarioRecordSize = sizeof(PackScenarioRecord);
+    header.pathRecordSize = sizeof(PackPathRecord);
+    header.programWordCount = static_cast<quint32>(programWords.size());
+    header.sourceRevision = sourceRevision;
+    header.scenarioOffset = alignUp(sizeof(PackHeader));
+    header.pathOffset = alignUp(header.scenarioOffset + quint64(scenarios.size()) * sizeof(PackScenarioRecord));
+    header.indexOffset = alignUp(header.pathOffset + quint64(paths.size()) * sizeof(PackPathRecord));
+    header.stringOffset = alignUp(header.indexOffset + quint64(index.size()) * sizeof(PackIndexEntry));
+    header.programOffset = alignUp(header.stringOffset + quint64(strings.size()));
+    header.fileSize = header.programOffset + quint64(programWords.size()) * sizeof(quint32);
+
+    // 整体写入后原子替换
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorMessage) *errorMessage = "无法创建文件";
+        return false;
+    }
+
+    auto writeAt = [&file](quint64 offset, const void *data, qint64 size) {
+        // 对齐填充
+        static const char zeros[8] = {0};
+        while (static_cast<quint64>(file.pos()) < offset) {
+            file.write(zeros, qMin<qint64>(8, offset - file.pos()));
+        }
+        if (size > 0) {
+            file.write(static_cast<const char *>(data), size);
+        }
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.scenarioOffset, scenarios.constData(), scenarios.size() * qint64(sizeof(PackScenarioRecord)));
+    writeAt(header.pathOffset, paths.constData(), paths.size() * qint64(sizeof(PackPathRecord)));
+    writeAt(header.indexOffset, index.constData(), index.size() * qint64(sizeof(PackIndexEntry)));
+    writeAt(header.stringOffset, strings.constData(), strings.size());
+    writeAt(header.programOffset, programWords.constData(), programWords.size() * qint64(sizeof(quint32)));
+
+    if (!file.commit()) {
+        if (errorMessage) *errorMessage = "写入文件失败: " + file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+#ifndef SCENARIOPACK_H
+#define SCENARIOPACK_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QFile>
+#include <QByteArray>
+#include "channelparaconifg.h"
+
+// 场景库二进制格式：固定布局、小端、8字节对齐，可mmap后直接访问
+//
+//   [PackHeader]
+//   [PackScenarioRecord x scenarioCount]   按写入顺序
+//   [PackPathRecord x pathCount]           各场景的多径连续存放
+//   [PackIndexEntry x scenarioCount]       按名称UTF-8字节序排序，二分查找
+//   [名称字符串区]                          UTF-8，不含结尾0
+//   [寄存器程序区]                          可选，quint32数组
+//
+// 版本号在布局变化时递增，读取时版本不符直接拒绝
+
+#define SCENARIO_PACK_MAGIC   0x4B505343u   // "CSPK"
+#define SCENARIO_PACK_VERSION 1
+
+#pragma pack(push, 1)
+struct PackHeader
+{
+    quint32 magic;
+    quint16 version;
+    quint16 headerSize;
+    quint32 scenarioCount;
+    quint32 pathCount;
+    quint16 scenarioRecordSize;
+    quint16 pathRecordSize;
+    quint32 programWordCount;
+    quint64 sourceRevision;     // 生成时数据源(数据库)的修订号，0表示未知
+    quint64 scenarioOffset;
+    quint64 pathOffset;
+    quint64 indexOffset;
+    quint64 stringOffset;
+    quint64 programOffset;
+    quint64 fileSize;
+};
+
+struct PackScenarioRecord
+{
+    qint32 channelNum;
+    qint32 modelType;
+    qint32 multipathNum;
+    qint32 filterNum;
+    double noisePower;
+    double signalAnt;
+    double comDistance;
+    quint32 nameOffset;         // 相对字符串区
+    quint32 nameLength;
+    quint32 pathIndex;          // 第一条多径在路径区的序号
+    quint32 pathCount;
+    quint32 programIndex;       // 相对程序区的字序号
+    quint32 programLength;      // 字数，0表示没有
+};
+
+struct PackPathRecord
+{
+    qint32 pathNum;
+    qint32 relativDelay;
+    qint32 antPower;
+    qint32 freShift;
+    qint32 freSpread;
+    qint32 dopplerType;
+};
+
+struct PackIndexEntry
+{
+    quint32 nameOffset;
+    quint32 nameLength;
+    quint32 scenarioIndex;
+    quint32 reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PackHeader) == 80, "PackHeader layout");
+static_assert(sizeof(PackScenarioRecord) == 64, "PackScenarioRecord layout");
+static_assert(sizeof(PackPathRecord) == 24, "PackPathRecord layout");
+static_assert(sizeof(PackIndexEntry) == 16, "PackIndexEntry layout");
+
+// 只读场景库：打开时mmap整个文件并校验布局，之后的访问不拷贝、不解析
+class ScenarioPack
+{
+public:
+    ScenarioPack();
+    ~ScenarioPack();
+
+    bool open(const QString &filePath, QString *errorMessage = nullptr);
+    void close();
+    bool isOpen() const;
+
+    int count() const;
+    quint64 sourceRevision() const;
+
+    // 按名称查找，返回场景序号，不存在时返回-1
+    int indexOf(const QString &name) const;
+
+    // 以下直接指向映射内存，close()后失效
+    const PackScenarioRecord *record(int index) const;
+    const PackPathRecord *paths(int index) const;
+    const quint32 *program(int index, int *wordCount) const;
+    QByteArray nameUtf8(int index) const;     // 不拷贝数据
+    QString name(int index) const;
+
+    // 解码为ModelParaSetting
+    ModelParaSetting scenario(int index) const;
+
+    // 写出场景库；programs为按场景名称的寄存器程序，可为空
+    static bool write(const QString &filePath,
+                      const QVector<ModelParaSetting> &configs,
+                      quint64 sourceRevision = 0,
+                      const QHash<QString, QVector<quint32>> &programs = QHash<QString, QVector<quint32>>(),
+                      QString *errorMessage = nullptr);
+
+private:
+    bool validate(QString *errorMessage) const;
+
+    QFile m_file;
+    const uchar *m_data;
+    qint64 m_size;
+    const PackHeader *m_header;
+    const PackScenarioRecord *m_scenarios;
+    const PackPathRecord *m_paths;
+    const PackIndexEntry *m_index;
+    const char *m_strings;
+    const quint32 *m_programs;
+};
+
+#endif // SCENARIOPACK_H
@@ -0,0 +1,147 @@
+#include "scenariotablemodel.h"
+#include <algorithm>
+
+ScenarioTableModel::ScenarioTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ScenarioTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_summaries.size();
+}
+
+int ScenarioTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ScenarioTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_summaries.size()) {
+        return QVariant();
+    }
+
+    const ScenarioSummary &summary = m_summaries.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case IndexColumn: return index.row() + 1;
+        case ChannelColumn: return summary.channelNum;
+        case NameColumn: return summary.modelName;
+        case NoiseColumn: return QString::number(summary.noisePower, 'f', 2);   // 保留2位小数
+        case SignalAntColumn: return QString::number(summary.signalAnt, 'f', 2);
+        case MultipathColumn: return summary.multipathNum;
+        }
+        break;
+    case SortRole:
+        switch (index.column()) {
+        case IndexColumn: return index.row();
+        case ChannelColumn: return summary.channelNum;
+        case NameColumn: return summary.modelName;
+        case NoiseColumn: return summary.noisePower;
+        case SignalAntColumn: return summary.signalAnt;
+        case MultipathColumn: return summary.multipathNum;
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        return Qt::AlignCenter;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+QVariant ScenarioTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case IndexColumn: return "列表序号";
+    case ChannelColumn: return "信道编号";
+    case NameColumn: return "模拟名称";
+    case NoiseColumn: return "噪声功率（dbm）";
+    case SignalAntColumn: return "衰减功率 (dB)";
+    case MultipathColumn: return "多径数量";
+    }
+    return QVariant();
+}
+
+void ScenarioTableModel::setSummaries(const QVector<ScenarioSummary> &summaries)
+{
+    beginResetModel();
+    m_summaries = summaries;
+    endResetModel();
+}
+
+void ScenarioTableModel::append(const ScenarioSummary &summary)
+{
+    int row = m_summaries.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_summaries.append(summary);
+    endInsertRows();
+}
+
+void ScenarioTableModel::append(const QVector<ScenarioSummary> &summaries)
+{
+    if (summaries.isEmpty()) {
+        return;
+    }
+    int first = m_summaries.size();
+    beginInsertRows(QModelIndex(), first, first + summaries.size() - 1);
+    m_summaries += summaries;
+    endInsertRows();
+}
+
+void ScenarioTableModel::removeSummaries(QList<int> rows)
+{
+    // 先丢弃越界行号，否则越界行与相邻的有效行合并后整个区间都被跳过
+    int count = m_summaries.size();
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [count](int row) { return row < 0 || row >= count; }),
+               rows.end());
+
+    // 从后往前按连续区间删除，避免行号错乱
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    int i = 0;
+    while (i < rows.size()) {
+        int last = rows.at(i);
+        int first = last;
+        while (i + 1 < rows.size() && rows.at(i + 1) == first - 1) {
+            first = rows.at(++i);
+        }
+        ++i;
+        beginRemoveRows(QModelIndex(), first, last);
+        m_summaries.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+}
+
+void ScenarioTableModel::clear()
+{
+    setSummaries(QVector<ScenarioSummary>());
+}
+
+const ScenarioSummary &ScenarioTableModel::summary(int row) const
+{
+    return m_summaries.at(row);
+}
+
+ScenarioFilterProxyModel::ScenarioFilterProxyModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setSortRole(ScenarioTableModel::SortRole);
+    setFilterKeyColumn(ScenarioTableModel::NameColumn);
+    setFilterCaseSensitivity(Qt::CaseInsensitive);
+}
+
+QVariant ScenarioFilterProxyModel::data(const QModelIndex &index, int role) const
+{
+    if (role == Qt::DisplayRole && index.column() == ScenarioTableModel::IndexColumn) {
+        return index.row() + 1;
+    }
+    return QSortFilterProxyModel::data(index, role);
+}
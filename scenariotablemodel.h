@@ -0,0 +1,62 @@
+#ifndef SCENARIOTABLEMODEL_H
+#define SCENARIOTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <QVector>
+#include "databasemanager.h"
+
+// 模拟列表的数据模型：场景摘要连续存放在一个QVector中，单元格内容在data()中生成
+// 不为每个单元格分配对象，1万条以上场景时插入、删除和显示都保持流畅
+class ScenarioTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        IndexColumn,        // 列表序号
+        ChannelColumn,      // 信道编号
+        NameColumn,         // 模拟名称
+        NoiseColumn,        // 噪声功率
+        SignalAntColumn,    // 衰减功率
+        MultipathColumn,    // 多径数量
+        ColumnCount
+    };
+
+    // 排序用的原始值(数值列为数字而不是显示文本)
+    static const int SortRole = Qt::UserRole;
+
+    explicit ScenarioTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // 整体替换，一次重置
+    void setSummaries(const QVector<ScenarioSummary> &summaries);
+    // 追加到末尾，批量追加只通知一次
+    void append(const ScenarioSummary &summary);
+    void append(const QVector<ScenarioSummary> &summaries);
+    // 删除多行，行号无需有序，连续的行合并为一次通知
+    void removeSummaries(QList<int> rows);
+    void clear();
+
+    const ScenarioSummary &summary(int row) const;
+
+private:
+    QVector<ScenarioSummary> m_summaries;
+};
+
+// 排序/过滤代理：序号列显示代理中的行号，排序或过滤后仍从1连续编号
+class ScenarioFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit ScenarioFilterProxyModel(QObject *parent = nullptr);
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+};
+
+#endif // SCENARIOTABLEMODEL_H
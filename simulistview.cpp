@@ -6,9 +6,15 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QVBoxLayout>
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QEventLoop>
+#include <QtConcurrent>
 
 SimuListView::SimuListView(QWidget *parent)
     : QWidget{parent}
+    , m_library(nullptr)
+    , m_ioHandler(new IOHandler(this))
 {
     initUI();
     setupConnections();
@@ -42,19 +48,33 @@ void SimuListView::initUI()
     tableContainerLayout->setContentsMargins(6, 0, 6, 0); // 表格左右边距
     tableContainerLayout->setSpacing(0);
 
-    // ========== 核心修改1：初始化model并绑定到m_tableView ==========
-    m_tableView = new QTableView(); // 改用QTableView（推荐），若坚持用QTableWidget需调整接口
-    model = new QStandardItemModel(0, 6, this);
-    model->setHorizontalHeaderLabels(QStringList() << "列表序号" << "信道编号" << "模拟名称" << "噪声功率（dbm）" << "衰减功率 (dB)" << "多径数量");
-    m_tableView->setModel(model); // 绑定model到表格
+    // 场景摘要模型 + 排序/过滤代理
+    m_tableView = new QTableView();
+    model = new ScenarioTableModel(this);
+    m_proxyModel = new ScenarioFilterProxyModel(this);
+    m_proxyModel->setSourceModel(model);
+    m_tableView->setModel(m_proxyModel);
 
     // 设置表格属性（适配QTableView）
     m_tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     m_tableView->verticalHeader()->setVisible(false);
+    // 固定行高，大量行时不逐行计算高度
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     m_tableView->setAlternatingRowColors(true);
     m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_tableView->setSelectionMode(QAbstractItemView::ExtendedSelection); // 支持多行选中（导出需要）
-    m_tableView->setEditTriggers(QAbstractItemView::AllEditTriggers);
+    // 列表只显示场景库摘要，修改参数在参数页面进行
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableView->setSortingEnabled(true);
+    m_tableView->sortByColumn(ScenarioTableModel::IndexColumn, Qt::AscendingOrder);
+
+    // 按名称过滤
+    m_filterEdit = new QLineEdit(this);
+    m_filterEdit->setPlaceholderText("搜索模拟名称");
+    m_filterEdit->setClearButtonEnabled(true);
+    m_filterEdit->setFixedHeight(40);
+    m_filterEdit->setStyleSheet("QLineEdit { background-color: #2C5555; color: white; font-size: 14px; "
+                                "border: 1px solid #4A7A7A; border-radius: 6px; padding: 0 8px; }");
     m_tableView->setStyleSheet(R"(
         /* 表格内容字体 */
         QTableView {
@@ -142,6 +162,7 @@ void SimuListView::initUI()
     buttonContainerLayout->addWidget(m_exportButton);
     buttonContainerLayout->addWidget(m_deleteButton);
 
+    contentLayout->addWidget(m_filterEdit);
     contentLayout->addWidget(tableContainer, 1);
     contentLayout->addWidget(buttonContainer);
 
@@ -161,126 +182,143 @@ void SimuListView::setupConnections()
     connect(m_importButton, &QPushButton::clicked, this, &SimuListView::onImportClicked);
     connect(m_exportButton, &QPushButton::clicked, this, &SimuListView::onExportClicked);
     connect(m_selectAllButton, &QPushButton::clicked, this, &SimuListView::onSelectAllClicked);
-
-    // 当模型数据变化时更新序号
-    connect(model, &QStandardItemModel::rowsRemoved, this, &SimuListView::updateRowNumbers);
-    connect(model, &QStandardItemModel::rowsInserted, this, &SimuListView::updateRowNumbers);
+    connect(m_filterEdit, &QLineEdit::textChanged, m_proxyModel, &QSortFilterProxyModel::setFilterFixedString);
 }
 
 
 // 实现插入数据的函数
 void SimuListView::insertScenarioData(const ModelParaSetting &scenarioData)
 {
-    // 1. 在表格末尾添加一行
-    int newRow = model->rowCount();
-    model->insertRow(newRow);
-
-    // 2. 创建 QStandardItem  并填充数据
-    // 列表序号 (通常是行号 + 1)
-    QStandardItem *indexItem = new QStandardItem(QString::number(newRow + 1));
-    indexItem->setFlags(indexItem->flags() & ~Qt::ItemIsEditable); // 序号不可编辑
-    indexItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 信道编号
-    QStandardItem *numItem = new QStandardItem(QString::number(scenarioData.channelNum));
-    numItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 模拟名称
-    QStandardItem *nameItem = new QStandardItem(scenarioData.modelName);
-    nameItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 噪声功率
-    QStandardItem *noiseItem = new QStandardItem(QString::number(scenarioData.noisePower, 'f', 2)); // 保留2位小数
-    noiseItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 衰减功率 (假设 signalAnt 字段对应衰减功率)
-    QStandardItem *attenuationItem = new QStandardItem(QString::number(scenarioData.signalAnt, 'f', 2));
-    attenuationItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 多径数量
-    QStandardItem *multiPathNumItem = new QStandardItem(QString::number(scenarioData.multipathNum));
-    multiPathNumItem->setTextAlignment(Qt::AlignCenter); // 居中显示
-
-    // 3. 将创建的 Item 设置到表格中
-    model->setItem(newRow, 0, indexItem);
-    model->setItem(newRow, 1, numItem);
-    model->setItem(newRow, 2, nameItem);
-    model->setItem(newRow, 3, noiseItem);
-    model->setItem(newRow, 4, attenuationItem);
-    model->setItem(newRow, 5, multiPathNumItem);
-
-    m_dataList.append(scenarioData);
+    model->append(ScenarioLibrary::summaryOf(scenarioData));
+
+    // 不在场景库中的(如导入的)保留完整数据供导出
+    if (!m_library || !m_library->contains(scenarioData.modelName)) {
+        m_unsavedData.insert(scenarioData.modelName, scenarioData);
+    }
     qDebug() << "成功插入场景数据: " << scenarioData.channelNum;
 }
 
-void SimuListView::updateRowNumbers()
+void SimuListView::setScenarioLibrary(ScenarioLibrary *library)
 {
-    // 遍历model中的所有行，更新序号列
-    for (int row = 0; row < model->rowCount(); ++row) {
-        QStandardItem *item = model->item(row, 0);
-        if (!item) {
-            item = new QStandardItem();
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            item->setTextAlignment(Qt::AlignCenter);
-            model->setItem(row, 0, item);
-        }
-        item->setText(QString::number(row + 1));
+    m_library = library;
+    if (!m_library) {
+        return;
     }
+
+    // 一次重置，不逐行插入
+    model->setSummaries(m_library->summaries());
+    qDebug() << "模拟列表加载场景摘要:" << model->rowCount();
 }
 
-void SimuListView::onDeleteClicked()
+bool SimuListView::scenarioAt(int row, ModelParaSetting *config)
 {
-    QModelIndexList selected = m_tableView->selectionModel()->selectedRows();
-    if (selected.isEmpty()) {
-        QMessageBox::warning(this, "警告", "请先选择要删除的行!");
-        return;
+    if (row < 0 || row >= model->rowCount()) {
+        return false;
+    }
+    const QString &name = model->summary(row).modelName;
+    if (m_unsavedData.contains(name)) {
+        *config = m_unsavedData.value(name);
+        return true;
     }
+    return m_library && m_library->scenario(name, config);
+}
 
-    // 从后往前删除，避免索引错乱
+QList<int> SimuListView::selectedSourceRows() const
+{
     QList<int> rows;
-    foreach (const QModelIndex &index, selected) {
-        rows.append(index.row());
+    const QModelIndexList selected = m_tableView->selectionModel()->selectedRows();
+    for (const QModelIndex &index : selected) {
+        rows.append(m_proxyModel->mapToSource(index).row());
     }
-    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    // 按模型顺序，与排序前列表顺序一致
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
 
-    // 删除model中的行 + 同步删除m_dataList中的数据
-    foreach (int row, rows) {
-        model->removeRow(row);
-        if (row < m_dataList.size()) {
-            m_dataList.removeAt(row); // 同步删除数据列表，避免导出时数据错位
-        }
+void SimuListView::onDeleteClicked()
+{
+    QList<int> rows = selectedSourceRows();
+    if (rows.isEmpty()) {
+        QMessageBox::warning(this, "警告", "请先选择要删除的行!");
+        return;
     }
 
-    // 删除后自动更新序号
-    updateRowNumbers();
+    for (int row : rows) {
+        m_unsavedData.remove(model->summary(row).modelName);
+    }
+    // 序号在data()中计算，删除后无需重新编号
+    model->removeSummaries(rows);
 }
 
 void SimuListView::onImportClicked()
 {
-    QString fileName = QFileDialog::getOpenFileName(this, "导入配置", "", "配置文件 (*.csv *.json *.xml)");
+    QStringList fileNames = QFileDialog::getOpenFileNames(this, "导入配置", "", "配置文件 (*.csv *.json *.xml *.cspk)");
 
     // 用户取消选择文件
-    if (fileName.isEmpty()) {
+    if (fileNames.isEmpty()) {
         qDebug() << "用户取消导入文件";
         return;
     }
 
-    IOHandler ioHandler;
-
-    ModelParaSetting importedConfig = ioHandler.importDataAutoDetect(fileName);
-
-    insertScenarioData(importedConfig);
-
-    // 5. 提示用户导入成功
-    QMessageBox::information(this, tr("导入成功"),
-                             tr("配置文件导入成功！\n场景名称：%1\n信道编号：%2").arg(
-                                 importedConfig.modelName,
-                                 QString::number(importedConfig.channelNum)
-                                 )
+    // 每个文件可包含多个场景，文件在后台并行解析
+    QList<ModelParaSetting> importedConfigs;
+    QString errorMessage;
+    runWithProgress("正在导入", true, [this, fileNames, &importedConfigs, &errorMessage]() {
+        importedConfigs = m_ioHandler->importFiles(fileNames, &errorMessage);
+        return true;
+    });
+
+    // 一次批量插入
+    QVector<ScenarioSummary> summaries;
+    summaries.reserve(importedConfigs.size());
+    for (const ModelParaSetting &config : importedConfigs) {
+        summaries.append(ScenarioLibrary::summaryOf(config));
+        if (!m_library || !m_library->contains(config.modelName)) {
+            m_unsavedData.insert(config.modelName, config);
+        }
+    }
+    model->append(summaries);
+
+    // 5. 提示用户导入结果
+    if (errorMessage.isEmpty()) {
+        QMessageBox::information(this, tr("导入成功"),
+                                 tr("配置文件导入成功！\n文件数：%1\n场景数：%2").arg(
+                                     QString::number(fileNames.size()),
+                                     QString::number(importedConfigs.size())
+                                     )
+                                 );
+    } else {
+        QMessageBox::warning(this, tr("导入完成"),
+                             tr("已导入场景数：%1\n%2").arg(
+                                 QString::number(importedConfigs.size()), errorMessage)
                              );
+    }
 
-    qDebug() << "配置导入成功，场景名称：" << importedConfig.modelName;
+    qDebug() << "配置导入完成，场景数：" << importedConfigs.size();
+}
 
+bool SimuListView::runWithProgress(const QString &title, bool import, const std::function<bool()> &task)
+{
+    QProgressDialog progress(title, "取消", 0, 100, this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(300);
+    progress.setValue(0);
+
+    // 进度信号由工作线程发出，排队到界面线程
+    QMetaObject::Connection conn = import
+            ? connect(m_ioHandler, &IOHandler::importProgress, &progress, &QProgressDialog::setValue)
+            : connect(m_ioHandler, &IOHandler::exportProgress, &progress, &QProgressDialog::setValue);
+    connect(&progress, &QProgressDialog::canceled, m_ioHandler, &IOHandler::cancel);
+
+    QFutureWatcher<bool> watcher;
+    QEventLoop loop;
+    connect(&watcher, &QFutureWatcher<bool>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::run(task));
+    loop.exec();
+
+    disconnect(conn);
+    progress.reset();
+    return watcher.result();
 }
 
 void SimuListView::onExportClicked()
@@ -290,17 +328,18 @@ void SimuListView::onExportClicked()
         return;
     }
 
-    QModelIndexList selectedIndexes = m_tableView->selectionModel()->selectedRows();
-    if (selectedIndexes.isEmpty()) {
+    QList<int> selectedRows = selectedSourceRows();
+    if (selectedRows.isEmpty()) {
         QMessageBox::warning(this, "导出失败", "请先选中表格中的一行/多行数据！");
         return;
     }
 
+    // 导出时才读取完整参数
     QList<ModelParaSetting> selectedDataList;
-    for (const QModelIndex &index : selectedIndexes) {
-        int row = index.row();
-        if (row >= 0 && row < m_dataList.size()) {
-            selectedDataList.append(m_dataList.at(row));
+    for (int row : selectedRows) {
+        ModelParaSetting config;
+        if (scenarioAt(row, &config)) {
+            selectedDataList.append(config);
         }
     }
     if (selectedDataList.isEmpty()) {
@@ -374,27 +413,16 @@ void SimuListView::onSelectAllClicked()
     m_tableView->selectAll();
 }
 
-// 辅助函数：模式2 - 多行导出为独立文件（循环生成每个文件）
+// 辅助函数：模式2 - 多行导出为独立文件（线程池并行生成每个文件）
 bool SimuListView::exportToMultiFiles(const QList<ModelParaSetting> &dataList,
                                       const QString &dirPath, const QString &format)
 {
-    bool allOk = true;
-    QDir dir(dirPath);
-    IOHandler ioHandler;
-
-    for (int i = 0; i < dataList.size(); ++i) { // 循环遍历每行数据
-        const ModelParaSetting &data = dataList.at(i);
-        // 文件名：场景名称_行号.json（避免重复）
-        QString fileName = QString("%1_%2.%3").arg(data.modelName).arg(i + 1).arg(format);
-        QString filePath = dir.filePath(fileName);
-
-        // 导出单个文件（复用原有单文件导出函数）
-        bool ok = ioHandler.exportData(data, filePath, format);
-        if (!ok) {
-            allOk = false;
-            qWarning() << "导出失败：" << filePath;
-        }
+    QString errorMessage;
+    bool ok = runWithProgress("正在导出", false, [this, &dataList, &dirPath, &format, &errorMessage]() {
+        return m_ioHandler->exportFiles(dataList, dirPath, format, &errorMessage);
+    });
+    if (!ok) {
+        qWarning() << "导出失败：" << errorMessage;
     }
-    return allOk;
+    return ok;
 }
-
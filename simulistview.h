@@ -5,8 +5,11 @@
 #include <QPushButton>
 #include <QTableView>
 #include <QHeaderView>
-#include <QStandardItemModel>
+#include <QLineEdit>
 #include "channelparaconifg.h"
+#include "scenariotablemodel.h"
+#include "scenariolibrary.h"
+#include "iohandler.h"
 
 class SimuListView : public QWidget
 {
@@ -18,6 +21,9 @@ public:
     // 声明用于插入数据的函数
     void insertScenarioData(const ModelParaSetting &scenarioData);
 
+    // 按场景库摘要填充列表，完整参数在导出时才读取
+    void setScenarioLibrary(ScenarioLibrary *library);
+
 signals:
 
 private slots:
@@ -27,18 +33,27 @@ private slots:
     void onSelectAllClicked();
 
 private:
-    QStandardItemModel *model;
+    ScenarioTableModel *model;
+    ScenarioFilterProxyModel *m_proxyModel;
     void initUI();
     void setupConnections();
-    void updateRowNumbers();
+    // 选中行对应的模型行号(未排序、未过滤时的行号)
+    QList<int> selectedSourceRows() const;
+    // 取模型行对应的完整场景
+    bool scenarioAt(int row, ModelParaSetting *config);
     bool exportToMultiFiles(const QList<ModelParaSetting> &dataList, const QString &dirPath, const QString &format);
+    // 在线程池中执行批量导入/导出，期间显示可取消的进度对话框
+    bool runWithProgress(const QString &title, bool import, const std::function<bool()> &task);
     QTableView *m_tableView;
+    QLineEdit *m_filterEdit;
     QPushButton *m_deleteButton;
     QPushButton *m_importButton;
     QPushButton *m_exportButton;
     QPushButton *m_selectAllButton;
 
-    QList<ModelParaSetting> m_dataList;
+    ScenarioLibrary *m_library;
+    IOHandler *m_ioHandler;
+    QHash<QString, ModelParaSetting> m_unsavedData;    // 导入但未入库的场景
 };
 
 #endif // SIMULISTVIEW_H
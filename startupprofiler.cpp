@@ -0,0 +1,25 @@
+#include "startupprofiler.h"
+#include <QDebug>
+
+qint64 StartupProfiler::m_lastMark = 0;
+
+QElapsedTimer &StartupProfiler::timer()
+{
+    static QElapsedTimer startTimer;
+    if (!startTimer.isValid()) {
+        startTimer.start();
+    }
+    return startTimer;
+}
+
+void StartupProfiler::mark(const char *phase)
+{
+    qint64 now = timer().elapsed();
+    qDebug() << "[启动耗时]" << phase << "本阶段:" << (now - m_lastMark) << "ms 累计:" << now << "ms";
+    m_lastMark = now;
+}
+
+qint64 StartupProfiler::elapsed()
+{
+    return timer().elapsed();
+}
@@ -0,0 +1,21 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QElapsedTimer>
+
+// 启动耗时统计：按阶段打点，输出本阶段耗时和从进程启动起的累计耗时
+class StartupProfiler
+{
+public:
+    // 记录一个阶段结束
+    static void mark(const char *phase);
+
+    // 从第一次打点起的累计耗时(ms)
+    static qint64 elapsed();
+
+private:
+    static QElapsedTimer &timer();
+    static qint64 m_lastMark;
+};
+
+#endif // STARTUPPROFILER_H
@@ -25,19 +25,18 @@ SubWindow::SubWindow(QWidget *parent)
     setupUI();
     createPages();
 
+    // 电台状态变化时按帧合并通知，不再定时轮询
+    for (RadioStatus &shown : m_shownStatus) {
+        shown.radioState = static_cast<RadioState>(-1);
+        shown.txPower = 0;
+    }
+    connect(RadioStatusBoard::instance(), &RadioStatusBoard::statusChanged,
+            this, &SubWindow::updateStatusBar);
     updateStatusBar();
-
-    // 创建定时器
-    m_timer = new QTimer(this);
-    connect(m_timer, &QTimer::timeout, this, &SubWindow::updateStatusBar);
-
-    // 启动定时器，每1000毫秒（1秒）触发一次
-    m_timer->start(5000);
 }
 
 SubWindow::~SubWindow()
 {
-    m_timer->stop();
 }
 
 void SubWindow::setMainWindow(MainWindow *mainWindow)
@@ -296,18 +295,67 @@ void SubWindow::initWindowSize()
 
 void SubWindow::createPages()
 {
-    m_channelModelSelect = new ChannelModelSelect();
-    m_channelBasicPara = new ChannelBasicPara();
-    m_multipathPara = new MultiPathPara();
-    m_stackedWidget->addWidget(m_channelModelSelect);
-    m_stackedWidget->addWidget(m_channelBasicPara);
-    m_stackedWidget->addWidget(m_multipathPara);
+    // 副窗口在选择信道后才显示，三个参数页面都延迟创建
+    // 场景选择页创建时列出场景库中已保存的场景
+    m_channelModelSelectPage = new LazyPage([this]() {
+        ChannelModelSelect *page = new ChannelModelSelect();
+        ScenarioLibrary *library = m_mainWindow->scenarioLibrary();
+        page->addScenarios(library->summaries());
+        // 之后场景库的增删增量同步到列表
+        connect(library, &ScenarioLibrary::scenarioSaved, page, &ChannelModelSelect::updateScenario);
+        connect(library, &ScenarioLibrary::scenarioRemoved, page, &ChannelModelSelect::removeScenario);
+        // 列表内容变化后切换动画中的快照过期
+        connect(library, &ScenarioLibrary::scenarioSaved, this, [this]() {
+            invalidatePageSnapshot(m_channelModelSelectPage);
+        });
+        connect(library, &ScenarioLibrary::scenarioRemoved, this, [this]() {
+            invalidatePageSnapshot(m_channelModelSelectPage);
+        });
+        return page;
+    });
+    m_channelBasicParaPage = new LazyPage([this]() {
+        ChannelBasicPara *page = new ChannelBasicPara();
+        connect(page, &ChannelBasicPara::parametersChanged, this, [this]() {
+            invalidatePageSnapshot(m_channelBasicParaPage);
+        });
+        return page;
+    });
+    m_multipathParaPage = new LazyPage([this]() {
+        MultiPathPara *page = new MultiPathPara();
+        connect(page, &MultiPathPara::multipathParametersChanged, this, [this]() {
+            invalidatePageSnapshot(m_multipathParaPage);
+        });
+        return page;
+    });
+    m_stackedWidget->addWidget(m_channelModelSelectPage);
+    m_stackedWidget->addWidget(m_channelBasicParaPage);
+    m_stackedWidget->addWidget(m_multipathParaPage);
 
     m_stackedWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
     m_pageIndicator->setCurrentIndex(0);
 }
 
+void SubWindow::invalidatePageSnapshot(QWidget *page)
+{
+    m_stackedWidget->invalidateSnapshot(m_stackedWidget->indexOf(page));
+}
+
+ChannelModelSelect *SubWindow::channelModelSelect()
+{
+    return static_cast<ChannelModelSelect *>(m_channelModelSelectPage->page());
+}
+
+ChannelBasicPara *SubWindow::channelBasicPara()
+{
+    return static_cast<ChannelBasicPara *>(m_channelBasicParaPage->page());
+}
+
+MultiPathPara *SubWindow::multipathPara()
+{
+    return static_cast<MultiPathPara *>(m_multipathParaPage->page());
+}
+
 void SubWindow::onSwipeFinished()
 {
     int currentIndex = m_stackedWidget->currentIndex();
@@ -362,22 +410,18 @@ void SubWindow::closeSubWindow()
 void SubWindow::startChannelSimu()
 {
     qDebug()<<"startChannelSimu--------------------------------1";
-    // QMutexLocker locker(&globalMutex);
+    // 下发的参数全部取自界面
     ModelParaSetting config;
-    if(globalParaMap.contains(config.modelName)){
-        config=globalParaMap[config.modelName];
-    }
+    config.modelName = channelModelSelect()->getSelectedRadioButtonText();
     config.channelNum = m_mainWindow->getChannelNum();
-    config.modelName = m_channelModelSelect->getSelectedRadioButtonText();
-    config.noisePower = m_channelBasicPara->getNoisePower();
-    config.signalAnt = m_channelBasicPara->getAttenuationPower();
-    config.comDistance = m_channelBasicPara->getCommunicationDistance();
-    config.filterNum = m_multipathPara->getFilterNum();
-    config.multipathNum = m_multipathPara->getMultipathCount();
-    config.multipathType = m_multipathPara->getMultipathPara();
+    config.noisePower = channelBasicPara()->getNoisePower();
+    config.signalAnt = channelBasicPara()->getAttenuationPower();
+    config.comDistance = channelBasicPara()->getCommunicationDistance();
+    config.filterNum = multipathPara()->getFilterNum();
+    config.multipathNum = multipathPara()->getMultipathCount();
+    config.multipathType = multipathPara()->getMultipathPara();
     config.isChange=true;
     qDebug()<<"滤波器编号:"<<config.filterNum;
-    globalParaMap[config.modelName] = config;
 
     ChannelSetting set;
     set.signalAnt = config.signalAnt;
@@ -427,86 +471,44 @@ QString SubWindow::getStatusStyle(const QString &status)
     }
 }
 
-void SubWindow::updateStatusBar()
+void SubWindow::updateStatusBar(quint32 radioMask)
 {
-    QMutexLocker locker(&globalMutex);
-    switch(globalStatusMap[1].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label1->setText(QString("电台1:停止"));
-        m_indicator1->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label1->setText(QString("电台1:接收"));
-        m_indicator1->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label1->setText(QString("电台1:发射，%1dbm").arg(globalStatusMap[1].txPower));
-        m_indicator1->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label1->setText(QString("电台1:发射，%1dbm").arg(globalStatusMap[1].txPower));
-        m_indicator1->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
-
-    switch(globalStatusMap[2].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label2->setText(QString("电台2:停止"));
-        m_indicator2->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label2->setText(QString("电台2:接收"));
-        m_indicator2->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label2->setText(QString("电台2:发射，%1dbm").arg(globalStatusMap[2].txPower));
-        m_indicator2->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label2->setText(QString("电台2:发射，%1dbm").arg(globalStatusMap[2].txPower));
-        m_indicator2->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
-
-    switch(globalStatusMap[3].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label3->setText(QString("电台3:停止"));
-        m_indicator3->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label3->setText(QString("电台3:接收"));
-        m_indicator3->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label3->setText(QString("电台3:发射，%1dbm").arg(globalStatusMap[3].txPower));
-        m_indicator3->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label3->setText(QString("电台3:发射，%1dbm").arg(globalStatusMap[3].txPower));
-        m_indicator3->setStyleSheet(getStatusStyle("警告"));
-        break;
-    }
-
-    switch(globalStatusMap[4].radioState)
-    {
-    case RADIO_DISABLE:
-        m_label4->setText(QString("电台4:停止"));
-        m_indicator4->setStyleSheet(getStatusStyle("停止"));
-        break;
-    case RADIO_RECEIVE:
-        m_label4->setText(QString("电台4:接收"));
-        m_indicator4->setStyleSheet(getStatusStyle("接收"));
-        break;
-    case RADIO_TRANSMIT:
-        m_label4->setText(QString("电台4:发射，%1dbm").arg(globalStatusMap[4].txPower));
-        m_indicator4->setStyleSheet(getStatusStyle("发射"));
-        break;
-    case RADIO_ALARM:
-        m_label4->setText(QString("电台4:发射，%1dbm").arg(globalStatusMap[4].txPower));
-        m_indicator4->setStyleSheet(getStatusStyle("警告"));
-        break;
+    QLabel *labels[RadioStatusBoard::RADIO_COUNT] = {m_label1, m_label2, m_label3, m_label4};
+    QLabel *indicators[RadioStatusBoard::RADIO_COUNT] = {m_indicator1, m_indicator2, m_indicator3, m_indicator4};
+
+    // 只刷新有变化的电台；收发状态不变时不重设样式表，避免重新解析样式
+    RadioStatusBoard *board = RadioStatusBoard::instance();
+    for (int radio = 1; radio <= RadioStatusBoard::RADIO_COUNT; radio++) {
+        if (!(radioMask & (1u << (radio - 1)))) {
+            continue;
+        }
+        RadioStatus status = board->status(radio);
+        RadioStatus &shown = m_shownStatus[radio - 1];
+        bool stateChanged = status.radioState != shown.radioState;
+        bool showPower = status.radioState == RADIO_TRANSMIT || status.radioState == RADIO_ALARM;
+        if (!stateChanged && !(showPower && status.txPower != shown.txPower)) {
+            continue;
+        }
+
+        QLabel *label = labels[radio - 1];
+        switch (status.radioState)
+        {
+        case RADIO_DISABLE:
+            label->setText(QString("电台%1:停止").arg(radio));
+            break;
+        case RADIO_RECEIVE:
+            label->setText(QString("电台%1:接收").arg(radio));
+            break;
+        case RADIO_TRANSMIT:
+        case RADIO_ALARM:
+            label->setText(QString("电台%1:发射，%2dbm").arg(radio).arg(status.txPower));
+            break;
+        }
+
+        if (stateChanged) {
+            static const char *styleNames[] = {"停止", "接收", "发射", "警告"};
+            indicators[radio - 1]->setStyleSheet(getStatusStyle(styleNames[status.radioState]));
+        }
+        shown = status;
     }
 }
@@ -9,6 +9,7 @@
 #include "channelmodelselect.h"
 #include "channelbasicpara.h"
 #include "multipathpara.h"
+#include "lazypage.h"
 
 class SwipeStackedWidget;
 class PageIndicator;
@@ -28,16 +29,23 @@ private slots:
     void onPageChanged(int index);
     void goToNextPage();
     void goToPrevPage();
-    void updateStatusBar();
+    // 刷新状态栏，radioMask为需要刷新的电台
+    void updateStatusBar(quint32 radioMask = RadioStatusBoard::ALL_RADIOS);
     void closeSubWindow();
     void startChannelSimu();
 signals:
     // 配置更新信号，当updateConfigInMap函数被调用时发出
     void configUpdated(const QString& key, const ModelParaSetting& config);
 private:
+    // 页面内容变化后使其切换快照失效
+    void invalidatePageSnapshot(QWidget *page);
     void setupUI();
     void initWindowSize();
     void createPages();
+    // 参数页面，未创建时立即创建
+    ChannelModelSelect *channelModelSelect();
+    ChannelBasicPara *channelBasicPara();
+    MultiPathPara *multipathPara();
     //配置侦察设备信道参数
     void setJtCfg(int chl,const ModelParaSetting& config);
     //配置干扰器信道参数
@@ -46,7 +54,8 @@ private:
     QString getStatusStyle(const QString &status);
 
     MainWindow *m_mainWindow;  // 主窗口引用
-    QTimer *m_timer;
+    // 状态栏当前显示的电台状态
+    RadioStatus m_shownStatus[RadioStatusBoard::RADIO_COUNT];
     QLabel *m_label1;
     QLabel *m_label2;
     QLabel *m_label3;
@@ -63,9 +72,10 @@ private:
     QPushButton *m_startButton;
     QPushButton *m_backButton;
 
-    ChannelModelSelect *m_channelModelSelect;
-    ChannelBasicPara *m_channelBasicPara;
-    MultiPathPara *m_multipathPara;
+    // 参数页面延迟到第一次显示或下发配置时创建
+    LazyPage *m_channelModelSelectPage;
+    LazyPage *m_channelBasicParaPage;
+    LazyPage *m_multipathParaPage;
 
 };
 
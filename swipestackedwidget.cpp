@@ -7,6 +7,27 @@
 #include <QTextEdit>
 #include <QComboBox>
 #include <QDebug>
+#include <QLayout>
+#include "lazypage.h"
+
+SwipeTransitionLayer::SwipeTransitionLayer(SwipeStackedWidget *owner)
+    : QWidget(owner)
+    , m_owner(owner)
+{
+    // 每帧整层覆盖，不需要清背景，也不让下层页面重绘
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_NoSystemBackground);
+    // 触摸和鼠标事件仍交给SwipeStackedWidget处理
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    hide();
+}
+
+void SwipeTransitionLayer::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+    QPainter painter(this);
+    m_owner->paintTransition(&painter);
+}
 
 SwipeStackedWidget::SwipeStackedWidget(QWidget *parent)
     : QStackedWidget(parent)
@@ -23,6 +44,11 @@ SwipeStackedWidget::SwipeStackedWidget(QWidget *parent)
     , m_edgeAreaColor(QColor(0, 100, 200, 50))
     , m_indicatorColor(QColor(0, 100, 200, 150))
     , m_circularEnabled(true)
+    , m_transitionActive(false)
+    , m_lastFrameMs(0)
+    , m_maxFrameMs(0)
+    , m_frameCount(0)
+    , m_lastFps(0)
 {
     // 初始化枚举成员变量
     m_swipeState = SwipeState::Idle;
@@ -35,6 +61,13 @@ SwipeStackedWidget::SwipeStackedWidget(QWidget *parent)
     connect(m_animation, &QPropertyAnimation::finished,
             this, &SwipeStackedWidget::onAnimationFinished);
 
+    m_transitionLayer = new SwipeTransitionLayer(this);
+    connect(this, &QStackedWidget::widgetRemoved, this, &SwipeStackedWidget::onWidgetRemoved);
+    // 成为当前页后页面可被操作，旧快照作废
+    connect(this, &QStackedWidget::currentChanged, this, [this](int index) {
+        invalidateSnapshot(index);
+    });
+
     // 启用触摸跟踪
     setAttribute(Qt::WA_AcceptTouchEvents);
 }
@@ -120,7 +153,12 @@ void SwipeStackedWidget::setSwipeDistance(int distance)
 {
     if (m_swipeDistance != distance) {
         m_swipeDistance = distance;
-        update();
+        // 切换期间只重绘快照层
+        if (m_transitionActive) {
+            m_transitionLayer->update();
+        } else {
+            update();
+        }
         emit swipeDistanceChanged(distance);
         emit swipeProgressChanged(calculateSwipeProgress());
     }
@@ -168,6 +206,8 @@ void SwipeStackedWidget::paintEvent(QPaintEvent *event)
 void SwipeStackedWidget::resizeEvent(QResizeEvent *event)
 {
     QStackedWidget::resizeEvent(event);
+    m_transitionLayer->setGeometry(rect());
+    invalidateSnapshot();
     // 重置滑动状态
     if (m_swipeState == SwipeState::Swiping) {
         cancelSwipe();
@@ -176,11 +216,13 @@ void SwipeStackedWidget::resizeEvent(QResizeEvent *event)
 
 void SwipeStackedWidget::onAnimationFinished()
 {
+    // 先在快照层下方切换实时页面，再移除快照层，避免闪烁
     if (m_targetIndex != -1 && m_targetIndex != currentIndex()) {
         QStackedWidget::setCurrentIndex(m_targetIndex);
         emit pageChanged(m_targetIndex);
     }
 
+    endTransition();
     setSwipeDistance(0);
     m_swipeState = SwipeState::Idle;
     m_targetIndex = -1;
@@ -328,6 +370,7 @@ void SwipeStackedWidget::startSwipe()
     m_swipeState = SwipeState::Swiping;
     m_swipeDirection = (m_currentPos.x() - m_startPos.x() > 0) ?
                            SwipeDirection::Right : SwipeDirection::Left;
+    beginTransition();
     emit swipeStarted();
     update();
 }
@@ -342,8 +385,11 @@ void SwipeStackedWidget::updateSwipe()
         deltaX = (deltaX > 0) ? maxSwipeDistance : -maxSwipeDistance;
     }
 
+    // 方向反转时相邻页变化，先准备快照再更新位置
+    if ((deltaX > 0) != (m_swipeDistance > 0)) {
+        ensureSnapshot(deltaX > 0 ? getCircularPrevIndex() : getCircularNextIndex());
+    }
     setSwipeDistance(deltaX);
-    updateSwipePreview();
 }
 
 void SwipeStackedWidget::completeSwipe()
@@ -365,6 +411,7 @@ void SwipeStackedWidget::cancelSwipe()
         m_swipeState = SwipeState::Animating;
     } else {
         m_swipeState = SwipeState::Idle;
+        endTransition();
         setSwipeDistance(0);
     }
 }
@@ -395,6 +442,10 @@ void SwipeStackedWidget::animateToIndex(int index)
 
     int targetDistance = direction * width();
 
+    // 编程切换时在此开始快照切换，滑动中则已开始
+    beginTransition();
+    ensureSnapshot(index);
+
     m_animation->setStartValue(m_swipeDistance);
     m_animation->setEndValue(targetDistance);
     m_animation->start();
@@ -407,10 +458,126 @@ void SwipeStackedWidget::animateReturn()
     m_animation->start();
 }
 
-void SwipeStackedWidget::updateSwipePreview()
+void SwipeStackedWidget::invalidateSnapshot(int index)
+{
+    if (index < 0) {
+        m_snapshots.clear();
+    } else {
+        m_snapshots.remove(widget(index));
+    }
+
+    // 动画期间正在显示的两页立即重新截取，不出现空白
+    if (m_transitionActive) {
+        ensureSnapshot(currentIndex());
+        ensureSnapshot(neighborIndex());
+        m_transitionLayer->update();
+    }
+}
+
+qreal SwipeStackedWidget::lastTransitionFps() const
 {
-    // 可以在这里实现滑动时的预览效果
-    // 例如改变下一页的透明度或缩放
+    return m_lastFps;
+}
+
+void SwipeStackedWidget::onWidgetRemoved(int index)
+{
+    Q_UNUSED(index)
+    // 页面已从布局移除，无法按下标定位，全部重新截取
+    invalidateSnapshot();
+}
+
+void SwipeStackedWidget::ensureSnapshot(int index)
+{
+    QWidget *page = widget(index);
+    if (!page || m_snapshots.contains(page)) {
+        return;
+    }
+    // grab()不触发showEvent，延迟页面须先创建真正的页面并完成布局，否则截到空白容器
+    LazyPage *lazyPage = qobject_cast<LazyPage*>(page);
+    if (lazyPage && !lazyPage->isCreated()) {
+        lazyPage->page();
+        lazyPage->layout()->activate();
+    }
+    // 隐藏页面同样由QStackedLayout设置了几何尺寸，可直接截取
+    m_snapshots.insert(page, page->grab());
+}
+
+int SwipeStackedWidget::neighborIndex() const
+{
+    if (m_targetIndex != -1) {
+        return m_targetIndex;
+    }
+    return m_swipeDistance > 0 ? getCircularPrevIndex() : getCircularNextIndex();
+}
+
+void SwipeStackedWidget::beginTransition()
+{
+    if (m_transitionActive || count() == 0) {
+        return;
+    }
+
+    // 当前页是实时页面，每次开始时重新截取
+    invalidateSnapshot(currentIndex());
+    ensureSnapshot(currentIndex());
+    ensureSnapshot(neighborIndex());
+
+    m_transitionActive = true;
+    m_transitionLayer->setGeometry(rect());
+    m_transitionLayer->raise();
+    m_transitionLayer->show();
+
+    m_frameCount = 0;
+    m_maxFrameMs = 0;
+    m_lastFrameMs = 0;
+    m_transitionTimer.start();
+}
+
+void SwipeStackedWidget::endTransition()
+{
+    if (!m_transitionActive) {
+        return;
+    }
+    m_transitionActive = false;
+    m_transitionLayer->hide();
+
+    // 新的当前页恢复为实时页面，其快照随时可能过期
+    invalidateSnapshot(currentIndex());
+
+    qint64 elapsed = m_transitionTimer.elapsed();
+    m_lastFps = elapsed > 0 ? m_frameCount * 1000.0 / elapsed : 0;
+    qDebug() << "页面切换帧数:" << m_frameCount << "耗时:" << elapsed << "ms"
+             << "最长帧间隔:" << m_maxFrameMs << "ms" << "帧率:" << m_lastFps;
+    emit transitionStats(m_frameCount, elapsed, m_maxFrameMs, m_lastFps);
+}
+
+void SwipeStackedWidget::paintTransition(QPainter *painter)
+{
+    // 帧间隔统计
+    qint64 now = m_transitionTimer.elapsed();
+    if (m_frameCount > 0) {
+        m_maxFrameMs = qMax(m_maxFrameMs, now - m_lastFrameMs);
+    }
+    m_lastFrameMs = now;
+    m_frameCount++;
+
+    // 当前页随滑动距离平移，相邻页紧贴其一侧
+    QPixmap current = m_snapshots.value(widget(currentIndex()));
+    QPixmap neighbor = m_snapshots.value(widget(neighborIndex()));
+    int neighborX = m_swipeDistance > 0 ? m_swipeDistance - width() : m_swipeDistance + width();
+
+    // 滑动距离为0时没有露出相邻页
+    if (m_swipeDistance == 0 || neighbor.isNull()) {
+        painter->fillRect(rect(), palette().window());
+    } else {
+        painter->drawPixmap(neighborX, 0, neighbor);
+    }
+    if (!current.isNull()) {
+        painter->drawPixmap(m_swipeDistance, 0, current);
+    }
+
+    if (m_showSwipeIndicator && m_swipeState == SwipeState::Swiping) {
+        drawSwipeIndicator(painter);
+    }
 }
 
 int SwipeStackedWidget::calculateTargetIndex() const
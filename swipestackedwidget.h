@@ -6,6 +6,24 @@
 #include <QPropertyAnimation>
 #include <QPainter>
 #include <QElapsedTimer>
+#include <QPixmap>
+#include <QHash>
+
+class SwipeStackedWidget;
+
+// 切换动画期间覆盖在页面上方的绘制层，每帧只贴两张页面快照
+// 不透明绘制，下层的实时页面不参与重绘
+class SwipeTransitionLayer : public QWidget
+{
+public:
+    explicit SwipeTransitionLayer(SwipeStackedWidget *owner);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    SwipeStackedWidget *m_owner;
+};
 
 class SwipeStackedWidget : public QStackedWidget
 {
@@ -40,12 +58,20 @@ public:
     int swipeDistance() const;
     void setSwipeDistance(int distance);
 
+    // 页面内容变化后使其快照失效，index为-1时全部失效
+    void invalidateSnapshot(int index = -1);
+
+    // 最近一次切换动画的实际帧率
+    qreal lastTransitionFps() const;
+
 signals:
     void swipeStarted();
     void swipeFinished();
     void pageChanged(int index);
     void swipeDistanceChanged(int distance);
     void swipeProgressChanged(qreal progress);
+    // 每次切换动画结束后报告帧数、耗时、最长帧间隔和实际帧率
+    void transitionStats(int frames, qint64 elapsedMs, qint64 maxFrameMs, qreal fps);
 
 protected:
     bool event(QEvent *event) override;
@@ -54,8 +80,11 @@ protected:
 
 private slots:
     void onAnimationFinished();
+    void onWidgetRemoved(int index);
 
 private:
+    friend class SwipeTransitionLayer;
+
     enum class SwipeDirection { None, Left, Right };
     enum class SwipeState { Idle, Tracking, Swiping, Animating };
 
@@ -80,7 +109,6 @@ private:
     // 动画控制
     void animateToIndex(int index);
     void animateReturn();
-    void updateSwipePreview();
 
     // 工具函数
     int calculateTargetIndex() const;
@@ -91,6 +119,15 @@ private:
     void drawSwipeIndicator(QPainter *painter);
     void drawEdgeAreas(QPainter *painter);
 
+    // 快照切换：开始时截取当前页，动画期间由绘制层贴图，结束后恢复实时页面
+    void beginTransition();
+    void endTransition();
+    // 当前滑动方向上要显示的相邻页
+    int neighborIndex() const;
+    // 确保页面快照存在，只在绘制之外调用
+    void ensureSnapshot(int index);
+    void paintTransition(QPainter *painter);
+
     // 成员变量
     QPropertyAnimation *m_animation;
     bool m_swipeEnabled;
@@ -119,6 +156,18 @@ private:
     // 循环滑动相关
     bool m_circularEnabled;
 
+    // 页面快照缓存，页面成为当前页或尺寸变化时失效
+    SwipeTransitionLayer *m_transitionLayer;
+    QHash<QWidget*, QPixmap> m_snapshots;
+    bool m_transitionActive;
+
+    // 帧率统计
+    QElapsedTimer m_transitionTimer;
+    qint64 m_lastFrameMs;
+    qint64 m_maxFrameMs;
+    int m_frameCount;
+    qreal m_lastFps;
+
     // 添加新的循环滑动函数
     int getCircularNextIndex() const;
     int getCircularPrevIndex() const;
@@ -6,7 +6,7 @@
 
 SystemSetting::SystemSetting(QWidget *parent)
     : QWidget{parent}
-    , m_mqttClient(new MqttClient(this))
+    , m_mqttClient(new MqttService(this))
     , m_mqttParser(new MqttMessageParser(this))
 {
     initUI();
@@ -284,15 +284,15 @@ void SystemSetting::initUI()
 
 void SystemSetting::initMqttClient()
 {
-    connect(m_mqttClient, &MqttClient::connectionStatusChanged, [](bool connected) {
+    connect(m_mqttClient, &MqttService::connectionStatusChanged, [](bool connected) {
         qDebug() << "连接状态:" << (connected ? "已连接" : "已断开");
     });
 
-    connect(m_mqttClient, &MqttClient::examStartMessageReceived, this, &SystemSetting::onMQTTExamStartMessageReceived);
-    connect(m_mqttClient, &MqttClient::examEndMessageReceived, this, &SystemSetting::onMQTTExamEndMessageReceived);
-    connect(m_mqttClient, &MqttClient::paramMessageReceived, this, &SystemSetting::onMQTTParamMessageReceived);
+    connect(m_mqttClient, &MqttService::examStartMessageReceived, this, &SystemSetting::onMQTTExamStartMessageReceived);
+    connect(m_mqttClient, &MqttService::examEndMessageReceived, this, &SystemSetting::onMQTTExamEndMessageReceived);
+    connect(m_mqttClient, &MqttService::paramMessageReceived, this, &SystemSetting::onMQTTParamMessageReceived);
 
-    connect(m_mqttClient, &MqttClient::errorOccurred, [](const QString &error) {
+    connect(m_mqttClient, &MqttService::errorOccurred, [](const QString &error) {
         qDebug() << "错误:" << error;
     });
 
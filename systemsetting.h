@@ -10,7 +10,7 @@
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include "settingmanager.h"
-#include "mqttclient.h"
+#include "mqttservice.h"
 #include "mqttmessageparser.h"
 
 class SystemSetting : public QWidget
@@ -61,7 +61,7 @@ private:
     QString m_fileFormat;   //导出格式
 
 
-    MqttClient *m_mqttClient;
+    MqttService *m_mqttClient;  // MQTT收发、解析运行在独立线程
     MqttMessageParser *m_mqttParser;
 };
 
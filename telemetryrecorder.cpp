@@ -0,0 +1,603 @@
+#include "telemetryrecorder.h"
+#include <QDebug>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <limits>
+
+// 写线程连接名
+static const char *WRITER_CONNECTION = "telemetry_writer";
+
+// 写线程刷新周期(ms)
+static const int FLUSH_INTERVAL_MS = 1000;
+
+// 队列上限，写线程长时间阻塞(如磁盘满)时丢弃新事件，不占用生产者
+static const int MAX_PENDING_EVENTS = 10000;
+
+// 清理周期(ms)
+static const qint64 RETENTION_INTERVAL_MS = 60 * 1000;
+
+// 默认保留时长(秒)：原始2小时、1秒汇总7天、1分钟汇总和事件1年
+static const qint64 DEFAULT_RETENTION_SEC[3] = { 2 * 3600, 7 * 86400, 365 * 86400 };
+
+static const char *POWER_TABLES[3] = { "telemetry_power_raw", "telemetry_power_1s", "telemetry_power_1m" };
+
+// 初始化静态成员变量
+TelemetryRecorder* TelemetryRecorder::m_instance = nullptr;
+QMutex TelemetryRecorder::m_instanceMutex;
+
+TelemetryRecorder::TelemetryRecorder(QObject *parent)
+    : QThread(parent)
+    , m_dropped(0)
+    , m_stopFlag(0)
+    , m_epochOffsetMs(0)
+    , m_minuteMs(0)
+    , m_lastRetentionMs(0)
+{
+    for (int i = 0; i < 3; i++) {
+        m_retentionSec[i] = DEFAULT_RETENTION_SEC[i];
+    }
+    for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+        m_lastPulledNs[i] = 0;
+        m_secondMs[i] = 0;
+    }
+
+    // PTT边沿在采样线程中直接入队
+    connect(TelemetryService::instance(), &TelemetryService::pttEdge,
+            this, &TelemetryRecorder::onPttEdge, Qt::DirectConnection);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    stop();
+    wait();
+}
+
+TelemetryRecorder* TelemetryRecorder::instance()
+{
+    // 双重检查锁定模式，确保线程安全的单例实例创建
+    if (!m_instance) {
+        QMutexLocker locker(&m_instanceMutex);
+        if (!m_instance) {
+            m_instance = new TelemetryRecorder();
+        }
+    }
+    return m_instance;
+}
+
+void TelemetryRecorder::setDatabaseName(const QString &dbName)
+{
+    QMutexLocker locker(&m_mutex);
+    m_dbName = dbName;
+}
+
+void TelemetryRecorder::setRetention(Tier tier, qint64 seconds)
+{
+    QMutexLocker locker(&m_mutex);
+    m_retentionSec[tier] = qMax<qint64>(60, seconds);
+}
+
+void TelemetryRecorder::stop()
+{
+    m_stopFlag.storeRelaxed(1);
+    m_semaphore.release();
+}
+
+int TelemetryRecorder::droppedEvents() const
+{
+    return m_dropped.loadRelaxed();
+}
+
+void TelemetryRecorder::enqueue(const TelemetryEvent &event)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_pending.size() >= MAX_PENDING_EVENTS) {
+        m_dropped.fetchAndAddRelaxed(1);
+        return;
+    }
+    m_pending.append(event);
+}
+
+void TelemetryRecorder::beginExam(const QString &examID)
+{
+    if (examID.isEmpty()) {
+        return;
+    }
+
+    // ExamID以字符串形式放在事件中，由写线程切换
+    TelemetryEvent event;
+    event.timeMs = TelemetryService::nowNs();
+    event.type = TelemetryEvent::ExamStart;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending.append(event);
+        m_pendingExamIDs.append(examID);
+    }
+    m_semaphore.release();
+}
+
+void TelemetryRecorder::endExam()
+{
+    TelemetryEvent event;
+    event.timeMs = TelemetryService::nowNs();
+    event.type = TelemetryEvent::ExamEnd;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending.append(event);
+    }
+    m_semaphore.release();
+}
+
+void TelemetryRecorder::recordAssignment(const QVector<qint8> &channels)
+{
+    qint64 t = TelemetryService::nowNs();
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < channels.size(); i++) {
+        int oldChannel = i < m_lastChannels.size() ? m_lastChannels[i] : 0;
+        if (channels[i] == oldChannel) {
+            continue;
+        }
+        if (m_pending.size() >= MAX_PENDING_EVENTS) {
+            m_dropped.fetchAndAddRelaxed(1);
+            continue;
+        }
+        TelemetryEvent event;
+        event.timeMs = t;
+        event.type = TelemetryEvent::ChannelAssign;
+        event.radio = i + 1;
+        event.oldValue = oldChannel;
+        event.newValue = channels[i];
+        m_pending.append(event);
+    }
+    m_lastChannels = channels;
+}
+
+void TelemetryRecorder::onPttEdge(quint8 oldPtt, quint8 newPtt, qint64 timeNs)
+{
+    // 按电台拆分变化位
+    quint8 changed = oldPtt ^ newPtt;
+    for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+        if (!((changed >> i) & 0x1)) {
+            continue;
+        }
+        TelemetryEvent event;
+        event.timeMs = timeNs;
+        event.type = TelemetryEvent::PttEdge;
+        event.radio = i + 1;
+        event.oldValue = (oldPtt >> i) & 0x1;
+        event.newValue = (newPtt >> i) & 0x1;
+        enqueue(event);
+    }
+}
+
+qint64 TelemetryRecorder::toEpochMs(qint64 timeNs) const
+{
+    return timeNs / 1000000 + m_epochOffsetMs;
+}
+
+bool TelemetryRecorder::createTables()
+{
+    QSqlDatabase db = QSqlDatabase::database(WRITER_CONNECTION);
+    QSqlQuery query(db);
+    QStringList statements;
+    statements << "CREATE TABLE IF NOT EXISTS telemetry_events ("
+                  "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                  "examID TEXT NOT NULL, "
+                  "timeMs INTEGER NOT NULL, "
+                  "type INTEGER NOT NULL, "
+                  "radio INTEGER NOT NULL, "
+                  "oldValue INTEGER, "
+                  "newValue INTEGER)"
+               << "CREATE INDEX IF NOT EXISTS idx_telemetry_events_exam ON telemetry_events(examID, timeMs)"
+               << "CREATE TABLE IF NOT EXISTS telemetry_power_raw ("
+                  "examID TEXT NOT NULL, "
+                  "radio INTEGER NOT NULL, "
+                  "timeMs INTEGER NOT NULL, "
+                  "powerDb REAL, "
+                  "lowAdc INTEGER, "
+                  "tx INTEGER)";
+    for (int tier = Tier1s; tier <= Tier1m; tier++) {
+        statements << QString("CREATE TABLE IF NOT EXISTS %1 ("
+                              "examID TEXT NOT NULL, "
+                              "radio INTEGER NOT NULL, "
+                              "timeMs INTEGER NOT NULL, "
+                              "minDb REAL, maxDb REAL, meanDb REAL, "
+                              "txRatio REAL, "
+                              "minLowAdc INTEGER, maxLowAdc INTEGER, meanLowAdc REAL, "
+                              "count INTEGER)").arg(POWER_TABLES[tier]);
+    }
+    for (int tier = TierRaw; tier <= Tier1m; tier++) {
+        statements << QString("CREATE INDEX IF NOT EXISTS idx_%1_exam ON %1(examID, radio, timeMs)").arg(POWER_TABLES[tier]);
+        statements << QString("CREATE INDEX IF NOT EXISTS idx_%1_time ON %1(timeMs)").arg(POWER_TABLES[tier]);
+    }
+
+    for (const QString &sql : statements) {
+        if (!query.exec(sql)) {
+            qWarning() << "Error: Failed to create telemetry table:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+void TelemetryRecorder::closeSecond(int radio)
+{
+    QVector<TelemetrySample> &samples = m_secondSamples[radio - 1];
+    if (samples.isEmpty()) {
+        return;
+    }
+
+    // 该秒对应的单调时钟区间
+    qint64 startNs = (m_secondMs[radio - 1] - m_epochOffsetMs) * 1000000;
+    QVector<TelemetryBucket> buckets = TelemetryService::decimate(samples, startNs, startNs + 1000000000LL, 1);
+    samples.clear();
+    if (buckets.isEmpty() || buckets.first().count == 0) {
+        return;
+    }
+
+    const TelemetryBucket &bucket = buckets.first();
+    QSqlQuery query(QSqlDatabase::database(WRITER_CONNECTION));
+    query.prepare("INSERT INTO telemetry_power_1s (examID, radio, timeMs, minDb, maxDb, meanDb, txRatio, "
+                  "minLowAdc, maxLowAdc, meanLowAdc, count) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    query.addBindValue(m_examID);
+    query.addBindValue(radio);
+    query.addBindValue(m_secondMs[radio - 1]);
+    query.addBindValue(bucket.minPowerDb);
+    query.addBindValue(bucket.maxPowerDb);
+    query.addBindValue(bucket.meanPowerDb);
+    query.addBindValue(bucket.txRatio);
+    query.addBindValue(bucket.minLowAdc);
+    query.addBindValue(bucket.maxLowAdc);
+    query.addBindValue(bucket.meanLowAdc);
+    query.addBindValue(bucket.count);
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to insert telemetry rollup:" << query.lastError().text();
+    }
+}
+
+void TelemetryRecorder::rollupMinutes(qint64 untilMs)
+{
+    // 由已完成的1秒汇总合成1分钟汇总，均值按采样数加权
+    QSqlQuery query(QSqlDatabase::database(WRITER_CONNECTION));
+    query.prepare("INSERT INTO telemetry_power_1m (examID, radio, timeMs, minDb, maxDb, meanDb, txRatio, "
+                  "minLowAdc, maxLowAdc, meanLowAdc, count) "
+                  "SELECT examID, radio, (timeMs / 60000) * 60000, MIN(minDb), MAX(maxDb), "
+                  "SUM(meanDb * count) / SUM(count), SUM(txRatio * count) / SUM(count), "
+                  "MIN(minLowAdc), MAX(maxLowAdc), SUM(meanLowAdc * count) / SUM(count), SUM(count) "
+                  "FROM telemetry_power_1s WHERE examID = ? AND timeMs >= ? AND timeMs < ? "
+                  "GROUP BY examID, radio, timeMs / 60000");
+    query.addBindValue(m_examID);
+    query.addBindValue(m_minuteMs);
+    query.addBindValue(untilMs);
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to roll up telemetry:" << query.lastError().text();
+    }
+    m_minuteMs = untilMs;
+}
+
+void TelemetryRecorder::applyRetention()
+{
+    qint64 retention[3];
+    {
+        QMutexLocker locker(&m_mutex);
+        for (int i = 0; i < 3; i++) {
+            retention[i] = m_retentionSec[i];
+        }
+    }
+
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QSqlQuery query(QSqlDatabase::database(WRITER_CONNECTION));
+    for (int tier = TierRaw; tier <= Tier1m; tier++) {
+        query.prepare(QString("DELETE FROM %1 WHERE timeMs < ?").arg(POWER_TABLES[tier]));
+        query.addBindValue(nowMs - retention[tier] * 1000);
+        if (!query.exec()) {
+            qWarning() << "Error: Failed to apply telemetry retention:" << query.lastError().text();
+        }
+    }
+    query.prepare("DELETE FROM telemetry_events WHERE timeMs < ?");
+    query.addBindValue(nowMs - retention[Tier1m] * 1000);
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to apply telemetry retention:" << query.lastError().text();
+    }
+}
+
+bool TelemetryRecorder::openWriter(const QString &dbName)
+{
+    // 与场景库同一文件，写线程使用独立连接
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", WRITER_CONNECTION);
+    db.setDatabaseName(dbName);
+    db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=1000");
+    if (!db.open() || !createTables()) {
+        qWarning() << "Error: Failed to open telemetry database:" << db.lastError().text();
+        db.close();
+        return false;
+    }
+
+    // 单调时钟到UTC毫秒的换算
+    m_epochOffsetMs = QDateTime::currentMSecsSinceEpoch() - TelemetryService::nowNs() / 1000000;
+    qint64 now = TelemetryService::nowNs();
+    for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+        m_lastPulledNs[i] = now;
+    }
+    return true;
+}
+
+void TelemetryRecorder::closeWriter()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database(WRITER_CONNECTION, false);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(WRITER_CONNECTION);
+}
+
+void TelemetryRecorder::flush(bool final)
+{
+    QVector<TelemetryEvent> events;
+    QStringList examIDs;
+    {
+        QMutexLocker locker(&m_mutex);
+        events.swap(m_pending);
+        examIDs.swap(m_pendingExamIDs);
+    }
+
+    // 拉取自上次以来的新采样
+    QVector<TelemetrySample> samples[TelemetryService::RADIO_COUNT];
+    for (int radio = 1; radio <= TelemetryService::RADIO_COUNT; radio++) {
+        samples[radio - 1] = TelemetryService::instance()->samplesSince(radio, m_lastPulledNs[radio - 1] + 1);
+        if (!samples[radio - 1].isEmpty()) {
+            m_lastPulledNs[radio - 1] = samples[radio - 1].last().timeNs;
+        }
+    }
+
+    writeBatch(events, examIDs, samples, final);
+}
+
+void TelemetryRecorder::writeSamples(QSqlQuery &rawQuery, const QVector<TelemetrySample> *samples,
+                                     int *cursor, qint64 untilNs)
+{
+    for (int radio = 1; radio <= TelemetryService::RADIO_COUNT; radio++) {
+        const QVector<TelemetrySample> &radioSamples = samples[radio - 1];
+        int &index = cursor[radio - 1];
+        for (; index < radioSamples.size() && radioSamples[index].timeNs < untilNs; index++) {
+            // 功率采样归属当前考试，考试外的采样不入库
+            if (m_examID.isEmpty()) {
+                continue;
+            }
+
+            const TelemetrySample &sample = radioSamples[index];
+            qint64 timeMs = toEpochMs(sample.timeNs);
+            rawQuery.addBindValue(m_examID);
+            rawQuery.addBindValue(radio);
+            rawQuery.addBindValue(timeMs);
+            rawQuery.addBindValue(sample.powerDb);
+            rawQuery.addBindValue(sample.lowAdc);
+            rawQuery.addBindValue(sample.tx ? 1 : 0);
+            if (!rawQuery.exec()) {
+                qWarning() << "Error: Failed to insert telemetry sample:" << rawQuery.lastError().text();
+            }
+
+            // 跨秒时结束上一秒的汇总
+            qint64 secondMs = timeMs - timeMs % 1000;
+            if (secondMs != m_secondMs[radio - 1]) {
+                closeSecond(radio);
+                m_secondMs[radio - 1] = secondMs;
+            }
+            m_secondSamples[radio - 1].append(sample);
+        }
+    }
+}
+
+void TelemetryRecorder::writeBatch(const QVector<TelemetryEvent> &events, const QStringList &examIDs,
+                                   const QVector<TelemetrySample> *samples, bool final)
+{
+    QSqlDatabase db = QSqlDatabase::database(WRITER_CONNECTION);
+    db.transaction();
+
+    QSqlQuery rawQuery(db);
+    rawQuery.prepare("INSERT INTO telemetry_power_raw (examID, radio, timeMs, powerDb, lowAdc, tx) "
+                     "VALUES (?, ?, ?, ?, ?, ?)");
+    // 各电台已写到的采样下标，采样在考试开始/结束事件的时刻处切分
+    int cursor[TelemetryService::RADIO_COUNT] = { 0 };
+
+    QSqlQuery eventQuery(db);
+    eventQuery.prepare("INSERT INTO telemetry_events (examID, timeMs, type, radio, oldValue, newValue) "
+                       "VALUES (?, ?, ?, ?, ?, ?)");
+    int examIndex = 0;
+    for (const TelemetryEvent &event : events) {
+        if (event.type == TelemetryEvent::ExamStart || event.type == TelemetryEvent::ExamEnd) {
+            // 切换前的采样归属切换前的考试
+            writeSamples(rawQuery, samples, cursor, event.timeMs);
+
+            // 考试切换前结束未完成的汇总
+            if (!m_examID.isEmpty()) {
+                for (int radio = 1; radio <= TelemetryService::RADIO_COUNT; radio++) {
+                    closeSecond(radio);
+                }
+                rollupMinutes(QDateTime::currentMSecsSinceEpoch() / 60000 * 60000 + 60000);
+            }
+
+            if (event.type == TelemetryEvent::ExamEnd) {
+                // 结束事件记在结束的考试下
+                if (m_examID.isEmpty()) {
+                    continue;
+                }
+            } else {
+                m_examID = examIDs.value(examIndex++);
+                m_minuteMs = toEpochMs(event.timeMs) / 60000 * 60000;
+                qDebug() << "遥测记录开始 ExamID:" << m_examID;
+            }
+        }
+
+        if (m_examID.isEmpty()) {
+            continue;
+        }
+        eventQuery.addBindValue(m_examID);
+        eventQuery.addBindValue(toEpochMs(event.timeMs));
+        eventQuery.addBindValue(event.type);
+        eventQuery.addBindValue(event.radio);
+        eventQuery.addBindValue(event.oldValue);
+        eventQuery.addBindValue(event.newValue);
+        if (!eventQuery.exec()) {
+            qWarning() << "Error: Failed to insert telemetry event:" << eventQuery.lastError().text();
+        }
+
+        if (event.type == TelemetryEvent::ExamEnd) {
+            qDebug() << "遥测记录结束 ExamID:" << m_examID;
+            m_examID.clear();
+        }
+    }
+
+    // 最后一次切换之后的采样归属当前考试
+    writeSamples(rawQuery, samples, cursor, std::numeric_limits<qint64>::max());
+
+    if (!m_examID.isEmpty()) {
+        if (final) {
+            for (int radio = 1; radio <= TelemetryService::RADIO_COUNT; radio++) {
+                closeSecond(radio);
+            }
+            rollupMinutes(QDateTime::currentMSecsSinceEpoch() / 60000 * 60000 + 60000);
+        } else {
+            // 已完整结束且各电台1秒汇总都已写入的分钟
+            qint64 currentMinuteMs = QDateTime::currentMSecsSinceEpoch() / 60000 * 60000;
+            for (int i = 0; i < TelemetryService::RADIO_COUNT; i++) {
+                if (!m_secondSamples[i].isEmpty()) {
+                    currentMinuteMs = qMin(currentMinuteMs, m_secondMs[i] / 60000 * 60000);
+                }
+            }
+            if (currentMinuteMs > m_minuteMs) {
+                rollupMinutes(currentMinuteMs);
+            }
+        }
+    }
+
+    if (!db.commit()) {
+        qWarning() << "Error: Failed to commit telemetry:" << db.lastError().text();
+        db.rollback();
+    }
+}
+
+void TelemetryRecorder::run()
+{
+    QString dbName;
+    {
+        QMutexLocker locker(&m_mutex);
+        dbName = m_dbName;
+    }
+
+    if (openWriter(dbName)) {
+        m_stopFlag.storeRelaxed(0);
+        qDebug() << "遥测记录线程启动:" << dbName;
+        while (!m_stopFlag.loadRelaxed()) {
+            m_semaphore.tryAcquire(1, FLUSH_INTERVAL_MS);
+            bool final = m_stopFlag.loadRelaxed();
+            flush(final);
+
+            qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+            if (nowMs - m_lastRetentionMs >= RETENTION_INTERVAL_MS) {
+                applyRetention();
+                m_lastRetentionMs = nowMs;
+            }
+        }
+        qDebug() << "遥测记录线程停止";
+    }
+    closeWriter();
+}
+
+// 每个查询线程一个只读连接，线程结束时移除
+static QSqlDatabase readerConnection(const QString &dbName)
+{
+    QString name = QString("telemetry_reader_%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+    if (QSqlDatabase::contains(name)) {
+        return QSqlDatabase::database(name);
+    }
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(dbName);
+    db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=1000;QSQLITE_OPEN_READONLY");
+    if (!db.open()) {
+        qWarning() << "Error: Failed to open telemetry database:" << db.lastError().text();
+    }
+
+    // finished在结束的线程中发出，直接连接保证在该线程内、wait()返回前移除
+    QThread *thread = QThread::currentThread();
+    QObject::connect(thread, &QThread::finished, thread, [name]() {
+        QSqlDatabase::removeDatabase(name);
+    }, Qt::DirectConnection);
+    return db;
+}
+
+QList<TelemetryEvent> TelemetryRecorder::events(const QString &examID) const
+{
+    QString dbName;
+    {
+        QMutexLocker locker(&m_mutex);
+        dbName = m_dbName;
+    }
+
+    QList<TelemetryEvent> result;
+    QSqlQuery query(readerConnection(dbName));
+    query.prepare("SELECT timeMs, type, radio, oldValue, newValue FROM telemetry_events "
+                  "WHERE examID = ? ORDER BY timeMs, id");
+    query.addBindValue(examID);
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to query telemetry events:" << query.lastError().text();
+        return result;
+    }
+    while (query.next()) {
+        TelemetryEvent event;
+        event.timeMs = query.value(0).toLongLong();
+        event.type = query.value(1).toInt();
+        event.radio = query.value(2).toInt();
+        event.oldValue = query.value(3).toInt();
+        event.newValue = query.value(4).toInt();
+        result.append(event);
+    }
+    return result;
+}
+
+QVector<TelemetryBucket> TelemetryRecorder::powerHistory(const QString &examID, int radio, Tier tier) const
+{
+    QString dbName;
+    {
+        QMutexLocker locker(&m_mutex);
+        dbName = m_dbName;
+    }
+
+    // 原始采样每条作为一个桶返回
+    QVector<TelemetryBucket> result;
+    QSqlQuery query(readerConnection(dbName));
+    if (tier == TierRaw) {
+        query.prepare("SELECT timeMs, powerDb, powerDb, powerDb, tx, lowAdc, lowAdc, lowAdc, 1 "
+                      "FROM telemetry_power_raw WHERE examID = ? AND radio = ? ORDER BY timeMs");
+    } else {
+        query.prepare(QString("SELECT timeMs, minDb, maxDb, meanDb, txRatio, minLowAdc, maxLowAdc, meanLowAdc, count "
+                              "FROM %1 WHERE examID = ? AND radio = ? ORDER BY timeMs").arg(POWER_TABLES[tier]));
+    }
+    query.addBindValue(examID);
+    query.addBindValue(radio);
+    if (!query.exec()) {
+        qWarning() << "Error: Failed to query telemetry power:" << query.lastError().text();
+        return result;
+    }
+
+    qint64 spanNs = tier == TierRaw ? 0 : (tier == Tier1s ? 1000000000LL : 60000000000LL);
+    while (query.next()) {
+        TelemetryBucket bucket;
+        bucket.startNs = query.value(0).toLongLong() * 1000000;
+        bucket.endNs = bucket.startNs + spanNs;
+        bucket.minPowerDb = query.value(1).toFloat();
+        bucket.maxPowerDb = query.value(2).toFloat();
+        bucket.meanPowerDb = query.value(3).toFloat();
+        bucket.txRatio = query.value(4).toFloat();
+        bucket.minLowAdc = query.value(5).toUInt();
+        bucket.maxLowAdc = query.value(6).toUInt();
+        bucket.meanLowAdc = query.value(7).toFloat();
+        bucket.count = query.value(8).toInt();
+        result.append(bucket);
+    }
+    return result;
+}
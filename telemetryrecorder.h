@@ -0,0 +1,135 @@
+#ifndef TELEMETRYRECORDER_H
+#define TELEMETRYRECORDER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <QVector>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "telemetryservice.h"
+
+class QSqlQuery;
+
+// 遥测历史事件
+struct TelemetryEvent
+{
+    enum Type {
+        ExamStart = 0,      // 考试开始
+        ExamEnd = 1,        // 考试结束
+        PttEdge = 2,        // 电台收发切换，radio为电台号，值为0收/1发
+        ChannelAssign = 3   // DAC信道分配变化，radio为DAC号，值为信道号
+    };
+
+    qint64 timeMs = 0;      // 入库后为UTC毫秒，入队时为单调时钟ns
+    int type = ExamStart;
+    int radio = 0;
+    int oldValue = 0;
+    int newValue = 0;
+};
+
+// 遥测历史记录：按ExamID将PTT边沿、功率采样和信道分配变化写入SQLite
+// 生产者只在内存队列中追加，后台写线程每秒以一个事务批量写入
+// 功率分三级存储：原始采样、1秒汇总、1分钟汇总，各级按保留时长清理
+class TelemetryRecorder : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum Tier {
+        TierRaw = 0,
+        Tier1s = 1,
+        Tier1m = 2
+    };
+
+    // 获取单例实例
+    static TelemetryRecorder* instance();
+
+    // 设置数据库文件，需在start()前调用；写线程使用独立连接
+    void setDatabaseName(const QString &dbName);
+
+    // 各级数据保留时长(秒)，事件与1分钟汇总同保留时长
+    void setRetention(Tier tier, qint64 seconds);
+
+    // 设置停止标志并唤醒写线程，退出前写完队列中的数据
+    void stop();
+
+    // 考试开始/结束，可在任意线程调用
+    void beginExam(const QString &examID);
+    void endExam();
+
+    // DAC信道分配变化，channels为各DAC当前信道
+    void recordAssignment(const QVector<qint8> &channels);
+
+    // 已丢弃的事件数(队列满)
+    int droppedEvents() const;
+
+    // 考后分析查询，在调用线程以独立连接读取；返回的时间为UTC(事件ms，功率桶ns)
+    QList<TelemetryEvent> events(const QString &examID) const;
+    QVector<TelemetryBucket> powerHistory(const QString &examID, int radio, Tier tier) const;
+
+protected:
+    void run() override;
+
+private slots:
+    // 采样线程直接调用，只入队
+    void onPttEdge(quint8 oldPtt, quint8 newPtt, qint64 timeNs);
+
+private:
+    // 测试在未启动的写线程对象上直接写入批次
+    friend class TestTelemetryRecorder;
+
+    explicit TelemetryRecorder(QObject *parent = nullptr);
+    ~TelemetryRecorder();
+
+    void enqueue(const TelemetryEvent &event);
+
+    // 在调用线程打开/关闭写连接，建表并校准单调时钟到UTC的换算
+    bool openWriter(const QString &dbName);
+    void closeWriter();
+
+    bool createTables();
+    // 取出队列和新采样，一个事务写入
+    void flush(bool final);
+    // 按时间顺序写入一批事件和各电台采样，采样在考试开始/结束事件处切分
+    void writeBatch(const QVector<TelemetryEvent> &events, const QStringList &examIDs,
+                    const QVector<TelemetrySample> *samples, bool final);
+    // 写入各电台cursor起、时刻早于untilNs的采样，考试外的只跳过
+    void writeSamples(QSqlQuery &rawQuery, const QVector<TelemetrySample> *samples,
+                      int *cursor, qint64 untilNs);
+    // 结束当前秒/分钟的汇总
+    void closeSecond(int radio);
+    void rollupMinutes(qint64 untilMs);
+    void applyRetention();
+
+    qint64 toEpochMs(qint64 timeNs) const;
+
+    // 单例实例
+    static TelemetryRecorder* m_instance;
+    static QMutex m_instanceMutex;
+
+    // 以下由m_mutex保护
+    mutable QMutex m_mutex;
+    QString m_dbName;
+    QVector<TelemetryEvent> m_pending;
+    QStringList m_pendingExamIDs;   // 与队列中ExamStart事件一一对应
+    QVector<qint8> m_lastChannels;
+    qint64 m_retentionSec[3];
+    QAtomicInt m_dropped;
+
+    QSemaphore m_semaphore;
+    QAtomicInt m_stopFlag;
+
+    // 以下只在写线程中访问
+    QString m_examID;
+    qint64 m_epochOffsetMs;
+    qint64 m_lastPulledNs[TelemetryService::RADIO_COUNT];
+    qint64 m_secondMs[TelemetryService::RADIO_COUNT];
+    QVector<TelemetrySample> m_secondSamples[TelemetryService::RADIO_COUNT];
+    qint64 m_minuteMs;
+    qint64 m_lastRetentionMs;
+};
+
+#endif // TELEMETRYRECORDER_H
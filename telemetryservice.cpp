@@ -0,0 +1,273 @@
+#include "telemetryservice.h"
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtMath>
+#include <time.h>
+#include "fpga_driver.h"
+#include "configmanager.h"
+
+// txPower刷新周期(ns)
+static const qint64 STATUS_POWER_PERIOD_NS = 100 * 1000 * 1000LL;
+
+// 初始化静态成员变量
+TelemetryService* TelemetryService::m_instance = nullptr;
+QMutex TelemetryService::m_instanceMutex;
+
+TelemetryRing::TelemetryRing()
+    : m_head(0)
+{
+}
+
+void TelemetryRing::push(const TelemetrySample &sample)
+{
+    quint64 head = m_head.load(std::memory_order_relaxed);
+    m_slots[head & (CAPACITY - 1)] = sample;
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+QVector<TelemetrySample> TelemetryRing::since(qint64 sinceNs) const
+{
+    quint64 head = m_head.load(std::memory_order_acquire);
+    quint64 oldest = head > CAPACITY ? head - CAPACITY : 0;
+
+    // 从最新往前找到窗口起点
+    quint64 first = head;
+    while (first > oldest && m_slots[(first - 1) & (CAPACITY - 1)].timeNs >= sinceNs) {
+        first--;
+    }
+
+    QVector<TelemetrySample> result;
+    result.reserve(static_cast<int>(head - first));
+    for (quint64 i = first; i < head; i++) {
+        result.append(m_slots[i & (CAPACITY - 1)]);
+    }
+
+    // 拷贝期间写者可能已绕回覆盖了最旧的槽位，丢弃这部分
+    quint64 headAfter = m_head.load(std::memory_order_acquire);
+    if (headAfter >= first + CAPACITY) {
+        int overwritten = static_cast<int>(qMin<quint64>(headAfter - CAPACITY - first + 1, result.size()));
+        result.remove(0, overwritten);
+    }
+    return result;
+}
+
+TelemetryService::TelemetryService(QObject *parent)
+    : QThread(parent)
+    , m_rateHz(DEFAULT_RATE_HZ)
+    , m_ptt(0)
+    , m_stopFlag(0)
+{
+    for (int i = 0; i < RADIO_COUNT; i++) {
+        m_rings[i] = new TelemetryRing();
+    }
+}
+
+TelemetryService::~TelemetryService()
+{
+    stop();
+    wait();
+    for (int i = 0; i < RADIO_COUNT; i++) {
+        delete m_rings[i];
+    }
+}
+
+TelemetryService* TelemetryService::instance()
+{
+    // 双重检查锁定模式，确保线程安全的单例实例创建
+    if (!m_instance) {
+        QMutexLocker locker(&m_instanceMutex);
+        if (!m_instance) {
+            m_instance = new TelemetryService();
+        }
+    }
+    return m_instance;
+}
+
+void TelemetryService::setSampleRate(int hz)
+{
+    m_rateHz.store(qBound(1, hz, MAX_RATE_HZ));
+}
+
+int TelemetryService::sampleRate() const
+{
+    return m_rateHz.load();
+}
+
+void TelemetryService::stop()
+{
+    m_stopFlag.storeRelaxed(1);
+}
+
+quint8 TelemetryService::currentPtt() const
+{
+    return m_ptt.load(std::memory_order_relaxed);
+}
+
+qint64 TelemetryService::nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+QVector<TelemetrySample> TelemetryService::samples(int radio, double seconds) const
+{
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return QVector<TelemetrySample>();
+    }
+    qint64 sinceNs = nowNs() - static_cast<qint64>(seconds * 1e9);
+    return m_rings[radio - 1]->since(sinceNs);
+}
+
+QVector<TelemetrySample> TelemetryService::samplesSince(int radio, qint64 sinceNs) const
+{
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return QVector<TelemetrySample>();
+    }
+    return m_rings[radio - 1]->since(sinceNs);
+}
+
+QVector<TelemetryBucket> TelemetryService::decimated(int radio, double seconds, int buckets) const
+{
+    qint64 endNs = nowNs();
+    qint64 startNs = endNs - static_cast<qint64>(seconds * 1e9);
+    if (radio < 1 || radio > RADIO_COUNT) {
+        return QVector<TelemetryBucket>();
+    }
+    return decimate(m_rings[radio - 1]->since(startNs), startNs, endNs, buckets);
+}
+
+QVector<TelemetryBucket> TelemetryService::decimate(const QVector<TelemetrySample> &samples,
+                                                    qint64 startNs, qint64 endNs, int buckets)
+{
+    QVector<TelemetryBucket> result;
+    if (buckets <= 0 || endNs <= startNs) {
+        return result;
+    }
+
+    result.resize(buckets);
+    qint64 span = endNs - startNs;
+    for (int i = 0; i < buckets; i++) {
+        result[i].startNs = startNs + span * i / buckets;
+        result[i].endNs = startNs + span * (i + 1) / buckets;
+    }
+
+    // 先累加，最后求均值
+    QVector<double> powerSum(buckets, 0.0);
+    QVector<double> adcSum(buckets, 0.0);
+    QVector<int> txCount(buckets, 0);
+    for (const TelemetrySample &sample : samples) {
+        if (sample.timeNs < startNs || sample.timeNs >= endNs) {
+            continue;
+        }
+        int idx = static_cast<int>((sample.timeNs - startNs) * buckets / span);
+        TelemetryBucket &bucket = result[idx];
+        if (bucket.count == 0) {
+            bucket.minPowerDb = bucket.maxPowerDb = sample.powerDb;
+            bucket.minLowAdc = bucket.maxLowAdc = sample.lowAdc;
+        } else {
+            bucket.minPowerDb = qMin(bucket.minPowerDb, sample.powerDb);
+            bucket.maxPowerDb = qMax(bucket.maxPowerDb, sample.powerDb);
+            bucket.minLowAdc = qMin(bucket.minLowAdc, sample.lowAdc);
+            bucket.maxLowAdc = qMax(bucket.maxLowAdc, sample.lowAdc);
+        }
+        bucket.count++;
+        powerSum[idx] += sample.powerDb;
+        adcSum[idx] += sample.lowAdc;
+        if (sample.tx) {
+            txCount[idx]++;
+        }
+    }
+
+    for (int i = 0; i < buckets; i++) {
+        if (result[i].count > 0) {
+            result[i].meanPowerDb = static_cast<float>(powerSum[i] / result[i].count);
+            result[i].meanLowAdc = static_cast<float>(adcSum[i] / result[i].count);
+            result[i].txRatio = static_cast<float>(txCount[i]) / result[i].count;
+        }
+    }
+    return result;
+}
+
+void TelemetryService::updateStatusPower()
+{
+    // 取最近一个刷新周期内发射状态采样的平均功率
+    qint64 sinceNs = nowNs() - STATUS_POWER_PERIOD_NS;
+    for (int radio = 1; radio <= RADIO_COUNT; radio++) {
+        QVector<TelemetrySample> recent = m_rings[radio - 1]->since(sinceNs);
+        double sum = 0;
+        int count = 0;
+        for (const TelemetrySample &sample : recent) {
+            if (sample.tx) {
+                sum += sample.powerDb;
+                count++;
+            }
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        RadioStatusBoard::instance()->setTxPower(radio, qRound(sum / count));
+    }
+}
+
+void TelemetryService::run()
+{
+    m_stopFlag.storeRelaxed(0);
+    qDebug() << "遥测采样线程启动，采样频率:" << m_rateHz.load() << "Hz";
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    qint64 lastStatusNs = 0;
+    quint8 lastPtt = 0;
+    bool first = true;
+
+    while (!m_stopFlag.loadRelaxed()) {
+        struct radios radioData;
+        struct low_adc lowAdc;
+        if (get_ptt_sta_power(&radioData) == FPGA_OK && get_low_adc(&lowAdc) == FPGA_OK) {
+            qint64 t = nowNs();
+            quint8 ptt = radioData.radio_sta & 0xF;
+            for (int i = 0; i < RADIO_COUNT; i++) {
+                TelemetrySample sample;
+                sample.timeNs = t;
+                sample.powerDb = static_cast<float>(radioData.radio_power[i]);
+                sample.lowAdc = lowAdc.low_adc_buf[i];
+                sample.tx = (ptt >> i) & 0x1;
+                m_rings[i]->push(sample);
+            }
+
+            m_ptt.store(ptt, std::memory_order_relaxed);
+            if (!first && ptt != lastPtt) {
+                emit pttEdge(lastPtt, ptt, t);
+            }
+            lastPtt = ptt;
+            first = false;
+
+            if (t - lastStatusNs >= STATUS_POWER_PERIOD_NS) {
+                updateStatusPower();
+                lastStatusNs = t;
+            }
+        }
+
+        // 按绝对时间休眠，采样间隔不随单次采样耗时漂移
+        long periodNs = 1000000000L / m_rateHz.load();
+        next.tv_nsec += periodNs;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+
+        // 采样被阻塞超过一个周期时从当前时刻重新计时，不连续补采错过的周期
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        qint64 lateNs = (now.tv_sec - next.tv_sec) * 1000000000LL + (now.tv_nsec - next.tv_nsec);
+        if (lateNs >= periodNs) {
+            next = now;
+        }
+    }
+
+    qDebug() << "遥测采样线程停止";
+}
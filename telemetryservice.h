@@ -0,0 +1,116 @@
+#ifndef TELEMETRYSERVICE_H
+#define TELEMETRYSERVICE_H
+
+#include <QThread>
+#include <QVector>
+#include <QAtomicInt>
+#include <QMutex>
+#include <atomic>
+
+// 单个采样点
+struct TelemetrySample
+{
+    qint64 timeNs = 0;      // 采样时刻(单调时钟ns)
+    float powerDb = 0;      // 功率(dBFS)
+    quint32 lowAdc = 0;     // 低速ADC
+    bool tx = false;        // PTT：是否发射
+};
+
+// 抽取后的统计桶
+struct TelemetryBucket
+{
+    qint64 startNs = 0;
+    qint64 endNs = 0;
+    int count = 0;              // 桶内采样数，0表示该时段无数据
+    float minPowerDb = 0;
+    float maxPowerDb = 0;
+    float meanPowerDb = 0;
+    float txRatio = 0;          // 发射占比[0,1]，短时PTT突发也会体现为非0
+    quint32 minLowAdc = 0;
+    quint32 maxLowAdc = 0;
+    float meanLowAdc = 0;
+};
+
+// 单写多读环形缓冲：采样线程写，界面/MQTT线程读
+// 写者先写槽位再发布head；读者拷贝后按最新head丢弃可能已被覆盖的部分
+class TelemetryRing
+{
+public:
+    static const quint32 CAPACITY = 1u << 15;  // 1kHz下约32秒
+
+    TelemetryRing();
+
+    void push(const TelemetrySample &sample);
+
+    // 取时刻不早于sinceNs的采样，按时间升序
+    QVector<TelemetrySample> since(qint64 sinceNs) const;
+
+private:
+    TelemetrySample m_slots[CAPACITY];
+    std::atomic<quint64> m_head;
+};
+
+// 遥测服务：按设定频率(最高1kHz)采集4个电台的PTT、功率和低速ADC
+// 采样写入各电台的环形缓冲，提供按时间窗口查询和min/max/mean抽取
+class TelemetryService : public QThread
+{
+    Q_OBJECT
+
+public:
+    static const int RADIO_COUNT = 4;
+    static const int MAX_RATE_HZ = 1000;
+    static const int DEFAULT_RATE_HZ = 200;
+
+    // 获取单例实例
+    static TelemetryService* instance();
+
+    // 采样频率，范围[1, MAX_RATE_HZ]，运行中修改下一周期生效
+    void setSampleRate(int hz);
+    int sampleRate() const;
+
+    // 设置停止标志
+    void stop();
+
+    // 最近seconds秒的原始采样，radio为电台号1-4
+    QVector<TelemetrySample> samples(int radio, double seconds) const;
+
+    // 时刻不早于sinceNs的原始采样
+    QVector<TelemetrySample> samplesSince(int radio, qint64 sinceNs) const;
+
+    // 最近seconds秒按时间等分为buckets个桶的抽取结果
+    QVector<TelemetryBucket> decimated(int radio, double seconds, int buckets) const;
+
+    // 将采样按[startNs, endNs)等分抽取
+    static QVector<TelemetryBucket> decimate(const QVector<TelemetrySample> &samples,
+                                             qint64 startNs, qint64 endNs, int buckets);
+
+    // 最近一次采样的PTT值
+    quint8 currentPtt() const;
+
+    static qint64 nowNs();
+
+signals:
+    // PTT变化，在采样线程发出
+    void pttEdge(quint8 oldPtt, quint8 newPtt, qint64 timeNs);
+
+protected:
+    void run() override;
+
+private:
+    explicit TelemetryService(QObject *parent = nullptr);
+    ~TelemetryService();
+
+    // 按发射期间的平均功率更新RadioStatusBoard中的发射功率
+    void updateStatusPower();
+
+    // 单例实例
+    static TelemetryService* m_instance;
+    static QMutex m_instanceMutex;
+
+    TelemetryRing *m_rings[RADIO_COUNT];
+    std::atomic<int> m_rateHz;
+    std::atomic<quint8> m_ptt;
+    QAtomicInt m_stopFlag;
+};
+
+#endif // TELEMETRYSERVICE_H
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_asynclogger
+
+SOURCES += \
+    tst_asynclogger.cpp
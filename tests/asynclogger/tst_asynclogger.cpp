@@ -0,0 +1,94 @@
+#include <QtTest>
+#include "asynclogger.h"
+
+// AsyncLogger格式化及环形缓冲测试
+class TestAsyncLogger : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void printfConversions();
+    void defaultPlaceholders();
+    void missingArguments();
+    void textTruncation();
+    void ringBufferDropsWhenFull();
+
+private:
+    template <typename... Args>
+    static QByteArray format(const char *fmt, const Args &... args);
+};
+
+template <typename... Args>
+QByteArray TestAsyncLogger::format(const char *fmt, const Args &... args)
+{
+    LogRecord record;
+    record.format = fmt;
+    record.argCount = 0;
+    record.textUsed = 0;
+    (AsyncLogDetail::captureArg(record, args), ...);
+    return AsyncLogger::formatMessage(record);
+}
+
+void TestAsyncLogger::printfConversions()
+{
+    QCOMPARE(format("addr:0x%X, value:%d", 0x1F4u, -3), QByteArray("addr:0x1F4, value:-3"));
+    // 长度修饰符按参数实际类型处理
+    QCOMPARE(format("%lf|%u", 1.5, quint64(1) << 40), QByteArray("1.500000|1099511627776"));
+    // 整数按printf的提升规则解释
+    QCOMPARE(format("%X %X %X", qint8(-1), -1, qint64(-1)), QByteArray("FFFFFFFF FFFFFFFF FFFFFFFFFFFFFFFF"));
+    QCOMPARE(format("%d %d %u", quint8(200), 0xFFFFFFF0u, -1), QByteArray("200 -16 4294967295"));
+    QCOMPARE(format("%05.1f%%", 3.14159), QByteArray("003.1%"));
+    QCOMPARE(format("%s=%s", "ch", QString("信道")), QByteArray("ch=信道"));
+}
+
+void TestAsyncLogger::defaultPlaceholders()
+{
+    QCOMPARE(format("{} {} {} {}", true, 7, 2.5, QByteArray("abc")), QByteArray("true 7 2.5 abc"));
+    enum Color { Red = 2 };
+    QCOMPARE(format("color={}", Red), QByteArray("color=2"));
+    // 十六进制占位符与%x/%X的提升规则一致，其他"{:...}"原样输出
+    QCOMPARE(format("ptt=0x{:X}({}) {:x}", quint8(0xA), quint8(0xA), 255), QByteArray("ptt=0xA(10) ff"));
+    QCOMPARE(format("{:X} {:d}", qint8(-1), 1), QByteArray("FFFFFFFF {:d}"));
+}
+
+void TestAsyncLogger::missingArguments()
+{
+    QCOMPARE(format("a={} b=%d", 1), QByteArray("a=1 b=%d"));
+    QCOMPARE(format("a={:x} b={:X}", 15), QByteArray("a=f b={:X}"));
+    QCOMPARE(format("%y %d", 5), QByteArray("%y 5"));
+}
+
+void TestAsyncLogger::textTruncation()
+{
+    QByteArray longText(LogRecord::TEXT_SIZE + 20, 'x');
+    QByteArray out = format("%s|%s", longText.constData(), "tail");
+    QCOMPARE(out, QByteArray(LogRecord::TEXT_SIZE, 'x') + "|");
+
+    // 截断不拆开多字节字符：前面占1字节后剩余空间不是3的倍数
+    QString chinese(LogRecord::TEXT_SIZE, QChar(0x4FE1));
+    QByteArray utf8 = format("{}{}", "a", chinese);
+    QCOMPARE(utf8, "a" + QString((LogRecord::TEXT_SIZE - 1) / 3, QChar(0x4FE1)).toUtf8());
+}
+
+void TestAsyncLogger::ringBufferDropsWhenFull()
+{
+    QScopedPointer<LogRingBuffer> buffer(new LogRingBuffer(0));
+    for (uint32_t i = 0; i < LogRingBuffer::CAPACITY; i++) {
+        LogRecord *record = buffer->beginWrite();
+        QVERIFY(record);
+        record->line = int(i);
+        QCOMPARE(buffer->commitWrite(), i + 1);
+    }
+    QVERIFY(!buffer->beginWrite());
+    QCOMPARE(buffer->dropped(), quint64(1));
+
+    LogRecord record;
+    QVERIFY(buffer->read(&record));
+    QCOMPARE(record.line, 0);
+    QVERIFY(buffer->beginWrite());
+    QVERIFY(!buffer->isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestAsyncLogger)
+
+#include "tst_asynclogger.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_channelcache
+
+SOURCES += \
+    tst_channelcache.cpp
@@ -0,0 +1,162 @@
+#include <QtTest>
+#include "channelcachemanager.h"
+
+// ChannelCacheManager功能测试
+class TestChannelCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initialCache();
+    void updateKeepsSwitchFlag();
+    void negativeKeyUsesAbs();
+    void invalidKeyIgnored();
+    void setChannelNotChanged();
+    void batchUpdateSingleSignal();
+    void batchFromOtherThreadDeferred();
+};
+
+void TestChannelCache::initialCache()
+{
+    QMap<int, ChannelSetting> all = ChannelCacheManager::instance()->getAllChannelSettings();
+    QCOMPARE(all.size(), 15);
+    QVERIFY(all.contains(1));
+    QVERIFY(all.contains(15));
+}
+
+void TestChannelCache::updateKeepsSwitchFlag()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    cache->updateChannelSwitch(2, true);
+
+    ChannelSetting setting;
+    setting.channelNum = 2;
+    setting.signalAnt = 12.5;
+    setting.filterNum = 3;
+    setting.switchFlag = false;
+
+    int emitted = 0;
+    QMetaObject::Connection conn = connect(cache, &ChannelCacheManager::parameterChanged,
+                                           [&emitted](int, const ChannelSetting &) { ++emitted; });
+    cache->updateChannelParameters(2, setting);
+    disconnect(conn);
+    QCOMPARE(emitted, 1);
+
+    ChannelSetting stored = cache->getChannelSetting(2);
+    QCOMPARE(stored.signalAnt, 12.5);
+    QCOMPARE(stored.filterNum, 3);
+    QVERIFY(stored.switchFlag);
+    QVERIFY(stored.isChange);
+}
+
+void TestChannelCache::negativeKeyUsesAbs()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ChannelSetting setting;
+    setting.channelNum = 4;
+    setting.signalAnt = 7.0;
+    setting.filterNum = 1;
+    cache->updateChannelParameters(-4, setting);
+
+    QCOMPARE(cache->getChannelSetting(4).signalAnt, 7.0);
+    QCOMPARE(cache->getChannelSetting(-4).signalAnt, 7.0);
+}
+
+void TestChannelCache::invalidKeyIgnored()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    int emitted = 0;
+    QMetaObject::Connection conn = connect(cache, &ChannelCacheManager::parameterChanged,
+                                           [&emitted](int, const ChannelSetting &) { ++emitted; });
+
+    ChannelSetting setting;
+    setting.signalAnt = 1.0;
+    setting.filterNum = 1;
+    cache->updateChannelParameters(0, setting);
+    cache->updateChannelParameters(16, setting);
+    disconnect(conn);
+
+    QCOMPARE(emitted, 0);
+    QCOMPARE(cache->getAllChannelSettings().size(), 15);
+}
+
+void TestChannelCache::setChannelNotChanged()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ChannelSetting setting;
+    setting.channelNum = 5;
+    setting.signalAnt = 3.0;
+    setting.filterNum = 1;
+    cache->updateChannelParameters(5, setting);
+    QVERIFY(cache->getChannelSetting(5).isChange);
+
+    cache->setChannelNotChanged(5);
+    QVERIFY(!cache->getChannelSetting(5).isChange);
+}
+
+void TestChannelCache::batchUpdateSingleSignal()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    cache->updateChannelSwitch(6, true);
+
+    QList<ChannelSetting> batch;
+    for (int chl : {6, -3, 12, 20}) {
+        ChannelSetting setting;
+        setting.channelNum = chl;
+        setting.signalAnt = 20.0;
+        setting.filterNum = 2;
+        batch.append(setting);
+    }
+
+    int single = 0;
+    QList<int> batchKeys;
+    QMetaObject::Connection conn1 = connect(cache, &ChannelCacheManager::parameterChanged,
+                                            [&single](int, const ChannelSetting &) { ++single; });
+    QMetaObject::Connection conn2 = connect(cache, &ChannelCacheManager::parametersBatchChanged,
+                                            [&batchKeys](const QList<int> &keys) { batchKeys += keys; });
+    cache->updateChannelParametersBatch(batch);
+    disconnect(conn1);
+    disconnect(conn2);
+
+    // 无效信道20被忽略，其余信道一次通知
+    QCOMPARE(single, 0);
+    QCOMPARE(batchKeys, QList<int>({6, 3, 12}));
+    QCOMPARE(cache->getChannelSetting(3).signalAnt, 20.0);
+    QVERIFY(cache->getChannelSetting(6).switchFlag);
+    QVERIFY(cache->getChannelSetting(12).isChange);
+}
+
+void TestChannelCache::batchFromOtherThreadDeferred()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    QList<ChannelSetting> batch;
+    for (int chl : {9, 4}) {
+        ChannelSetting setting;
+        setting.channelNum = chl;
+        setting.signalAnt = 7.0;
+        setting.filterNum = 1;
+        batch.append(setting);
+    }
+
+    QList<int> batchKeys;
+    QMetaObject::Connection conn = connect(cache, &ChannelCacheManager::parametersBatchChanged,
+                                           [&batchKeys](const QList<int> &keys) { batchKeys += keys; });
+    // 模拟PTT线程调用：缓存立即更新，信号经eventfd唤醒后在本线程发出
+    QThread *writer = QThread::create([cache, batch]() {
+        cache->updateChannelParametersBatch(batch);
+        cache->updateChannelParametersBatch(batch);
+    });
+    writer->start();
+    QVERIFY(writer->wait(5000));
+    delete writer;
+
+    QCOMPARE(cache->getChannelSetting(9).signalAnt, 7.0);
+    QVERIFY(batchKeys.isEmpty());
+    // 两批合并为一次通知，按信道号排序
+    QTRY_COMPARE(batchKeys, QList<int>({4, 9}));
+    disconnect(conn);
+}
+
+QTEST_GUILESS_MAIN(TestChannelCache)
+
+#include "tst_channelcache.moc"
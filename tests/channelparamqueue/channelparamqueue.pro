@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_channelparamqueue
+
+SOURCES += \
+    tst_channelparamqueue.cpp
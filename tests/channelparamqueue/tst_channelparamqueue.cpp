@@ -0,0 +1,209 @@
+#include <QtTest>
+#include <QThread>
+#include <atomic>
+#include "channelparamqueue.h"
+
+// ChannelParamQueue单生产者单消费者环形队列测试
+class TestChannelParamQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void fifoOrder();
+    void fullQueueRejects();
+    void wrapAround();
+    void popReturnsSettings();
+    void notifierCalledPerPush();
+    void notifierReplaced();
+    void concurrentProducerConsumer();
+    void latencyStats();
+
+private:
+    static ChannelParamBatch makeBatch(int sequence, int settingCount = 1);
+    static void drain();
+};
+
+ChannelParamBatch TestChannelParamQueue::makeBatch(int sequence, int settingCount)
+{
+    ChannelParamBatch batch;
+    batch.examID = QString::number(sequence);
+    batch.receivedNs = sequence;
+    for (int i = 0; i < settingCount; i++) {
+        batch.settings.append(ChannelSetting());
+    }
+    return batch;
+}
+
+void TestChannelParamQueue::drain()
+{
+    ChannelParamBatch batch;
+    while (ChannelParamQueue::instance()->pop(&batch)) {
+    }
+}
+
+void TestChannelParamQueue::init()
+{
+    // 单例在各用例间共享，开始前清空
+    drain();
+}
+
+void TestChannelParamQueue::cleanup()
+{
+    ChannelParamQueue::instance()->setNotifier(nullptr);
+    drain();
+}
+
+void TestChannelParamQueue::fifoOrder()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    ChannelParamBatch batch;
+    QVERIFY(!queue->pop(&batch));
+
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(queue->push(makeBatch(i)));
+    }
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(queue->pop(&batch));
+        QCOMPARE(batch.receivedNs, qint64(i));
+        QCOMPARE(batch.examID, QString::number(i));
+    }
+    QVERIFY(!queue->pop(&batch));
+}
+
+void TestChannelParamQueue::fullQueueRejects()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    for (quint32 i = 0; i < ChannelParamQueue::CAPACITY; i++) {
+        QVERIFY(queue->push(makeBatch(static_cast<int>(i))));
+    }
+    // 满时拒绝且不覆盖最旧的批次
+    QVERIFY(!queue->push(makeBatch(-1)));
+
+    ChannelParamBatch batch;
+    QVERIFY(queue->pop(&batch));
+    QCOMPARE(batch.receivedNs, qint64(0));
+    QVERIFY(queue->push(makeBatch(1000)));
+}
+
+void TestChannelParamQueue::wrapAround()
+{
+    // 反复入队出队，使位置多次越过容量边界
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    ChannelParamBatch batch;
+    int next = 0;
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 50; i++) {
+            QVERIFY(queue->push(makeBatch(round * 50 + i)));
+        }
+        for (int i = 0; i < 50; i++) {
+            QVERIFY(queue->pop(&batch));
+            QCOMPARE(batch.receivedNs, qint64(next++));
+        }
+    }
+    QVERIFY(!queue->pop(&batch));
+}
+
+void TestChannelParamQueue::popReturnsSettings()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    QVERIFY(queue->push(makeBatch(1, 8)));
+    ChannelParamBatch batch;
+    QVERIFY(queue->pop(&batch));
+    QCOMPARE(batch.settings.size(), 8);
+    QCOMPARE(batch.examID, QString("1"));
+}
+
+void TestChannelParamQueue::notifierCalledPerPush()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    int calls = 0;
+    queue->setNotifier([&calls]() { calls++; });
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(queue->push(makeBatch(i)));
+    }
+    QCOMPARE(calls, 3);
+
+    // 队列满时不唤醒
+    drain();
+    for (quint32 i = 0; i < ChannelParamQueue::CAPACITY; i++) {
+        queue->push(makeBatch(0));
+    }
+    calls = 0;
+    QVERIFY(!queue->push(makeBatch(0)));
+    QCOMPARE(calls, 0);
+}
+
+void TestChannelParamQueue::notifierReplaced()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    int first = 0;
+    int second = 0;
+    queue->setNotifier([&first]() { first++; });
+    queue->push(makeBatch(0));
+    queue->setNotifier([&second]() { second++; });
+    queue->push(makeBatch(1));
+    queue->setNotifier(nullptr);
+    queue->push(makeBatch(2));
+    QCOMPARE(first, 1);
+    QCOMPARE(second, 1);
+}
+
+void TestChannelParamQueue::concurrentProducerConsumer()
+{
+    // 生产者线程连续入队，消费者按序取出，不丢不重
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    const int total = 200000;
+    std::atomic<int> wakeups(0);
+    queue->setNotifier([&wakeups]() { wakeups.fetch_add(1, std::memory_order_relaxed); });
+
+    QThread *producer = QThread::create([queue, total]() {
+        for (int i = 0; i < total; i++) {
+            while (!queue->push(makeBatch(i))) {
+                QThread::yieldCurrentThread();
+            }
+        }
+    });
+    producer->start();
+
+    int expected = 0;
+    bool ordered = true;
+    ChannelParamBatch batch;
+    while (expected < total) {
+        if (!queue->pop(&batch)) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+        if (batch.receivedNs != expected || batch.examID != QString::number(expected)) {
+            ordered = false;
+        }
+        expected++;
+    }
+    QVERIFY(producer->wait(10000));
+    delete producer;
+
+    QVERIFY(ordered);
+    QVERIFY(!queue->pop(&batch));
+    QCOMPARE(wakeups.load(), total);
+}
+
+void TestChannelParamQueue::latencyStats()
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    ApplyLatencyStats before = queue->latencyStats();
+
+    qint64 now = ChannelParamQueue::nowNs();
+    queue->recordApplyLatency(now - 2000000);
+    queue->recordApplyLatency(now - 1000000);
+
+    ApplyLatencyStats stats = queue->latencyStats();
+    QCOMPARE(stats.count, before.count + 2);
+    QVERIFY(stats.lastUs >= 1000);
+    QVERIFY(stats.maxUs >= 2000);
+    QVERIFY(stats.minUs <= stats.lastUs);
+}
+
+QTEST_GUILESS_MAIN(TestChannelParamQueue)
+
+#include "tst_channelparamqueue.moc"
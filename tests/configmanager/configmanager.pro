@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_configmanager
+
+SOURCES += \
+    tst_configmanager.cpp
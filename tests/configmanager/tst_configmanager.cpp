@@ -0,0 +1,207 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QThread>
+#include <atomic>
+#include "configmanager.h"
+#include "testutil.h"
+
+// ConfigManager多线程读写及RadioStatusBoard变化计数、通知合并测试
+class TestConfigManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void concurrentAddAndGet();
+    void updateAndRemove();
+    void sequenceMonotonic();
+    void changesCoalescedIntoOneNotify();
+    void notifiesAtMostOncePerFrame();
+
+private:
+    // 等待上一帧的通知和帧定时器都已结束
+    static void settle();
+};
+
+void TestConfigManager::settle()
+{
+    QTest::qWait(3 * RadioStatusBoard::FRAME_INTERVAL_MS);
+}
+
+void TestConfigManager::initTestCase()
+{
+    // 每次增删都有qDebug输出
+    QLoggingCategory::setFilterRules("default.debug=false");
+}
+
+void TestConfigManager::concurrentAddAndGet()
+{
+    ConfigManager manager;
+    const int threadCount = 4;
+    const int perThread = 200;
+    std::atomic<int> mismatches(0);
+
+    QVector<QThread *> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.append(QThread::create([&manager, &mismatches, t, perThread]() {
+            for (int i = 0; i < perThread; i++) {
+                QString key = QString("t%1-%2").arg(t).arg(i);
+                manager.addConfigToMap(key, TestUtil::makeConfig(key, i % 15 + 1));
+                // 读回自己写入的，同时读取其他线程可能正在写入的
+                if (manager.getConfigFromMap(key).channelNum != i % 15 + 1) {
+                    mismatches++;
+                }
+                manager.getAllConfigKeys();
+            }
+        }));
+    }
+    for (QThread *thread : threads) {
+        thread->start();
+    }
+    for (QThread *thread : threads) {
+        QVERIFY(thread->wait(10000));
+        delete thread;
+    }
+
+    QCOMPARE(mismatches.load(), 0);
+    QCOMPARE(manager.getAllConfigKeys().size(), threadCount * perThread);
+    QCOMPARE(manager.getConfigFromMap("t3-199").modelName, QString("t3-199"));
+
+    // 重复添加不覆盖
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Key already exists"));
+    manager.addConfigToMap("t0-0", TestUtil::makeConfig("t0-0", 9));
+    QCOMPARE(manager.getConfigFromMap("t0-0").channelNum, 1);
+}
+
+void TestConfigManager::updateAndRemove()
+{
+    ConfigManager manager;
+    QSignalSpy updated(&manager, &ConfigManager::configUpdated);
+    manager.addConfigToMap("a", TestUtil::makeConfig("a", 1));
+
+    QVERIFY(manager.updateConfigInMap("a", TestUtil::makeConfig("a", 2)));
+    QCOMPARE(updated.count(), 1);
+    QCOMPARE(updated.first().first().toString(), QString("a"));
+    QCOMPARE(manager.getConfigFromMap("a").channelNum, 2);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Config not found for update"));
+    QVERIFY(!manager.updateConfigInMap("b", TestUtil::makeConfig("b", 3)));
+    QCOMPARE(updated.count(), 1);
+
+    QVERIFY(manager.removeConfigFromMap("a"));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Config not found"));
+    QVERIFY(!manager.removeConfigFromMap("a"));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Config not found"));
+    QCOMPARE(manager.getConfigFromMap("a").modelName, QString());
+    QVERIFY(manager.getAllConfigKeys().isEmpty());
+}
+
+void TestConfigManager::sequenceMonotonic()
+{
+    RadioStatusBoard *board = RadioStatusBoard::instance();
+    const int toggles = 2000;
+
+    // 两个写线程各写一部电台，每次写入都改变功率
+    QThread *writer2 = QThread::create([board, toggles]() {
+        for (int i = 0; i < toggles; i++) {
+            board->setTxPower(2, 100 + (i & 1));
+        }
+    });
+    QThread *writer4 = QThread::create([board, toggles]() {
+        for (int i = 0; i < toggles; i++) {
+            board->setState(4, (i & 1) ? RADIO_TRANSMIT : RADIO_ALARM);
+        }
+    });
+    board->setTxPower(2, 101);
+    board->setState(4, RADIO_TRANSMIT);
+    quint32 start = board->sequence();
+
+    writer2->start();
+    writer4->start();
+    quint32 last = start;
+    bool monotonic = true;
+    while (!writer2->isFinished() || !writer4->isFinished()) {
+        quint32 current = board->sequence();
+        monotonic = monotonic && current >= last;
+        last = current;
+    }
+    QVERIFY(writer2->wait(10000));
+    QVERIFY(writer4->wait(10000));
+    delete writer2;
+    delete writer4;
+
+    QVERIFY(monotonic);
+    QCOMPARE(board->sequence(), start + 2 * toggles);
+
+    // 写入相同的值不算变化
+    board->setTxPower(2, board->status(2).txPower);
+    QCOMPARE(board->sequence(), start + 2 * toggles);
+    settle();
+}
+
+void TestConfigManager::changesCoalescedIntoOneNotify()
+{
+    RadioStatusBoard *board = RadioStatusBoard::instance();
+    settle();
+    QSignalSpy spy(board, &RadioStatusBoard::statusChanged);
+
+    // 其他线程连续改变电台1、3，主线程只收到一次合并后的通知
+    int power = board->status(1).txPower;
+    QThread *writer = QThread::create([board, power]() {
+        board->setState(1, board->status(1).radioState == RADIO_RECEIVE ? RADIO_TRANSMIT : RADIO_RECEIVE);
+        board->setTxPower(1, power + 1);
+        board->setState(3, board->status(3).radioState == RADIO_RECEIVE ? RADIO_TRANSMIT : RADIO_RECEIVE);
+        board->setTxPower(1, power + 2);
+    });
+    writer->start();
+    QVERIFY(writer->wait(10000));
+    delete writer;
+
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(spy.first().first().toUInt(), quint32((1u << 0) | (1u << 2)));
+    settle();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(board->status(1).txPower, power + 2);
+}
+
+void TestConfigManager::notifiesAtMostOncePerFrame()
+{
+    RadioStatusBoard *board = RadioStatusBoard::instance();
+    settle();
+
+    QElapsedTimer clock;
+    clock.start();
+    QVector<qint64> times;
+    QVector<quint32> masks;
+    QMetaObject::Connection conn = connect(board, &RadioStatusBoard::statusChanged, this,
+                                           [&times, &masks, &clock](quint32 mask) {
+        times.append(clock.elapsed());
+        masks.append(mask);
+    });
+
+    // 第一次通知后立即再次变化：第二次通知延后到帧边界，期间的变化合并
+    int power = board->status(2).txPower;
+    board->setTxPower(2, power + 1);
+    // 不用QTRY_COMPARE：它按50ms步长等待，第二次变化会晚于帧边界
+    while (times.isEmpty() && clock.elapsed() < 5000) {
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(times.size(), 1);
+    board->setTxPower(2, power + 2);
+    board->setTxPower(4, board->status(4).txPower + 1);
+    QTRY_COMPARE(times.size(), 2);
+    settle();
+    disconnect(conn);
+
+    QCOMPARE(times.size(), 2);
+    QCOMPARE(masks.at(0), quint32(1u << 1));
+    QCOMPARE(masks.at(1), quint32((1u << 1) | (1u << 3)));
+    // 定时器精度为毫秒，允许1ms误差
+    QVERIFY2(times.at(1) - times.at(0) >= RadioStatusBoard::FRAME_INTERVAL_MS - 1,
+             qPrintable(QString("interval %1 ms").arg(times.at(1) - times.at(0))));
+}
+
+QTEST_GUILESS_MAIN(TestConfigManager)
+
+#include "tst_configmanager.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_databasemanager
+
+SOURCES += \
+    tst_databasemanager.cpp
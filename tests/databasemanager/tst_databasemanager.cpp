@@ -0,0 +1,228 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "databasemanager.h"
+#include "testutil.h"
+
+// DatabaseManager结构升级测试：旧版(user_version=0)库升级到当前版本
+// 以及按原名称修改场景：改名冲突或原名称不存在时不改动任何数据
+class TestDatabaseManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void migratesVersion0();
+    void migrationRunsOnce();
+    void freshDatabase();
+    void renameOntoExistingFails();
+    void renameAndMissing();
+
+private:
+    // 按旧版结构建库：多径参数存在configs的JSON列，允许同名场景
+    QString createVersion0(const QString &name);
+    static int scalar(const QString &sql);
+
+    QTemporaryDir m_dir;
+};
+
+void TestDatabaseManager::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString TestDatabaseManager::createVersion0(const QString &name)
+{
+    QString path = m_dir.filePath(name);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "fixture");
+        db.setDatabaseName(path);
+        if (db.open()) {
+            QSqlQuery query(db);
+            query.exec("CREATE TABLE configs ("
+                       "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                       "channelNum INTEGER NOT NULL, "
+                       "modelName TEXT NOT NULL, "
+                       "noisePower TEXT NOT NULL, "
+                       "signalAnt TEXT NOT NULL, "
+                       "comDistance TEXT NOT NULL, "
+                       "multipathNum INTEGER NOT NULL, "
+                       "filterNum INTEGER NOT NULL, "
+                       "MultiPathType JSON)");
+            query.exec("INSERT INTO configs VALUES (1, 1, 'sky', '1', '2', '100', 1, 0, "
+                       "'[{\"pathNum\":1,\"relativDelay\":10,\"antPower\":-1,\"freShift\":5,\"freSpread\":1,\"dopplerType\":0}]')");
+            query.exec("INSERT INTO configs VALUES (2, 3, 'sea', '10.5', '20.25', '3000', 2, 2, "
+                       "'[{\"pathNum\":1,\"relativDelay\":100,\"antPower\":-1,\"freShift\":10,\"freSpread\":5,\"dopplerType\":1},"
+                       "{\"pathNum\":2,\"relativDelay\":200,\"antPower\":-2,\"freShift\":20,\"freSpread\":10,\"dopplerType\":2}]')");
+            // 同名场景后写入的一条生效
+            query.exec("INSERT INTO configs VALUES (3, 5, 'sky', '3', '4', '200', 1, 1, "
+                       "'[{\"pathNum\":1,\"relativDelay\":30,\"antPower\":-3,\"freShift\":-30,\"freSpread\":3,\"dopplerType\":0}]')");
+            query.exec("INSERT INTO configs VALUES (4, 2, 'empty', '0', '0', '0', 0, 0, NULL)");
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("fixture");
+    return path;
+}
+
+int TestDatabaseManager::scalar(const QString &sql)
+{
+    // DatabaseManager使用默认连接
+    QSqlQuery query(QSqlDatabase::database());
+    if (!query.exec(sql) || !query.next()) {
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+void TestDatabaseManager::migratesVersion0()
+{
+    DatabaseManager db;
+    QVERIFY(db.openDatabase(createVersion0("v0.db")));
+    QCOMPARE(scalar("PRAGMA user_version"), 0);
+    QVERIFY(db.createTable());
+    QCOMPARE(scalar("PRAGMA user_version"), 2);
+
+    QVector<ModelParaSetting> configs = db.getAllConfigs();
+    QCOMPARE(configs.size(), 3);
+    QCOMPARE(configs[0].modelName, QString("sea"));
+    QCOMPARE(configs[1].modelName, QString("sky"));
+    QCOMPARE(configs[2].modelName, QString("empty"));
+
+    const ModelParaSetting &sea = configs[0];
+    QCOMPARE(sea.channelNum, 3);
+    QCOMPARE(sea.noisePower, 10.5);
+    QCOMPARE(sea.signalAnt, 20.25);
+    QCOMPARE(sea.filterNum, 2);
+    QCOMPARE(sea.multipathType.size(), 2);
+    QCOMPARE(sea.multipathType[1].pathNum, 2);
+    QCOMPARE(sea.multipathType[1].relativDelay, 200);
+    QCOMPARE(sea.multipathType[1].antPower, -2);
+    QCOMPARE(sea.multipathType[1].freShift, 20);
+    QCOMPARE(sea.multipathType[1].freSpread, 10);
+    QCOMPARE(sea.multipathType[1].dopplerType, 2);
+
+    const ModelParaSetting &sky = configs[1];
+    QCOMPARE(sky.channelNum, 5);
+    QCOMPARE(sky.multipathType.size(), 1);
+    QCOMPARE(sky.multipathType[0].freShift, -30);
+
+    QVERIFY(configs[2].multipathType.isEmpty());
+
+    // JSON列已清空，路径只在paths表
+    QCOMPARE(scalar("SELECT COUNT(*) FROM configs WHERE multiPathType IS NOT NULL"), 0);
+    QCOMPARE(scalar("SELECT COUNT(*) FROM paths"), 3);
+    QCOMPARE(scalar("SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND name = 'idx_configs_modelName'"), 1);
+
+    // 摘要按paths表聚合最大频移
+    QVector<ScenarioSummary> summaries = db.getScenarioSummaries();
+    QCOMPARE(summaries.size(), 3);
+    QCOMPARE(summaries[1].maxDoppler, 30);
+    QCOMPARE(db.libraryRevision(), quint64(1));
+}
+
+void TestDatabaseManager::migrationRunsOnce()
+{
+    QString path = createVersion0("v0-reopen.db");
+    {
+        DatabaseManager db;
+        QVERIFY(db.openDatabase(path));
+        QVERIFY(db.createTable());
+    }
+
+    // 已是当前版本的库再次打开不重复迁移，数据和修订号不变
+    DatabaseManager db;
+    QVERIFY(db.openDatabase(path));
+    QVERIFY(db.createTable());
+    QCOMPARE(scalar("PRAGMA user_version"), 2);
+    QCOMPARE(db.getAllConfigs().size(), 3);
+    QCOMPARE(scalar("SELECT COUNT(*) FROM paths"), 3);
+    QCOMPARE(db.libraryRevision(), quint64(1));
+}
+
+void TestDatabaseManager::freshDatabase()
+{
+    DatabaseManager db;
+    QVERIFY(db.openDatabase(m_dir.filePath("fresh.db")));
+    QVERIFY(db.createTable());
+    QCOMPARE(scalar("PRAGMA user_version"), 2);
+    QVERIFY(db.getAllConfigs().isEmpty());
+
+    ModelParaSetting config;
+    config.channelNum = 4;
+    config.modelType = 1;
+    config.modelName = "new";
+    config.noisePower = 1;
+    config.signalAnt = 2;
+    config.comDistance = 3;
+    config.multipathNum = 1;
+    config.filterNum = 0;
+    MultiPathType path = {1, 10, -1, 7, 2, 1};
+    config.multipathType.append(path);
+    QVERIFY(db.insertParaConfig(config));
+
+    // 新写入的场景不再写JSON列
+    QCOMPARE(scalar("SELECT COUNT(*) FROM configs WHERE multiPathType IS NOT NULL"), 0);
+    ModelParaSetting loaded;
+    QVERIFY(db.getParaConfig("new", &loaded));
+    QCOMPARE(loaded.multipathType.size(), 1);
+    QCOMPARE(loaded.multipathType[0].freShift, 7);
+    QVERIFY(db.libraryRevision() > 1);
+}
+
+void TestDatabaseManager::renameOntoExistingFails()
+{
+    DatabaseManager db;
+    QVERIFY(db.openDatabase(m_dir.filePath("rename-collision.db")));
+    QVERIFY(db.createTable());
+    QVERIFY(db.insertParaConfigs({TestUtil::makeConfig("a", 2, 2), TestUtil::makeConfig("b", 1, 1)}));
+    quint64 revision = db.libraryRevision();
+
+    // 把a改名为已存在的b：违反唯一索引，两个场景及其路径都保持不变
+    ModelParaSetting renamed = TestUtil::makeConfig("b", 3, 3);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Failed to update config"));
+    QVERIFY(!db.updateParaConfig("a", renamed));
+
+    ModelParaSetting a;
+    QVERIFY(db.getParaConfig("a", &a));
+    QCOMPARE(a.channelNum, 2);
+    QCOMPARE(a.multipathType.size(), 2);
+    QCOMPARE(a.multipathType[1].relativDelay, 200);
+    ModelParaSetting b;
+    QVERIFY(db.getParaConfig("b", &b));
+    QCOMPARE(b.channelNum, 1);
+    QCOMPARE(b.multipathType.size(), 1);
+    QCOMPARE(b.multipathType[0].relativDelay, 100);
+    QCOMPARE(scalar("SELECT COUNT(*) FROM paths"), 3);
+    QCOMPARE(db.libraryRevision(), revision);
+}
+
+void TestDatabaseManager::renameAndMissing()
+{
+    DatabaseManager db;
+    QVERIFY(db.openDatabase(m_dir.filePath("rename.db")));
+    QVERIFY(db.createTable());
+    QVERIFY(db.insertParaConfigs({TestUtil::makeConfig("a", 2, 2), TestUtil::makeConfig("b", 1, 1)}));
+
+    // 改名为新名称，路径按原id整体替换
+    ModelParaSetting renamed = TestUtil::makeConfig("c", 3, 3);
+    QVERIFY(db.updateParaConfig("a", renamed));
+    ModelParaSetting loaded;
+    QVERIFY(!db.getParaConfig("a", &loaded));
+    QVERIFY(db.getParaConfig("c", &loaded));
+    QCOMPARE(loaded.multipathType.size(), 3);
+    QCOMPARE(loaded.multipathType[2].freShift, 30);
+    QCOMPARE(scalar("SELECT COUNT(*) FROM paths"), 4);
+
+    // 原名称不存在时失败，不写入任何路径
+    ModelParaSetting missing = TestUtil::makeConfig("d", 2, 2);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Config not found for update"));
+    QVERIFY(!db.updateParaConfig("a", missing));
+    QVERIFY(!db.getParaConfig("d", &loaded));
+    QCOMPARE(scalar("SELECT COUNT(*) FROM paths"), 4);
+}
+
+QTEST_GUILESS_MAIN(TestDatabaseManager)
+
+#include "tst_databasemanager.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_hardwarejournal
+
+SOURCES += \
+    tst_hardwarejournal.cpp
@@ -0,0 +1,242 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "hardwarejournal.h"
+
+// HardwareJournal保存/读取往返及各种无效日志的拒绝测试
+// 热启动据此跳过FPGA复位，任何不完整的日志都必须按冷启动处理
+class TestHardwareJournal : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void roundTrip();
+    void missingFile();
+    void rejects_data();
+    void rejects();
+    void truncatedFile();
+    void saveFailsForMissingDirectory();
+    void removeDeletesFile();
+
+private:
+    static HardwareState makeState();
+    // 有效日志的JSON对象，供各拒绝用例修改
+    QJsonObject validRoot();
+    QString writeFile(const QString &name, const QByteArray &content);
+
+    QTemporaryDir m_dir;
+};
+
+HardwareState TestHardwareJournal::makeState()
+{
+    HardwareState state;
+    state.ptt = 0x5;
+    state.dacChannels = {2, 3, -1, 7};
+    state.dacSelections = {1, 3, 0, 2};
+    state.shadowRegs = {0, 1, 0x7fffffff, 0xffffffff};
+    for (int channel : {2, 3}) {
+        ChannelSetting setting;
+        setting.channelNum = channel;
+        setting.signalAnt = 12.5 * channel;
+        setting.filterNum = channel;
+        setting.switchFlag = channel == 3;
+        setting.isChange = true;
+        for (int i = 1; i <= channel; i++) {
+            MultiPathType path;
+            path.pathNum = i;
+            path.relativDelay = 100 * i;
+            path.antPower = -i;
+            path.freShift = -20 * i;
+            path.freSpread = 5 * i;
+            path.dopplerType = i % 3;
+            setting.multipathType.append(path);
+        }
+        state.channels.insert(channel, setting);
+    }
+    return state;
+}
+
+QString TestHardwareJournal::writeFile(const QString &name, const QByteArray &content)
+{
+    QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(content);
+    }
+    return path;
+}
+
+QJsonObject TestHardwareJournal::validRoot()
+{
+    HardwareJournal journal(m_dir.filePath("valid.json"));
+    if (!journal.save(makeState())) {
+        return QJsonObject();
+    }
+    QFile file(journal.filePath());
+    file.open(QIODevice::ReadOnly);
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+void TestHardwareJournal::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestHardwareJournal::roundTrip()
+{
+    HardwareJournal journal(m_dir.filePath("roundtrip.json"));
+    HardwareState saved = makeState();
+    QVERIFY(journal.save(saved));
+
+    HardwareState loaded;
+    QVERIFY(journal.load(&loaded));
+    QCOMPARE(loaded.ptt, saved.ptt);
+    QCOMPARE(loaded.dacChannels, saved.dacChannels);
+    QCOMPARE(loaded.dacSelections, saved.dacSelections);
+    QCOMPARE(loaded.shadowRegs, saved.shadowRegs);
+    QCOMPARE(loaded.channels.keys(), saved.channels.keys());
+
+    const ChannelSetting &channel = loaded.channels.value(3);
+    QCOMPARE(channel.channelNum, 3);
+    QCOMPARE(channel.signalAnt, 37.5);
+    QCOMPARE(channel.filterNum, 3);
+    QVERIFY(channel.switchFlag);
+    QVERIFY(!loaded.channels.value(2).switchFlag);
+    // 恢复的信道都已下发，不再标记为改变
+    QVERIFY(!channel.isChange);
+    QCOMPARE(channel.multipathType.size(), 3);
+    const MultiPathType &path = channel.multipathType.at(2);
+    QCOMPARE(path.pathNum, 3);
+    QCOMPARE(path.relativDelay, 300);
+    QCOMPARE(path.antPower, -3);
+    QCOMPARE(path.freShift, -60);
+    QCOMPARE(path.freSpread, 15);
+    QCOMPARE(path.dopplerType, 0);
+
+    // 再次保存覆盖旧内容
+    saved.ptt = 0x0;
+    QVERIFY(journal.save(saved));
+    QVERIFY(journal.load(&loaded));
+    QCOMPARE(loaded.ptt, quint8(0x0));
+    QVERIFY(!journal.load(nullptr));
+}
+
+void TestHardwareJournal::missingFile()
+{
+    HardwareJournal journal(m_dir.filePath("missing.json"));
+    HardwareState state;
+    QVERIFY(!journal.load(&state));
+}
+
+void TestHardwareJournal::rejects_data()
+{
+    QTest::addColumn<QByteArray>("content");
+
+    QJsonObject root = validRoot();
+    QVERIFY(!root.isEmpty());
+    auto encode = [](const QJsonObject &object) { return QJsonDocument(object).toJson(QJsonDocument::Compact); };
+
+    // 确认未修改的日志可以读取，以下各行只有一处不同
+    QTest::newRow("valid control") << QByteArray();
+
+    QJsonObject changed = root;
+    changed["version"] = 2;
+    QTest::newRow("newer version") << encode(changed);
+    changed.remove("version");
+    QTest::newRow("no version") << encode(changed);
+
+    changed = root;
+    changed["dacChannels"] = QJsonArray({2, 3, -1});
+    QTest::newRow("3 dacChannels") << encode(changed);
+    changed["dacChannels"] = QJsonArray({2, 3, -1, 7, 8});
+    QTest::newRow("5 dacChannels") << encode(changed);
+    changed.remove("dacChannels");
+    QTest::newRow("no dacChannels") << encode(changed);
+
+    changed = root;
+    changed["dacSelections"] = QJsonArray({1, 3, 0});
+    QTest::newRow("3 dacSelections") << encode(changed);
+    changed["dacSelections"] = QJsonArray({1, 3, 0, 2, 4});
+    QTest::newRow("5 dacSelections") << encode(changed);
+
+    changed = root;
+    changed["channels"] = QJsonArray();
+    QTest::newRow("empty channels") << encode(changed);
+    changed.remove("channels");
+    QTest::newRow("no channels") << encode(changed);
+
+    QTest::newRow("empty file") << QByteArray("");
+    QTest::newRow("not json") << QByteArray("ptt=5\n");
+    QTest::newRow("array root") << QByteArray("[1,2,3]");
+    QTest::newRow("binary garbage") << QByteArray("\x00\xff{\"version\":1", 15);
+}
+
+void TestHardwareJournal::rejects()
+{
+    QFETCH(QByteArray, content);
+
+    QString path;
+    if (content.isNull()) {
+        path = m_dir.filePath("valid.json");
+    } else {
+        path = writeFile("reject.json", content);
+    }
+
+    HardwareJournal journal(path);
+    HardwareState state;
+    state.ptt = 0xA;
+    bool ok = journal.load(&state);
+    if (content.isNull()) {
+        QVERIFY(ok);
+        return;
+    }
+
+    // 失败时不修改输出
+    QVERIFY(!ok);
+    QCOMPARE(state.ptt, quint8(0xA));
+    QVERIFY(state.channels.isEmpty());
+}
+
+void TestHardwareJournal::truncatedFile()
+{
+    HardwareJournal source(m_dir.filePath("full.json"));
+    QVERIFY(source.save(makeState()));
+    QFile file(source.filePath());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll();
+    file.close();
+
+    // 在任意位置截断都按冷启动处理
+    for (int length : {1, content.size() / 4, content.size() / 2, content.size() - 1}) {
+        HardwareJournal journal(writeFile("truncated.json", content.left(length)));
+        HardwareState state;
+        QVERIFY2(!journal.load(&state), qPrintable(QString("length %1").arg(length)));
+    }
+}
+
+void TestHardwareJournal::saveFailsForMissingDirectory()
+{
+    HardwareJournal journal(m_dir.filePath("no/such/dir/journal.json"));
+    QVERIFY(!journal.save(makeState()));
+}
+
+void TestHardwareJournal::removeDeletesFile()
+{
+    HardwareJournal journal(m_dir.filePath("remove.json"));
+    QVERIFY(journal.save(makeState()));
+    QVERIFY(QFile::exists(journal.filePath()));
+
+    journal.remove();
+    QVERIFY(!QFile::exists(journal.filePath()));
+    HardwareState state;
+    QVERIFY(!journal.load(&state));
+    // 文件不存在时再次删除无副作用
+    journal.remove();
+}
+
+QTEST_GUILESS_MAIN(TestHardwareJournal)
+
+#include "tst_hardwarejournal.moc"
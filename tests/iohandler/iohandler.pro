@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_iohandler
+
+SOURCES += \
+    tst_iohandler.cpp
@@ -0,0 +1,187 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "iohandler.h"
+#include "testutil.h"
+
+// IOHandler多场景流式读取(JSON按块扫描、CSV按表头分块)及批量导出文件名测试
+class TestIOHandler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void jsonObjectsSpanChunks();
+    void jsonEscapesAtChunkBoundary();
+    void jsonTruncatedArray();
+    void jsonBadObjectSkipped();
+    void csvMultipleBlocks();
+    void exportFilesSanitizesNames();
+
+private:
+    QString writeFile(const QString &name, const QByteArray &content);
+
+    QTemporaryDir m_dir;
+};
+
+// 与iohandler.cpp中的READ_CHUNK_SIZE一致
+static const int CHUNK_SIZE = 64 * 1024;
+
+QString TestIOHandler::writeFile(const QString &name, const QByteArray &content)
+{
+    QString filePath = m_dir.filePath(name);
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+        return QString();
+    }
+    return filePath;
+}
+
+void TestIOHandler::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestIOHandler::jsonObjectsSpanChunks()
+{
+    // 长名称使对象跨越多个读取块
+    QList<ModelParaSetting> configs;
+    for (int i = 0; i < 300; i++) {
+        configs.append(TestUtil::makeConfig(QString("场景%1_").arg(i) + QString(200, QChar('x')), i % 15 + 1, i % 5 + 1));
+    }
+    IOHandler handler;
+    QString filePath = m_dir.filePath("chunks.json");
+    QVERIFY(handler.exportArchive(configs, filePath, "JSON"));
+    QVERIFY(QFileInfo(filePath).size() > 3 * CHUNK_SIZE);
+
+    QSignalSpy progress(&handler, &IOHandler::importProgress);
+    QString error;
+    QList<ModelParaSetting> imported = handler.importArchive(filePath, &error);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(imported.size(), configs.size());
+    for (int i = 0; i < configs.size(); i++) {
+        QCOMPARE(imported[i].modelName, configs[i].modelName);
+        QCOMPARE(imported[i].channelNum, configs[i].channelNum);
+        QCOMPARE(imported[i].multipathType.size(), configs[i].multipathType.size());
+        QCOMPARE(imported[i].multipathType.last().dopplerType, configs[i].multipathType.last().dopplerType);
+    }
+    QVERIFY(!progress.isEmpty());
+    QCOMPARE(progress.last().first().toInt(), 100);
+}
+
+void TestIOHandler::jsonEscapesAtChunkBoundary()
+{
+    // 字符串中的引号、括号不影响对象边界；转义符恰好是第一块的最后一个字节
+    QByteArray head = "[{\"modelName\":\"a}{[\\";
+    QByteArray content = "[" + QByteArray(CHUNK_SIZE - head.size(), ' ') + head.mid(1);
+    QCOMPARE(content.size(), CHUNK_SIZE);
+    content += "\"]\",\"channelNum\":3},\n"
+               "{\"modelName\":\"b\\\\\",\"channelNum\":4,\"multipathType\":[{\"pathNum\":1}]},\n"
+               "{\"modelName\":\"}\",\"channelNum\":5}]\n";
+    QString filePath = writeFile("escape.json", content);
+    QVERIFY(!filePath.isEmpty());
+
+    IOHandler handler;
+    QString error;
+    QList<ModelParaSetting> imported = handler.importArchive(filePath, &error);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(imported.size(), 3);
+    QCOMPARE(imported[0].modelName, QStringLiteral("a}{[\"]"));
+    QCOMPARE(imported[0].channelNum, 3);
+    QCOMPARE(imported[1].modelName, QStringLiteral("b\\"));
+    QCOMPARE(imported[1].multipathType.size(), 1);
+    QCOMPARE(imported[2].modelName, QStringLiteral("}"));
+}
+
+void TestIOHandler::jsonTruncatedArray()
+{
+    QString filePath = writeFile("truncated.json",
+                                 "[{\"modelName\":\"a\",\"channelNum\":1},\n{\"modelName\":\"b\",\"multipathType\":[{");
+    QVERIFY(!filePath.isEmpty());
+
+    IOHandler handler;
+    QString error;
+    QList<ModelParaSetting> imported = handler.importArchive(filePath, &error);
+    // 已完整的对象保留，并报告文件不完整
+    QCOMPARE(imported.size(), 1);
+    QCOMPARE(imported[0].modelName, QStringLiteral("a"));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestIOHandler::jsonBadObjectSkipped()
+{
+    QString filePath = writeFile("bad.json",
+                                 "[{\"modelName\":\"a\"},\n{\"modelName\":,\"channelNum\":2},\n"
+                                 "{\"modelName\":\"c\",\"channelNum\":3}]");
+    QVERIFY(!filePath.isEmpty());
+
+    IOHandler handler;
+    QString error;
+    QList<ModelParaSetting> imported = handler.importArchive(filePath, &error);
+    // 无法解析的对象跳过并给出错误，后续对象继续读取
+    QCOMPARE(imported.size(), 2);
+    QCOMPARE(imported[0].modelName, QStringLiteral("a"));
+    QCOMPARE(imported[1].modelName, QStringLiteral("c"));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestIOHandler::csvMultipleBlocks()
+{
+    // 导出的多场景CSV按基础参数表头重新分块，含无多径的场景
+    QList<ModelParaSetting> configs;
+    configs << TestUtil::makeConfig("场景A", 1, 3) << TestUtil::makeConfig("场景B", 2, 0) << TestUtil::makeConfig("场景C", 15, 5);
+    IOHandler handler;
+    QString filePath = m_dir.filePath("blocks.csv");
+    QVERIFY(handler.exportArchive(configs, filePath, "CSV"));
+
+    QString error;
+    QList<ModelParaSetting> imported = handler.importArchive(filePath, &error);
+    QCOMPARE(imported.size(), configs.size());
+    for (int i = 0; i < configs.size(); i++) {
+        QCOMPARE(imported[i].modelName, configs[i].modelName);
+        QCOMPARE(imported[i].channelNum, configs[i].channelNum);
+        QCOMPARE(imported[i].multipathNum, configs[i].multipathNum);
+        QCOMPARE(imported[i].multipathType.size(), configs[i].multipathType.size());
+    }
+    QCOMPARE(imported[2].multipathType[4].freSpread, 25);
+
+    // 块之间多余的空行被忽略
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll().replace("\nchannelNum,", "\n\n\r\n\nchannelNum,");
+    file.close();
+    QString spacedPath = writeFile("spaced.csv", content);
+    QCOMPARE(handler.importArchive(spacedPath, &error).size(), configs.size());
+}
+
+void TestIOHandler::exportFilesSanitizesNames()
+{
+    QDir root(m_dir.path());
+    QVERIFY(root.mkdir("export"));
+    QString exportDir = root.filePath("export");
+
+    QList<ModelParaSetting> configs;
+    configs << TestUtil::makeConfig("../escape", 1, 1)
+            << TestUtil::makeConfig("a/b:c*?", 2, 1)
+            << TestUtil::makeConfig("..", 3, 1)
+            << TestUtil::makeConfig("%2名称", 4, 1);
+    IOHandler handler;
+    QString error;
+    QVERIFY2(handler.exportFiles(configs, exportDir, "JSON", &error), qPrintable(error));
+
+    // 全部写在目标目录内，名称中的分隔符、保留字符和开头的点被替换或去掉
+    QStringList files = QDir(exportDir).entryList(QDir::Files | QDir::Hidden, QDir::Name);
+    QStringList expected;
+    expected << "%2名称_4.json" << "_escape_1.json" << "a_b_c___2.json" << "场景_3.json";
+    expected.sort();
+    files.sort();
+    QCOMPARE(files, expected);
+    QVERIFY(!root.exists("escape_1.json"));
+
+    // 导出文件仍保留原场景名称
+    ModelParaSetting imported = handler.importDataAutoDetect(QDir(exportDir).filePath("_escape_1.json"));
+    QCOMPARE(imported.modelName, QStringLiteral("../escape"));
+}
+
+QTEST_GUILESS_MAIN(TestIOHandler)
+
+#include "tst_iohandler.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_mqttparser
+
+SOURCES += \
+    tst_mqttparser.cpp
@@ -0,0 +1,240 @@
+#include <QtTest>
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "channel_utils.h"
+#include "mqttmessageparser.h"
+
+// MqttMessageParser::parseChannelParams的接受/拒绝测试
+class TestMqttParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void acceptsStringAndNumberFields();
+    void acceptsOptionalFields();
+    void acceptsCbor();
+    void rejects_data();
+    void rejects();
+
+private:
+    // 一个合法的信道：channel号，pathCount条多径，数值按字符串下发
+    static QJsonObject makeChannel(int channel, int pathCount);
+    static QByteArray makePayload(const QJsonArray &channels);
+};
+
+QJsonObject TestMqttParser::makeChannel(int channel, int pathCount)
+{
+    QJsonObject modelObj;
+    modelObj["modelType"] = "1";
+    modelObj["modelName"] = "海洋场景";
+    modelObj["channelNum"] = QString::number(channel);
+    modelObj["signalAnt"] = "10.5";
+    modelObj["filterNum"] = "2";
+    modelObj["noisePower"] = "2000";
+    modelObj["comDistance"] = "3000";
+    modelObj["multipathNum"] = QString::number(pathCount);
+
+    QJsonArray multiPathArray;
+    for (int i = 1; i <= pathCount; i++) {
+        QJsonObject pathObj;
+        pathObj["pathNum"] = QString::number(i);
+        pathObj["relativDelay"] = QString::number(i * 100);
+        pathObj["antPower"] = QString::number(-i);
+        pathObj["freShift"] = QString::number(i * 10);
+        pathObj["freSpread"] = QString::number(i * 5);
+        multiPathArray.append(pathObj);
+    }
+    modelObj["MultiPath"] = multiPathArray;
+    return modelObj;
+}
+
+QByteArray TestMqttParser::makePayload(const QJsonArray &channels)
+{
+    QJsonObject rootObj;
+    rootObj["ExamID"] = "1943573142583222273";
+    rootObj["ModelParaSetting"] = channels;
+    return QJsonDocument(rootObj).toJson(QJsonDocument::Compact);
+}
+
+void TestMqttParser::acceptsStringAndNumberFields()
+{
+    // 第二个信道数值用原生数字，负信道号按绝对值查重
+    QJsonObject numeric = makeChannel(-3, 1);
+    numeric["channelNum"] = -3;
+    numeric["signalAnt"] = 0;
+    numeric["filterNum"] = 0;
+    numeric["multipathNum"] = 1;
+    QJsonArray paths = numeric["MultiPath"].toArray();
+    QJsonObject path = paths[0].toObject();
+    path["pathNum"] = 5;
+    path["relativDelay"] = 7;
+    path["dopplerType"] = 2;
+    paths[0] = path;
+    numeric["MultiPath"] = paths;
+
+    QString examID;
+    QList<ModelParaSetting> settings;
+    QString error;
+    MessageFormat format = MessageFormat::Unknown;
+    QVERIFY2(MqttMessageParser::parseChannelParams(makePayload({makeChannel(15, 5), numeric}),
+                                                   &examID, &settings, &error, &format),
+             qPrintable(error));
+    QCOMPARE(format, MessageFormat::JSON);
+    QCOMPARE(examID, QStringLiteral("1943573142583222273"));
+    QCOMPARE(settings.size(), 2);
+
+    QCOMPARE(settings[0].channelNum, 15);
+    QCOMPARE(settings[0].modelName, QStringLiteral("海洋场景"));
+    QCOMPARE(settings[0].signalAnt, 10.5);
+    QCOMPARE(settings[0].filterNum, 2);
+    QCOMPARE(settings[0].multipathNum, 5);
+    QCOMPARE(settings[0].multipathType[4].antPower, -5);
+    QVERIFY(settings[0].isChange);
+
+    QCOMPARE(settings[1].channelNum, -3);
+    QCOMPARE(settings[1].signalAnt, 0.0);
+    QCOMPARE(settings[1].multipathType.size(), 1);
+    QCOMPARE(settings[1].multipathType[0].pathNum, 5);
+    QCOMPARE(settings[1].multipathType[0].relativDelay, 7);
+    QCOMPARE(settings[1].multipathType[0].dopplerType, 2);
+}
+
+void TestMqttParser::acceptsOptionalFields()
+{
+    // multipathNum、modelType、noisePower、comDistance、dopplerType可省略，MultiPath可为空
+    QJsonObject modelObj = makeChannel(7, 2);
+    modelObj.remove("multipathNum");
+    modelObj.remove("modelType");
+    modelObj.remove("noisePower");
+    modelObj.remove("comDistance");
+    QJsonObject empty = makeChannel(8, 0);
+    empty.remove("MultiPath");
+    empty.remove("multipathNum");
+
+    QList<ModelParaSetting> settings;
+    QString error;
+    QVERIFY2(MqttMessageParser::parseChannelParams(makePayload({modelObj, empty}),
+                                                   nullptr, &settings, &error),
+             qPrintable(error));
+    QCOMPARE(settings.size(), 2);
+    QCOMPARE(settings[0].multipathNum, 2);
+    QCOMPARE(settings[0].modelType, 0);
+    QCOMPARE(settings[0].noisePower, 0.0);
+    QCOMPARE(settings[0].multipathType[1].dopplerType, 0);
+    QCOMPARE(settings[1].multipathNum, 0);
+    QVERIFY(settings[1].multipathType.isEmpty());
+}
+
+void TestMqttParser::acceptsCbor()
+{
+    // 带或不带自描述标签的CBOR map，整数ExamID不丢精度
+    QCborMap root = QCborMap::fromJsonObject(QJsonDocument::fromJson(makePayload({makeChannel(2, 3)})).object());
+    root[QStringLiteral("ExamID")] = qint64(1943573142583222273LL);
+    QByteArray untagged = root.toCborValue().toCbor();
+    QByteArray tagged = QCborValue(QCborKnownTags::Signature, root.toCborValue()).toCbor();
+
+    for (const QByteArray &payload : {untagged, tagged}) {
+        QString examID;
+        QList<ModelParaSetting> settings;
+        QString error;
+        MessageFormat format = MessageFormat::Unknown;
+        QVERIFY2(MqttMessageParser::parseChannelParams(payload, &examID, &settings, &error, &format),
+                 qPrintable(error));
+        QCOMPARE(format, MessageFormat::CBOR);
+        QCOMPARE(examID, QStringLiteral("1943573142583222273"));
+        QCOMPARE(settings.size(), 1);
+        QCOMPARE(settings[0].channelNum, 2);
+        QCOMPARE(settings[0].multipathType.size(), 3);
+    }
+}
+
+void TestMqttParser::rejects_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("not json") << QByteArray("{\"ExamID\":");
+    QTest::newRow("json array") << QByteArray("[1,2]");
+    QTest::newRow("bad cbor") << QByteArray("\xD9\xD9\xF7\xA1", 4);
+    QTest::newRow("cbor not map") << QByteArray("\xD9\xD9\xF7\x01", 4);
+    QTest::newRow("no ModelParaSetting") << QByteArray("{\"ExamID\":\"1\"}");
+    QTest::newRow("ModelParaSetting not array") << QByteArray("{\"ModelParaSetting\":{}}");
+    QTest::newRow("ModelParaSetting empty") << makePayload(QJsonArray());
+
+    // 信道号：0、超出[-6,15]、非数字、重复(含正负同号)
+    for (const QString &channel : {QStringLiteral("0"), QStringLiteral("16"), QStringLiteral("-7"), QStringLiteral("abc")}) {
+        QJsonObject modelObj = makeChannel(1, 1);
+        modelObj["channelNum"] = channel;
+        QTest::newRow(qPrintable("channel " + channel)) << makePayload({modelObj});
+    }
+    QTest::newRow("channel duplicate") << makePayload({makeChannel(4, 1), makeChannel(-4, 1)});
+
+    QJsonObject modelObj = makeChannel(1, 1);
+    modelObj["signalAnt"] = "-0.5";
+    QTest::newRow("signalAnt negative") << makePayload({modelObj});
+    modelObj = makeChannel(1, 1);
+    modelObj.remove("signalAnt");
+    QTest::newRow("signalAnt missing") << makePayload({modelObj});
+    modelObj = makeChannel(1, 1);
+    modelObj["filterNum"] = "-1";
+    QTest::newRow("filterNum negative") << makePayload({modelObj});
+    modelObj = makeChannel(1, 1);
+    modelObj["filterNum"] = "x";
+    QTest::newRow("filterNum not number") << makePayload({modelObj});
+
+    // 多径：数量超过ALG_PATH_MAX、编号越界/重复、字段缺失、与multipathNum不一致
+    QTest::newRow("too many paths") << makePayload({makeChannel(1, ALG_PATH_MAX + 1)});
+    for (int pathNum : {0, ALG_PATH_MAX + 1}) {
+        modelObj = makeChannel(1, 1);
+        QJsonArray paths = modelObj["MultiPath"].toArray();
+        QJsonObject path = paths[0].toObject();
+        path["pathNum"] = pathNum;
+        paths[0] = path;
+        modelObj["MultiPath"] = paths;
+        QTest::newRow(qPrintable(QString("pathNum %1").arg(pathNum))) << makePayload({modelObj});
+    }
+    modelObj = makeChannel(1, 2);
+    QJsonArray paths = modelObj["MultiPath"].toArray();
+    QJsonObject path = paths[1].toObject();
+    path["pathNum"] = 1;
+    paths[1] = path;
+    modelObj["MultiPath"] = paths;
+    QTest::newRow("pathNum duplicate") << makePayload({modelObj});
+    modelObj = makeChannel(1, 1);
+    paths = modelObj["MultiPath"].toArray();
+    path = paths[0].toObject();
+    path.remove("freSpread");
+    paths[0] = path;
+    modelObj["MultiPath"] = paths;
+    QTest::newRow("path field missing") << makePayload({modelObj});
+    modelObj = makeChannel(1, 2);
+    modelObj["multipathNum"] = "3";
+    QTest::newRow("multipathNum mismatch") << makePayload({modelObj});
+
+    // 任一信道不合法时整条消息无效
+    modelObj = makeChannel(2, 1);
+    modelObj["channelNum"] = "99";
+    QTest::newRow("second channel invalid") << makePayload({makeChannel(1, 1), modelObj});
+}
+
+void TestMqttParser::rejects()
+{
+    QFETCH(QByteArray, payload);
+
+    QString examID = QStringLiteral("unchanged");
+    QList<ModelParaSetting> settings;
+    settings.append(ModelParaSetting());
+    QString error;
+    QVERIFY(!MqttMessageParser::parseChannelParams(payload, &examID, &settings, &error));
+    QVERIFY(!error.isEmpty());
+    // 失败时不修改输出参数
+    QCOMPARE(examID, QStringLiteral("unchanged"));
+    QCOMPARE(settings.size(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestMqttParser)
+
+#include "tst_mqttparser.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_pttallocation
+
+SOURCES += \
+    tst_pttallocation.cpp
@@ -0,0 +1,302 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <atomic>
+#include <errno.h>
+#include <stdlib.h>
+#include "PttMonitorThread.h"
+#include "asynclogger.h"
+#include "channelcachemanager.h"
+#include "channelparamqueue.h"
+
+// PTT处理路径的堆分配测试：替换malloc系列函数计数，PTT切换和参数下发在稳态下必须为0次
+// Qt容器和operator new最终都经过malloc，只统计开启计数的线程，日志写文件线程不计入
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+}
+
+namespace {
+thread_local bool t_counting = false;
+std::atomic<int> g_allocations(0);
+
+inline void countAllocation()
+{
+    if (t_counting) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+}
+
+extern "C" void *malloc(size_t size) noexcept
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    void *p = __libc_memalign(alignment, size);
+    if (!p) {
+        return ENOMEM;
+    }
+    *ptr = p;
+    return 0;
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+#endif
+
+// 作用域内统计当前线程的堆分配次数
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+#ifdef __GLIBC__
+        g_allocations.store(0);
+        t_counting = true;
+#endif
+    }
+    ~AllocationCounter() { stop(); }
+
+    // 结束统计，返回分配次数
+    int stop()
+    {
+#ifdef __GLIBC__
+        t_counting = false;
+        return g_allocations.load();
+#else
+        return 0;
+#endif
+    }
+};
+
+class TestPttAllocation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void counterDetectsAllocations();
+    void pttTransitionsDoNotAllocate();
+    void parameterRoundsDoNotAllocate();
+    void drainRoundsDoNotAllocate();
+    void drainWithSnapshotDoesNotAllocate();
+
+private:
+    // 信道2、3、4的参数批次
+    static ChannelParamBatch makeBatch(double signalAnt);
+    // 在缓存所属线程之外执行rounds轮出队、写缓存和下发，返回计数期间的分配次数
+    static int drainRounds(PttMonitorThread *thread, ChannelParamBatch batch, int rounds, int *committed);
+
+    QTemporaryDir m_logDir;
+};
+
+// 覆盖收发切换、多电台同时发射和全部释放
+static const UINT8 PTT_SEQUENCE[] = {0x1, 0x3, 0x2, 0x6, 0x0, 0x9, 0xc, 0x5, 0xe, 0x0};
+
+void TestPttAllocation::initTestCase()
+{
+#ifndef __GLIBC__
+    QSKIP("分配计数依赖glibc的__libc_malloc");
+#endif
+    // 日志开启时热路径同样不能分配
+    QVERIFY(m_logDir.isValid());
+    QVERIFY(AsyncLogger::instance()->start(m_logDir.filePath("ptt.log")));
+    AsyncLogger::instance()->setLevel(LogLevel::Debug);
+}
+
+void TestPttAllocation::cleanupTestCase()
+{
+    AsyncLogger::instance()->stop();
+}
+
+void TestPttAllocation::counterDetectsAllocations()
+{
+    AllocationCounter counter;
+    QVector<int> values(64, 1);
+    int allocations = counter.stop();
+    QVERIFY(values.size() == 64);
+    QVERIFY(allocations > 0);
+}
+
+void TestPttAllocation::pttTransitionsDoNotAllocate()
+{
+    PttMonitorThread thread(nullptr);
+
+    // 预热：单例创建、本线程日志缓冲注册等一次性分配
+    for (UINT8 ptt : PTT_SEQUENCE) {
+        thread.processPtt(ptt, false);
+    }
+
+    AllocationCounter counter;
+    int committed = 0;
+    for (int round = 0; round < 3; round++) {
+        for (UINT8 ptt : PTT_SEQUENCE) {
+            committed += thread.processPtt(ptt, false) ? 1 : 0;
+        }
+    }
+    int allocations = counter.stop();
+
+    QCOMPARE(allocations, 0);
+    QCOMPARE(committed, 3 * int(sizeof(PTT_SEQUENCE)));
+
+    // 下发结果仍可在其他线程取出
+    UINT8 ptt = 0xff;
+    QVector<INT8> channels;
+    thread.committedState(&ptt, &channels, nullptr);
+    QCOMPARE(ptt, UINT8(0x0));
+    QCOMPARE(channels.size(), int(RadioChannelManager::DAC_COUNT));
+}
+
+void TestPttAllocation::parameterRoundsDoNotAllocate()
+{
+    PttMonitorThread thread(nullptr);
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+
+    // 电台1、2同时发射，DAC承载信道2、3、4、5
+    thread.processPtt(0x3, false);
+
+    ChannelSetting setting;
+    setting.signalAnt = 6;
+    setting.filterNum = 1;
+    MultiPathType path;
+    path.pathNum = 1;
+    path.relativDelay = 100;
+    path.antPower = 3;
+    path.freShift = 20;
+    path.freSpread = 5;
+    path.dopplerType = 0;
+    setting.multipathType.append(path);
+    for (int channel : {2, 3, 4}) {
+        setting.channelNum = channel;
+        cache->updateChannelParameters(channel, setting);
+    }
+    thread.processPtt(0x3, true);
+
+    AllocationCounter counter;
+    bool committed = thread.processPtt(0x3, true);
+    bool idle = thread.processPtt(0x3, false);
+    int allocations = counter.stop();
+
+    QCOMPARE(allocations, 0);
+    QVERIFY(committed);
+    QVERIFY(!idle);
+}
+
+ChannelParamBatch TestPttAllocation::makeBatch(double signalAnt)
+{
+    ChannelParamBatch batch;
+    batch.examID = "exam";
+    ChannelSetting setting;
+    setting.signalAnt = signalAnt;
+    setting.filterNum = 2;
+    MultiPathType path;
+    path.pathNum = 1;
+    path.relativDelay = 50;
+    path.antPower = 2;
+    path.freShift = 10;
+    path.freSpread = 3;
+    path.dopplerType = 0;
+    setting.multipathType.append(path);
+    for (int channel : {2, 3, 4}) {
+        setting.channelNum = channel;
+        batch.settings.append(setting);
+    }
+    return batch;
+}
+
+int TestPttAllocation::drainRounds(PttMonitorThread *thread, ChannelParamBatch batch, int rounds, int *committed)
+{
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+    int allocations = 0;
+    QThread *worker = QThread::create([&]() {
+        // 预热：本线程日志缓冲注册、首次分配DAC等一次性分配
+        thread->processPtt(0x3, false);
+        queue->push(batch);
+        thread->drainParamQueue();
+        thread->commitRound(0x3);
+
+        for (int round = 0; round < rounds; round++) {
+            // 入队是MQTT线程的工作，不计入
+            batch.receivedNs = ChannelParamQueue::nowNs();
+            queue->push(batch);
+            queue->push(batch);
+
+            AllocationCounter counter;
+            thread->drainParamQueue();
+            *committed += thread->commitRound(0x3) ? 1 : 0;
+            allocations += counter.stop();
+        }
+    });
+    worker->start();
+    bool finished = worker->wait(10000);
+    delete worker;
+    return finished ? allocations : -1;
+}
+
+void TestPttAllocation::drainRoundsDoNotAllocate()
+{
+    PttMonitorThread thread(nullptr);
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ChannelParamQueue *queue = ChannelParamQueue::instance();
+
+    QList<int> notifiedKeys;
+    QMetaObject::Connection conn = connect(cache, &ChannelCacheManager::parametersBatchChanged,
+                                           [&notifiedKeys](const QList<int> &keys) { notifiedKeys = keys; });
+    quint64 latencyCount = queue->latencyStats().count;
+
+    const int rounds = 8;
+    int committed = 0;
+    QCOMPARE(drainRounds(&thread, makeBatch(9), rounds, &committed), 0);
+    QCOMPARE(committed, rounds);
+    QCOMPARE(queue->latencyStats().count, latencyCount + 1 + 2 * rounds);
+    QCOMPARE(cache->getChannelSetting(3).signalAnt, 9.0);
+
+    // 批量改变信号由eventfd唤醒后在本线程发出
+    QTRY_COMPARE(notifiedKeys, QList<int>({2, 3, 4}));
+    disconnect(conn);
+}
+
+void TestPttAllocation::drainWithSnapshotDoesNotAllocate()
+{
+    PttMonitorThread thread(nullptr);
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    cache->updateChannelParameters(3, makeBatch(1).settings.at(1));
+
+    // 上报组包和硬件日志持有的快照在下发期间一直存活，写缓存不能因共享而分离复制
+    QMap<int, ChannelSetting> snapshot = cache->getAllChannelSettings();
+
+    const int rounds = 4;
+    int committed = 0;
+    QCOMPARE(drainRounds(&thread, makeBatch(12), rounds, &committed), 0);
+    QCOMPARE(committed, rounds);
+    QCOMPARE(cache->getChannelSetting(3).signalAnt, 12.0);
+    QCOMPARE(snapshot.value(3).signalAnt, 1.0);
+}
+
+QTEST_GUILESS_MAIN(TestPttAllocation)
+
+#include "tst_pttallocation.moc"
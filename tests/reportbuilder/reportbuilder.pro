@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_reportbuilder
+
+SOURCES += \
+    tst_reportbuilder.cpp
@@ -0,0 +1,238 @@
+#include <QtTest>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "channelcachemanager.h"
+#include "reportbuilder.h"
+
+// ReportBuilder信道参数上报测试：编码结果解码回来逐字段比较，按修改代数判断内容是否变化
+class TestReportBuilder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cborParamReportRoundTrip();
+    void jsonParamReportRoundTrip();
+    void cborHeartbeatRoundTrip();
+    void unchangedCacheReturnsRetainedPayload();
+    void cacheUpdateRebuildsPayload();
+    void sameContentNotChanged();
+    void examIdAndInvalidateRebuild();
+
+private:
+    static ChannelSetting makeSetting(int channel);
+    static QJsonObject jsonChannel(const QByteArray &payload, int channel);
+};
+
+ChannelSetting TestReportBuilder::makeSetting(int channel)
+{
+    ChannelSetting setting;
+    setting.channelNum = channel;
+    setting.signalAnt = 12.5;
+    setting.filterNum = 3;
+    for (int i = 1; i <= 2; i++) {
+        MultiPathType path;
+        path.pathNum = i;
+        path.relativDelay = 100 * i;
+        path.antPower = -6 * i;
+        path.freShift = 20 + i;
+        path.freSpread = 5 * i;
+        path.dopplerType = i - 1;
+        setting.multipathType.append(path);
+    }
+    return setting;
+}
+
+QJsonObject TestReportBuilder::jsonChannel(const QByteArray &payload, int channel)
+{
+    const QJsonArray channels = QJsonDocument::fromJson(payload).object().value("ModelParaSetting").toArray();
+    for (const QJsonValue &item : channels) {
+        if (item.toObject().value("channelNum").toString() == QString::number(channel)) {
+            return item.toObject();
+        }
+    }
+    return QJsonObject();
+}
+
+void TestReportBuilder::initTestCase()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    cache->updateChannelSwitch(5, true);
+    cache->updateChannelParameters(5, makeSetting(5));
+}
+
+void TestReportBuilder::cborParamReportRoundTrip()
+{
+    ReportBuilder builder;
+    builder.setEncoding(ReportEncoding::Cbor);
+    bool changed = false;
+    QByteArray payload = builder.channelParamReport(QStringLiteral("1943573142583222273"), &changed);
+    QVERIFY(changed);
+
+    // 自描述标签 + 拼接出的map，必须能被标准解码器完整解码
+    QCborParserError error;
+    QCborValue value = QCborValue::fromCbor(payload, &error);
+    QVERIFY(error.error == QCborError::NoError);
+    QVERIFY(value.isTag());
+    QCOMPARE(quint64(value.tag()), quint64(55799));
+
+    QCborMap root = value.taggedValue().toMap();
+    QCOMPARE(root.size(), 3);
+    QCOMPARE(root.value(QStringLiteral("schema")).toInteger(), qint64(REPORT_SCHEMA_VERSION));
+    QCOMPARE(root.value(QStringLiteral("ExamID")).toString(), QStringLiteral("1943573142583222273"));
+
+    QCborArray channels = root.value(QStringLiteral("ModelParaSetting")).toArray();
+    QCOMPARE(channels.size(), qsizetype(15));
+    QCborMap channel;
+    for (const QCborValue &item : channels) {
+        if (item.toMap().value(QStringLiteral("channelNum")).toInteger() == 5) {
+            channel = item.toMap();
+        }
+    }
+    QVERIFY(!channel.isEmpty());
+    QCOMPARE(channel.value(QStringLiteral("signalAnt")).toDouble(), 12.5);
+    QCOMPARE(channel.value(QStringLiteral("filterNum")).toInteger(), qint64(3));
+    QCOMPARE(channel.value(QStringLiteral("switchFlag")).toBool(), true);
+    QCOMPARE(channel.value(QStringLiteral("multipathNum")).toInteger(), qint64(2));
+
+    QCborArray paths = channel.value(QStringLiteral("MultiPath")).toArray();
+    QCOMPARE(paths.size(), qsizetype(2));
+    QCborMap path = paths.at(1).toMap();
+    QCOMPARE(path.value(QStringLiteral("pathNum")).toInteger(), qint64(2));
+    QCOMPARE(path.value(QStringLiteral("relativDelay")).toInteger(), qint64(200));
+    QCOMPARE(path.value(QStringLiteral("antPower")).toInteger(), qint64(-12));
+    QCOMPARE(path.value(QStringLiteral("freShift")).toInteger(), qint64(22));
+    QCOMPARE(path.value(QStringLiteral("freSpread")).toInteger(), qint64(10));
+    QCOMPARE(path.value(QStringLiteral("dopplerType")).toInteger(), qint64(1));
+}
+
+void TestReportBuilder::jsonParamReportRoundTrip()
+{
+    ReportBuilder builder;
+    QByteArray payload = builder.channelParamReport(QStringLiteral("42"), nullptr);
+
+    // JSON保持旧格式，数值为字符串
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QJsonObject root = doc.object();
+    QCOMPARE(root.value("ExamID").toString(), QStringLiteral("42"));
+
+    QJsonArray channels = root.value("ModelParaSetting").toArray();
+    QCOMPARE(channels.size(), 15);
+    QJsonObject channel;
+    for (const QJsonValue &item : channels) {
+        if (item.toObject().value("channelNum").toString() == "5") {
+            channel = item.toObject();
+        }
+    }
+    QVERIFY(!channel.isEmpty());
+    QCOMPARE(channel.value("signalAnt").toString(), QStringLiteral("12.5"));
+    QCOMPARE(channel.value("filterNum").toString(), QStringLiteral("3"));
+    QCOMPARE(channel.value("switchFlag").toBool(), true);
+    QCOMPARE(channel.value("multipathNum").toString(), QStringLiteral("2"));
+    QJsonObject path = channel.value("MultiPath").toArray().at(0).toObject();
+    QCOMPARE(path.value("pathNum").toString(), QStringLiteral("1"));
+    QCOMPARE(path.value("antPower").toString(), QStringLiteral("-6"));
+}
+
+void TestReportBuilder::cborHeartbeatRoundTrip()
+{
+    ReportBuilder builder;
+    builder.setEncoding(ReportEncoding::Cbor);
+    QCborValue value = QCborValue::fromCbor(builder.heartbeat());
+    QVERIFY(value.isTag());
+    QCborMap heartbeat = value.taggedValue().toMap();
+    QCOMPARE(heartbeat.value(QStringLiteral("schema")).toInteger(), qint64(REPORT_SCHEMA_VERSION));
+    QCOMPARE(heartbeat.value(QStringLiteral("state")).toInteger(), qint64(0));
+
+    // 切回JSON后心跳恢复旧格式
+    builder.setEncoding(ReportEncoding::Json);
+    QCOMPARE(builder.heartbeat(), QByteArray("{\"state\":0}"));
+}
+
+void TestReportBuilder::unchangedCacheReturnsRetainedPayload()
+{
+    ReportBuilder builder;
+    bool changed = false;
+    QByteArray first = builder.channelParamReport(QStringLiteral("42"), &changed);
+    QVERIFY(changed);
+
+    // 缓存未修改，返回上次保存的内容
+    QByteArray second = builder.channelParamReport(QStringLiteral("42"), &changed);
+    QVERIFY(!changed);
+    QCOMPARE(second, first);
+    QCOMPARE(jsonChannel(second, 5).value("signalAnt").toString(), QStringLiteral("12.5"));
+}
+
+void TestReportBuilder::cacheUpdateRebuildsPayload()
+{
+    ReportBuilder builder;
+    bool changed = false;
+    QByteArray before = builder.channelParamReport(QStringLiteral("42"), &changed);
+
+    ChannelSetting setting = makeSetting(6);
+    setting.signalAnt = 30;
+    setting.multipathType.removeLast();
+    ChannelCacheManager::instance()->updateChannelParameters(6, setting);
+
+    QByteArray after = builder.channelParamReport(QStringLiteral("42"), &changed);
+    QVERIFY(changed);
+    QVERIFY(after != before);
+    QJsonObject channel = jsonChannel(after, 6);
+    QCOMPARE(channel.value("signalAnt").toString(), QStringLiteral("30"));
+    QCOMPARE(channel.value("multipathNum").toString(), QStringLiteral("1"));
+    // 未修改的信道沿用缓存片段
+    QCOMPARE(jsonChannel(after, 5), jsonChannel(before, 5));
+
+    // 保存的是新内容
+    QCOMPARE(builder.channelParamReport(QStringLiteral("42"), &changed), after);
+    QVERIFY(!changed);
+}
+
+void TestReportBuilder::sameContentNotChanged()
+{
+    ChannelCacheManager *cache = ChannelCacheManager::instance();
+    ReportBuilder builder;
+    bool changed = false;
+    QByteArray before = builder.channelParamReport(QStringLiteral("42"), &changed);
+    quint64 generation = cache->generation();
+
+    // 开关来回切换：代数变化，内容不变
+    ChannelSetting setting;
+    QVERIFY(cache->getChannelSetting(7, &setting));
+    cache->updateChannelSwitch(7, !setting.switchFlag);
+    cache->updateChannelSwitch(7, setting.switchFlag);
+    QVERIFY(cache->generation() != generation);
+    QCOMPARE(builder.channelParamReport(QStringLiteral("42"), &changed), before);
+    QVERIFY(!changed);
+
+    // 用相同参数恢复：代数变化，内容不变
+    cache->restoreSettings(cache->getAllChannelSettings());
+    QCOMPARE(builder.channelParamReport(QStringLiteral("42"), &changed), before);
+    QVERIFY(!changed);
+}
+
+void TestReportBuilder::examIdAndInvalidateRebuild()
+{
+    ReportBuilder builder;
+    bool changed = false;
+    builder.channelParamReport(QStringLiteral("42"), &changed);
+
+    QByteArray other = builder.channelParamReport(QStringLiteral("43"), &changed);
+    QVERIFY(changed);
+    QCOMPARE(QJsonDocument::fromJson(other).object().value("ExamID").toString(), QStringLiteral("43"));
+
+    // 清除缓存后内容相同也按变化上报
+    builder.invalidate();
+    QCOMPARE(builder.channelParamReport(QStringLiteral("43"), &changed), other);
+    QVERIFY(changed);
+}
+
+QTEST_GUILESS_MAIN(TestReportBuilder)
+
+#include "tst_reportbuilder.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_rtprofile
+
+SOURCES += \
+    tst_rtprofile.cpp
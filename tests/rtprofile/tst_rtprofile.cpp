@@ -0,0 +1,135 @@
+#include <QtTest>
+#include <QSettings>
+#include <QTemporaryDir>
+#include "rtprofile.h"
+
+// RtProfile配置读取及JitterHistogram统计测试
+class TestRtProfile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultsWhenMissing();
+    void loadClampsValues();
+    void lockMemoryOnlyWhenEnabled();
+    void emptyHistogram();
+    void percentiles();
+    void coarseBuckets();
+    void resetClears();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void TestRtProfile::defaultsWhenMissing()
+{
+    RtProfile profile = RtProfile::load(m_dir.filePath("missing.ini"));
+    QVERIFY(!profile.enabled);
+    QVERIFY(!profile.jitterMode());
+    QCOMPARE(profile.cpu, -1);
+}
+
+void TestRtProfile::loadClampsValues()
+{
+    QString path = m_dir.filePath("ChannelSettings.ini");
+    {
+        QSettings settings(path, QSettings::IniFormat);
+        settings.setValue("General/Domain", "127.0.0.1");
+        settings.beginGroup("Realtime");
+        settings.setValue("Enabled", true);
+        settings.setValue("Priority", 150);
+        settings.setValue("Cpu", 3);
+        settings.setValue("LockMemory", false);
+        settings.setValue("StackPrefaultKb", 100000);
+        settings.setValue("JitterPeriodUs", 10);
+        settings.setValue("JitterReportSec", 0);
+        settings.endGroup();
+    }
+
+    RtProfile profile = RtProfile::load(path);
+    QVERIFY(profile.enabled);
+    QCOMPARE(profile.priority, int(RtProfile::MAX_PRIORITY));
+    QCOMPARE(profile.cpu, 3);
+    QVERIFY(!profile.lockMemory);
+    QCOMPARE(profile.stackPrefaultKb, int(RtProfile::MAX_STACK_PREFAULT_KB));
+    QCOMPARE(profile.jitterPeriodUs, int(RtProfile::MIN_JITTER_PERIOD_US));
+    QCOMPARE(profile.jitterReportSec, 1);
+}
+
+void TestRtProfile::lockMemoryOnlyWhenEnabled()
+{
+    // 未启用或未开LockMemory时不调用mlockall，不影响测试进程
+    QStringList errors;
+    RtProfile disabled;
+    QVERIFY(disabled.lockProcessMemory(&errors));
+    RtProfile noLock;
+    noLock.enabled = true;
+    noLock.lockMemory = false;
+    QVERIFY(noLock.lockProcessMemory(&errors));
+    QVERIFY(errors.isEmpty());
+}
+
+void TestRtProfile::emptyHistogram()
+{
+    JitterHistogram histogram;
+    JitterStats stats = histogram.stats();
+    QCOMPARE(stats.count, quint64(0));
+    QCOMPARE(stats.maxUs, qint64(0));
+}
+
+void TestRtProfile::percentiles()
+{
+    JitterHistogram histogram;
+    // 0~99us各10次
+    for (int i = 0; i < 1000; i++) {
+        histogram.record(i % 100);
+    }
+    histogram.record(-5);       // 时钟误差导致的负值按0计
+    histogram.recordOverrun();
+
+    JitterStats stats = histogram.stats();
+    QCOMPARE(stats.count, quint64(1001));
+    QCOMPARE(stats.overruns, quint64(1));
+    QCOMPARE(stats.minUs, qint64(0));
+    QCOMPARE(stats.maxUs, qint64(99));
+    QCOMPARE(stats.avgUs, qint64(49));
+    QCOMPARE(stats.p50Us, qint64(49));
+    QCOMPARE(stats.p99Us, qint64(98));
+    QCOMPARE(stats.p999Us, qint64(99));
+}
+
+void TestRtProfile::coarseBuckets()
+{
+    JitterHistogram histogram;
+    for (int i = 0; i < 998; i++) {
+        histogram.record(10);
+    }
+    histogram.record(1234);
+    histogram.record(50000);
+
+    JitterStats stats = histogram.stats();
+    QCOMPARE(stats.p50Us, qint64(10));
+    // 1234us落在1200~1299us一档
+    QCOMPARE(stats.p999Us, qint64(1299));
+    // 超出范围的计入最后一档，最大值保留原值
+    QCOMPARE(stats.maxUs, qint64(50000));
+}
+
+void TestRtProfile::resetClears()
+{
+    JitterHistogram histogram;
+    histogram.record(500);
+    histogram.recordOverrun();
+    histogram.reset();
+    histogram.record(7);
+
+    JitterStats stats = histogram.stats();
+    QCOMPARE(stats.count, quint64(1));
+    QCOMPARE(stats.overruns, quint64(0));
+    QCOMPARE(stats.minUs, qint64(7));
+    QCOMPARE(stats.p99Us, qint64(7));
+}
+
+QTEST_GUILESS_MAIN(TestRtProfile)
+
+#include "tst_rtprofile.moc"
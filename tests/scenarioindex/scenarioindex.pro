@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_scenarioindex
+
+SOURCES += \
+    tst_scenarioindex.cpp
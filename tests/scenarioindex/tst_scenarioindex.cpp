@@ -0,0 +1,162 @@
+#include <QtTest>
+#include "scenarioindex.h"
+
+// ScenarioIndex功能测试
+class TestScenarioIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void duplicateNameIgnored();
+    void prefixSearch();
+    void substringSearch();
+    void rangeFilters();
+    void removeShiftsPositions();
+    void insertKeepsSortedIndex();
+    void updateKeepsPosition();
+
+private:
+    static ScenarioSummary makeSummary(const QString &name, int channel, int paths, int doppler);
+    QStringList names(const QVector<int> &positions) const;
+
+    ScenarioIndex m_index;
+};
+
+ScenarioSummary TestScenarioIndex::makeSummary(const QString &name, int channel, int paths, int doppler)
+{
+    ScenarioSummary summary;
+    summary.modelName = name;
+    summary.channelNum = channel;
+    summary.multipathNum = paths;
+    summary.maxDoppler = doppler;
+    return summary;
+}
+
+QStringList TestScenarioIndex::names(const QVector<int> &positions) const
+{
+    QStringList result;
+    for (int position : positions) {
+        result << m_index.summary(position).modelName;
+    }
+    return result;
+}
+
+void TestScenarioIndex::init()
+{
+    m_index.reset({
+        makeSummary("Sky-1", 1, 2, 10),
+        makeSummary("ground", 3, 1, 0),
+        makeSummary("sky-2", 5, 4, 40),
+        makeSummary("Sea", 3, 3, 25),
+        makeSummary("skywave", 12, 6, 100),
+    });
+}
+
+void TestScenarioIndex::duplicateNameIgnored()
+{
+    QCOMPARE(m_index.size(), 5);
+    QVERIFY(!m_index.insert(makeSummary("Sea", 9, 9, 9)));
+    QCOMPARE(m_index.summary(m_index.indexOf("Sea")).channelNum, 3);
+
+    m_index.reset({makeSummary("a", 1, 1, 1), makeSummary("a", 2, 2, 2)});
+    QCOMPARE(m_index.size(), 1);
+    QCOMPARE(m_index.summary(0).channelNum, 1);
+}
+
+void TestScenarioIndex::prefixSearch()
+{
+    ScenarioQuery query;
+    query.text = "SKY";
+    query.prefixOnly = true;
+    // 不区分大小写，结果按添加顺序
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sky-1", "sky-2", "skywave"}));
+
+    query.text = "sky-";
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sky-1", "sky-2"}));
+
+    query.text = "z";
+    QVERIFY(m_index.search(query).isEmpty());
+}
+
+void TestScenarioIndex::substringSearch()
+{
+    ScenarioQuery query;
+    query.text = "E";
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sea", "skywave"}));
+
+    QVERIFY(query.prefixOnly == false);
+    QVERIFY(m_index.matches(m_index.indexOf("skywave"), query));
+    QVERIFY(!m_index.matches(m_index.indexOf("ground"), query));
+
+    // 空条件匹配全部
+    QVERIFY(ScenarioQuery().isEmpty());
+    QCOMPARE(m_index.search(ScenarioQuery()).size(), 5);
+}
+
+void TestScenarioIndex::rangeFilters()
+{
+    ScenarioQuery query;
+    query.channelNum.setMin(3);
+    query.channelNum.setMax(5);
+    QCOMPARE(names(m_index.search(query)), QStringList({"ground", "sky-2", "Sea"}));
+
+    query.multipathNum.setMin(3);
+    QCOMPARE(names(m_index.search(query)), QStringList({"sky-2", "Sea"}));
+
+    query.maxDoppler.setMax(30);
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sea"}));
+
+    // 名称条件与范围条件同时生效
+    query = ScenarioQuery();
+    query.text = "sky";
+    query.prefixOnly = true;
+    query.maxDoppler.setMin(40);
+    QCOMPARE(names(m_index.search(query)), QStringList({"sky-2", "skywave"}));
+}
+
+void TestScenarioIndex::removeShiftsPositions()
+{
+    QCOMPARE(m_index.remove("ground"), 1);
+    QCOMPARE(m_index.remove("ground"), -1);
+    QCOMPARE(m_index.size(), 4);
+    QCOMPARE(m_index.indexOf("sky-2"), 1);
+    QCOMPARE(m_index.indexOf("skywave"), 3);
+    QVERIFY(!m_index.contains("ground"));
+
+    ScenarioQuery query;
+    query.text = "s";
+    query.prefixOnly = true;
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sky-1", "sky-2", "Sea", "skywave"}));
+}
+
+void TestScenarioIndex::insertKeepsSortedIndex()
+{
+    QVERIFY(m_index.insert(makeSummary("Skyline", 2, 2, 5)));
+    QVERIFY(m_index.insert(makeSummary("abc", 2, 2, 5)));
+    QCOMPARE(m_index.indexOf("abc"), 6);
+
+    ScenarioQuery query;
+    query.text = "sky";
+    query.prefixOnly = true;
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sky-1", "sky-2", "skywave", "Skyline"}));
+
+    query.text = "ab";
+    QCOMPARE(names(m_index.search(query)), QStringList({"abc"}));
+}
+
+void TestScenarioIndex::updateKeepsPosition()
+{
+    QVERIFY(m_index.update(makeSummary("Sea", 7, 8, 90)));
+    QVERIFY(!m_index.update(makeSummary("missing", 1, 1, 1)));
+    QCOMPARE(m_index.indexOf("Sea"), 3);
+    QCOMPARE(m_index.summary(3).channelNum, 7);
+
+    ScenarioQuery query;
+    query.channelNum.setMin(7);
+    QCOMPARE(names(m_index.search(query)), QStringList({"Sea", "skywave"}));
+}
+
+QTEST_GUILESS_MAIN(TestScenarioIndex)
+
+#include "tst_scenarioindex.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_scenariolibrary
+
+SOURCES += \
+    tst_scenariolibrary.cpp
@@ -0,0 +1,190 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "scenariolibrary.h"
+#include "testutil.h"
+
+// ScenarioLibrary完整场景LRU缓存测试
+// 绕过场景库直接删除数据库中的行：缓存命中的场景仍能取到，已淘汰的场景取不到
+class TestScenarioLibrary : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void loadReadsSummariesOnly();
+    void fetchCachesScenario();
+    void evictsLeastRecentlyUsed();
+    void shrinkEvicts();
+    void staysBoundedPastCapacity();
+    void saveAndRemoveUpdateCache();
+    void unknownNameNotLoaded();
+
+private:
+
+    QTemporaryDir m_dir;
+    int m_dbIndex = 0;
+    DatabaseManager *m_db = nullptr;
+    ScenarioLibrary *m_library = nullptr;
+};
+
+void TestScenarioLibrary::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestScenarioLibrary::init()
+{
+    // 每个用例使用新的数据库文件
+    m_db = new DatabaseManager;
+    QVERIFY(m_db->openDatabase(m_dir.filePath(QString("library%1.db").arg(m_dbIndex++))));
+    QVERIFY(m_db->createTable());
+    QVERIFY(m_db->insertParaConfigs({TestUtil::makeConfig("a", 1, 1), TestUtil::makeConfig("b", 2, 2),
+                                     TestUtil::makeConfig("c", 3, 3), TestUtil::makeConfig("d", 4, 4)}));
+
+    m_library = new ScenarioLibrary(m_db);
+    m_library->setCacheSize(2);
+    m_library->load();
+}
+
+void TestScenarioLibrary::cleanup()
+{
+    delete m_library;
+    m_library = nullptr;
+    delete m_db;
+    m_db = nullptr;
+}
+
+void TestScenarioLibrary::loadReadsSummariesOnly()
+{
+    QVector<ScenarioSummary> summaries = m_library->summaries();
+    QCOMPARE(summaries.size(), 4);
+    QCOMPARE(summaries[2].modelName, QString("c"));
+    QCOMPARE(summaries[2].channelNum, 3);
+    QCOMPARE(summaries[2].maxDoppler, 30);
+    QVERIFY(m_library->contains("d"));
+    QCOMPARE(m_library->cachedCount(), 0);
+    QVERIFY(!m_library->isCacheCurrent());
+}
+
+void TestScenarioLibrary::fetchCachesScenario()
+{
+    ModelParaSetting config;
+    QVERIFY(m_library->scenario("b", &config));
+    QCOMPARE(config.channelNum, 2);
+    QCOMPARE(config.multipathType.size(), 2);
+    QCOMPARE(config.multipathType[1].relativDelay, 200);
+    QCOMPARE(m_library->cachedCount(), 1);
+
+    // 再次读取命中缓存，不访问数据库
+    QVERIFY(m_db->deleteParaConfig("b"));
+    QVERIFY(m_library->scenario("b", &config));
+    QCOMPARE(config.channelNum, 2);
+    QCOMPARE(m_library->cachedCount(), 1);
+}
+
+void TestScenarioLibrary::evictsLeastRecentlyUsed()
+{
+    QVERIFY(m_library->scenario("a", nullptr));
+    QVERIFY(m_library->scenario("b", nullptr));
+    // 再次访问a，b成为最久未使用
+    QVERIFY(m_library->scenario("a", nullptr));
+    QVERIFY(m_library->scenario("c", nullptr));
+    QCOMPARE(m_library->cachedCount(), 2);
+
+    QVERIFY(m_db->deleteParaConfigs({"a", "b", "c"}));
+    QVERIFY(m_library->scenario("a", nullptr));
+    QVERIFY(m_library->scenario("c", nullptr));
+    QVERIFY(!m_library->scenario("b", nullptr));
+}
+
+void TestScenarioLibrary::shrinkEvicts()
+{
+    m_library->setCacheSize(4);
+    for (const char *name : {"a", "b", "c", "d"}) {
+        QVERIFY(m_library->scenario(name, nullptr));
+    }
+    QCOMPARE(m_library->cachedCount(), 4);
+
+    // 缩小后只保留最近使用的一个
+    m_library->setCacheSize(1);
+    QCOMPARE(m_library->cachedCount(), 1);
+    QVERIFY(m_db->deleteParaConfigs({"c", "d"}));
+    QVERIFY(m_library->scenario("d", nullptr));
+    QVERIFY(!m_library->scenario("c", nullptr));
+
+    // 上限至少为1
+    m_library->setCacheSize(0);
+    QCOMPARE(m_library->cachedCount(), 1);
+}
+
+void TestScenarioLibrary::staysBoundedPastCapacity()
+{
+    QVector<ModelParaSetting> configs;
+    for (int i = 0; i < 40; i++) {
+        configs.append(TestUtil::makeConfig(QString("extra%1").arg(i), i % 15 + 1));
+    }
+    QVERIFY(m_db->insertParaConfigs(configs));
+    m_library->setCacheSize(8);
+    m_library->load();
+
+    // 读取远超缓存上限的场景，完整参数只保留最近使用的8个
+    QVector<ScenarioSummary> summaries = m_library->summaries();
+    QCOMPARE(summaries.size(), 44);
+    for (const ScenarioSummary &summary : summaries) {
+        ModelParaSetting config;
+        QVERIFY(m_library->scenario(summary.modelName, &config));
+        QCOMPARE(config.channelNum, summary.channelNum);
+        QVERIFY(m_library->cachedCount() <= 8);
+    }
+    QCOMPARE(m_library->cachedCount(), 8);
+
+    // 保存同样只进入缓存
+    QVERIFY(m_library->save(TestUtil::makeConfig("saved", 3)));
+    QCOMPARE(m_library->cachedCount(), 8);
+}
+
+void TestScenarioLibrary::saveAndRemoveUpdateCache()
+{
+    // ScenarioSummary未注册元类型，保存信号用计数代替QSignalSpy
+    int savedCount = 0;
+    connect(m_library, &ScenarioLibrary::scenarioSaved, this, [&savedCount]() { savedCount++; });
+    QSignalSpy removed(m_library, &ScenarioLibrary::scenarioRemoved);
+
+    // 同名覆盖：摘要移到末尾，缓存中为新参数
+    QVERIFY(m_library->scenario("a", nullptr));
+    QVERIFY(m_library->save(TestUtil::makeConfig("a", 9)));
+    QCOMPARE(savedCount, 1);
+    QVector<ScenarioSummary> summaries = m_library->summaries();
+    QCOMPARE(summaries.size(), 4);
+    QCOMPARE(summaries.last().modelName, QString("a"));
+    QCOMPARE(summaries.last().channelNum, 9);
+    QCOMPARE(m_library->cachedCount(), 1);
+    ModelParaSetting config;
+    QVERIFY(m_library->scenario("a", &config));
+    QCOMPARE(config.channelNum, 9);
+
+    QVERIFY(m_library->remove("a"));
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(removed.first().first().toString(), QString("a"));
+    QCOMPARE(m_library->cachedCount(), 0);
+    QVERIFY(!m_library->contains("a"));
+    QVERIFY(!m_library->scenario("a", nullptr));
+    QVERIFY(!m_library->remove("a"));
+}
+
+void TestScenarioLibrary::unknownNameNotLoaded()
+{
+    // 不在摘要中的名称不查询数据库
+    QVERIFY(m_db->insertParaConfig(TestUtil::makeConfig("late", 5)));
+    QVERIFY(!m_library->scenario("late", nullptr));
+    QCOMPARE(m_library->cachedCount(), 0);
+
+    m_library->load();
+    QVERIFY(m_library->scenario("late", nullptr));
+}
+
+QTEST_GUILESS_MAIN(TestScenarioLibrary)
+
+#include "tst_scenariolibrary.moc"
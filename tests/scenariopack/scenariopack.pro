@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_scenariopack
+
+SOURCES += \
+    tst_scenariopack.cpp
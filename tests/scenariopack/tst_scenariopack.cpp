@@ -0,0 +1,229 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <cstddef>
+#include <cstring>
+#include "scenariopack.h"
+#include "iohandler.h"
+#include "testutil.h"
+
+// ScenarioPack写出/映射读取及损坏文件拒绝测试
+class TestScenarioPack : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void roundTrip();
+    void nameLookup();
+    void importAutoDetect();
+    void rejectTruncated();
+    void rejectBadMagic();
+    void rejectWrongVersion();
+    void rejectOverflowingOffset();
+    void rejectOutOfRangeRecord();
+    void rejectUnalignedProgram();
+
+private:
+    static PackHeader readHeader(const QString &filePath);
+    // 复制source后在offset处覆写value，返回新文件路径
+    template <typename T>
+    QString patchedCopy(const QString &source, const QString &name, qint64 offset, T value);
+    QString expectOpenFails(const QString &filePath);
+
+    QTemporaryDir m_dir;
+    QString m_packPath;
+    QString m_noProgramPath;    // 不含寄存器程序的场景库
+    QVector<ModelParaSetting> m_configs;
+};
+
+PackHeader TestScenarioPack::readHeader(const QString &filePath)
+{
+    PackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+    return header;
+}
+
+template <typename T>
+QString TestScenarioPack::patchedCopy(const QString &sourcePath, const QString &name, qint64 offset, T value)
+{
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    QByteArray data = source.readAll();
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+
+    QString path = m_dir.filePath(name);
+    QFile target(path);
+    if (!target.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    target.write(data);
+    return path;
+}
+
+QString TestScenarioPack::expectOpenFails(const QString &filePath)
+{
+    ScenarioPack pack;
+    QString error;
+    bool opened = pack.open(filePath, &error);
+    return opened ? QString() : error;
+}
+
+void TestScenarioPack::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_configs << TestUtil::makeConfig("urban-3", 3, 3)
+              << TestUtil::makeConfig("城市多径", 5, 6)
+              << TestUtil::makeConfig("free", 1, 0);
+
+    QHash<QString, QVector<quint32>> programs;
+    programs.insert("城市多径", QVector<quint32>() << 0x11 << 0x22 << 0x33);
+
+    m_packPath = m_dir.filePath("scenarios.cspk");
+    QString error;
+    QVERIFY2(ScenarioPack::write(m_packPath, m_configs, 42, programs, &error), qPrintable(error));
+
+    m_noProgramPath = m_dir.filePath("noprogram.cspk");
+    QVERIFY2(ScenarioPack::write(m_noProgramPath, m_configs, 0, QHash<QString, QVector<quint32>>(), &error),
+             qPrintable(error));
+}
+
+void TestScenarioPack::roundTrip()
+{
+    ScenarioPack pack;
+    QString error;
+    QVERIFY2(pack.open(m_packPath, &error), qPrintable(error));
+    QCOMPARE(pack.count(), m_configs.size());
+    QCOMPARE(pack.sourceRevision(), quint64(42));
+
+    for (int i = 0; i < m_configs.size(); i++) {
+        const ModelParaSetting &expected = m_configs.at(i);
+        ModelParaSetting actual = pack.scenario(i);
+        QCOMPARE(actual.modelName, expected.modelName);
+        QCOMPARE(actual.channelNum, expected.channelNum);
+        QCOMPARE(actual.modelType, expected.modelType);
+        QCOMPARE(actual.noisePower, expected.noisePower);
+        QCOMPARE(actual.signalAnt, expected.signalAnt);
+        QCOMPARE(actual.comDistance, expected.comDistance);
+        QCOMPARE(actual.multipathNum, expected.multipathNum);
+        QCOMPARE(actual.filterNum, expected.filterNum);
+        QCOMPARE(actual.multipathType.size(), expected.multipathType.size());
+        for (int p = 0; p < expected.multipathType.size(); p++) {
+            QCOMPARE(actual.multipathType[p].relativDelay, expected.multipathType[p].relativDelay);
+            QCOMPARE(actual.multipathType[p].antPower, expected.multipathType[p].antPower);
+            QCOMPARE(actual.multipathType[p].dopplerType, expected.multipathType[p].dopplerType);
+        }
+    }
+
+    int words = -1;
+    const quint32 *program = pack.program(1, &words);
+    QCOMPARE(words, 3);
+    QVERIFY(program);
+    QCOMPARE(program[2], quint32(0x33));
+    QVERIFY(!pack.program(0, &words));
+    QCOMPARE(words, 0);
+
+    QVERIFY(!pack.record(-1));
+    QVERIFY(!pack.record(pack.count()));
+}
+
+void TestScenarioPack::nameLookup()
+{
+    ScenarioPack pack;
+    QVERIFY(pack.open(m_packPath));
+    for (int i = 0; i < m_configs.size(); i++) {
+        QCOMPARE(pack.indexOf(m_configs.at(i).modelName), i);
+    }
+    QCOMPARE(pack.indexOf("urban"), -1);
+    QCOMPARE(pack.indexOf("urban-30"), -1);
+    QCOMPARE(pack.indexOf(QString()), -1);
+    QCOMPARE(pack.nameUtf8(1), QString("城市多径").toUtf8());
+}
+
+void TestScenarioPack::importAutoDetect()
+{
+    // 按扩展名识别场景库，单场景导入取第一个场景
+    IOHandler handler;
+    QString error;
+    ModelParaSetting config = handler.importDataAutoDetect(m_packPath, &error);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(config.modelName, QString("urban-3"));
+    QCOMPARE(config.multipathType.size(), 3);
+}
+
+void TestScenarioPack::rejectTruncated()
+{
+    QFile source(m_packPath);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QByteArray data = source.readAll();
+
+    QString path = m_dir.filePath("truncated.cspk");
+    QFile target(path);
+    QVERIFY(target.open(QIODevice::WriteOnly));
+    target.write(data.left(data.size() - 8));
+    target.close();
+    QVERIFY(!expectOpenFails(path).isEmpty());
+
+    // 不足一个文件头
+    QVERIFY(target.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    target.write(data.left(16));
+    target.close();
+    QVERIFY(!expectOpenFails(path).isEmpty());
+}
+
+void TestScenarioPack::rejectBadMagic()
+{
+    QString path = patchedCopy(m_packPath, "magic.cspk", offsetof(PackHeader, magic), quint32(0x12345678));
+    QVERIFY(!expectOpenFails(path).isEmpty());
+}
+
+void TestScenarioPack::rejectWrongVersion()
+{
+    QString path = patchedCopy(m_packPath, "version.cspk", offsetof(PackHeader, version), quint16(SCENARIO_PACK_VERSION + 1));
+    QVERIFY(expectOpenFails(path).contains(QString::number(SCENARIO_PACK_VERSION + 1)));
+}
+
+void TestScenarioPack::rejectOverflowingOffset()
+{
+    // offset + count * size按64位回绕后会小于文件大小
+    quint64 wrapping = ~quint64(0) - 15;
+    QString path = patchedCopy(m_packPath, "offset.cspk", offsetof(PackHeader, scenarioOffset), wrapping);
+    QVERIFY(!expectOpenFails(path).isEmpty());
+
+    path = patchedCopy(m_packPath, "string.cspk", offsetof(PackHeader, stringOffset), wrapping);
+    QVERIFY(!expectOpenFails(path).isEmpty());
+}
+
+void TestScenarioPack::rejectOutOfRangeRecord()
+{
+    qint64 scenarioOffset = static_cast<qint64>(readHeader(m_packPath).scenarioOffset);
+
+    // 第一个场景的多径数超出路径区
+    qint64 offset = scenarioOffset + offsetof(PackScenarioRecord, pathCount);
+    QString path = patchedCopy(m_packPath, "record.cspk", offset, quint32(1000));
+    QVERIFY(!expectOpenFails(path).isEmpty());
+
+    // 名称超出字符串区
+    offset = scenarioOffset + offsetof(PackScenarioRecord, nameLength);
+    path = patchedCopy(m_packPath, "name.cspk", offset, quint32(0xFFFFFFFF));
+    QVERIFY(!expectOpenFails(path).isEmpty());
+}
+
+void TestScenarioPack::rejectUnalignedProgram()
+{
+    // 无程序时区段长度为0，前移1字节仍在文件内，只有对齐检查能拒绝
+    quint64 programOffset = readHeader(m_noProgramPath).programOffset;
+    QVERIFY(programOffset % 8 == 0);
+    QString path = patchedCopy(m_noProgramPath, "program.cspk", offsetof(PackHeader, programOffset),
+                               quint64(programOffset - 1));
+    QVERIFY(expectOpenFails(path).contains("对齐"));
+}
+
+QTEST_GUILESS_MAIN(TestScenarioPack)
+
+#include "tst_scenariopack.moc"
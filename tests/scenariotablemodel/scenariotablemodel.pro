@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_scenariotablemodel
+
+SOURCES += \
+    tst_scenariotablemodel.cpp
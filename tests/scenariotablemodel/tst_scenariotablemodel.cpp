@@ -0,0 +1,157 @@
+#include <QtTest>
+#include <QAbstractItemModelTester>
+#include "scenariotablemodel.h"
+
+// ScenarioTableModel及排序/过滤代理测试，模型操作全部经过QAbstractItemModelTester检查
+class TestScenarioTableModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void modelTesterAcceptsOperations();
+    void removeMergesContiguousRows();
+    void removeIgnoresInvalidRows();
+    void proxyRowNumbering();
+
+private:
+    static ScenarioSummary makeSummary(const QString &name, int channel);
+    QStringList names() const;
+
+    ScenarioTableModel m_model;
+};
+
+ScenarioSummary TestScenarioTableModel::makeSummary(const QString &name, int channel)
+{
+    ScenarioSummary summary;
+    summary.modelName = name;
+    summary.channelNum = channel;
+    summary.multipathNum = channel % 4;
+    summary.noisePower = channel * 1.5;
+    summary.signalAnt = channel * 2.0;
+    return summary;
+}
+
+QStringList TestScenarioTableModel::names() const
+{
+    QStringList result;
+    for (int row = 0; row < m_model.rowCount(); row++) {
+        result << m_model.summary(row).modelName;
+    }
+    return result;
+}
+
+void TestScenarioTableModel::init()
+{
+    // r0..r9，信道号与行号相反
+    QVector<ScenarioSummary> summaries;
+    for (int i = 0; i < 10; i++) {
+        summaries.append(makeSummary(QString("r%1").arg(i), 10 - i));
+    }
+    m_model.setSummaries(summaries);
+}
+
+void TestScenarioTableModel::modelTesterAcceptsOperations()
+{
+    ScenarioFilterProxyModel proxy;
+    proxy.setSourceModel(&m_model);
+    proxy.sort(ScenarioTableModel::ChannelColumn);
+    QAbstractItemModelTester modelTester(&m_model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    QAbstractItemModelTester proxyTester(&proxy, QAbstractItemModelTester::FailureReportingMode::QtTest);
+
+    m_model.append(makeSummary("single", 20));
+    m_model.append(QVector<ScenarioSummary>({makeSummary("batch1", 21), makeSummary("batch2", 22)}));
+    m_model.append(QVector<ScenarioSummary>());
+    QCOMPARE(m_model.rowCount(), 13);
+    m_model.removeSummaries({12, 0, 5, 6});
+    QCOMPARE(m_model.rowCount(), 9);
+    proxy.setFilterFixedString("batch");
+    QCOMPARE(proxy.rowCount(), 1);
+    proxy.setFilterFixedString(QString());
+    m_model.clear();
+    QCOMPARE(m_model.rowCount(), 0);
+    QCOMPARE(proxy.rowCount(), 0);
+}
+
+void TestScenarioTableModel::removeMergesContiguousRows()
+{
+    QSignalSpy spy(&m_model, &QAbstractItemModel::rowsAboutToBeRemoved);
+
+    // 乱序且有重复，合并为[7,8]和[1,3]两次通知，从后往前删除
+    m_model.removeSummaries({7, 2, 8, 3, 1, 3});
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(0).at(1).toInt(), 7);
+    QCOMPARE(spy.at(0).at(2).toInt(), 8);
+    QCOMPARE(spy.at(1).at(1).toInt(), 1);
+    QCOMPARE(spy.at(1).at(2).toInt(), 3);
+    QCOMPARE(names(), QStringList({"r0", "r4", "r5", "r6", "r9"}));
+
+    // 单行
+    spy.clear();
+    m_model.removeSummaries({4});
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(names(), QStringList({"r0", "r4", "r5", "r6"}));
+
+    // 全部删除为一次通知
+    spy.clear();
+    m_model.removeSummaries({3, 2, 1, 0});
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(m_model.rowCount(), 0);
+}
+
+void TestScenarioTableModel::removeIgnoresInvalidRows()
+{
+    QSignalSpy spy(&m_model, &QAbstractItemModel::rowsAboutToBeRemoved);
+
+    // 越界行号与相邻的有效行号不合并，有效行照常删除
+    m_model.removeSummaries({-1, 0, 9, 10, 42});
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(names(), QStringList({"r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8"}));
+
+    spy.clear();
+    m_model.removeSummaries({-3, 8, 100});
+    QCOMPARE(spy.count(), 0);
+    m_model.removeSummaries({});
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(m_model.rowCount(), 8);
+}
+
+void TestScenarioTableModel::proxyRowNumbering()
+{
+    ScenarioFilterProxyModel proxy;
+    proxy.setSourceModel(&m_model);
+
+    // 源模型序号为行号+1，排序值为行号
+    QCOMPARE(m_model.data(m_model.index(3, ScenarioTableModel::IndexColumn)).toInt(), 4);
+    QCOMPARE(m_model.data(m_model.index(3, ScenarioTableModel::IndexColumn), ScenarioTableModel::SortRole).toInt(), 3);
+    QCOMPARE(m_model.data(m_model.index(3, ScenarioTableModel::NoiseColumn)).toString(), QStringLiteral("10.50"));
+
+    // 按信道号升序：顺序反转，序号仍从1连续
+    proxy.sort(ScenarioTableModel::ChannelColumn, Qt::AscendingOrder);
+    QCOMPARE(proxy.rowCount(), 10);
+    for (int row = 0; row < proxy.rowCount(); row++) {
+        QCOMPARE(proxy.data(proxy.index(row, ScenarioTableModel::IndexColumn)).toInt(), row + 1);
+        QCOMPARE(proxy.data(proxy.index(row, ScenarioTableModel::NameColumn)).toString(), QString("r%1").arg(9 - row));
+    }
+
+    // 过滤后按代理行号重新编号，不区分大小写
+    m_model.append(makeSummary("R-extra", 11));
+    proxy.setFilterFixedString("r1");
+    QCOMPARE(proxy.rowCount(), 1);
+    QCOMPARE(proxy.data(proxy.index(0, ScenarioTableModel::IndexColumn)).toInt(), 1);
+    proxy.setFilterFixedString("R-");
+    QCOMPARE(proxy.rowCount(), 1);
+    QCOMPARE(proxy.data(proxy.index(0, ScenarioTableModel::NameColumn)).toString(), QStringLiteral("R-extra"));
+
+    // 源模型删除后代理序号仍连续
+    proxy.setFilterFixedString(QString());
+    m_model.removeSummaries({0, 1, 2});
+    QCOMPARE(proxy.rowCount(), 8);
+    for (int row = 0; row < proxy.rowCount(); row++) {
+        QCOMPARE(proxy.data(proxy.index(row, ScenarioTableModel::IndexColumn)).toInt(), row + 1);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestScenarioTableModel)
+
+#include "tst_scenariotablemodel.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_telemetry
+
+SOURCES += \
+    tst_telemetry.cpp
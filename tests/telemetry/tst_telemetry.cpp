@@ -0,0 +1,145 @@
+#include <QtTest>
+#include <QScopedPointer>
+#include "telemetryservice.h"
+
+// TelemetryRing时间窗口查询及TelemetryService::decimate抽取测试
+class TestTelemetry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void ringEmpty();
+    void ringSinceWindow();
+    void ringSinceAfterWrap();
+    void decimateInvalidArgs();
+    void decimateBuckets();
+    void decimateDropsOutOfRange();
+
+private:
+    static TelemetrySample makeSample(qint64 timeNs, float powerDb, quint32 lowAdc, bool tx);
+};
+
+TelemetrySample TestTelemetry::makeSample(qint64 timeNs, float powerDb, quint32 lowAdc, bool tx)
+{
+    TelemetrySample sample;
+    sample.timeNs = timeNs;
+    sample.powerDb = powerDb;
+    sample.lowAdc = lowAdc;
+    sample.tx = tx;
+    return sample;
+}
+
+void TestTelemetry::ringEmpty()
+{
+    QScopedPointer<TelemetryRing> ring(new TelemetryRing());
+    QVERIFY(ring->since(0).isEmpty());
+}
+
+void TestTelemetry::ringSinceWindow()
+{
+    QScopedPointer<TelemetryRing> ring(new TelemetryRing());
+    for (int i = 0; i < 100; i++) {
+        ring->push(makeSample(i * 10, i, i, false));
+    }
+
+    // 窗口起点落在采样时刻上时包含该采样
+    QVector<TelemetrySample> result = ring->since(500);
+    QCOMPARE(result.size(), 50);
+    QCOMPARE(result.first().timeNs, qint64(500));
+    QCOMPARE(result.last().timeNs, qint64(990));
+    for (int i = 1; i < result.size(); i++) {
+        QVERIFY(result[i - 1].timeNs < result[i].timeNs);
+    }
+
+    // 起点在两次采样之间
+    QCOMPARE(ring->since(505).first().timeNs, qint64(510));
+    QCOMPARE(ring->since(0).size(), 100);
+    QVERIFY(ring->since(1000).isEmpty());
+}
+
+void TestTelemetry::ringSinceAfterWrap()
+{
+    QScopedPointer<TelemetryRing> ring(new TelemetryRing());
+    const int extra = 100;
+    const int total = static_cast<int>(TelemetryRing::CAPACITY) + extra;
+    for (int i = 0; i < total; i++) {
+        ring->push(makeSample(i, 0, i, false));
+    }
+
+    // 绕回后只保留最近CAPACITY个采样
+    QVector<TelemetrySample> result = ring->since(0);
+    QCOMPARE(result.size(), static_cast<int>(TelemetryRing::CAPACITY));
+    QCOMPARE(result.first().timeNs, qint64(extra));
+    QCOMPARE(result.last().timeNs, qint64(total - 1));
+
+    result = ring->since(total - 10);
+    QCOMPARE(result.size(), 10);
+    QCOMPARE(result.first().lowAdc, quint32(total - 10));
+}
+
+void TestTelemetry::decimateInvalidArgs()
+{
+    QVector<TelemetrySample> samples;
+    samples.append(makeSample(10, 0, 0, false));
+    QVERIFY(TelemetryService::decimate(samples, 0, 100, 0).isEmpty());
+    QVERIFY(TelemetryService::decimate(samples, 100, 100, 4).isEmpty());
+    QVERIFY(TelemetryService::decimate(samples, 100, 0, 4).isEmpty());
+}
+
+void TestTelemetry::decimateBuckets()
+{
+    // [0,400)等分为4个桶，第3个桶无数据
+    QVector<TelemetrySample> samples;
+    samples.append(makeSample(0, -10, 100, true));
+    samples.append(makeSample(50, -20, 300, false));
+    samples.append(makeSample(99, -30, 200, true));
+    samples.append(makeSample(100, -40, 50, false));
+    samples.append(makeSample(399, -5, 7, true));
+
+    QVector<TelemetryBucket> buckets = TelemetryService::decimate(samples, 0, 400, 4);
+    QCOMPARE(buckets.size(), 4);
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(buckets[i].startNs, qint64(i * 100));
+        QCOMPARE(buckets[i].endNs, qint64((i + 1) * 100));
+    }
+
+    const TelemetryBucket &first = buckets[0];
+    QCOMPARE(first.count, 3);
+    QCOMPARE(first.minPowerDb, -30.0f);
+    QCOMPARE(first.maxPowerDb, -10.0f);
+    QCOMPARE(first.meanPowerDb, -20.0f);
+    QCOMPARE(first.minLowAdc, quint32(100));
+    QCOMPARE(first.maxLowAdc, quint32(300));
+    QCOMPARE(first.meanLowAdc, 200.0f);
+    QCOMPARE(first.txRatio, 2.0f / 3.0f);
+
+    QCOMPARE(buckets[1].count, 1);
+    QCOMPARE(buckets[1].meanPowerDb, -40.0f);
+    QCOMPARE(buckets[1].txRatio, 0.0f);
+
+    QCOMPARE(buckets[2].count, 0);
+    QCOMPARE(buckets[2].txRatio, 0.0f);
+
+    QCOMPARE(buckets[3].count, 1);
+    QCOMPARE(buckets[3].txRatio, 1.0f);
+}
+
+void TestTelemetry::decimateDropsOutOfRange()
+{
+    // 区间左闭右开，endNs处及区间外的采样不计入
+    QVector<TelemetrySample> samples;
+    samples.append(makeSample(-1, 0, 0, true));
+    samples.append(makeSample(1000, 0, 0, true));
+    samples.append(makeSample(2000, 0, 0, true));
+    samples.append(makeSample(1999, -3, 9, false));
+
+    QVector<TelemetryBucket> buckets = TelemetryService::decimate(samples, 1000, 2000, 1);
+    QCOMPARE(buckets.size(), 1);
+    QCOMPARE(buckets[0].count, 2);
+    QCOMPARE(buckets[0].txRatio, 0.5f);
+    QCOMPARE(buckets[0].maxLowAdc, quint32(9));
+}
+
+QTEST_GUILESS_MAIN(TestTelemetry)
+
+#include "tst_telemetry.moc"
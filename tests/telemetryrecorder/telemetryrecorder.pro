@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = tst_telemetryrecorder
+
+SOURCES += \
+    tst_telemetryrecorder.cpp
@@ -0,0 +1,162 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QTemporaryDir>
+#include "telemetryrecorder.h"
+
+// TelemetryRecorder批次写入测试：采样按考试开始/结束切分，查询连接随线程移除
+class TestTelemetryRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void samplesSplitAtExamEvents();
+    void eventsRecordedUnderExam();
+    void readerConnectionRemovedWithThread();
+
+private:
+    static TelemetryEvent makeEvent(qint64 timeNs, int type);
+    static int readerConnectionCount();
+
+    QTemporaryDir m_dir;
+    TelemetryRecorder *m_recorder = nullptr;
+};
+
+// 单调时钟上任取的起点，以下时刻均相对于它
+static const qint64 BASE_NS = 100 * 1000000000LL;
+static const qint64 MS_NS = 1000000LL;
+
+TelemetryEvent TestTelemetryRecorder::makeEvent(qint64 timeNs, int type)
+{
+    TelemetryEvent event;
+    event.timeMs = timeNs;
+    event.type = type;
+    return event;
+}
+
+int TestTelemetryRecorder::readerConnectionCount()
+{
+    int count = 0;
+    for (const QString &name : QSqlDatabase::connectionNames()) {
+        if (name.startsWith("telemetry_reader_")) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TestTelemetryRecorder::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_recorder = TelemetryRecorder::instance();
+    m_recorder->setDatabaseName(m_dir.filePath("telemetry.db"));
+    QVERIFY(m_recorder->openWriter(m_dir.filePath("telemetry.db")));
+
+    // 电台1每100ms一个采样，覆盖1.0s~3.9s；电台2无采样
+    QVector<TelemetrySample> samples[TelemetryService::RADIO_COUNT];
+    for (int i = 10; i < 40; i++) {
+        TelemetrySample sample;
+        sample.timeNs = BASE_NS + i * 100 * MS_NS;
+        sample.powerDb = -i;
+        sample.lowAdc = i;
+        sample.tx = true;
+        samples[0].append(sample);
+    }
+
+    // 同一批次内：1.5s开始A，2.5s结束A，3.0s开始B
+    QVector<TelemetryEvent> events;
+    events.append(makeEvent(BASE_NS + 1500 * MS_NS, TelemetryEvent::ExamStart));
+    TelemetryEvent edge = makeEvent(BASE_NS + 2000 * MS_NS, TelemetryEvent::PttEdge);
+    edge.radio = 1;
+    edge.newValue = 1;
+    events.append(edge);
+    events.append(makeEvent(BASE_NS + 2500 * MS_NS, TelemetryEvent::ExamEnd));
+    events.append(makeEvent(BASE_NS + 3000 * MS_NS, TelemetryEvent::ExamStart));
+    m_recorder->writeBatch(events, QStringList() << "A" << "B", samples, false);
+
+    // 下一批次结束B，无新采样
+    QVector<TelemetrySample> empty[TelemetryService::RADIO_COUNT];
+    events.clear();
+    events.append(makeEvent(BASE_NS + 4000 * MS_NS, TelemetryEvent::ExamEnd));
+    m_recorder->writeBatch(events, QStringList(), empty, true);
+}
+
+void TestTelemetryRecorder::cleanupTestCase()
+{
+    m_recorder->closeWriter();
+}
+
+void TestTelemetryRecorder::samplesSplitAtExamEvents()
+{
+    QList<TelemetryEvent> eventsA = m_recorder->events("A");
+    QCOMPARE(eventsA.size(), 3);
+    qint64 startMs = eventsA.first().timeMs;
+    qint64 endMs = eventsA.last().timeMs;
+
+    // 开始时刻的采样归属该考试，结束时刻的不归属
+    QVector<TelemetryBucket> rawA = m_recorder->powerHistory("A", 1, TelemetryRecorder::TierRaw);
+    QCOMPARE(rawA.size(), 10);
+    for (const TelemetryBucket &bucket : rawA) {
+        qint64 timeMs = bucket.startNs / MS_NS;
+        QVERIFY(timeMs >= startMs);
+        QVERIFY(timeMs < endMs);
+    }
+    QCOMPARE(rawA.first().minLowAdc, quint32(15));
+    QCOMPARE(rawA.last().minLowAdc, quint32(24));
+
+    // B开始前(2.5s~2.9s)的采样不属于任何考试
+    QVector<TelemetryBucket> rawB = m_recorder->powerHistory("B", 1, TelemetryRecorder::TierRaw);
+    QCOMPARE(rawB.size(), 10);
+    QCOMPARE(rawB.first().minLowAdc, quint32(30));
+    QCOMPARE(rawB.last().minLowAdc, quint32(39));
+
+    QVERIFY(m_recorder->powerHistory("A", 2, TelemetryRecorder::TierRaw).isEmpty());
+
+    // 1秒汇总的采样数与原始采样一致，不跨考试
+    int countA = 0;
+    for (const TelemetryBucket &bucket : m_recorder->powerHistory("A", 1, TelemetryRecorder::Tier1s)) {
+        countA += bucket.count;
+    }
+    QCOMPARE(countA, 10);
+    int countB = 0;
+    for (const TelemetryBucket &bucket : m_recorder->powerHistory("B", 1, TelemetryRecorder::Tier1s)) {
+        countB += bucket.count;
+    }
+    QCOMPARE(countB, 10);
+}
+
+void TestTelemetryRecorder::eventsRecordedUnderExam()
+{
+    QList<TelemetryEvent> eventsA = m_recorder->events("A");
+    QCOMPARE(eventsA.size(), 3);
+    QCOMPARE(eventsA[0].type, int(TelemetryEvent::ExamStart));
+    QCOMPARE(eventsA[1].type, int(TelemetryEvent::PttEdge));
+    QCOMPARE(eventsA[1].radio, 1);
+    QCOMPARE(eventsA[1].newValue, 1);
+    QCOMPARE(eventsA[2].type, int(TelemetryEvent::ExamEnd));
+
+    QList<TelemetryEvent> eventsB = m_recorder->events("B");
+    QCOMPARE(eventsB.size(), 2);
+    QCOMPARE(eventsB.last().type, int(TelemetryEvent::ExamEnd));
+    QCOMPARE(eventsB.last().timeMs - eventsB.first().timeMs, qint64(1000));
+}
+
+void TestTelemetryRecorder::readerConnectionRemovedWithThread()
+{
+    int before = readerConnectionCount();
+    int found = 0;
+    QThread *thread = QThread::create([this, &found]() {
+        found = m_recorder->events("A").size();
+    });
+    thread->start();
+    QVERIFY(thread->wait(5000));
+    delete thread;
+
+    QCOMPARE(found, 3);
+    QCOMPARE(readerConnectionCount(), before);
+}
+
+QTEST_GUILESS_MAIN(TestTelemetryRecorder)
+
+#include "tst_telemetryrecorder.moc"
@@ -0,0 +1,12 @@
+# 测试公共配置
+QT += testlib
+QT -= gui
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+# 公用数据构造
+INCLUDEPATH += $$PWD
+HEADERS += $$PWD/testutil.h
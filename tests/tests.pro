@@ -0,0 +1,21 @@
+# 功能测试，每个被测模块一个独立可执行程序，make check运行
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    asynclogger \
+    channelcache \
+    channelparamqueue \
+    configmanager \
+    databasemanager \
+    hardwarejournal \
+    iohandler \
+    mqttparser \
+    pttallocation \
+    reportbuilder \
+    rtprofile \
+    scenarioindex \
+    scenariolibrary \
+    scenariopack \
+    scenariotablemodel \
+    telemetry \
+    telemetryrecorder
@@ -0,0 +1,37 @@
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+#include <QString>
+#include "channelparaconifg.h"
+
+// 单元测试和基准测试公用的数据构造，由tests.pri、bench.pri加入包含路径
+namespace TestUtil {
+
+// 场景配置：第i条多径(1起)时延100*i、功率-i、频移10*i、扩展5*i、多普勒类型i%3
+inline ModelParaSetting makeConfig(const QString &name, int channel, int paths = 1)
+{
+    ModelParaSetting config;
+    config.channelNum = channel;
+    config.modelType = 1;
+    config.modelName = name;
+    config.noisePower = 10.5;
+    config.signalAnt = 20.25;
+    config.comDistance = 3000;
+    config.multipathNum = paths;
+    config.filterNum = 2;
+    for (int i = 1; i <= paths; i++) {
+        MultiPathType path;
+        path.pathNum = i;
+        path.relativDelay = 100 * i;
+        path.antPower = -i;
+        path.freShift = 10 * i;
+        path.freSpread = 5 * i;
+        path.dopplerType = i % 3;
+        config.multipathType.append(path);
+    }
+    return config;
+}
+
+}
+
+#endif // TESTUTIL_H
@@ -0,0 +1,56 @@
+#include "wakeupnotifier.h"
+#include <QSocketNotifier>
+#include <QDebug>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+WakeupNotifier::WakeupNotifier(QObject *parent)
+    : QObject(parent)
+    , m_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , m_notifier(nullptr)
+{
+    if (m_fd < 0) {
+        qWarning() << "创建eventfd失败:" << strerror(errno);
+        return;
+    }
+    // 作为子对象随本对象moveToThread，在所属线程的事件循环中监听
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, QOverload<QSocketDescriptor, QSocketNotifier::Type>::of(&QSocketNotifier::activated),
+            this, &WakeupNotifier::readEvent);
+}
+
+WakeupNotifier::~WakeupNotifier()
+{
+    delete m_notifier;
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool WakeupNotifier::isValid() const
+{
+    return m_fd >= 0;
+}
+
+void WakeupNotifier::notify()
+{
+    if (m_fd < 0) {
+        return;
+    }
+    // 计数已满(EAGAIN)时说明已有未处理的唤醒，忽略即可
+    uint64_t one = 1;
+    ssize_t ret = write(m_fd, &one, sizeof(one));
+    Q_UNUSED(ret);
+}
+
+void WakeupNotifier::readEvent()
+{
+    // 读出计数即清零，之后的notify()会再次触发
+    uint64_t count = 0;
+    if (read(m_fd, &count, sizeof(count)) != sizeof(count)) {
+        return;
+    }
+    emit activated();
+}
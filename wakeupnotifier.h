@@ -0,0 +1,35 @@
+#ifndef WAKEUPNOTIFIER_H
+#define WAKEUPNOTIFIER_H
+
+#include <QObject>
+
+class QSocketNotifier;
+
+// 跨线程唤醒：任意线程调用notify()，在本对象所属线程中发出activated()
+// 基于eventfd，notify()只是一次write系统调用，不投递Qt事件、不分配堆内存，可在PTT线程中使用
+// activated()处理前的多次notify()合并为一次
+class WakeupNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WakeupNotifier(QObject *parent = nullptr);
+    ~WakeupNotifier();
+
+    bool isValid() const;
+
+    // 任意线程调用
+    void notify();
+
+signals:
+    void activated();
+
+private slots:
+    void readEvent();
+
+private:
+    int m_fd;
+    QSocketNotifier *m_notifier;
+};
+
+#endif // WAKEUPNOTIFIER_H